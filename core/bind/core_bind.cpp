@@ -111,6 +111,39 @@ bool _ResourceLoader::exists(const String& p_path, const String& p_type_hint) {
     return ResourceLoader::exists(p_path, p_type_hint);
 }
 
+Error _ResourceLoader::load_threaded_request(
+    const String& p_path,
+    const String& p_type_hint
+) {
+    return ResourceLoader::load_threaded_request(p_path, p_type_hint);
+}
+
+_ResourceLoader::ThreadLoadStatus _ResourceLoader::load_threaded_get_status(
+    const String& p_path
+) {
+    return static_cast<ThreadLoadStatus>(
+        ResourceLoader::load_threaded_get_status(p_path)
+    );
+}
+
+float _ResourceLoader::load_threaded_get_progress(const String& p_path) {
+    float progress = 0;
+    ResourceLoader::load_threaded_get_status(p_path, &progress);
+    return progress;
+}
+
+RES _ResourceLoader::load_threaded_get(const String& p_path) {
+    Error err = OK;
+    RES ret   = ResourceLoader::load_threaded_get(p_path, &err);
+
+    ERR_FAIL_COND_V_MSG(
+        err != OK,
+        ret,
+        "Error loading resource: '" + p_path + "'."
+    );
+    return ret;
+}
+
 void _ResourceLoader::_bind_methods() {
     ClassDB::bind_method(
         D_METHOD("load_interactive", "path", "type_hint"),
@@ -144,9 +177,31 @@ void _ResourceLoader::_bind_methods() {
         &_ResourceLoader::exists,
         DEFVAL("")
     );
+    ClassDB::bind_method(
+        D_METHOD("load_threaded_request", "path", "type_hint"),
+        &_ResourceLoader::load_threaded_request,
+        DEFVAL("")
+    );
+    ClassDB::bind_method(
+        D_METHOD("load_threaded_get_status", "path"),
+        &_ResourceLoader::load_threaded_get_status
+    );
+    ClassDB::bind_method(
+        D_METHOD("load_threaded_get_progress", "path"),
+        &_ResourceLoader::load_threaded_get_progress
+    );
+    ClassDB::bind_method(
+        D_METHOD("load_threaded_get", "path"),
+        &_ResourceLoader::load_threaded_get
+    );
 #ifndef DISABLE_DEPRECATED
     ClassDB::bind_method(D_METHOD("has", "path"), &_ResourceLoader::has);
 #endif // DISABLE_DEPRECATED
+
+    BIND_ENUM_CONSTANT(THREAD_LOAD_INVALID_RESOURCE);
+    BIND_ENUM_CONSTANT(THREAD_LOAD_IN_PROGRESS);
+    BIND_ENUM_CONSTANT(THREAD_LOAD_FAILED);
+    BIND_ENUM_CONSTANT(THREAD_LOAD_LOADED);
 }
 
 _ResourceLoader::_ResourceLoader() {
@@ -26,6 +26,13 @@ protected:
     static _ResourceLoader* singleton;
 
 public:
+    enum ThreadLoadStatus {
+        THREAD_LOAD_INVALID_RESOURCE,
+        THREAD_LOAD_IN_PROGRESS,
+        THREAD_LOAD_FAILED,
+        THREAD_LOAD_LOADED,
+    };
+
     static _ResourceLoader* get_singleton() {
         return singleton;
     }
@@ -48,9 +55,19 @@ public:
     bool has_cached(const String& p_path);
     bool exists(const String& p_path, const String& p_type_hint = "");
 
+    Error load_threaded_request(
+        const String& p_path,
+        const String& p_type_hint = ""
+    );
+    ThreadLoadStatus load_threaded_get_status(const String& p_path);
+    float load_threaded_get_progress(const String& p_path);
+    RES load_threaded_get(const String& p_path);
+
     _ResourceLoader();
 };
 
+VARIANT_ENUM_CAST(_ResourceLoader::ThreadLoadStatus);
+
 class _ResourceSaver : public Object {
     GDCLASS(_ResourceSaver, Object);
 
@@ -14,6 +14,10 @@ void CommandQueueMT::lock() {
 }
 
 void CommandQueueMT::unlock() {
+    if (ring_buffer) {
+        // Publish the commands written while the mutex was locked.
+        ring_written.set(ring_write_ptr);
+    }
     mutex.unlock();
 }
 
@@ -70,11 +74,103 @@ tryagain:
     return true;
 }
 
-CommandQueueMT::CommandQueueMT(bool p_sync) {
+uint8_t* CommandQueueMT::_allocate_ring_memory(uint32_t p_size) {
+    // Commands are preceded by their size and the 'in use' bit, like in the
+    // mutex mode.
+    uint32_t size       = (p_size + 8 - 1) & ~(8 - 1);
+    uint32_t alloc_size = size + 8;
+
+    // Assert that the buffer is big enough to hold at least two messages.
+    ERR_FAIL_COND_V(alloc_size * 2 + 8 > command_mem_size, nullptr);
+
+    uint32_t freed     = ring_freed.get();
+    uint32_t write_ptr = ring_write_ptr;
+
+    // The write pointer never catches up with the freed pointer, because
+    // they are equal when the buffer is empty.
+    if (write_ptr >= freed) {
+        // Keep room at the end for the wrap marker.
+        if (command_mem_size - write_ptr < alloc_size + 8) {
+            if (freed <= alloc_size) {
+                return nullptr;
+            }
+            // Size zero means wrap to the beginning.
+            *(uint32_t*)&command_mem[write_ptr] = 1;
+            write_ptr                           = 0;
+        }
+    } else if (freed - write_ptr <= alloc_size) {
+        return nullptr;
+    }
+
+    *(uint32_t*)&command_mem[write_ptr] = (size << 1) | 1;
+    ring_write_ptr                      = write_ptr + alloc_size;
+    return &command_mem[write_ptr + 8];
+}
+
+bool CommandQueueMT::_flush_one_ring() {
+    uint32_t written = ring_written.get();
+
+tryagain:
+    if (ring_read_ptr == written) {
+        // The queue is empty
+        return false;
+    }
+
+    uint32_t* size_ptr = (uint32_t*)&command_mem[ring_read_ptr];
+    uint32_t size      = *size_ptr >> 1;
+
+    if (size == 0) {
+        *size_ptr = 0; // clear in-use bit.
+        // end of ringbuffer, wrap
+        ring_read_ptr = 0;
+        goto tryagain;
+    }
+
+    // Advance before calling, so commands can flush the queue themselves.
+    CommandBase* cmd =
+        reinterpret_cast<CommandBase*>(&command_mem[ring_read_ptr + 8]);
+    ring_read_ptr += size + 8;
+
+    cmd->call();
+    cmd->post();
+    cmd->~CommandBase();
+    *size_ptr &= ~1;
+
+    _dealloc_ring();
+    return true;
+}
+
+void CommandQueueMT::_dealloc_ring() {
+    // Commands are freed in order, once every command before them is freed.
+    while (ring_dealloc_ptr != ring_read_ptr) {
+        uint32_t size = *(uint32_t*)&command_mem[ring_dealloc_ptr];
+
+        if (size & 1) {
+            // Still used, nothing else can be deallocated
+            break;
+        }
+
+        if (size == 0) {
+            // End of command buffer wrap down
+            ring_dealloc_ptr = 0;
+        } else {
+            ring_dealloc_ptr += (size >> 1) + 8;
+        }
+    }
+
+    ring_freed.set(ring_dealloc_ptr);
+}
+
+CommandQueueMT::CommandQueueMT(bool p_sync, bool p_ring_buffer) {
     read_ptr_and_epoch  = 0;
     write_ptr_and_epoch = 0;
     dealloc_ptr         = 0;
 
+    ring_buffer      = p_ring_buffer;
+    ring_write_ptr   = 0;
+    ring_read_ptr    = 0;
+    ring_dealloc_ptr = 0;
+
     command_mem_size = GLOBAL_DEF_RST(
         "memory/limits/command_queue/multithreading_queue_size_kb",
         DEFAULT_COMMAND_MEM_SIZE_KB
@@ -10,6 +10,7 @@
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
 #include "core/os/semaphore.h"
+#include "core/safe_refcount.h"
 #include "core/simple_type.h"
 #include "core/typedefs.h"
 
@@ -311,6 +312,18 @@ class CommandQueueMT {
     Mutex mutex;
     Semaphore* sync;
 
+    // In ring buffer mode, the mutex is only locked by producers, and the
+    // consumer reads and frees commands without locking. The producer and the
+    // consumer only share the positions they have written and freed up to.
+    // With a single producer, neither side ever waits for the other unless
+    // the buffer is full. Only one thread may flush the queue at a time.
+    bool ring_buffer;
+    uint32_t ring_write_ptr;
+    uint32_t ring_read_ptr;
+    uint32_t ring_dealloc_ptr;
+    SafeNumeric<uint32_t> ring_written;
+    SafeNumeric<uint32_t> ring_freed;
+
     template <class T>
     T* allocate() {
         // alloc size is size+T+safeguard
@@ -382,12 +395,22 @@ class CommandQueueMT {
         return cmd;
     }
 
+    template <class T>
+    T* allocate_ring() {
+        uint8_t* mem = _allocate_ring_memory(sizeof(T));
+        if (!mem) {
+            return nullptr;
+        }
+        return memnew_placement(mem, T);
+    }
+
     template <class T>
     T* allocate_and_lock() {
         lock();
         T* ret;
 
-        while ((ret = allocate<T>()) == nullptr) {
+        while ((ret = ring_buffer ? allocate_ring<T>() : allocate<T>())
+               == nullptr) {
             unlock();
             // sleep a little until fetch happened and some room is made
             wait_for_flush();
@@ -398,6 +421,10 @@ class CommandQueueMT {
     }
 
     bool flush_one(bool p_lock = true) {
+        if (ring_buffer) {
+            return _flush_one_ring();
+        }
+
         if (p_lock) {
             lock();
         }
@@ -455,6 +482,10 @@ class CommandQueueMT {
     SyncSemaphore* _alloc_sync_sem();
     bool dealloc_one();
 
+    uint8_t* _allocate_ring_memory(uint32_t p_size);
+    bool _flush_one_ring();
+    void _dealloc_ring();
+
 public:
     /* NORMAL PUSH COMMANDS */
     DECL_PUSH(0)
@@ -475,6 +506,13 @@ public:
     }
 
     void flush_all() {
+        if (ring_buffer) {
+            while (_flush_one_ring()) {
+                ;
+            }
+            return;
+        }
+
         // ERR_FAIL_COND(sync);
         lock();
         while (flush_one(false)) {
@@ -483,7 +521,11 @@ public:
         unlock();
     }
 
-    CommandQueueMT(bool p_sync);
+    _FORCE_INLINE_ bool is_ring_buffer() const {
+        return ring_buffer;
+    }
+
+    CommandQueueMT(bool p_sync, bool p_ring_buffer = false);
     ~CommandQueueMT();
 };
 
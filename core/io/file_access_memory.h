@@ -42,6 +42,7 @@ public:
 
     virtual uint64_t get_buffer(uint8_t* p_dst, uint64_t p_length)
         const; ///< get an array of bytes
+    virtual const uint8_t* get_buffer_ptr(uint64_t p_length) const;
 
     virtual Error get_error() const; ///< get last error
 
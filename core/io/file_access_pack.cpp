@@ -6,6 +6,7 @@
 
 #include "file_access_pack.h"
 
+#include "core/os/os.h"
 #include "core/version.h"
 
 #include <stdio.h>
@@ -217,18 +218,64 @@ bool PackedSourcePCK::try_open_pack(
         );
     };
 
+    _map_pack(p_path, f->get_path_absolute());
+
     f->close();
     memdelete(f);
     return true;
 };
 
+void PackedSourcePCK::_map_pack(
+    const String& p_path,
+    const String& p_absolute_path
+) {
+    // the pack may have changed since it was last loaded from this path
+    Map<String, Mapping>::Element* E = mappings.find(p_path);
+    if (E) {
+        replaced_mappings.push_back(E->get());
+        mappings.erase(E);
+    }
+
+    if (p_absolute_path.empty()) {
+        return;
+    }
+
+    Mapping mapping;
+    mapping.data =
+        OS::get_singleton()->map_file(p_absolute_path, &mapping.size);
+    if (mapping.data) {
+        mappings[p_path] = mapping;
+    }
+}
+
 FileAccess* PackedSourcePCK::get_file(
     const String& p_path,
     PackedData::PackedFile* p_file
 ) {
+    Map<String, Mapping>::Element* E = mappings.find(p_file->pack);
+    if (E && p_file->offset + p_file->size <= E->get().size) {
+        return memnew(FileAccessPack(
+            p_path,
+            *p_file,
+            E->get().data + p_file->offset
+        ));
+    }
     return memnew(FileAccessPack(p_path, *p_file));
 };
 
+PackedSourcePCK::~PackedSourcePCK() {
+    for (Map<String, Mapping>::Element* E = mappings.front(); E;
+         E                                = E->next()) {
+        OS::get_singleton()->unmap_file(E->get().data, E->get().size);
+    }
+    for (int i = 0; i < replaced_mappings.size(); i++) {
+        OS::get_singleton()->unmap_file(
+            replaced_mappings[i].data,
+            replaced_mappings[i].size
+        );
+    }
+}
+
 //////////////////////////////////////////////////////////////////
 
 Error FileAccessPack::_open(const String& p_path, int p_mode_flags) {
@@ -237,10 +284,17 @@ Error FileAccessPack::_open(const String& p_path, int p_mode_flags) {
 }
 
 void FileAccessPack::close() {
-    f->close();
+    if (mapped) {
+        data = nullptr;
+    } else {
+        f->close();
+    }
 }
 
 bool FileAccessPack::is_open() const {
+    if (mapped) {
+        return data != nullptr;
+    }
     return f->is_open();
 }
 
@@ -251,7 +305,9 @@ void FileAccessPack::seek(uint64_t p_position) {
         eof = false;
     }
 
-    f->seek(pf.offset + p_position);
+    if (!mapped) {
+        f->seek(pf.offset + p_position);
+    }
     pos = p_position;
 }
 
@@ -277,6 +333,11 @@ uint8_t FileAccessPack::get_8() const {
         return 0;
     }
 
+    if (mapped) {
+        ERR_FAIL_COND_V(!data, 0);
+        return data[pos++];
+    }
+
     pos++;
     return f->get_8();
 }
@@ -294,19 +355,37 @@ uint64_t FileAccessPack::get_buffer(uint8_t* p_dst, uint64_t p_length) const {
         to_read = (int64_t)pf.size - (int64_t)pos;
     }
 
+    uint64_t from = pos;
     pos += p_length;
 
     if (to_read <= 0) {
         return 0;
     }
-    f->get_buffer(p_dst, to_read);
+    if (mapped) {
+        ERR_FAIL_COND_V(!data, -1);
+        memcpy(p_dst, data + from, to_read);
+    } else {
+        f->get_buffer(p_dst, to_read);
+    }
 
     return to_read;
 }
 
+const uint8_t* FileAccessPack::get_buffer_ptr(uint64_t p_length) const {
+    if (!mapped || !data || eof || p_length > pf.size - pos) {
+        return nullptr;
+    }
+
+    const uint8_t* ptr = data + pos;
+    pos += p_length;
+    return ptr;
+}
+
 void FileAccessPack::set_endian_swap(bool p_swap) {
     FileAccess::set_endian_swap(p_swap);
-    f->set_endian_swap(p_swap);
+    if (!mapped) {
+        f->set_endian_swap(p_swap);
+    }
 }
 
 Error FileAccessPack::get_error() const {
@@ -334,18 +413,26 @@ bool FileAccessPack::file_exists(const String& p_name) {
 
 FileAccessPack::FileAccessPack(
     const String& p_path,
-    const PackedData::PackedFile& p_file
+    const PackedData::PackedFile& p_file,
+    const uint8_t* p_data
 ) :
     pf(p_file),
-    f(FileAccess::open(pf.pack, FileAccess::READ)) {
+    pos(0),
+    eof(false),
+    data(p_data),
+    mapped(p_data != nullptr),
+    f(nullptr) {
+    if (mapped) {
+        return;
+    }
+
+    f = FileAccess::open(pf.pack, FileAccess::READ);
     ERR_FAIL_COND_MSG(
         !f,
         "Can't open pack-referenced file '" + String(pf.pack) + "'."
     );
 
     f->seek(pf.offset);
-    pos = 0;
-    eof = false;
 }
 
 FileAccessPack::~FileAccessPack() {
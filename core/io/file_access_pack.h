@@ -135,7 +135,21 @@ public:
     virtual ~PackSource() {}
 };
 
+// Packs that can be mapped into memory are read from the mapping instead of
+// through a file handle, and their files support FileAccess::get_buffer_ptr().
 class PackedSourcePCK : public PackSource {
+    struct Mapping {
+        const uint8_t* data;
+        uint64_t size;
+    };
+
+    Map<String, Mapping> mappings;
+    // Mappings of packs that were loaded again, kept until the source is
+    // destroyed since files opened from them may still be reading them.
+    Vector<Mapping> replaced_mappings;
+
+    void _map_pack(const String& p_path, const String& p_absolute_path);
+
 public:
     virtual bool try_open_pack(
         const String& p_path,
@@ -146,6 +160,8 @@ public:
         const String& p_path,
         PackedData::PackedFile* p_file
     );
+
+    virtual ~PackedSourcePCK();
 };
 
 class FileAccessPack : public FileAccess {
@@ -154,6 +170,10 @@ class FileAccessPack : public FileAccess {
     mutable uint64_t pos;
     mutable bool eof;
 
+    // The file's data in the mapped pack, if the pack is mapped.
+    const uint8_t* data;
+    bool mapped;
+
     FileAccess* f;
     virtual Error _open(const String& p_path, int p_mode_flags);
 
@@ -186,6 +206,7 @@ public:
     virtual uint8_t get_8() const;
 
     virtual uint64_t get_buffer(uint8_t* p_dst, uint64_t p_length) const;
+    virtual const uint8_t* get_buffer_ptr(uint64_t p_length) const;
 
     virtual void set_endian_swap(bool p_swap);
 
@@ -198,7 +219,11 @@ public:
 
     virtual bool file_exists(const String& p_name);
 
-    FileAccessPack(const String& p_path, const PackedData::PackedFile& p_file);
+    FileAccessPack(
+        const String& p_path,
+        const PackedData::PackedFile& p_file,
+        const uint8_t* p_data = nullptr
+    );
     ~FileAccessPack();
 };
 
@@ -117,8 +117,12 @@ void MultiplayerAPI::clear() {
     connected_peers.clear();
     path_get_cache.clear();
     path_send_cache.clear();
+    name_get_cache.clear();
+    name_send_cache.clear();
     packet_cache.clear();
+    full_name_packet_cache.clear();
     last_send_cache_id = 1;
+    last_send_name_id  = 1;
 }
 
 void MultiplayerAPI::set_root_node(Node* p_node) {
@@ -199,7 +203,8 @@ void MultiplayerAPI::_process_packet(
     }
 #endif
 
-    uint8_t packet_type = p_packet[0];
+    uint8_t packet_type = p_packet[0] & ~NETWORK_COMMAND_FLAG_FULL_NAME;
+    bool full_name      = p_packet[0] & NETWORK_COMMAND_FLAG_FULL_NAME;
 
     switch (packet_type) {
         case NETWORK_COMMAND_SIMPLIFY_PATH: {
@@ -210,6 +215,14 @@ void MultiplayerAPI::_process_packet(
             _process_confirm_path(p_from, p_packet, p_packet_len);
         } break;
 
+        case NETWORK_COMMAND_SIMPLIFY_NAME: {
+            _process_simplify_name(p_from, p_packet, p_packet_len);
+        } break;
+
+        case NETWORK_COMMAND_CONFIRM_NAME: {
+            _process_confirm_name(p_from, p_packet, p_packet_len);
+        } break;
+
         case NETWORK_COMMAND_REMOTE_CALL:
         case NETWORK_COMMAND_REMOTE_SET: {
             ERR_FAIL_COND_MSG(
@@ -224,20 +237,51 @@ void MultiplayerAPI::_process_packet(
                 "Invalid packet received. Requested node was not found."
             );
 
-            // Detect cstring end.
-            int len_end = 5;
-            for (; len_end < p_packet_len; len_end++) {
-                if (p_packet[len_end] == 0) {
-                    break;
+            StringName name;
+            int offset;
+
+            if (full_name) {
+                // Detect cstring end.
+                int len_end = 5;
+                for (; len_end < p_packet_len; len_end++) {
+                    if (p_packet[len_end] == 0) {
+                        break;
+                    }
                 }
-            }
 
-            ERR_FAIL_COND_MSG(
-                len_end >= p_packet_len,
-                "Invalid packet received. Size too small."
-            );
+                ERR_FAIL_COND_MSG(
+                    len_end >= p_packet_len,
+                    "Invalid packet received. Size too small."
+                );
+
+                name   = String::utf8((const char*)&p_packet[5]);
+                offset = len_end + 1;
+
+            } else {
+                // Use cached name.
+                ERR_FAIL_COND_MSG(
+                    p_packet_len < 8,
+                    "Invalid packet received. Size too small."
+                );
 
-            StringName name = String::utf8((const char*)&p_packet[5]);
+                Map<int, NameGetCache>::Element* E =
+                    name_get_cache.find(p_from);
+                ERR_FAIL_COND_MSG(
+                    !E,
+                    "Invalid packet received. Requests invalid peer cache."
+                );
+
+                int id                           = decode_uint16(&p_packet[5]);
+                Map<int, StringName>::Element* F = E->get().names.find(id);
+                ERR_FAIL_COND_MSG(
+                    !F,
+                    "Invalid packet received. Unable to find requested cached "
+                    "name."
+                );
+
+                name   = F->get();
+                offset = 7;
+            }
 
             if (packet_type == NETWORK_COMMAND_REMOTE_CALL) {
                 _process_rpc(
@@ -246,7 +290,7 @@ void MultiplayerAPI::_process_packet(
                     p_from,
                     p_packet,
                     p_packet_len,
-                    len_end + 1
+                    offset
                 );
 
             } else {
@@ -256,7 +300,7 @@ void MultiplayerAPI::_process_packet(
                     p_from,
                     p_packet,
                     p_packet_len,
-                    len_end + 1
+                    offset
                 );
             }
 
@@ -554,6 +598,76 @@ void MultiplayerAPI::_process_confirm_path(
     E->get() = true;
 }
 
+void MultiplayerAPI::_process_simplify_name(
+    int p_from,
+    const uint8_t* p_packet,
+    int p_packet_len
+) {
+    ERR_FAIL_COND_MSG(
+        p_packet_len < 4,
+        "Invalid packet received. Size too small."
+    );
+    int id = decode_uint16(&p_packet[1]);
+
+    String names;
+    names.parse_utf8((const char*)&p_packet[3], p_packet_len - 3);
+
+    StringName name = names;
+
+    if (!name_get_cache.has(p_from)) {
+        name_get_cache[p_from] = NameGetCache();
+    }
+
+    name_get_cache[p_from].names[id] = name;
+
+    // Encode name to send ack.
+    CharString cname = names.utf8();
+    int len          = encode_cstring(cname.get_data(), nullptr);
+
+    Vector<uint8_t> packet;
+
+    packet.resize(1 + len);
+    packet.write[0] = NETWORK_COMMAND_CONFIRM_NAME;
+    encode_cstring(cname.get_data(), &packet.write[1]);
+
+    network_peer->set_transfer_mode(
+        NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE
+    );
+    network_peer->set_target_peer(p_from);
+    network_peer->put_packet(packet.ptr(), packet.size());
+}
+
+void MultiplayerAPI::_process_confirm_name(
+    int p_from,
+    const uint8_t* p_packet,
+    int p_packet_len
+) {
+    ERR_FAIL_COND_MSG(
+        p_packet_len < 2,
+        "Invalid packet received. Size too small."
+    );
+
+    String names;
+    names.parse_utf8((const char*)&p_packet[1], p_packet_len - 1);
+
+    StringName name = names;
+
+    NameSentCache* nsc = name_send_cache.getptr(name);
+    ERR_FAIL_COND_MSG(
+        !nsc,
+        "Invalid packet received. Tries to confirm a name which was not found "
+        "in cache."
+    );
+
+    Map<int, bool>::Element* E = nsc->confirmed_peers.find(p_from);
+    ERR_FAIL_COND_MSG(
+        !E,
+        "Invalid packet received. Source peer was not found in cache for the "
+        "given name."
+    );
+    E->get() = true;
+}
+
 bool MultiplayerAPI::_send_confirm_path(
     NodePath p_path,
     PathSentCache* psc,
@@ -613,6 +727,65 @@ bool MultiplayerAPI::_send_confirm_path(
     return has_all_peers;
 }
 
+bool MultiplayerAPI::_send_confirm_name(
+    const StringName& p_name,
+    NameSentCache* nsc,
+    int p_target
+) {
+    bool has_all_peers = true;
+    List<int> peers_to_add; // If one is missing, take note to add it.
+
+    for (Set<int>::Element* E = connected_peers.front(); E; E = E->next()) {
+        if (p_target < 0 && E->get() == -p_target) {
+            continue; // Continue, excluded.
+        }
+
+        if (p_target > 0 && E->get() != p_target) {
+            continue; // Continue, not for this peer.
+        }
+
+        Map<int, bool>::Element* F = nsc->confirmed_peers.find(E->get());
+
+        if (!F || !F->get()) {
+            // Name was not cached, or was cached but is unconfirmed.
+            if (!F) {
+                // Not cached at all, take note.
+                peers_to_add.push_back(E->get());
+            }
+
+            has_all_peers = false;
+        }
+    }
+
+    if (peers_to_add.empty()) {
+        return has_all_peers;
+    }
+
+    // Those that need to be added, send a message for this.
+    CharString cname = String(p_name).utf8();
+    int len          = encode_cstring(cname.get_data(), nullptr);
+
+    Vector<uint8_t> packet;
+
+    packet.resize(1 + 2 + len);
+    packet.write[0] = NETWORK_COMMAND_SIMPLIFY_NAME;
+    encode_uint16(nsc->id, &packet.write[1]);
+    encode_cstring(cname.get_data(), &packet.write[3]);
+
+    for (List<int>::Element* E = peers_to_add.front(); E; E = E->next()) {
+        network_peer->set_target_peer(E->get());
+        network_peer->set_transfer_mode(
+            NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE
+        );
+        network_peer->put_packet(packet.ptr(), packet.size());
+
+        // Insert into confirmed, but as false since it was not confirmed.
+        nsc->confirmed_peers.insert(E->get(), false);
+    }
+
+    return has_all_peers;
+}
+
 void MultiplayerAPI::_send_rpc(
     Node* p_from,
     int p_to,
@@ -671,6 +844,15 @@ void MultiplayerAPI::_send_rpc(
         psc->id                    = last_send_cache_id++;
     }
 
+    // See if the name is cached. Once the IDs run out, new names are always
+    // sent in full.
+    NameSentCache* nsc = name_send_cache.getptr(p_name);
+    if (!nsc && last_send_name_id <= UINT16_MAX) {
+        name_send_cache[p_name] = NameSentCache();
+        nsc                     = name_send_cache.getptr(p_name);
+        nsc->id                 = last_send_name_id++;
+    }
+
     // Create base packet, lots of hardcode because it must be tight.
 
     int ofs = 0;
@@ -689,12 +871,13 @@ void MultiplayerAPI::_send_rpc(
     encode_uint32(psc->id, &(packet_cache.write[ofs]));
     ofs += 4;
 
-    // Encode function name.
-    CharString name = String(p_name).utf8();
-    int len         = encode_cstring(name.get_data(), nullptr);
-    MAKE_ROOM(ofs + len);
-    encode_cstring(name.get_data(), &(packet_cache.write[ofs]));
-    ofs += len;
+    // Encode function name ID. Peers that didn't confirm it yet get a copy of
+    // the packet with the full name instead, see below.
+    MAKE_ROOM(ofs + 2);
+    encode_uint16(nsc ? nsc->id : 0, &(packet_cache.write[ofs]));
+    ofs += 2;
+
+    int len = 0;
 
     if (p_set) {
         // Set argument.
@@ -760,6 +943,7 @@ void MultiplayerAPI::_send_rpc(
 
     // See if all peers have cached path (is so, call can be fast).
     bool has_all_peers = _send_confirm_path(from_path, psc, p_to);
+    bool has_all_names = nsc && _send_confirm_name(p_name, nsc, p_to);
 
     // Take chance and set transfer mode, since all send methods will use it.
     network_peer->set_transfer_mode(
@@ -767,15 +951,15 @@ void MultiplayerAPI::_send_rpc(
                      : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE
     );
 
-    if (has_all_peers) {
-        // They all have verified paths, so send fast.
+    if (has_all_peers && has_all_names) {
+        // They all have verified paths and names, so send fast.
         network_peer->set_target_peer(p_to); // To all of you.
         network_peer->put_packet(
             packet_cache.ptr(),
             ofs
         ); // A message with love.
     } else {
-        // Not all verified path, so send one by one.
+        // Not all verified path or name, so send one by one.
 
         // Append path at the end, since we will need it for some packets.
         CharString pname = String(from_path).utf8();
@@ -783,6 +967,27 @@ void MultiplayerAPI::_send_rpc(
         MAKE_ROOM(ofs + path_len);
         encode_cstring(pname.get_data(), &(packet_cache.write[ofs]));
 
+        // Copy the packet with the full name instead of its ID, since we will
+        // need it for some packets.
+        int full_name_ofs = 0;
+        if (!has_all_names) {
+            CharString name = String(p_name).utf8();
+            int name_len    = encode_cstring(name.get_data(), nullptr);
+            full_name_ofs   = ofs - 2 + name_len;
+            if (full_name_packet_cache.size() < full_name_ofs + path_len) {
+                full_name_packet_cache.resize(full_name_ofs + path_len);
+            }
+
+            uint8_t* packet = full_name_packet_cache.ptrw();
+            packet[0]       = packet_cache[0] | NETWORK_COMMAND_FLAG_FULL_NAME;
+            encode_cstring(name.get_data(), &packet[5]);
+            memcpy(
+                &packet[5 + name_len],
+                &packet_cache[7],
+                ofs - 7 + path_len
+            );
+        }
+
         for (Set<int>::Element* E = connected_peers.front(); E; E = E->next()) {
             if (p_to < 0 && E->get() == -p_to) {
                 continue; // Continue, excluded.
@@ -795,21 +1000,32 @@ void MultiplayerAPI::_send_rpc(
             Map<int, bool>::Element* F = psc->confirmed_peers.find(E->get());
             ERR_CONTINUE(!F); // Should never happen.
 
+            // If this one did not confirm name yet, use entire name.
+            bool name_confirmed = has_all_names;
+            if (!name_confirmed && nsc) {
+                Map<int, bool>::Element* G =
+                    nsc->confirmed_peers.find(E->get());
+                name_confirmed = G && G->get();
+            }
+            Vector<uint8_t>& packet =
+                name_confirmed ? packet_cache : full_name_packet_cache;
+            int packet_ofs          = name_confirmed ? ofs : full_name_ofs;
+
             network_peer->set_target_peer(E->get()
             ); // To this one specifically.
 
             if (F->get()) {
                 // This one confirmed path, so use id.
-                encode_uint32(psc->id, &(packet_cache.write[1]));
-                network_peer->put_packet(packet_cache.ptr(), ofs);
+                encode_uint32(psc->id, &(packet.write[1]));
+                network_peer->put_packet(packet.ptr(), packet_ofs);
             } else {
                 // This one did not confirm path yet, so use entire path
                 // (sorry!).
                 encode_uint32(
-                    0x80000000 | ofs,
-                    &(packet_cache.write[1])
+                    0x80000000 | packet_ofs,
+                    &(packet.write[1])
                 ); // Offset to path and flag.
-                network_peer->put_packet(packet_cache.ptr(), ofs + path_len);
+                network_peer->put_packet(packet.ptr(), packet_ofs + path_len);
             }
         }
     }
@@ -818,6 +1034,7 @@ void MultiplayerAPI::_send_rpc(
 void MultiplayerAPI::_add_peer(int p_id) {
     connected_peers.insert(p_id);
     path_get_cache.insert(p_id, PathGetCache());
+    name_get_cache.insert(p_id, NameGetCache());
     emit_signal("network_peer_connected", p_id);
 }
 
@@ -833,6 +1050,13 @@ void MultiplayerAPI::_del_peer(int p_id) {
         PathSentCache* psc = path_send_cache.getptr(E->get());
         psc->confirmed_peers.erase(p_id);
     }
+    name_get_cache.erase(p_id);
+    List<StringName> names;
+    name_send_cache.get_key_list(&names);
+    for (List<StringName>::Element* E = names.front(); E; E = E->next()) {
+        NameSentCache* nsc = name_send_cache.getptr(E->get());
+        nsc->confirmed_peers.erase(p_id);
+    }
     emit_signal("network_peer_disconnected", p_id);
 }
 
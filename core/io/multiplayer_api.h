@@ -40,6 +40,17 @@ private:
         Map<int, NodeInfo> nodes;
     };
 
+    // method and property name sent caches
+    struct NameSentCache {
+        Map<int, bool> confirmed_peers;
+        int id;
+    };
+
+    // method and property name get caches
+    struct NameGetCache {
+        Map<int, StringName> names;
+    };
+
 #ifdef DEBUG_ENABLED
     struct BandwidthFrame {
         uint64_t timestamp;
@@ -66,7 +77,11 @@ private:
     HashMap<NodePath, PathSentCache> path_send_cache;
     Map<int, PathGetCache> path_get_cache;
     int last_send_cache_id;
+    HashMap<StringName, NameSentCache> name_send_cache;
+    Map<int, NameGetCache> name_get_cache;
+    int last_send_name_id;
     Vector<uint8_t> packet_cache;
+    Vector<uint8_t> full_name_packet_cache;
     Node* root_node;
     bool allow_object_decoding;
 
@@ -84,6 +99,16 @@ protected:
         const uint8_t* p_packet,
         int p_packet_len
     );
+    void _process_simplify_name(
+        int p_from,
+        const uint8_t* p_packet,
+        int p_packet_len
+    );
+    void _process_confirm_name(
+        int p_from,
+        const uint8_t* p_packet,
+        int p_packet_len
+    );
     Node* _process_get_node(
         int p_from,
         const uint8_t* p_packet,
@@ -117,6 +142,11 @@ protected:
         int p_argcount
     );
     bool _send_confirm_path(NodePath p_path, PathSentCache* psc, int p_target);
+    bool _send_confirm_name(
+        const StringName& p_name,
+        NameSentCache* nsc,
+        int p_target
+    );
 
 public:
     enum NetworkCommands {
@@ -125,6 +155,11 @@ public:
         NETWORK_COMMAND_SIMPLIFY_PATH,
         NETWORK_COMMAND_CONFIRM_PATH,
         NETWORK_COMMAND_RAW,
+        NETWORK_COMMAND_SIMPLIFY_NAME,
+        NETWORK_COMMAND_CONFIRM_NAME,
+        // Set on remote calls and sets that contain the method or property
+        // name, instead of its ID.
+        NETWORK_COMMAND_FLAG_FULL_NAME = 0x80,
     };
 
     enum RPCMode {
@@ -86,8 +86,13 @@ StringName ResourceInteractiveLoaderBinary::_get_string() {
         if (len == 0) {
             return StringName();
         }
-        f->get_buffer((uint8_t*)&str_buf[0], len);
         String s;
+        const uint8_t* ptr = f->get_buffer_ptr(len);
+        if (ptr) {
+            s.parse_utf8((const char*)ptr, len);
+            return s;
+        }
+        f->get_buffer((uint8_t*)&str_buf[0], len);
         s.parse_utf8(&str_buf[0]);
         return s;
     }
@@ -780,8 +785,13 @@ String ResourceInteractiveLoaderBinary::get_unicode_string() {
     if (len == 0) {
         return String();
     }
-    f->get_buffer((uint8_t*)&str_buf[0], len);
     String s;
+    const uint8_t* ptr = f->get_buffer_ptr(len);
+    if (ptr) {
+        s.parse_utf8((const char*)ptr, len);
+        return s;
+    }
+    f->get_buffer((uint8_t*)&str_buf[0], len);
     s.parse_utf8(&str_buf[0]);
     return s;
 }
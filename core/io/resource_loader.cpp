@@ -563,6 +563,292 @@ bool ResourceLoader::exists(const String& p_path, const String& p_type_hint) {
     return false;
 }
 
+ResourceLoader::ThreadLoadTask* ResourceLoader::_request_thread_load(
+    const String& p_local_path,
+    const String& p_type_hint
+) {
+    ThreadLoadTask** task_ptr = thread_load_tasks.getptr(p_local_path);
+    if (task_ptr) {
+        return *task_ptr;
+    }
+
+    ThreadLoadTask* task         = memnew(ThreadLoadTask);
+    task->local_path             = p_local_path;
+    task->type_hint              = p_type_hint;
+    task->error                  = OK;
+    task->status                 = THREAD_LOAD_IN_PROGRESS;
+    task->dependencies_requested = false;
+    task->request_count          = 0;
+    task->waiter_count           = 0;
+    task->pending_dependencies   = 0;
+    task->pending_dependents     = 0;
+
+    thread_load_tasks[p_local_path] = task;
+
+    thread_load_queue.push_back(task);
+    thread_load_semaphore.post();
+    return task;
+}
+
+bool ResourceLoader::_thread_load_depends_on(
+    const ThreadLoadTask* p_task,
+    const ThreadLoadTask* p_dependency
+) {
+    if (p_task == p_dependency) {
+        return true;
+    }
+    for (uint32_t i = 0; i < p_task->dependencies.size(); i++) {
+        if (_thread_load_depends_on(p_task->dependencies[i], p_dependency)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Must be called with thread_load_mutex locked. The mutex is released while
+// the dependencies are read from the file.
+void ResourceLoader::_request_thread_load_dependencies(ThreadLoadTask* p_task) {
+    p_task->dependencies_requested = true;
+    if (ResourceCache::has(p_task->local_path)) {
+        return;
+    }
+
+    List<String> dependencies;
+    String local_path = p_task->local_path;
+    thread_load_mutex.unlock();
+    get_dependencies(local_path, &dependencies);
+    thread_load_mutex.lock();
+
+    for (List<String>::Element* E = dependencies.front(); E; E = E->next()) {
+        String path = E->get().get_slice("::", 0);
+        if (path.is_rel_path()) {
+            path = "res://" + path;
+        } else {
+            path = ProjectSettings::get_singleton()->localize_path(path);
+        }
+
+        ThreadLoadTask* dependency = _request_thread_load(path, "");
+        if (p_task->dependencies.find(dependency) >= 0) {
+            continue;
+        }
+        // A cyclic dependency is left to the resource's own loader.
+        if (_thread_load_depends_on(dependency, p_task)) {
+            continue;
+        }
+
+        p_task->dependencies.push_back(dependency);
+        dependency->pending_dependents++;
+        if (dependency->status == THREAD_LOAD_IN_PROGRESS) {
+            dependency->dependents.push_back(p_task);
+            p_task->pending_dependencies++;
+        }
+    }
+}
+
+void ResourceLoader::_finish_thread_load(ThreadLoadTask* p_task) {
+    for (uint32_t i = 0; i < p_task->dependents.size(); i++) {
+        ThreadLoadTask* dependent = p_task->dependents[i];
+        dependent->pending_dependencies--;
+        if (dependent->pending_dependencies == 0) {
+            thread_load_queue.push_back(dependent);
+            thread_load_semaphore.post();
+        }
+    }
+    p_task->dependents.clear();
+
+    // The dependencies are in the cache, or failed, by now.
+    for (uint32_t i = 0; i < p_task->dependencies.size(); i++) {
+        ThreadLoadTask* dependency = p_task->dependencies[i];
+        dependency->pending_dependents--;
+        _release_thread_load(dependency);
+    }
+    p_task->dependencies.clear();
+
+    for (int i = 0; i < p_task->waiter_count; i++) {
+        p_task->loaded.post();
+    }
+    _release_thread_load(p_task);
+}
+
+void ResourceLoader::_release_thread_load(ThreadLoadTask* p_task) {
+    if (p_task->status == THREAD_LOAD_IN_PROGRESS || p_task->request_count > 0
+        || p_task->waiter_count > 0 || p_task->pending_dependents > 0) {
+        return;
+    }
+    thread_load_tasks.erase(p_task->local_path);
+    memdelete(p_task);
+}
+
+float ResourceLoader::_get_thread_load_progress(const ThreadLoadTask* p_task) {
+    LocalVector<const ThreadLoadTask*> tasks;
+    tasks.push_back(p_task);
+    int loaded_count = 0;
+    for (uint32_t i = 0; i < tasks.size(); i++) {
+        const ThreadLoadTask* task = tasks[i];
+        if (task->status != THREAD_LOAD_IN_PROGRESS) {
+            loaded_count++;
+            continue;
+        }
+        for (uint32_t j = 0; j < task->dependencies.size(); j++) {
+            if (tasks.find(task->dependencies[j]) < 0) {
+                tasks.push_back(task->dependencies[j]);
+            }
+        }
+    }
+    return (float)loaded_count / tasks.size();
+}
+
+// Must be called with thread_load_mutex locked. Processes the next queued task
+// by either requesting its dependencies or loading it. The mutex is released
+// while the resource is loaded.
+void ResourceLoader::_process_thread_load() {
+    if (thread_load_queue.empty()) {
+        return;
+    }
+    ThreadLoadTask* task = thread_load_queue.front()->get();
+    thread_load_queue.pop_front();
+
+    if (!task->dependencies_requested) {
+        _request_thread_load_dependencies(task);
+        if (task->pending_dependencies > 0) {
+            // Queued again when the last dependency finishes.
+            return;
+        }
+    }
+
+    String local_path = task->local_path;
+    String type_hint  = task->type_hint;
+    thread_load_mutex.unlock();
+    Error error  = OK;
+    RES resource = load(local_path, type_hint, false, &error);
+    thread_load_mutex.lock();
+
+    task->resource = resource;
+    task->error    = error;
+    task->status   =
+        resource.is_valid() ? THREAD_LOAD_LOADED : THREAD_LOAD_FAILED;
+    _finish_thread_load(task);
+}
+
+void ResourceLoader::_thread_load_function(void* p_userdata) {
+    thread_load_mutex.lock();
+    while (true) {
+        thread_load_mutex.unlock();
+        thread_load_semaphore.wait();
+        thread_load_mutex.lock();
+        if (thread_load_exit) {
+            break;
+        }
+        _process_thread_load();
+    }
+    thread_load_mutex.unlock();
+}
+
+Error ResourceLoader::load_threaded_request(
+    const String& p_path,
+    const String& p_type_hint
+) {
+    String local_path;
+    if (p_path.is_rel_path()) {
+        local_path = "res://" + p_path;
+    } else {
+        local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+    }
+
+    MutexLock lock(thread_load_mutex);
+#ifndef NO_THREADS
+    if (thread_load_threads.empty()) {
+        int thread_count =
+            GLOBAL_GET("application/run/resource_loader_thread_count");
+        if (thread_count <= 0) {
+            thread_count =
+                MAX(OS::get_singleton()->get_processor_count() - 1, 1);
+        }
+        for (int i = 0; i < thread_count; i++) {
+            Thread* thread = memnew(Thread);
+            thread->start(_thread_load_function, nullptr);
+            thread_load_threads.push_back(thread);
+        }
+    }
+#endif
+
+    ThreadLoadTask* task = _request_thread_load(local_path, p_type_hint);
+    task->request_count++;
+    return OK;
+}
+
+ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(
+    const String& p_path,
+    float* r_progress
+) {
+    String local_path;
+    if (p_path.is_rel_path()) {
+        local_path = "res://" + p_path;
+    } else {
+        local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+    }
+
+    MutexLock lock(thread_load_mutex);
+    ThreadLoadTask** task_ptr = thread_load_tasks.getptr(local_path);
+    if (!task_ptr || (*task_ptr)->request_count == 0) {
+        if (r_progress) {
+            *r_progress = 0;
+        }
+        return THREAD_LOAD_INVALID_RESOURCE;
+    }
+
+    if (r_progress) {
+        *r_progress = _get_thread_load_progress(*task_ptr);
+    }
+    return (*task_ptr)->status;
+}
+
+RES ResourceLoader::load_threaded_get(const String& p_path, Error* r_error) {
+    String local_path;
+    if (p_path.is_rel_path()) {
+        local_path = "res://" + p_path;
+    } else {
+        local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+    }
+
+    MutexLock lock(thread_load_mutex);
+    ThreadLoadTask** task_ptr = thread_load_tasks.getptr(local_path);
+    if (!task_ptr || (*task_ptr)->request_count == 0) {
+        if (r_error) {
+            *r_error = ERR_INVALID_PARAMETER;
+        }
+        ERR_FAIL_V_MSG(
+            RES(),
+            "Resource: '" + local_path
+                + "' was not requested with load_threaded_request()."
+        );
+    }
+
+    ThreadLoadTask* task = *task_ptr;
+#ifdef NO_THREADS
+    // Without loading threads, the queue is processed by the caller.
+    while (task->status == THREAD_LOAD_IN_PROGRESS) {
+        _process_thread_load();
+    }
+#else
+    if (task->status == THREAD_LOAD_IN_PROGRESS) {
+        task->waiter_count++;
+        thread_load_mutex.unlock();
+        task->loaded.wait();
+        thread_load_mutex.lock();
+        task->waiter_count--;
+    }
+#endif
+
+    RES resource = task->resource;
+    if (r_error) {
+        *r_error = task->error;
+    }
+    task->request_count--;
+    _release_thread_load(task);
+    return resource;
+}
+
 Ref<ResourceInteractiveLoader> ResourceLoader::load_interactive(
     const String& p_path,
     const String& p_type_hint,
@@ -1177,6 +1463,14 @@ Mutex ResourceLoader::loading_map_mutex;
 HashMap<ResourceLoader::LoadingMapKey, int, ResourceLoader::LoadingMapKeyHasher>
     ResourceLoader::loading_map;
 
+Mutex ResourceLoader::thread_load_mutex;
+Semaphore ResourceLoader::thread_load_semaphore;
+HashMap<String, ResourceLoader::ThreadLoadTask*>
+    ResourceLoader::thread_load_tasks;
+List<ResourceLoader::ThreadLoadTask*> ResourceLoader::thread_load_queue;
+LocalVector<Thread*> ResourceLoader::thread_load_threads;
+bool ResourceLoader::thread_load_exit = false;
+
 void ResourceLoader::finalize() {
 #ifndef NO_THREADS
     const LoadingMapKey* K = nullptr;
@@ -1185,6 +1479,25 @@ void ResourceLoader::finalize() {
     }
     loading_map.clear();
 #endif
+
+    thread_load_mutex.lock();
+    thread_load_exit = true;
+    thread_load_mutex.unlock();
+    for (uint32_t i = 0; i < thread_load_threads.size(); i++) {
+        thread_load_semaphore.post();
+    }
+    for (uint32_t i = 0; i < thread_load_threads.size(); i++) {
+        thread_load_threads[i]->wait_to_finish();
+        memdelete(thread_load_threads[i]);
+    }
+    thread_load_threads.clear();
+
+    const String* E = nullptr;
+    while ((E = thread_load_tasks.next(E))) {
+        memdelete(thread_load_tasks[*E]);
+    }
+    thread_load_tasks.clear();
+    thread_load_queue.clear();
 }
 
 ResourceLoadErrorNotify ResourceLoader::err_notify = nullptr;
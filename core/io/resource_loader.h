@@ -7,6 +7,8 @@
 #ifndef RESOURCE_LOADER_H
 #define RESOURCE_LOADER_H
 
+#include "core/local_vector.h"
+#include "core/os/semaphore.h"
 #include "core/os/thread.h"
 #include "core/resource.h"
 
@@ -103,6 +105,15 @@ typedef Error (*ResourceLoaderImport)(const String& p_path);
 typedef void (*ResourceLoadedCallback)(RES p_resource, const String& p_path);
 
 class ResourceLoader {
+public:
+    enum ThreadLoadStatus {
+        THREAD_LOAD_INVALID_RESOURCE,
+        THREAD_LOAD_IN_PROGRESS,
+        THREAD_LOAD_FAILED,
+        THREAD_LOAD_LOADED,
+    };
+
+private:
     enum {
         MAX_LOADERS = 64
     };
@@ -170,6 +181,53 @@ class ResourceLoader {
         Thread::ID p_thread
     );
 
+    // A resource being loaded by the loading threads. Before a resource is
+    // loaded, its dependencies are requested as tasks of their own, and the
+    // resource is only loaded once they have all finished. This way
+    // independent dependencies load in parallel, and the resource finds them
+    // in the cache.
+    struct ThreadLoadTask {
+        String local_path;
+        String type_hint;
+        RES resource;
+        Error error;
+        ThreadLoadStatus status;
+        bool dependencies_requested;
+        // Requests that haven't been collected with load_threaded_get().
+        int request_count;
+        // Threads waiting in load_threaded_get().
+        int waiter_count;
+        Semaphore loaded;
+        // Dependencies that haven't finished loading.
+        int pending_dependencies;
+        // Unloaded tasks that depend on this one, which keep it alive.
+        int pending_dependents;
+        LocalVector<ThreadLoadTask*> dependencies;
+        LocalVector<ThreadLoadTask*> dependents;
+    };
+
+    static Mutex thread_load_mutex;
+    static Semaphore thread_load_semaphore;
+    static HashMap<String, ThreadLoadTask*> thread_load_tasks;
+    static List<ThreadLoadTask*> thread_load_queue;
+    static LocalVector<Thread*> thread_load_threads;
+    static bool thread_load_exit;
+
+    static ThreadLoadTask* _request_thread_load(
+        const String& p_local_path,
+        const String& p_type_hint
+    );
+    static bool _thread_load_depends_on(
+        const ThreadLoadTask* p_task,
+        const ThreadLoadTask* p_dependency
+    );
+    static void _request_thread_load_dependencies(ThreadLoadTask* p_task);
+    static void _finish_thread_load(ThreadLoadTask* p_task);
+    static void _release_thread_load(ThreadLoadTask* p_task);
+    static float _get_thread_load_progress(const ThreadLoadTask* p_task);
+    static void _process_thread_load();
+    static void _thread_load_function(void* p_userdata);
+
 public:
     static Ref<ResourceInteractiveLoader> load_interactive(
         const String& p_path,
@@ -185,6 +243,25 @@ public:
     );
     static bool exists(const String& p_path, const String& p_type_hint = "");
 
+    // Starts loading a resource and its dependencies on the loading threads.
+    // Requesting a path that is already being loaded only counts the request.
+    static Error load_threaded_request(
+        const String& p_path,
+        const String& p_type_hint = ""
+    );
+    // r_progress is the fraction of the resource and its dependencies that
+    // have been loaded.
+    static ThreadLoadStatus load_threaded_get_status(
+        const String& p_path,
+        float* r_progress = nullptr
+    );
+    // Waits until the resource is loaded and returns it. Every call to
+    // load_threaded_request() must be matched by a call to this.
+    static RES load_threaded_get(
+        const String& p_path,
+        Error* r_error = nullptr
+    );
+
     static void get_recognized_extensions_for_type(
         const String& p_type,
         List<String>* p_extensions
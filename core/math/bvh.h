@@ -232,6 +232,26 @@ public:
         }
     }
 
+    // Moves an item like move(), but doesn't refit the nodes above it.
+    // refit_moved() must be called after a batch of deferred moves, and
+    // before the BVH is used again, which refits every node above the moved
+    // items once.
+    void move_deferred(uint32_t p_handle, const BOUNDS& p_aabb) {
+        BVH_LOCKED_FUNCTION
+        BVHHandle h;
+        h.set(p_handle);
+        if (tree.item_move(h, p_aabb, true)) {
+            if (USE_PAIRS) {
+                _add_changed_item(h, p_aabb);
+            }
+        }
+    }
+
+    void refit_moved() {
+        BVH_LOCKED_FUNCTION
+        tree.refit_dirty();
+    }
+
     void recheck_pairs(BVHHandle p_handle) {
         BVH_LOCKED_FUNCTION
         if (USE_PAIRS) {
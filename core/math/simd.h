@@ -0,0 +1,546 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include "core/typedefs.h"
+
+#include <math.h>
+
+// Thin wrappers around the SIMD instruction set selected at build time with
+// the `simd` SCons option. SimdFloat holds SimdFloat::WIDTH floats and
+// SimdMask holds the result of a lane-wise comparison. When no instruction
+// set is available, or SIMD_DISABLED is defined, plain arrays of floats are
+// used instead, so code written against these types always compiles.
+
+#if defined(SIMD_DISABLED)
+#define SIMD_SCALAR_ENABLED
+#elif defined(__AVX__)
+#define SIMD_AVX_ENABLED
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)                                     \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_SSE_ENABLED
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SIMD_NEON_ENABLED
+#include <arm_neon.h>
+#else
+#define SIMD_SCALAR_ENABLED
+#endif
+
+#if defined(SIMD_AVX_ENABLED)
+
+struct SimdMask {
+    __m256 m;
+
+    _ALWAYS_INLINE_ SimdMask operator&(const SimdMask& p_mask) const {
+        return {_mm256_and_ps(m, p_mask.m)};
+    }
+
+    _ALWAYS_INLINE_ SimdMask operator|(const SimdMask& p_mask) const {
+        return {_mm256_or_ps(m, p_mask.m)};
+    }
+
+    _ALWAYS_INLINE_ bool any() const {
+        return _mm256_movemask_ps(m) != 0;
+    }
+};
+
+struct SimdFloat {
+    enum {
+        WIDTH = 8
+    };
+
+    __m256 v;
+
+    static _ALWAYS_INLINE_ SimdFloat splat(float p_value) {
+        return {_mm256_set1_ps(p_value)};
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat load(const float* p_src) {
+        return {_mm256_loadu_ps(p_src)};
+    }
+
+    // Loads every p_stride-th float, starting at p_src.
+    static _ALWAYS_INLINE_ SimdFloat
+    load_strided(const float* p_src, int p_stride) {
+        return {_mm256_set_ps(
+            p_src[7 * p_stride],
+            p_src[6 * p_stride],
+            p_src[5 * p_stride],
+            p_src[4 * p_stride],
+            p_src[3 * p_stride],
+            p_src[2 * p_stride],
+            p_src[p_stride],
+            p_src[0]
+        )};
+    }
+
+    _ALWAYS_INLINE_ void store(float* p_dst) const {
+        _mm256_storeu_ps(p_dst, v);
+    }
+
+    // Stores the lanes converted to integers, truncated towards zero.
+    _ALWAYS_INLINE_ void store_truncated(int32_t* p_dst) const {
+        _mm256_storeu_si256((__m256i*)p_dst, _mm256_cvttps_epi32(v));
+    }
+
+    _ALWAYS_INLINE_ SimdFloat operator+(const SimdFloat& p_b) const {
+        return {_mm256_add_ps(v, p_b.v)};
+    }
+
+    _ALWAYS_INLINE_ SimdFloat operator-(const SimdFloat& p_b) const {
+        return {_mm256_sub_ps(v, p_b.v)};
+    }
+
+    _ALWAYS_INLINE_ SimdFloat operator*(const SimdFloat& p_b) const {
+        return {_mm256_mul_ps(v, p_b.v)};
+    }
+
+    _ALWAYS_INLINE_ SimdFloat operator/(const SimdFloat& p_b) const {
+        return {_mm256_div_ps(v, p_b.v)};
+    }
+
+    _ALWAYS_INLINE_ SimdFloat operator-() const {
+        return {_mm256_xor_ps(v, _mm256_set1_ps(-0.0f))};
+    }
+
+    _ALWAYS_INLINE_ SimdMask operator>(const SimdFloat& p_b) const {
+        return {_mm256_cmp_ps(v, p_b.v, _CMP_GT_OQ)};
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat
+    min(const SimdFloat& p_a, const SimdFloat& p_b) {
+        return {_mm256_min_ps(p_a.v, p_b.v)};
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat
+    max(const SimdFloat& p_a, const SimdFloat& p_b) {
+        return {_mm256_max_ps(p_a.v, p_b.v)};
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat abs(const SimdFloat& p_a) {
+        return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), p_a.v)};
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat sqrt(const SimdFloat& p_a) {
+        return {_mm256_sqrt_ps(p_a.v)};
+    }
+
+    // Rounds the lanes towards zero.
+    static _ALWAYS_INLINE_ SimdFloat truncate(const SimdFloat& p_a) {
+        return {_mm256_round_ps(p_a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)};
+    }
+
+    // Lanes of p_a where p_mask is set, lanes of p_b elsewhere.
+    static _ALWAYS_INLINE_ SimdFloat
+    select(const SimdMask& p_mask, const SimdFloat& p_a, const SimdFloat& p_b) {
+        return {_mm256_blendv_ps(p_b.v, p_a.v, p_mask.m)};
+    }
+};
+
+#elif defined(SIMD_SSE_ENABLED)
+
+struct SimdMask {
+    __m128 m;
+
+    _ALWAYS_INLINE_ SimdMask operator&(const SimdMask& p_mask) const {
+        return {_mm_and_ps(m, p_mask.m)};
+    }
+
+    _ALWAYS_INLINE_ SimdMask operator|(const SimdMask& p_mask) const {
+        return {_mm_or_ps(m, p_mask.m)};
+    }
+
+    _ALWAYS_INLINE_ bool any() const {
+        return _mm_movemask_ps(m) != 0;
+    }
+};
+
+struct SimdFloat {
+    enum {
+        WIDTH = 4
+    };
+
+    __m128 v;
+
+    static _ALWAYS_INLINE_ SimdFloat splat(float p_value) {
+        return {_mm_set1_ps(p_value)};
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat load(const float* p_src) {
+        return {_mm_loadu_ps(p_src)};
+    }
+
+    // Loads every p_stride-th float, starting at p_src.
+    static _ALWAYS_INLINE_ SimdFloat
+    load_strided(const float* p_src, int p_stride) {
+        return {_mm_set_ps(
+            p_src[3 * p_stride],
+            p_src[2 * p_stride],
+            p_src[p_stride],
+            p_src[0]
+        )};
+    }
+
+    _ALWAYS_INLINE_ void store(float* p_dst) const {
+        _mm_storeu_ps(p_dst, v);
+    }
+
+    // Stores the lanes converted to integers, truncated towards zero.
+    _ALWAYS_INLINE_ void store_truncated(int32_t* p_dst) const {
+        _mm_storeu_si128((__m128i*)p_dst, _mm_cvttps_epi32(v));
+    }
+
+    _ALWAYS_INLINE_ SimdFloat operator+(const SimdFloat& p_b) const {
+        return {_mm_add_ps(v, p_b.v)};
+    }
+
+    _ALWAYS_INLINE_ SimdFloat operator-(const SimdFloat& p_b) const {
+        return {_mm_sub_ps(v, p_b.v)};
+    }
+
+    _ALWAYS_INLINE_ SimdFloat operator*(const SimdFloat& p_b) const {
+        return {_mm_mul_ps(v, p_b.v)};
+    }
+
+    _ALWAYS_INLINE_ SimdFloat operator/(const SimdFloat& p_b) const {
+        return {_mm_div_ps(v, p_b.v)};
+    }
+
+    _ALWAYS_INLINE_ SimdFloat operator-() const {
+        return {_mm_xor_ps(v, _mm_set1_ps(-0.0f))};
+    }
+
+    _ALWAYS_INLINE_ SimdMask operator>(const SimdFloat& p_b) const {
+        return {_mm_cmpgt_ps(v, p_b.v)};
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat
+    min(const SimdFloat& p_a, const SimdFloat& p_b) {
+        return {_mm_min_ps(p_a.v, p_b.v)};
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat
+    max(const SimdFloat& p_a, const SimdFloat& p_b) {
+        return {_mm_max_ps(p_a.v, p_b.v)};
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat abs(const SimdFloat& p_a) {
+        return {_mm_andnot_ps(_mm_set1_ps(-0.0f), p_a.v)};
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat sqrt(const SimdFloat& p_a) {
+        return {_mm_sqrt_ps(p_a.v)};
+    }
+
+    // Rounds the lanes towards zero. SSE2 has no rounding, so the lanes are
+    // converted to integers and back, which is exact within the int32 range.
+    static _ALWAYS_INLINE_ SimdFloat truncate(const SimdFloat& p_a) {
+        return {_mm_cvtepi32_ps(_mm_cvttps_epi32(p_a.v))};
+    }
+
+    // Lanes of p_a where p_mask is set, lanes of p_b elsewhere.
+    static _ALWAYS_INLINE_ SimdFloat
+    select(const SimdMask& p_mask, const SimdFloat& p_a, const SimdFloat& p_b) {
+        return {_mm_or_ps(
+            _mm_and_ps(p_mask.m, p_a.v),
+            _mm_andnot_ps(p_mask.m, p_b.v)
+        )};
+    }
+};
+
+#elif defined(SIMD_NEON_ENABLED)
+
+struct SimdMask {
+    uint32x4_t m;
+
+    _ALWAYS_INLINE_ SimdMask operator&(const SimdMask& p_mask) const {
+        return {vandq_u32(m, p_mask.m)};
+    }
+
+    _ALWAYS_INLINE_ SimdMask operator|(const SimdMask& p_mask) const {
+        return {vorrq_u32(m, p_mask.m)};
+    }
+
+    _ALWAYS_INLINE_ bool any() const {
+#if defined(__aarch64__) || defined(_M_ARM64)
+        return vmaxvq_u32(m) != 0;
+#else
+        uint32x2_t pairs = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+        return (vget_lane_u32(pairs, 0) | vget_lane_u32(pairs, 1)) != 0;
+#endif
+    }
+};
+
+struct SimdFloat {
+    enum {
+        WIDTH = 4
+    };
+
+    float32x4_t v;
+
+    static _ALWAYS_INLINE_ SimdFloat splat(float p_value) {
+        return {vdupq_n_f32(p_value)};
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat load(const float* p_src) {
+        return {vld1q_f32(p_src)};
+    }
+
+    // Loads every p_stride-th float, starting at p_src.
+    static _ALWAYS_INLINE_ SimdFloat
+    load_strided(const float* p_src, int p_stride) {
+        float32x4_t r = vdupq_n_f32(p_src[0]);
+        r             = vsetq_lane_f32(p_src[p_stride], r, 1);
+        r             = vsetq_lane_f32(p_src[2 * p_stride], r, 2);
+        r             = vsetq_lane_f32(p_src[3 * p_stride], r, 3);
+        return {r};
+    }
+
+    _ALWAYS_INLINE_ void store(float* p_dst) const {
+        vst1q_f32(p_dst, v);
+    }
+
+    // Stores the lanes converted to integers, truncated towards zero.
+    _ALWAYS_INLINE_ void store_truncated(int32_t* p_dst) const {
+        vst1q_s32(p_dst, vcvtq_s32_f32(v));
+    }
+
+    _ALWAYS_INLINE_ SimdFloat operator+(const SimdFloat& p_b) const {
+        return {vaddq_f32(v, p_b.v)};
+    }
+
+    _ALWAYS_INLINE_ SimdFloat operator-(const SimdFloat& p_b) const {
+        return {vsubq_f32(v, p_b.v)};
+    }
+
+    _ALWAYS_INLINE_ SimdFloat operator*(const SimdFloat& p_b) const {
+        return {vmulq_f32(v, p_b.v)};
+    }
+
+    _ALWAYS_INLINE_ SimdFloat operator/(const SimdFloat& p_b) const {
+#if defined(__aarch64__) || defined(_M_ARM64)
+        return {vdivq_f32(v, p_b.v)};
+#else
+        // ARMv7 NEON has no division, divide each lane exactly.
+        float a[WIDTH];
+        float b[WIDTH];
+        vst1q_f32(a, v);
+        vst1q_f32(b, p_b.v);
+        for (int i = 0; i < WIDTH; i++) {
+            a[i] /= b[i];
+        }
+        return {vld1q_f32(a)};
+#endif
+    }
+
+    _ALWAYS_INLINE_ SimdFloat operator-() const {
+        return {vnegq_f32(v)};
+    }
+
+    _ALWAYS_INLINE_ SimdMask operator>(const SimdFloat& p_b) const {
+        return {vcgtq_f32(v, p_b.v)};
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat
+    min(const SimdFloat& p_a, const SimdFloat& p_b) {
+        return {vminq_f32(p_a.v, p_b.v)};
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat
+    max(const SimdFloat& p_a, const SimdFloat& p_b) {
+        return {vmaxq_f32(p_a.v, p_b.v)};
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat abs(const SimdFloat& p_a) {
+        return {vabsq_f32(p_a.v)};
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat sqrt(const SimdFloat& p_a) {
+#if defined(__aarch64__) || defined(_M_ARM64)
+        return {vsqrtq_f32(p_a.v)};
+#else
+        float a[WIDTH];
+        vst1q_f32(a, p_a.v);
+        for (int i = 0; i < WIDTH; i++) {
+            a[i] = ::sqrtf(a[i]);
+        }
+        return {vld1q_f32(a)};
+#endif
+    }
+
+    // Rounds the lanes towards zero.
+    static _ALWAYS_INLINE_ SimdFloat truncate(const SimdFloat& p_a) {
+#if defined(__aarch64__) || defined(_M_ARM64)
+        return {vrndq_f32(p_a.v)};
+#else
+        // ARMv7 NEON has no rounding, this is exact within the int32 range.
+        return {vcvtq_f32_s32(vcvtq_s32_f32(p_a.v))};
+#endif
+    }
+
+    // Lanes of p_a where p_mask is set, lanes of p_b elsewhere.
+    static _ALWAYS_INLINE_ SimdFloat
+    select(const SimdMask& p_mask, const SimdFloat& p_a, const SimdFloat& p_b) {
+        return {vbslq_f32(p_mask.m, p_a.v, p_b.v)};
+    }
+};
+
+#else // SIMD_SCALAR_ENABLED
+
+struct SimdMask {
+    bool m[4];
+
+    _ALWAYS_INLINE_ SimdMask operator&(const SimdMask& p_mask) const {
+        SimdMask r;
+        for (int i = 0; i < 4; i++) {
+            r.m[i] = m[i] && p_mask.m[i];
+        }
+        return r;
+    }
+
+    _ALWAYS_INLINE_ SimdMask operator|(const SimdMask& p_mask) const {
+        SimdMask r;
+        for (int i = 0; i < 4; i++) {
+            r.m[i] = m[i] || p_mask.m[i];
+        }
+        return r;
+    }
+
+    _ALWAYS_INLINE_ bool any() const {
+        return m[0] || m[1] || m[2] || m[3];
+    }
+};
+
+struct SimdFloat {
+    enum {
+        WIDTH = 4
+    };
+
+    float v[WIDTH];
+
+    static _ALWAYS_INLINE_ SimdFloat splat(float p_value) {
+        return {
+            {p_value, p_value, p_value, p_value}
+        };
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat load(const float* p_src) {
+        return {
+            {p_src[0], p_src[1], p_src[2], p_src[3]}
+        };
+    }
+
+    // Loads every p_stride-th float, starting at p_src.
+    static _ALWAYS_INLINE_ SimdFloat
+    load_strided(const float* p_src, int p_stride) {
+        return {
+            {p_src[0],
+             p_src[p_stride],
+             p_src[2 * p_stride],
+             p_src[3 * p_stride]}
+        };
+    }
+
+    _ALWAYS_INLINE_ void store(float* p_dst) const {
+        for (int i = 0; i < WIDTH; i++) {
+            p_dst[i] = v[i];
+        }
+    }
+
+    // Stores the lanes converted to integers, truncated towards zero.
+    _ALWAYS_INLINE_ void store_truncated(int32_t* p_dst) const {
+        for (int i = 0; i < WIDTH; i++) {
+            p_dst[i] = (int32_t)v[i];
+        }
+    }
+
+#define SIMD_SCALAR_OPERATOR(m_op)                                             \
+    _ALWAYS_INLINE_ SimdFloat operator m_op(const SimdFloat& p_b) const {      \
+        SimdFloat r;                                                           \
+        for (int i = 0; i < WIDTH; i++) {                                      \
+            r.v[i] = v[i] m_op p_b.v[i];                                       \
+        }                                                                      \
+        return r;                                                              \
+    }
+
+    SIMD_SCALAR_OPERATOR(+)
+    SIMD_SCALAR_OPERATOR(-)
+    SIMD_SCALAR_OPERATOR(*)
+    SIMD_SCALAR_OPERATOR(/)
+
+#undef SIMD_SCALAR_OPERATOR
+
+    _ALWAYS_INLINE_ SimdFloat operator-() const {
+        return {
+            {-v[0], -v[1], -v[2], -v[3]}
+        };
+    }
+
+    _ALWAYS_INLINE_ SimdMask operator>(const SimdFloat& p_b) const {
+        return {
+            {v[0] > p_b.v[0], v[1] > p_b.v[1], v[2] > p_b.v[2], v[3] > p_b.v[3]}
+        };
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat
+    min(const SimdFloat& p_a, const SimdFloat& p_b) {
+        SimdFloat r;
+        for (int i = 0; i < WIDTH; i++) {
+            r.v[i] = p_a.v[i] < p_b.v[i] ? p_a.v[i] : p_b.v[i];
+        }
+        return r;
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat
+    max(const SimdFloat& p_a, const SimdFloat& p_b) {
+        SimdFloat r;
+        for (int i = 0; i < WIDTH; i++) {
+            r.v[i] = p_a.v[i] > p_b.v[i] ? p_a.v[i] : p_b.v[i];
+        }
+        return r;
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat abs(const SimdFloat& p_a) {
+        SimdFloat r;
+        for (int i = 0; i < WIDTH; i++) {
+            r.v[i] = ::fabsf(p_a.v[i]);
+        }
+        return r;
+    }
+
+    static _ALWAYS_INLINE_ SimdFloat sqrt(const SimdFloat& p_a) {
+        SimdFloat r;
+        for (int i = 0; i < WIDTH; i++) {
+            r.v[i] = ::sqrtf(p_a.v[i]);
+        }
+        return r;
+    }
+
+    // Rounds the lanes towards zero.
+    static _ALWAYS_INLINE_ SimdFloat truncate(const SimdFloat& p_a) {
+        SimdFloat r;
+        for (int i = 0; i < WIDTH; i++) {
+            r.v[i] = ::truncf(p_a.v[i]);
+        }
+        return r;
+    }
+
+    // Lanes of p_a where p_mask is set, lanes of p_b elsewhere.
+    static _ALWAYS_INLINE_ SimdFloat
+    select(const SimdMask& p_mask, const SimdFloat& p_a, const SimdFloat& p_b) {
+        SimdFloat r;
+        for (int i = 0; i < WIDTH; i++) {
+            r.v[i] = p_mask.m[i] ? p_a.v[i] : p_b.v[i];
+        }
+        return r;
+    }
+};
+
+#endif
+
+#endif // SIMD_H
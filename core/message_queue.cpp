@@ -6,15 +6,186 @@
 
 #include "message_queue.h"
 
+#include "core/os/thread.h"
 #include "core/project_settings.h"
 #include "core/script_language.h"
 
 MessageQueue* MessageQueue::singleton = nullptr;
+uint64_t MessageQueue::last_queue_id  = 0;
+thread_local MessageQueue::ThreadBufferRef MessageQueue::thread_buffer_ref;
 
 MessageQueue* MessageQueue::get_singleton() {
     return singleton;
 }
 
+uint8_t* MessageQueue::Buffer::allocate(uint32_t p_size) {
+    if (page_count > 0) {
+        Page& page = pages[page_count - 1];
+        if (page.end + p_size <= page.size) {
+            uint8_t* room  = &page.data[page.end];
+            page.end      += p_size;
+            return room;
+        }
+    }
+
+    if (page_count == pages.size()) {
+        Page page;
+        page.size = MAX((uint32_t)PAGE_SIZE, p_size);
+        page.data = (uint8_t*)memalloc(page.size);
+        page.end  = 0;
+        pages.push_back(page);
+    } else if (pages[page_count].size < p_size) {
+        // Messages larger than a page get a page of their own.
+        Page& page = pages[page_count];
+        memfree(page.data);
+        page.size = p_size;
+        page.data = (uint8_t*)memalloc(page.size);
+    }
+
+    Page& page = pages[page_count++];
+    page.end   = p_size;
+    return page.data;
+}
+
+void MessageQueue::Buffer::reserve(uint32_t p_size) {
+    uint32_t size = 0;
+    for (uint32_t i = 0; i < pages.size(); i++) {
+        size += pages[i].size;
+    }
+    while (size < p_size) {
+        Page page;
+        page.size = PAGE_SIZE;
+        page.data = (uint8_t*)memalloc(page.size);
+        page.end  = 0;
+        pages.push_back(page);
+        size += page.size;
+    }
+}
+
+uint32_t MessageQueue::Buffer::get_used() const {
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < page_count; i++) {
+        used += pages[i].end;
+    }
+    return used;
+}
+
+void MessageQueue::Buffer::clear() {
+    for (uint32_t i = 0; i < page_count; i++) {
+        const Page& page  = pages[i];
+        uint32_t read_pos = 0;
+        while (read_pos < page.end) {
+            Message* message  = (Message*)&page.data[read_pos];
+            read_pos         += message->get_size();
+            if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+                Variant* args = (Variant*)(message + 1);
+                for (int j = 0; j < message->args; j++) {
+                    args[j].~Variant();
+                }
+            }
+            message->~Message();
+        }
+    }
+    reset();
+}
+
+void MessageQueue::Buffer::reset() {
+    for (uint32_t i = 0; i < page_count; i++) {
+        pages[i].end = 0;
+    }
+    page_count = 0;
+}
+
+void MessageQueue::Buffer::free() {
+    for (uint32_t i = 0; i < pages.size(); i++) {
+        memfree(pages[i].data);
+    }
+    pages.clear();
+    page_count = 0;
+}
+
+MessageQueue::Buffer::Buffer() {
+    page_count = 0;
+}
+
+MessageQueue::ThreadBufferRef::~ThreadBufferRef() {
+    if (!thread_buffer || !singleton || singleton->queue_id != queue_id) {
+        return;
+    }
+    thread_buffer->mutex.lock();
+    thread_buffer->orphaned = true;
+    thread_buffer->mutex.unlock();
+}
+
+uint8_t* MessageQueue::_allocate_message(
+    uint32_t p_size,
+    ThreadBuffer*& r_thread_buffer
+) {
+    if (Thread::get_caller_id() == Thread::get_main_id()) {
+        r_thread_buffer = nullptr;
+        _THREAD_SAFE_LOCK_
+        return buffer.allocate(p_size);
+    }
+
+    ThreadBufferRef& ref = thread_buffer_ref;
+    if (unlikely(ref.queue_id != queue_id)) {
+        ThreadBuffer* thread_buffer = memnew(ThreadBuffer);
+        thread_buffer->orphaned     = false;
+        _THREAD_SAFE_LOCK_
+        thread_buffers.push_back(thread_buffer);
+        _THREAD_SAFE_UNLOCK_
+        ref.queue_id      = queue_id;
+        ref.thread_buffer = thread_buffer;
+    }
+
+    r_thread_buffer = ref.thread_buffer;
+    r_thread_buffer->mutex.lock();
+    return r_thread_buffer->buffer.allocate(p_size);
+}
+
+void MessageQueue::_commit_message(ThreadBuffer* p_thread_buffer) {
+    if (p_thread_buffer) {
+        p_thread_buffer->mutex.unlock();
+    } else {
+        _THREAD_SAFE_UNLOCK_
+    }
+}
+
+void MessageQueue::_merge_thread_buffers() {
+    uint32_t i = 0;
+    while (i < thread_buffers.size()) {
+        ThreadBuffer* thread_buffer = thread_buffers[i];
+        thread_buffer->mutex.lock();
+
+        // Messages are moved by copying their bytes, like LocalVector does
+        // when it grows.
+        Buffer& source = thread_buffer->buffer;
+        for (uint32_t j = 0; j < source.page_count; j++) {
+            const Page& page  = source.pages[j];
+            uint32_t read_pos = 0;
+            while (read_pos < page.end) {
+                const Message* message =
+                    (const Message*)&page.data[read_pos];
+                uint32_t size  = message->get_size();
+                memcpy(buffer.allocate(size), message, size);
+                read_pos      += size;
+            }
+        }
+        source.reset();
+
+        bool orphaned = thread_buffer->orphaned;
+        thread_buffer->mutex.unlock();
+
+        if (orphaned) {
+            source.free();
+            memdelete(thread_buffer);
+            thread_buffers.remove_unordered(i);
+        } else {
+            i++;
+        }
+    }
+}
+
 Error MessageQueue::push_call(
     ObjectID p_id,
     const StringName& p_method,
@@ -22,28 +193,11 @@ Error MessageQueue::push_call(
     int p_argcount,
     bool p_show_error
 ) {
-    _THREAD_SAFE_METHOD_
-
-    int room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
-
-    if ((buffer_end + room_needed) >= buffer_size) {
-        String type;
-        if (ObjectDB::get_instance(p_id)) {
-            type = ObjectDB::get_instance(p_id)->get_class();
-        }
-        print_line(
-            "Failed method: " + type + ":" + p_method
-            + " target ID: " + itos(p_id)
-        );
-        statistics();
-        ERR_FAIL_V_MSG(
-            ERR_OUT_OF_MEMORY,
-            "Message queue out of memory. Try increasing "
-            "'memory/limits/message_queue/max_size_kb' in project settings."
-        );
-    }
+    uint32_t room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
 
-    Message* msg     = memnew_placement(&buffer[buffer_end], Message);
+    ThreadBuffer* thread_buffer;
+    uint8_t* room    = _allocate_message(room_needed, thread_buffer);
+    Message* msg     = memnew_placement(room, Message);
     msg->args        = p_argcount;
     msg->instance_id = p_id;
     msg->target      = p_method;
@@ -52,14 +206,13 @@ Error MessageQueue::push_call(
         msg->type |= FLAG_SHOW_ERROR;
     }
 
-    buffer_end += sizeof(Message);
-
+    Variant* args = (Variant*)(msg + 1);
     for (int i = 0; i < p_argcount; i++) {
-        Variant* v  = memnew_placement(&buffer[buffer_end], Variant);
-        buffer_end += sizeof(Variant);
-        *v          = *p_args[i];
+        Variant* v = memnew_placement(&args[i], Variant);
+        *v         = *p_args[i];
     }
 
+    _commit_message(thread_buffer);
     return OK;
 }
 
@@ -87,70 +240,36 @@ Error MessageQueue::push_set(
     const StringName& p_prop,
     const Variant& p_value
 ) {
-    _THREAD_SAFE_METHOD_
-
-    uint8_t room_needed = sizeof(Message) + sizeof(Variant);
-
-    if ((buffer_end + room_needed) >= buffer_size) {
-        String type;
-        if (ObjectDB::get_instance(p_id)) {
-            type = ObjectDB::get_instance(p_id)->get_class();
-        }
-        print_line(
-            "Failed set: " + type + ":" + p_prop + " target ID: " + itos(p_id)
-        );
-        statistics();
-        ERR_FAIL_V_MSG(
-            ERR_OUT_OF_MEMORY,
-            "Message queue out of memory. Try increasing "
-            "'memory/limits/message_queue/max_size_kb' in project settings."
-        );
-    }
+    uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-    Message* msg     = memnew_placement(&buffer[buffer_end], Message);
+    ThreadBuffer* thread_buffer;
+    uint8_t* room    = _allocate_message(room_needed, thread_buffer);
+    Message* msg     = memnew_placement(room, Message);
     msg->args        = 1;
     msg->instance_id = p_id;
     msg->target      = p_prop;
     msg->type        = TYPE_SET;
 
-    buffer_end += sizeof(Message);
-
-    Variant* v  = memnew_placement(&buffer[buffer_end], Variant);
-    buffer_end += sizeof(Variant);
-    *v          = p_value;
+    Variant* v = memnew_placement(msg + 1, Variant);
+    *v         = p_value;
 
+    _commit_message(thread_buffer);
     return OK;
 }
 
 Error MessageQueue::push_notification(ObjectID p_id, int p_notification) {
-    _THREAD_SAFE_METHOD_
-
     ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
 
-    uint8_t room_needed = sizeof(Message);
-
-    if ((buffer_end + room_needed) >= buffer_size) {
-        print_line(
-            "Failed notification: " + itos(p_notification)
-            + " target ID: " + itos(p_id)
-        );
-        statistics();
-        ERR_FAIL_V_MSG(
-            ERR_OUT_OF_MEMORY,
-            "Message queue out of memory. Try increasing "
-            "'memory/limits/message_queue/max_size_kb' in project settings."
-        );
-    }
-
-    Message* msg = memnew_placement(&buffer[buffer_end], Message);
+    ThreadBuffer* thread_buffer;
+    uint8_t* room = _allocate_message(sizeof(Message), thread_buffer);
+    Message* msg  = memnew_placement(room, Message);
 
     msg->type         = TYPE_NOTIFICATION;
     msg->instance_id  = p_id;
     // msg->target;
     msg->notification = p_notification;
 
-    buffer_end += sizeof(Message);
-
+    _commit_message(thread_buffer);
     return OK;
 }
 
@@ -180,54 +299,56 @@ void MessageQueue::statistics() {
     Map<StringName, int> call_count;
     int null_count = 0;
 
-    uint32_t read_pos = 0;
-    while (read_pos < buffer_end) {
-        Message* message = (Message*)&buffer[read_pos];
+    _THREAD_SAFE_METHOD_
 
-        Object* target = ObjectDB::get_instance(message->instance_id);
+    for (uint32_t i = 0; i < buffer.page_count; i++) {
+        const Page& page  = buffer.pages[i];
+        uint32_t read_pos = 0;
+        while (read_pos < page.end) {
+            Message* message = (Message*)&page.data[read_pos];
 
-        if (target != nullptr) {
-            switch (message->type & FLAG_MASK) {
-                case TYPE_CALL: {
-                    if (!call_count.has(message->target)) {
-                        call_count[message->target] = 0;
-                    }
+            Object* target = ObjectDB::get_instance(message->instance_id);
 
-                    call_count[message->target]++;
+            if (target != nullptr) {
+                switch (message->type & FLAG_MASK) {
+                    case TYPE_CALL: {
+                        if (!call_count.has(message->target)) {
+                            call_count[message->target] = 0;
+                        }
 
-                } break;
-                case TYPE_NOTIFICATION: {
-                    if (!notify_count.has(message->notification)) {
-                        notify_count[message->notification] = 0;
-                    }
+                        call_count[message->target]++;
 
-                    notify_count[message->notification]++;
+                    } break;
+                    case TYPE_NOTIFICATION: {
+                        if (!notify_count.has(message->notification)) {
+                            notify_count[message->notification] = 0;
+                        }
 
-                } break;
-                case TYPE_SET: {
-                    if (!set_count.has(message->target)) {
-                        set_count[message->target] = 0;
-                    }
+                        notify_count[message->notification]++;
 
-                    set_count[message->target]++;
+                    } break;
+                    case TYPE_SET: {
+                        if (!set_count.has(message->target)) {
+                            set_count[message->target] = 0;
+                        }
 
-                } break;
-            }
+                        set_count[message->target]++;
 
-        } else {
-            // object was deleted
-            print_line("Object was deleted while awaiting a callback");
+                    } break;
+                }
 
-            null_count++;
-        }
+            } else {
+                // object was deleted
+                print_line("Object was deleted while awaiting a callback");
 
-        read_pos += sizeof(Message);
-        if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-            read_pos += sizeof(Variant) * message->args;
+                null_count++;
+            }
+
+            read_pos += message->get_size();
         }
     }
 
-    print_line("TOTAL BYTES: " + itos(buffer_end));
+    print_line("TOTAL BYTES: " + itos(buffer.get_used()));
     print_line("NULL count: " + itos(null_count));
 
     for (Map<StringName, int>::Element* E = set_count.front(); E;
@@ -282,32 +403,44 @@ void MessageQueue::_call_function(
 }
 
 void MessageQueue::flush() {
-    if (buffer_end > buffer_max_used) {
-        buffer_max_used = buffer_end;
-    }
-
-    uint32_t read_pos = 0;
-
     // using reverse locking strategy
     _THREAD_SAFE_LOCK_
 
     ERR_FAIL_COND(flushing); // already flushing, you did something odd
     flushing = true;
 
-    while (read_pos < buffer_end) {
+    _merge_thread_buffers();
+
+    uint32_t used = buffer.get_used();
+    if (used > buffer_max_used) {
+        buffer_max_used = used;
+    }
+
+    uint32_t page     = 0;
+    uint32_t read_pos = 0;
+
+    while (page < buffer.page_count) {
         // lock on each iteration, so a call can re-add itself to the message
         // queue
+        // messages are only added to the last page, so once a page has been
+        // read it stays read
 
-        Message* message = (Message*)&buffer[read_pos];
-
-        uint32_t advance = sizeof(Message);
-        if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-            advance += sizeof(Variant) * message->args;
+        if (read_pos >= buffer.pages[page].end) {
+            page++;
+            read_pos = 0;
+            continue;
         }
 
+        Message* message = (Message*)&buffer.pages[page].data[read_pos];
+
+        uint32_t advance = message->get_size();
+
         // pre-advance so this function is reentrant
         read_pos += advance;
 
+        flushed_messages++;
+        flushed_bytes += advance;
+
         _THREAD_SAFE_UNLOCK_
 
         Object* target = ObjectDB::get_instance(message->instance_id);
@@ -354,8 +487,8 @@ void MessageQueue::flush() {
         _THREAD_SAFE_LOCK_
     }
 
-    buffer_end = 0; // reset buffer
-    flushing   = false;
+    buffer.reset(); // reset buffer
+    flushing = false;
     _THREAD_SAFE_UNLOCK_
 }
 
@@ -363,6 +496,13 @@ bool MessageQueue::is_flushing() const {
     return flushing;
 }
 
+void MessageQueue::end_frame() {
+    frame_messages   = flushed_messages;
+    frame_bytes      = flushed_bytes;
+    flushed_messages = 0;
+    flushed_bytes    = 0;
+}
+
 MessageQueue::MessageQueue() {
     ERR_FAIL_COND_MSG(
         singleton != nullptr,
@@ -370,10 +510,15 @@ MessageQueue::MessageQueue() {
     );
     singleton = this;
     flushing  = false;
+    queue_id  = ++last_queue_id;
+
+    buffer_max_used  = 0;
+    flushed_messages = 0;
+    flushed_bytes    = 0;
+    frame_messages   = 0;
+    frame_bytes      = 0;
 
-    buffer_end      = 0;
-    buffer_max_used = 0;
-    buffer_size     = GLOBAL_DEF_RST(
+    uint32_t buffer_size = GLOBAL_DEF_RST(
         "memory/limits/message_queue/max_size_kb",
         DEFAULT_QUEUE_SIZE_KB
     );
@@ -386,30 +531,20 @@ MessageQueue::MessageQueue() {
             "1024,4096,1,or_greater"
         )
     );
-    buffer_size *= 1024;
-    buffer       = memnew_arr(uint8_t, buffer_size);
+    // The queue grows past this size when needed.
+    buffer.reserve(buffer_size * 1024);
 }
 
 MessageQueue::~MessageQueue() {
-    uint32_t read_pos = 0;
+    buffer.clear();
+    buffer.free();
 
-    while (read_pos < buffer_end) {
-        Message* message = (Message*)&buffer[read_pos];
-        Variant* args    = (Variant*)(message + 1);
-        int argc         = message->args;
-        if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-            for (int i = 0; i < argc; i++) {
-                args[i].~Variant();
-            }
-        }
-        message->~Message();
-
-        read_pos += sizeof(Message);
-        if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-            read_pos += sizeof(Variant) * message->args;
-        }
+    for (uint32_t i = 0; i < thread_buffers.size(); i++) {
+        thread_buffers[i]->buffer.clear();
+        thread_buffers[i]->buffer.free();
+        memdelete(thread_buffers[i]);
     }
+    thread_buffers.clear();
 
     singleton = nullptr;
-    memdelete_arr(buffer);
 }
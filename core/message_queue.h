@@ -7,14 +7,23 @@
 #ifndef MESSAGE_QUEUE_H
 #define MESSAGE_QUEUE_H
 
+#include "core/local_vector.h"
 #include "core/object.h"
 #include "core/os/thread_safe.h"
 
+// Defers calls, notifications and property sets until the next flush.
+//
+// Messages are stored in pages that are kept between flushes, so the queue
+// only allocates memory while it grows. Threads other than the main thread
+// append to their own buffers, which are merged into the queue when it is
+// flushed, so they don't contend with each other. Messages from the same
+// thread are always flushed in the order they were pushed.
 class MessageQueue {
     _THREAD_SAFE_CLASS_
 
     enum {
-        DEFAULT_QUEUE_SIZE_KB = 4096
+        DEFAULT_QUEUE_SIZE_KB = 4096,
+        PAGE_SIZE             = 64 * 1024
     };
 
     enum {
@@ -34,12 +43,75 @@ class MessageQueue {
             int16_t notification;
             int16_t args;
         };
+
+        _FORCE_INLINE_ uint32_t get_size() const {
+            uint32_t size = sizeof(Message);
+            if ((type & FLAG_MASK) != TYPE_NOTIFICATION) {
+                size += sizeof(Variant) * args;
+            }
+            return size;
+        }
+    };
+
+    struct Page {
+        uint8_t* data;
+        uint32_t size;
+        uint32_t end;
+    };
+
+    // Pages in use are filled in order, and only the last one has room.
+    struct Buffer {
+        LocalVector<Page> pages;
+        uint32_t page_count;
+
+        uint8_t* allocate(uint32_t p_size);
+        void reserve(uint32_t p_size);
+        uint32_t get_used() const;
+        // Destroys the messages and empties the pages.
+        void clear();
+        // Only empties the pages, for messages that were moved.
+        void reset();
+        void free();
+
+        Buffer();
+    };
+
+    struct ThreadBuffer {
+        BinaryMutex mutex;
+        Buffer buffer;
+        // Set when the thread exits, so the buffer can be freed.
+        bool orphaned;
+    };
+
+    // Cleans up the buffer of a thread when the thread exits.
+    struct ThreadBufferRef {
+        uint64_t queue_id;
+        ThreadBuffer* thread_buffer;
+
+        ~ThreadBufferRef();
     };
 
-    uint8_t* buffer;
-    uint32_t buffer_end;
+    static thread_local ThreadBufferRef thread_buffer_ref;
+    static uint64_t last_queue_id;
+
+    uint64_t queue_id;
+    Buffer buffer;
+    LocalVector<ThreadBuffer*> thread_buffers;
     uint32_t buffer_max_used;
-    uint32_t buffer_size;
+
+    uint32_t flushed_messages;
+    uint32_t flushed_bytes;
+    uint32_t frame_messages;
+    uint32_t frame_bytes;
+
+    // Returns room for a message in the buffer of the calling thread, which
+    // stays locked until the message is committed.
+    uint8_t* _allocate_message(
+        uint32_t p_size,
+        ThreadBuffer*& r_thread_buffer
+    );
+    void _commit_message(ThreadBuffer* p_thread_buffer);
+    void _merge_thread_buffers();
 
     void _call_function(
         Object* p_target,
@@ -94,6 +166,17 @@ public:
 
     int get_max_buffer_usage() const;
 
+    // Called once per frame to update the frame counters.
+    void end_frame();
+
+    _FORCE_INLINE_ uint32_t get_frame_message_count() const {
+        return frame_messages;
+    }
+
+    _FORCE_INLINE_ uint32_t get_frame_byte_count() const {
+        return frame_bytes;
+    }
+
     MessageQueue();
     ~MessageQueue();
 };
@@ -18,19 +18,6 @@
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-    Object* obj;
-
-    _ObjectDebugLock(Object* p_obj) {
-        obj = p_obj;
-        obj->_lock_index.ref();
-    }
-
-    ~_ObjectDebugLock() {
-        obj->_lock_index.unref();
-    }
-};
-
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
 #else
@@ -797,6 +797,22 @@ public:
 bool predelete_handler(Object* p_object);
 void postinitialize_handler(Object* p_object);
 
+#ifdef DEBUG_ENABLED
+// Prevents the object from being freed while one of its methods is called.
+struct _ObjectDebugLock {
+    Object* obj;
+
+    _ObjectDebugLock(Object* p_obj) {
+        obj = p_obj;
+        obj->_lock_index.ref();
+    }
+
+    ~_ObjectDebugLock() {
+        obj->_lock_index.unref();
+    }
+};
+#endif
+
 class ObjectDB {
     struct ObjectPtrHash {
         static _FORCE_INLINE_ uint32_t hash(const Object* p_obj) {
@@ -109,6 +109,13 @@ public:
     virtual Vector<String> get_csv_line(const String& p_delim = ",") const;
     virtual String get_as_utf8_string() const;
 
+    // Returns a pointer to the next p_length bytes and advances the position
+    // past them, or nullptr if the bytes can't be accessed without copying
+    // them. The pointer is valid while the file is open.
+    virtual const uint8_t* get_buffer_ptr(uint64_t p_length) const {
+        return nullptr;
+    }
+
     /**< use this for files WRITTEN in _big_ endian machines (ie, amiga/mac)
      * It's not about the current CPU type but file formats.
      * this flags get reset to false (little endian) on each open
@@ -523,6 +523,12 @@ int OS::get_processor_count() const {
     return 1;
 }
 
+const uint8_t* OS::map_file(const String& p_path, uint64_t* r_size) {
+    return nullptr;
+}
+
+void OS::unmap_file(const uint8_t* p_data, uint64_t p_size) {}
+
 Error OS::native_video_play(
     String p_path,
     float p_volume,
@@ -671,6 +671,11 @@ public:
 
     virtual int get_processor_count() const;
 
+    // Maps a file into memory for reading. Returns nullptr if the file can't
+    // be mapped.
+    virtual const uint8_t* map_file(const String& p_path, uint64_t* r_size);
+    virtual void unmap_file(const uint8_t* p_data, uint64_t p_size);
+
     virtual String get_unique_id() const;
 
     virtual Error native_video_play(
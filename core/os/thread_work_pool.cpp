@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "thread_work_pool.h"
+
+#include "core/os/os.h"
+#include "core/project_settings.h"
+
+void ThreadWorkPool::_thread_function(void* p_user) {
+    ThreadData* thread = static_cast<ThreadData*>(p_user);
+    while (true) {
+        thread->start.wait();
+        if (thread->exit.is_set()) {
+            break;
+        }
+        thread->work->work();
+        thread->completed.post();
+    }
+}
+
+void ThreadWorkPool::_dispatch(BaseWork* p_work) {
+    current_work = p_work;
+    index.set(0);
+
+    for (uint32_t i = 0; i < thread_count; i++) {
+        threads[i].work = p_work;
+        threads[i].start.post();
+    }
+
+    // The calling thread helps until every item has been claimed.
+    p_work->work();
+
+    for (uint32_t i = 0; i < thread_count; i++) {
+        threads[i].completed.wait();
+        threads[i].work = nullptr;
+    }
+
+    memdelete(p_work);
+    current_work = nullptr;
+}
+
+void ThreadWorkPool::init(int p_thread_count, Thread::Priority p_priority) {
+    ERR_FAIL_COND(threads != nullptr);
+
+#ifdef NO_THREADS
+    thread_count = 0;
+#else
+    if (p_thread_count <= 0) {
+        p_thread_count = OS::get_singleton()->get_processor_count();
+    }
+    // The calling thread is one of the workers.
+    thread_count = p_thread_count - 1;
+#endif
+
+    if (thread_count == 0) {
+        return;
+    }
+
+    Thread::Settings settings;
+    settings.priority = p_priority;
+
+    threads = memnew_arr(ThreadData, thread_count);
+    for (uint32_t i = 0; i < thread_count; i++) {
+        threads[i].thread.start(
+            &ThreadWorkPool::_thread_function,
+            &threads[i],
+            settings
+        );
+    }
+}
+
+void ThreadWorkPool::finish() {
+    if (threads == nullptr) {
+        ERR_FAIL_COND(thread_count != 0);
+        return;
+    }
+
+    for (uint32_t i = 0; i < thread_count; i++) {
+        threads[i].exit.set();
+        threads[i].start.post();
+    }
+    for (uint32_t i = 0; i < thread_count; i++) {
+        threads[i].thread.wait_to_finish();
+    }
+
+    memdelete_arr(threads);
+    threads      = nullptr;
+    thread_count = 0;
+}
+
+int ThreadWorkPool::define_thread_count_setting(
+    const String& p_setting,
+    bool p_restart_if_changed
+) {
+    int thread_count = _GLOBAL_DEF(p_setting, 1, p_restart_if_changed);
+    ProjectSettings::get_singleton()->set_custom_property_info(
+        p_setting,
+        PropertyInfo(
+            Variant::INT,
+            p_setting,
+            PROPERTY_HINT_RANGE,
+            "0,64,1,or_greater"
+        )
+    );
+    return thread_count;
+}
+
+ThreadWorkPool::~ThreadWorkPool() {
+    finish();
+}
@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef THREAD_WORK_POOL_H
+#define THREAD_WORK_POOL_H
+
+#include "core/os/memory.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/safe_refcount.h"
+#include "core/ustring.h"
+
+// A pool of persistent worker threads that process arrays of work items.
+// Unlike thread_process_array(), the threads are created once in init() and
+// reused by every do_work() call, so it is suitable for per-frame work.
+// The calling thread also processes items while it waits for the workers.
+class ThreadWorkPool {
+    struct BaseWork {
+        SafeNumeric<uint32_t>* index = nullptr;
+        uint32_t max_elements        = 0;
+
+        virtual void work() = 0;
+
+        virtual ~BaseWork() {}
+    };
+
+    template <class C, class M, class U>
+    struct Work : public BaseWork {
+        C* instance;
+        M method;
+        U userdata;
+
+        virtual void work() {
+            while (true) {
+                uint32_t work_index = index->postincrement();
+                if (work_index >= max_elements) {
+                    break;
+                }
+                (instance->*method)(work_index, userdata);
+            }
+        }
+    };
+
+    struct ThreadData {
+        Thread thread;
+        Semaphore start;
+        Semaphore completed;
+        SafeFlag exit;
+        BaseWork* work = nullptr;
+    };
+
+    SafeNumeric<uint32_t> index;
+    ThreadData* threads    = nullptr;
+    uint32_t thread_count  = 0;
+    BaseWork* current_work = nullptr;
+
+    static void _thread_function(void* p_user);
+
+    void _dispatch(BaseWork* p_work);
+
+public:
+    // Processes p_elements items by calling (p_instance->*p_method)(index,
+    // p_userdata) for every index, spread across the pool threads. Returns
+    // once all items have been processed. Items are claimed in ascending
+    // order, but may complete in any order.
+    template <class C, class M, class U>
+    void do_work(uint32_t p_elements, C* p_instance, M p_method, U p_userdata) {
+        if (p_elements == 0) {
+            return;
+        }
+        if (p_elements == 1 || thread_count == 0) {
+            for (uint32_t i = 0; i < p_elements; i++) {
+                (p_instance->*p_method)(i, p_userdata);
+            }
+            return;
+        }
+
+        ERR_FAIL_COND_MSG(current_work, "A work is already in progress.");
+
+        Work<C, M, U>* w = memnew((Work<C, M, U>));
+        w->instance      = p_instance;
+        w->userdata      = p_userdata;
+        w->method        = p_method;
+        w->index         = &index;
+        w->max_elements  = p_elements;
+
+        _dispatch(w);
+    }
+
+    // Number of threads that process work, including the calling thread.
+    _FORCE_INLINE_ int get_thread_count() const {
+        return thread_count + 1;
+    }
+
+    _FORCE_INLINE_ bool is_working() const {
+        return current_work != nullptr;
+    }
+
+    // p_thread_count is the total number of threads to process work with,
+    // including the calling thread (0 or less = use all logical CPU cores).
+    // p_priority is the priority of the worker threads.
+    void init(
+        int p_thread_count          = -1,
+        Thread::Priority p_priority = Thread::PRIORITY_NORMAL
+    );
+    void finish();
+
+    // Defines p_setting, a project setting for the p_thread_count of init(),
+    // with a default of 1, and returns its value.
+    static int define_thread_count_setting(
+        const String& p_setting,
+        bool p_restart_if_changed = false
+    );
+
+    ~ThreadWorkPool();
+};
+
+#endif // THREAD_WORK_POOL_H
@@ -233,6 +233,17 @@ void register_core_settings() {
             "*.crt"
         )
     );
+
+    GLOBAL_DEF("application/run/resource_loader_thread_count", 0);
+    ProjectSettings::get_singleton()->set_custom_property_info(
+        "application/run/resource_loader_thread_count",
+        PropertyInfo(
+            Variant::INT,
+            "application/run/resource_loader_thread_count",
+            PROPERTY_HINT_RANGE,
+            "0,64,1,or_greater"
+        )
+    );
 }
 
 void register_core_singletons() {
@@ -969,6 +969,11 @@ public:
         return Transform();
     }
 
+    void skeleton_set_as_bulk_array(
+        RID p_skeleton,
+        const PoolVector<float>& p_array
+    ) {}
+
     void skeleton_bone_set_transform_2d(
         RID p_skeleton,
         int p_bone,
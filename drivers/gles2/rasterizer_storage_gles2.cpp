@@ -4585,6 +4585,29 @@ Transform RasterizerStorageGLES2::skeleton_bone_get_transform(
     return ret;
 }
 
+void RasterizerStorageGLES2::skeleton_set_as_bulk_array(
+    RID p_skeleton,
+    const PoolVector<float>& p_array
+) {
+    Skeleton* skeleton = skeleton_owner.getornull(p_skeleton);
+    ERR_FAIL_COND(!skeleton);
+
+    ERR_FAIL_COND(skeleton->use_2d);
+    ERR_FAIL_COND(p_array.size() != skeleton->size * 4 * 3);
+
+    // the bone data has the same layout as the array
+    PoolVector<float>::Read r = p_array.read();
+    memcpy(
+        skeleton->bone_data.ptrw(),
+        r.ptr(),
+        p_array.size() * sizeof(float)
+    );
+
+    if (!skeleton->update_list.in_list()) {
+        skeleton_update_list.add(&skeleton->update_list);
+    }
+}
+
 void RasterizerStorageGLES2::skeleton_bone_set_transform_2d(
     RID p_skeleton,
     int p_bone,
@@ -1065,6 +1065,10 @@ public:
     );
     virtual Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone)
         const;
+    virtual void skeleton_set_as_bulk_array(
+        RID p_skeleton,
+        const PoolVector<float>& p_array
+    );
     virtual void skeleton_bone_set_transform_2d(
         RID p_skeleton,
         int p_bone,
@@ -6870,6 +6870,38 @@ Transform RasterizerStorageGLES3::skeleton_bone_get_transform(
     return ret;
 }
 
+void RasterizerStorageGLES3::skeleton_set_as_bulk_array(
+    RID p_skeleton,
+    const PoolVector<float>& p_array
+) {
+    Skeleton* skeleton = skeleton_owner.getornull(p_skeleton);
+
+    ERR_FAIL_COND(!skeleton);
+    ERR_FAIL_COND(skeleton->use_2d);
+    ERR_FAIL_COND(p_array.size() != skeleton->size * 4 * 3);
+
+    PoolVector<float>::Read r = p_array.read();
+    const float* src          = r.ptr();
+    float* texture            = skeleton->skel_texture.ptrw();
+
+    // the texture stores the rows of every 256 bones together
+    for (int i = 0; i < skeleton->size; i++) {
+        int base_ofs = ((i / 256) * 256) * 3 * 4 + (i % 256) * 4;
+        for (int row = 0; row < 3; row++) {
+            memcpy(
+                &texture[base_ofs],
+                &src[(i * 3 + row) * 4],
+                4 * sizeof(float)
+            );
+            base_ofs += 256 * 4;
+        }
+    }
+
+    if (!skeleton->update_list.in_list()) {
+        skeleton_update_list.add(&skeleton->update_list);
+    }
+}
+
 void RasterizerStorageGLES3::skeleton_bone_set_transform_2d(
     RID p_skeleton,
     int p_bone,
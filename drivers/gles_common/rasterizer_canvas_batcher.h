@@ -7,10 +7,13 @@
 #ifndef RASTERIZER_CANVAS_BATCHER_H
 #define RASTERIZER_CANVAS_BATCHER_H
 
+#include "core/hash_map.h"
+#include "core/local_vector.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
 #include "rasterizer_array.h"
 #include "rasterizer_asserts.h"
+#include "rasterizer_canvas_transformer.h"
 #include "rasterizer_storage_common.h"
 #include "servers/visual/rasterizer.h"
 
@@ -269,6 +272,36 @@ public:
         Color final_modulate;
     };
 
+    // the state of an item when the batches of its joined item were cached
+    struct BCacheItem {
+        const RasterizerCanvas::Item* item;
+        uint64_t version;
+        Transform2D final_transform;
+        Color final_modulate;
+    };
+
+    // the batches and vertices filled for a joined item, kept between frames
+    // so they can be reused while its items don't change
+    struct BCacheEntry {
+        LocalVector<BCacheItem> items;
+        uint16_t flags;
+        uint64_t last_used_frame;
+
+        LocalVector<Batch> batches;
+        LocalVector<BatchTex> batch_textures;
+        LocalVector<BatchVertex> vertices;
+        LocalVector<float> light_angles;
+        LocalVector<BatchColor> vertex_colors;
+        LocalVector<BatchColor> vertex_modulates;
+        LocalVector<BatchTransform> vertex_transforms;
+
+        int total_quads;
+        int total_verts;
+        int total_color_changes;
+        bool use_light_angles;
+        uint32_t sequence_batch_type_flags;
+    };
+
     struct BLightRegion {
         void reset() {
             light_bitfield  = 0;
@@ -318,6 +351,8 @@ public:
             settings_use_software_skinning        = true;
             settings_ninepatch_mode               = 0; // default
             settings_light_max_join_items         = 16;
+            settings_deferred_software_transform  = false;
+            settings_use_batch_cache              = false;
 
             settings_uv_contract        = false;
             settings_uv_contract_amount = 0.0f;
@@ -327,6 +362,10 @@ public:
 
             stats_items_sorted       = 0;
             stats_light_items_joined = 0;
+            stats_batch_cache_hits   = 0;
+            stats_batch_cache_misses = 0;
+
+            batch_cache_frame = 0;
         }
 
         // called for each joined item
@@ -344,6 +383,7 @@ public:
             vertex_colors.reset();
             vertex_modulates.reset();
             vertex_transforms.reset();
+            software_transformer.clear();
 
             total_quads         = 0;
             total_verts         = 0;
@@ -377,6 +417,15 @@ public:
         RasterizerArray<BatchColor> vertex_modulates;
         RasterizerArray<BatchTransform> vertex_transforms;
 
+        // rects using a software transform are transformed in bulk when
+        // flushing, rather than as they are filled
+        RasterizerCanvasTransformer software_transformer;
+
+        // joined items that were filled in a single flush, keyed by the
+        // version of their first item, for unlit and lit passes
+        HashMap<uint64_t, BCacheEntry> batch_cache[2];
+        uint64_t batch_cache_frame;
+
         // instead of having a different buffer for each vertex FVF type
         // we have a special array big enough for the biggest FVF
         // which can have a changeable unit size, and reuse it.
@@ -454,6 +503,8 @@ public:
         bool settings_use_software_skinning;
         int settings_light_max_join_items;
         int settings_ninepatch_mode;
+        bool settings_deferred_software_transform;
+        bool settings_use_batch_cache;
 
         // buffer orphaning modes
         bool buffer_mode_batch_upload_send_null;
@@ -467,11 +518,15 @@ public:
         void reset_stats() {
             stats_items_sorted       = 0;
             stats_light_items_joined = 0;
+            stats_batch_cache_hits   = 0;
+            stats_batch_cache_misses = 0;
         }
 
         // frame stats (just for monitoring and debugging)
         int stats_items_sorted;
         int stats_light_items_joined;
+        int stats_batch_cache_hits;
+        int stats_batch_cache_misses;
     } bdata;
 
     struct FillState {
@@ -652,6 +707,61 @@ protected:
     );
 
 private:
+    // reusing the batches of unchanged joined items from previous frames
+    bool _batch_cache_is_cacheable(const BItemJoined& p_bij) const;
+    bool _batch_cache_matches(
+        const BCacheEntry& p_entry,
+        const BItemJoined& p_bij,
+        bool p_lit
+    ) const;
+    bool _batch_cache_restore(
+        const BItemJoined& p_bij,
+        bool p_lit,
+        uint32_t& r_sequence_batch_type_flags
+    );
+    void _batch_cache_store(
+        const BItemJoined& p_bij,
+        bool p_lit,
+        uint32_t p_sequence_batch_type_flags
+    );
+    void _batch_cache_prune();
+
+    template <class TYPE>
+    static void _batch_cache_save(
+        LocalVector<TYPE>& r_to,
+        const RasterizerArray<TYPE>& p_from
+    ) {
+        r_to.resize(p_from.size());
+        if (p_from.size()) {
+            memcpy(r_to.ptr(), p_from.get_data(), p_from.size() * sizeof(TYPE));
+        }
+    }
+
+    template <class TYPE>
+    static void _batch_cache_load(
+        RasterizerArray<TYPE>& r_to,
+        const LocalVector<TYPE>& p_from
+    ) {
+        int count = p_from.size();
+        if (!count) {
+            return;
+        }
+        TYPE* data = r_to.request(count);
+        while (!data) {
+            r_to.grow();
+            data = r_to.request(count);
+        }
+        memcpy(data, p_from.ptr(), count * sizeof(TYPE));
+    }
+
+    const Color& _get_final_modulate(const BItemRef& p_ref, bool p_lit) const {
+        // if not lit we use the complex calculated final modulate, if lit we
+        // ignore canvas modulate and just use the item modulate
+        return p_lit ? p_ref.item->final_modulate : p_ref.final_modulate;
+    }
+
+    void _apply_deferred_software_transforms();
+
     // flush once full or end of joined item
     void flush_render_batches(
         RasterizerCanvas::Item* p_first_item,
@@ -884,6 +994,10 @@ PREAMBLE(void)::batch_canvas_begin() {
         }
     }
 #endif
+
+    if (bdata.settings_use_batch_cache) {
+        _batch_cache_prune();
+    }
 }
 
 PREAMBLE(void)::batch_canvas_end() {
@@ -898,6 +1012,9 @@ PREAMBLE(void)::batch_canvas_end() {
             bdata.frame_string += "\tlight items joined: "
                                 + itos(bdata.stats_light_items_joined) + "\n";
         }
+        if (bdata.settings_use_batch_cache) {
+            bdata.frame_string += _diagnose_batch_cache_string();
+        }
 
         print_line(bdata.frame_string);
     }
@@ -1310,6 +1427,16 @@ PREAMBLE(void)::batch_initialize() {
     bdata.settings_batch_buffer_num_verts =
         GLOBAL_GET("rendering/batching/parameters/batch_buffer_size");
 
+    bdata.settings_deferred_software_transform =
+        GLOBAL_GET("rendering/batching/options/deferred_software_transform");
+    bdata.settings_use_batch_cache =
+        GLOBAL_GET("rendering/batching/options/use_batch_cache");
+    if (bdata.settings_deferred_software_transform) {
+        bdata.software_transformer.init(
+            GLOBAL_GET("rendering/threads/canvas_batching_thread_count")
+        );
+    }
+
     // override the use_batching setting in the editor
     // (note that if the editor can't start, you can't change the use_batching
     // project setting!)
@@ -2539,7 +2666,13 @@ bool C_PREAMBLE::_prefill_rect(
     }
 
     if (r_fill_state.transform_mode == TM_ALL) {
-        if (!use_large_verts) {
+        if (!use_large_verts && bdata.settings_deferred_software_transform) {
+            bdata.software_transformer.add(
+                bdata.vertices.size() - 4,
+                4,
+                r_fill_state.transform_combined
+            );
+        } else if (!use_large_verts) {
             _software_transform_vertex(
                 bA->pos,
                 r_fill_state.transform_combined
@@ -3026,6 +3159,9 @@ PREAMBLE(void)::flush_render_batches(
     // .. however probably not necessary
     bdata.use_colored_vertices = false;
 
+    // finish any deferred software transforms before the vertices are read
+    _apply_deferred_software_transforms();
+
     RasterizerStorageCommon::FVF backup_fvf = bdata.fvf;
 
     // the batch type in this flush can override the fvf from the joined item.
@@ -3142,6 +3278,170 @@ PREAMBLE(void)::flush_render_batches(
 #endif
 }
 
+PREAMBLE(void)::_apply_deferred_software_transforms() {
+    if (!bdata.software_transformer.is_empty()) {
+        bdata.software_transformer.apply(
+            &bdata.vertices[0].pos.x,
+            sizeof(BatchVertex) / sizeof(float)
+        );
+    }
+}
+
+PREAMBLE(bool)::_batch_cache_is_cacheable(const BItemJoined& p_bij) const {
+    // software skinned polygons depend on the skeleton pose, which doesn't
+    // change the item version
+    for (unsigned int i = 0; i < p_bij.num_item_refs; i++) {
+        const BItemRef& ref = bdata.item_refs[p_bij.first_item_ref + i];
+        if (ref.item->skeleton.is_valid()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+PREAMBLE(bool)::_batch_cache_matches(
+    const BCacheEntry& p_entry,
+    const BItemJoined& p_bij,
+    bool p_lit
+) const {
+    if (p_entry.flags != p_bij.flags
+        || p_entry.items.size() != p_bij.num_item_refs) {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < p_bij.num_item_refs; i++) {
+        const BItemRef& ref       = bdata.item_refs[p_bij.first_item_ref + i];
+        const BCacheItem& cached = p_entry.items[i];
+        if (cached.item != ref.item || cached.version != ref.item->version
+            || cached.final_transform != ref.item->final_transform
+            || cached.final_modulate != _get_final_modulate(ref, p_lit)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+PREAMBLE(bool)::_batch_cache_restore(
+    const BItemJoined& p_bij,
+    bool p_lit,
+    uint32_t& r_sequence_batch_type_flags
+) {
+    const RasterizerCanvas::Item* first_item =
+        bdata.item_refs[p_bij.first_item_ref].item;
+    BCacheEntry* entry = bdata.batch_cache[p_lit].getptr(first_item->version);
+    if (!entry || !_batch_cache_matches(*entry, p_bij, p_lit)) {
+        bdata.stats_batch_cache_misses++;
+        return false;
+    }
+
+    // the uvs were calculated from the texture sizes, so the textures must not
+    // have changed either
+    for (unsigned int n = 0; n < entry->batch_textures.size(); n++) {
+        const BatchTex& cached = entry->batch_textures[n];
+        int batch_tex_id       = _batch_find_or_create_tex(
+            cached.RID_texture,
+            cached.RID_normal,
+            cached.tile_mode != BatchTex::TILE_OFF,
+            -1
+        );
+        const BatchTex& current = bdata.batch_textures[batch_tex_id];
+        if (batch_tex_id != (int)n || current.tile_mode != cached.tile_mode
+            || current.flags != cached.flags
+            || current.tex_pixel_size.x != cached.tex_pixel_size.x
+            || current.tex_pixel_size.y != cached.tex_pixel_size.y) {
+            bdata.batch_textures.reset();
+            bdata.stats_batch_cache_misses++;
+            return false;
+        }
+    }
+
+    _batch_cache_load(bdata.batches, entry->batches);
+    _batch_cache_load(bdata.vertices, entry->vertices);
+    _batch_cache_load(bdata.light_angles, entry->light_angles);
+    _batch_cache_load(bdata.vertex_colors, entry->vertex_colors);
+    _batch_cache_load(bdata.vertex_modulates, entry->vertex_modulates);
+    _batch_cache_load(bdata.vertex_transforms, entry->vertex_transforms);
+
+    bdata.total_quads         = entry->total_quads;
+    bdata.total_verts         = entry->total_verts;
+    bdata.total_color_changes = entry->total_color_changes;
+    bdata.use_light_angles    = entry->use_light_angles;
+
+    r_sequence_batch_type_flags = entry->sequence_batch_type_flags;
+
+    entry->last_used_frame = Engine::get_singleton()->get_frames_drawn();
+    bdata.stats_batch_cache_hits++;
+    return true;
+}
+
+PREAMBLE(void)::_batch_cache_store(
+    const BItemJoined& p_bij,
+    bool p_lit,
+    uint32_t p_sequence_batch_type_flags
+) {
+    // the cached vertices must be final
+    _apply_deferred_software_transforms();
+
+    const RasterizerCanvas::Item* first_item =
+        bdata.item_refs[p_bij.first_item_ref].item;
+    BCacheEntry& entry = bdata.batch_cache[p_lit][first_item->version];
+
+    entry.items.resize(p_bij.num_item_refs);
+    for (unsigned int i = 0; i < p_bij.num_item_refs; i++) {
+        const BItemRef& ref    = bdata.item_refs[p_bij.first_item_ref + i];
+        BCacheItem& cached     = entry.items[i];
+        cached.item            = ref.item;
+        cached.version         = ref.item->version;
+        cached.final_transform = ref.item->final_transform;
+        cached.final_modulate  = _get_final_modulate(ref, p_lit);
+    }
+    entry.flags           = p_bij.flags;
+    entry.last_used_frame = Engine::get_singleton()->get_frames_drawn();
+
+    entry.batch_textures.resize(bdata.batch_textures.size());
+    for (int n = 0; n < bdata.batch_textures.size(); n++) {
+        entry.batch_textures[n] = bdata.batch_textures[n];
+    }
+
+    _batch_cache_save(entry.batches, bdata.batches);
+    _batch_cache_save(entry.vertices, bdata.vertices);
+    _batch_cache_save(entry.light_angles, bdata.light_angles);
+    _batch_cache_save(entry.vertex_colors, bdata.vertex_colors);
+    _batch_cache_save(entry.vertex_modulates, bdata.vertex_modulates);
+    _batch_cache_save(entry.vertex_transforms, bdata.vertex_transforms);
+
+    entry.total_quads               = bdata.total_quads;
+    entry.total_verts               = bdata.total_verts;
+    entry.total_color_changes       = bdata.total_color_changes;
+    entry.use_light_angles          = bdata.use_light_angles;
+    entry.sequence_batch_type_flags = p_sequence_batch_type_flags;
+}
+
+PREAMBLE(void)::_batch_cache_prune() {
+    uint64_t frame = Engine::get_singleton()->get_frames_drawn();
+    if (frame == bdata.batch_cache_frame) {
+        return;
+    }
+    bdata.batch_cache_frame = frame;
+
+    // drop the joined items that weren't drawn last frame
+    LocalVector<uint64_t> unused;
+    for (int lit = 0; lit < 2; lit++) {
+        HashMap<uint64_t, BCacheEntry>& cache = bdata.batch_cache[lit];
+
+        unused.clear();
+        const uint64_t* key = nullptr;
+        while ((key = cache.next(key))) {
+            if (cache[*key].last_used_frame + 1 < frame) {
+                unused.push_back(*key);
+            }
+        }
+        for (unsigned int i = 0; i < unused.size(); i++) {
+            cache.erase(unused[i]);
+        }
+    }
+}
+
 PREAMBLE(void)::render_joined_item_commands(
     const BItemJoined& p_bij,
     RasterizerCanvas::Item* p_current_clip,
@@ -3189,17 +3489,34 @@ PREAMBLE(void)::render_joined_item_commands(
         fill_state.extra_matrix_sent = true;
     }
 
+    // reuse the batches from a previous frame if nothing has changed
+    bool use_cache =
+        bdata.settings_use_batch_cache && _batch_cache_is_cacheable(p_bij);
+    if (use_cache
+        && _batch_cache_restore(
+            p_bij,
+            p_lit,
+            fill_state.sequence_batch_type_flags
+        )) {
+        flush_render_batches(
+            first_item,
+            p_current_clip,
+            r_reclip,
+            p_material,
+            fill_state.sequence_batch_type_flags
+        );
+        bdata.reset_flush();
+        return;
+    }
+
+    // only joined items filled in a single flush are cached
+    bool flushed = false;
+
     for (unsigned int i = 0; i < p_bij.num_item_refs; i++) {
         const BItemRef& ref = bdata.item_refs[p_bij.first_item_ref + i];
         item                = ref.item;
 
-        if (!p_lit) {
-            // if not lit we use the complex calculated final modulate
-            fill_state.final_modulate = ref.final_modulate;
-        } else {
-            // if lit we ignore canvas modulate and just use the item modulate
-            fill_state.final_modulate = item->final_modulate;
-        }
+        fill_state.final_modulate = _get_final_modulate(ref, p_lit);
 
         int command_count = item->commands.size();
         int command_start = 0;
@@ -3254,6 +3571,8 @@ PREAMBLE(void)::render_joined_item_commands(
             );
 
             if (bFull) {
+                flushed = true;
+
                 // always pass first item (commands for default are always first
                 // item)
                 flush_render_batches(
@@ -3273,6 +3592,10 @@ PREAMBLE(void)::render_joined_item_commands(
         }
     }
 
+    if (use_cache && !flushed) {
+        _batch_cache_store(p_bij, p_lit, fill_state.sequence_batch_type_flags);
+    }
+
     // flush if any left
     flush_render_batches(
         first_item,
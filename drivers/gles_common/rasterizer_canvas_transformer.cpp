@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "rasterizer_canvas_transformer.h"
+
+#include "core/math/simd.h"
+
+void RasterizerCanvasTransformer::init(int p_thread_count) {
+    work_pool.finish();
+    work_pool.init(p_thread_count);
+}
+
+void RasterizerCanvasTransformer::apply(float* p_positions, uint32_t p_stride) {
+    if (runs.size() == 0) {
+        return;
+    }
+
+    positions = p_positions;
+    stride    = p_stride;
+
+    const Run& last = runs[runs.size() - 1];
+    uint32_t count  = last.first + last.count - runs[0].first;
+    uint32_t chunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    work_pool.do_work(
+        chunks,
+        this,
+        &RasterizerCanvasTransformer::_apply_chunk,
+        nullptr
+    );
+
+    runs.clear();
+}
+
+// Returns the first run that ends after p_vertex.
+uint32_t RasterizerCanvasTransformer::_find_run(uint32_t p_vertex) const {
+    uint32_t low  = 0;
+    uint32_t high = runs.size();
+    while (low < high) {
+        uint32_t middle = (low + high) / 2;
+        const Run& run  = runs[middle];
+        if (run.first + run.count <= p_vertex) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+void RasterizerCanvasTransformer::_transform(
+    const Run& p_run,
+    uint32_t p_from,
+    uint32_t p_to
+) {
+    const Transform2D& t = p_run.transform;
+    const float xx       = t.elements[0].x;
+    const float xy       = t.elements[0].y;
+    const float yx       = t.elements[1].x;
+    const float yy       = t.elements[1].y;
+    const float ox       = t.elements[2].x;
+    const float oy       = t.elements[2].y;
+
+    const SimdFloat s_xx = SimdFloat::splat(xx);
+    const SimdFloat s_xy = SimdFloat::splat(xy);
+    const SimdFloat s_yx = SimdFloat::splat(yx);
+    const SimdFloat s_yy = SimdFloat::splat(yy);
+    const SimdFloat s_ox = SimdFloat::splat(ox);
+    const SimdFloat s_oy = SimdFloat::splat(oy);
+
+    // The positions are interleaved with the other vertex attributes, so they
+    // are gathered into lanes, transformed together and scattered back.
+    float xs[SimdFloat::WIDTH];
+    float ys[SimdFloat::WIDTH];
+
+    uint32_t v = p_from;
+    for (; v + SimdFloat::WIDTH <= p_to; v += SimdFloat::WIDTH) {
+        float* position = positions + v * stride;
+        SimdFloat x     = SimdFloat::load_strided(position, stride);
+        SimdFloat y     = SimdFloat::load_strided(position + 1, stride);
+        (s_xx * x + s_yx * y + s_ox).store(xs);
+        (s_xy * x + s_yy * y + s_oy).store(ys);
+
+        for (int i = 0; i < SimdFloat::WIDTH; i++) {
+            position[i * stride]     = xs[i];
+            position[i * stride + 1] = ys[i];
+        }
+    }
+
+    for (; v < p_to; v++) {
+        float* position = positions + v * stride;
+        float x         = position[0];
+        float y         = position[1];
+        position[0]     = xx * x + yx * y + ox;
+        position[1]     = xy * x + yy * y + oy;
+    }
+}
+
+void RasterizerCanvasTransformer::_apply_chunk(
+    uint32_t p_chunk,
+    void* p_userdata
+) {
+    const Run& last = runs[runs.size() - 1];
+    uint32_t from   = runs[0].first + p_chunk * CHUNK_SIZE;
+    uint32_t to     = MIN(from + CHUNK_SIZE, last.first + last.count);
+
+    for (uint32_t r = _find_run(from); r < runs.size(); r++) {
+        const Run& run = runs[r];
+        if (run.first >= to) {
+            break;
+        }
+        _transform(run, MAX(run.first, from), MIN(run.first + run.count, to));
+    }
+}
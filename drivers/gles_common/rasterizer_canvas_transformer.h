@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef RASTERIZER_CANVAS_TRANSFORMER_H
+#define RASTERIZER_CANVAS_TRANSFORMER_H
+
+#include "core/local_vector.h"
+#include "core/math/transform_2d.h"
+#include "core/os/thread_work_pool.h"
+
+// Deferred software transform of batched canvas vertices.
+//
+// Instead of transforming every vertex as it is written to the batch vertex
+// buffer, the batcher records runs of consecutive vertices that share a
+// transform, and transforms all of them at once before the buffer is
+// uploaded. The vertices are split into chunks that are transformed in
+// parallel on a work pool, several vertices at a time with SIMD. Every chunk
+// only writes its own vertices, so the result doesn't depend on the number of
+// threads.
+//
+// Only the transform is parallel. Recording, sorting and joining the items,
+// and prefilling the batches with the untransformed vertices, stay serial on
+// the rendering thread.
+class RasterizerCanvasTransformer {
+public:
+    enum {
+        CHUNK_SIZE = 2048,
+    };
+
+    // Records that p_count vertices, starting at p_first_vertex, are to be
+    // transformed by p_transform. Vertices must be added in ascending order.
+    _FORCE_INLINE_ void add(
+        uint32_t p_first_vertex,
+        uint32_t p_count,
+        const Transform2D& p_transform
+    ) {
+        if (runs.size()) {
+            Run& last = runs[runs.size() - 1];
+            if (last.first + last.count == p_first_vertex
+                && _is_same(last.transform, p_transform)) {
+                last.count += p_count;
+                return;
+            }
+        }
+        Run run;
+        run.first     = p_first_vertex;
+        run.count     = p_count;
+        run.transform = p_transform;
+        runs.push_back(run);
+    }
+
+    // Transforms the recorded vertices in place and clears the runs.
+    // p_positions points to the x of the first vertex's position, followed by
+    // its y, and p_stride is the number of floats between vertices.
+    void apply(float* p_positions, uint32_t p_stride);
+
+    _FORCE_INLINE_ void clear() {
+        runs.clear();
+    }
+
+    _FORCE_INLINE_ bool is_empty() const {
+        return runs.size() == 0;
+    }
+
+    // p_thread_count is the total number of threads, including the calling
+    // thread (0 = use all logical CPU cores).
+    void init(int p_thread_count);
+
+private:
+    struct Run {
+        uint32_t first;
+        uint32_t count;
+        Transform2D transform;
+    };
+
+    LocalVector<Run> runs;
+    ThreadWorkPool work_pool;
+
+    float* positions = nullptr;
+    uint32_t stride  = 0;
+
+    // Transform2D::operator==() isn't inlined, and this is called per rect.
+    static _FORCE_INLINE_ bool _is_same(
+        const Transform2D& p_a,
+        const Transform2D& p_b
+    ) {
+        return p_a.elements[0] == p_b.elements[0]
+            && p_a.elements[1] == p_b.elements[1]
+            && p_a.elements[2] == p_b.elements[2];
+    }
+
+    uint32_t _find_run(uint32_t p_vertex) const;
+    void _transform(const Run& p_run, uint32_t p_from, uint32_t p_to);
+    void _apply_chunk(uint32_t p_chunk, void* p_userdata);
+};
+
+#endif // RASTERIZER_CANVAS_TRANSFORMER_H
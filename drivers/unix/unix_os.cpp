@@ -28,12 +28,15 @@
 #include <assert.h>
 #include <dlfcn.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <poll.h>
 #include <signal.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/wait.h>
 #include <time.h>
@@ -490,6 +493,33 @@ int UnixOS::get_processor_count() const {
     return sysconf(_SC_NPROCESSORS_CONF);
 }
 
+const uint8_t* UnixOS::map_file(const String& p_path, uint64_t* r_size) {
+    int fd = open(p_path.utf8().get_data(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+
+    *r_size = st.st_size;
+    return static_cast<const uint8_t*>(data);
+}
+
+void UnixOS::unmap_file(const uint8_t* p_data, uint64_t p_size) {
+    munmap(const_cast<uint8_t*>(p_data), p_size);
+}
+
 String UnixOS::get_user_data_dir() const {
     String appname = get_safe_dir_name(
         ProjectSettings::get_singleton()->get("application/config/name")
@@ -90,6 +90,9 @@ public:
 
     virtual int get_processor_count() const;
 
+    virtual const uint8_t* map_file(const String& p_path, uint64_t* r_size);
+    virtual void unmap_file(const uint8_t* p_data, uint64_t p_size);
+
     virtual void debug_break();
     virtual void initialize_debugging();
 
@@ -1040,6 +1040,23 @@ void ResourceImporterScene::_optimize_animations(
     }
 }
 
+void ResourceImporterScene::_compress_animations(Node* scene) {
+    if (!scene->has_node(String("AnimationPlayer"))) {
+        return;
+    }
+    Node* n = scene->get_node(String("AnimationPlayer"));
+    ERR_FAIL_COND(!n);
+    AnimationPlayer* anim = Object::cast_to<AnimationPlayer>(n);
+    ERR_FAIL_COND(!anim);
+
+    List<StringName> anim_names;
+    anim->get_animation_list(&anim_names);
+    for (List<StringName>::Element* E = anim_names.front(); E; E = E->next()) {
+        Ref<Animation> a = anim->get_animation(E->get());
+        a->compress();
+    }
+}
+
 static String _make_extname(const String& p_str) {
     String ext_name = p_str.replace(".", "_");
     ext_name        = ext_name.replace(":", "_");
@@ -1569,6 +1586,10 @@ void ResourceImporterScene::get_import_options(
         PropertyInfo(Variant::BOOL, "animation/optimizer/remove_unused_tracks"),
         true
     ));
+    r_options->push_back(ImportOption(
+        PropertyInfo(Variant::BOOL, "animation/compression/enabled"),
+        false
+    ));
     r_options->push_back(ImportOption(
         PropertyInfo(
             Variant::INT,
@@ -1900,6 +1921,11 @@ Error ResourceImporterScene::import(
         _filter_tracks(scene, animation_filter);
     }
 
+    // clips copy the keys of the source animation, so compress after them
+    if (bool(p_options["animation/compression/enabled"])) {
+        _compress_animations(scene);
+    }
+
     bool external_animations = int(p_options["animation/storage"]) == 1
                             || int(p_options["animation/storage"]) == 2;
     bool external_animations_as_text = int(p_options["animation/storage"]) == 2;
@@ -194,6 +194,7 @@ public:
         float p_max_ang_error,
         float p_max_angle
     );
+    void _compress_animations(Node* scene);
 
     virtual Error import(
         const String& p_source_file,
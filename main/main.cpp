@@ -3039,6 +3039,7 @@ bool Main::iteration() {
 
     frames++;
     Engine::get_singleton()->_idle_frames++;
+    message_queue->end_frame();
 
     if (frame > 1000000) {
         if (editor || projects_manager) {
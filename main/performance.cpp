@@ -54,6 +54,13 @@ void Performance::_bind_methods() {
     BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
     BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
     BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+    BIND_ENUM_CONSTANT(PHYSICS_3D_PACKED_CONTACT_COUNT);
+    BIND_ENUM_CONSTANT(PHYSICS_3D_UNPACKED_ISLAND_COUNT);
+    BIND_ENUM_CONSTANT(PHYSICS_3D_SOLVE_TIME);
+    BIND_ENUM_CONSTANT(MESSAGE_QUEUE_MESSAGES_IN_FRAME);
+    BIND_ENUM_CONSTANT(MESSAGE_QUEUE_BYTES_IN_FRAME);
+    BIND_ENUM_CONSTANT(RENDER_OCCLUDED_OBJECTS_IN_FRAME);
+    BIND_ENUM_CONSTANT(RENDER_CULL_OVERFLOWS_IN_FRAME);
 
     BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -102,6 +109,13 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
         "physics_3d/collision_pairs",
         "physics_3d/islands",
         "audio/output_latency",
+        "physics_3d/packed_contacts",
+        "physics_3d/unpacked_islands",
+        "physics_3d/solve_time",
+        "message_queue/messages",
+        "message_queue/bytes",
+        "raster/objects_occluded",
+        "raster/cull_overflows",
 
     };
 
@@ -206,6 +220,31 @@ float Performance::get_monitor(Monitor p_monitor) const {
             );
         case AUDIO_OUTPUT_LATENCY:
             return AudioServer::get_singleton()->get_output_latency();
+        case PHYSICS_3D_PACKED_CONTACT_COUNT:
+            return PhysicsServer::get_singleton()->get_process_info(
+                PhysicsServer::INFO_PACKED_CONTACT_COUNT
+            );
+        case PHYSICS_3D_UNPACKED_ISLAND_COUNT:
+            return PhysicsServer::get_singleton()->get_process_info(
+                PhysicsServer::INFO_UNPACKED_ISLAND_COUNT
+            );
+        case PHYSICS_3D_SOLVE_TIME:
+            return PhysicsServer::get_singleton()->get_process_info(
+                       PhysicsServer::INFO_SOLVE_TIME
+                   )
+                 / 1000000.0;
+        case MESSAGE_QUEUE_MESSAGES_IN_FRAME:
+            return MessageQueue::get_singleton()->get_frame_message_count();
+        case MESSAGE_QUEUE_BYTES_IN_FRAME:
+            return MessageQueue::get_singleton()->get_frame_byte_count();
+        case RENDER_OCCLUDED_OBJECTS_IN_FRAME:
+            return VS::get_singleton()->get_render_info(
+                VS::INFO_OCCLUDED_OBJECTS_IN_FRAME
+            );
+        case RENDER_CULL_OVERFLOWS_IN_FRAME:
+            return VS::get_singleton()->get_render_info(
+                VS::INFO_CULL_OVERFLOWS_IN_FRAME
+            );
 
         default: {
         }
@@ -230,7 +269,9 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor
         MONITOR_TYPE_MEMORY,   MONITOR_TYPE_MEMORY,   MONITOR_TYPE_MEMORY,
         MONITOR_TYPE_QUANTITY, MONITOR_TYPE_QUANTITY, MONITOR_TYPE_QUANTITY,
         MONITOR_TYPE_QUANTITY, MONITOR_TYPE_QUANTITY, MONITOR_TYPE_QUANTITY,
-        MONITOR_TYPE_TIME,
+        MONITOR_TYPE_TIME,     MONITOR_TYPE_QUANTITY, MONITOR_TYPE_QUANTITY,
+        MONITOR_TYPE_TIME,     MONITOR_TYPE_QUANTITY, MONITOR_TYPE_MEMORY,
+        MONITOR_TYPE_QUANTITY, MONITOR_TYPE_QUANTITY,
 
     };
 
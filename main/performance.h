@@ -57,6 +57,13 @@ public:
         PHYSICS_3D_ISLAND_COUNT,
         // physics
         AUDIO_OUTPUT_LATENCY,
+        PHYSICS_3D_PACKED_CONTACT_COUNT,
+        PHYSICS_3D_UNPACKED_ISLAND_COUNT,
+        PHYSICS_3D_SOLVE_TIME,
+        MESSAGE_QUEUE_MESSAGES_IN_FRAME,
+        MESSAGE_QUEUE_BYTES_IN_FRAME,
+        RENDER_OCCLUDED_OBJECTS_IN_FRAME,
+        RENDER_CULL_OVERFLOWS_IN_FRAME,
         MONITOR_MAX
     };
 
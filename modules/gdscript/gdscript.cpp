@@ -1103,6 +1103,7 @@ GDScript::~GDScript() {
          E = E->next()) {
         memdelete(E->get());
     }
+    GDScriptLanguage::get_singleton()->invalidate_inline_caches();
 
     _save_orphaned_subclasses();
 
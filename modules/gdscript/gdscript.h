@@ -441,6 +441,7 @@ class GDScriptLanguage : public ScriptLanguage {
     friend class GDScriptFunction;
 
     SelfList<GDScriptFunction>::List function_list;
+    SafeNumeric<uint32_t> inline_cache_version;
     bool profiling;
     uint64_t script_frame_time;
 
@@ -558,6 +559,16 @@ public:
         return named_globals;
     }
 
+    // Inline caches are emptied when their version differs, which happens
+    // whenever script functions are freed.
+    _FORCE_INLINE_ uint32_t get_inline_cache_version() const {
+        return inline_cache_version.get();
+    }
+
+    _FORCE_INLINE_ void invalidate_inline_caches() {
+        inline_cache_version.increment();
+    }
+
     _FORCE_INLINE_ static GDScriptLanguage* get_singleton() {
         return singleton;
     }
@@ -59,6 +59,144 @@ void GDScriptCompiler::_set_error(
     }
 }
 
+StringName GDScriptCompiler::_get_native_class(const GDScript* p_script
+) const {
+    const GDScript* scr = p_script;
+    while (scr) {
+        if (scr->native.is_valid()) {
+            return scr->native->get_name();
+        }
+        scr = scr->_base;
+    }
+    return StringName();
+}
+
+GDScriptFunction::Opcode GDScriptCompiler::_get_operator_opcode(
+    Variant::Operator p_op,
+    const GDScriptParser::DataType& p_a,
+    const GDScriptParser::DataType& p_b
+) const {
+    if (!p_a.has_type || p_a.kind != GDScriptParser::DataType::BUILTIN
+        || !p_b.has_type || p_b.kind != GDScriptParser::DataType::BUILTIN) {
+        return GDScriptFunction::OPCODE_OPERATOR;
+    }
+
+    bool comparison = false;
+    bool arithmetic = false;
+    switch (p_op) {
+        case Variant::OP_EQUAL:
+        case Variant::OP_NOT_EQUAL:
+        case Variant::OP_LESS:
+        case Variant::OP_LESS_EQUAL:
+        case Variant::OP_GREATER:
+        case Variant::OP_GREATER_EQUAL: {
+            comparison = true;
+        } break;
+        case Variant::OP_ADD:
+        case Variant::OP_SUBTRACT:
+        case Variant::OP_MULTIPLY: {
+            arithmetic = true;
+        } break;
+        default: {
+        }
+    }
+    bool equality = p_op == Variant::OP_EQUAL || p_op == Variant::OP_NOT_EQUAL;
+    bool scaling  = p_op == Variant::OP_MULTIPLY || p_op == Variant::OP_DIVIDE;
+    bool number_b = p_b.builtin_type == Variant::INT
+                 || p_b.builtin_type == Variant::REAL;
+
+    switch (p_a.builtin_type) {
+        case Variant::INT: {
+            if (p_b.builtin_type == Variant::INT
+                && (comparison || arithmetic)) {
+                return GDScriptFunction::OPCODE_OPERATOR_INT;
+            }
+            if (p_b.builtin_type == Variant::REAL
+                && (comparison || arithmetic || p_op == Variant::OP_DIVIDE)) {
+                return GDScriptFunction::OPCODE_OPERATOR_REAL;
+            }
+        } break;
+        case Variant::REAL: {
+            if (number_b
+                && (comparison || arithmetic || p_op == Variant::OP_DIVIDE)) {
+                return GDScriptFunction::OPCODE_OPERATOR_REAL;
+            }
+        } break;
+        case Variant::VECTOR2: {
+            if ((p_b.builtin_type == Variant::VECTOR2
+                 && (equality || arithmetic || scaling))
+                || (number_b && scaling)) {
+                return GDScriptFunction::OPCODE_OPERATOR_VECTOR2;
+            }
+        } break;
+        case Variant::VECTOR3: {
+            if ((p_b.builtin_type == Variant::VECTOR3
+                 && (equality || arithmetic || scaling))
+                || (number_b && scaling)) {
+                return GDScriptFunction::OPCODE_OPERATOR_VECTOR3;
+            }
+        } break;
+        default: {
+        }
+    }
+    return GDScriptFunction::OPCODE_OPERATOR;
+}
+
+int GDScriptCompiler::_get_native_property_accessor(
+    CodeGen& codegen,
+    const StringName& p_name,
+    bool p_setter
+) {
+    // Resolved the same way as ClassDB::set_property() and
+    // ClassDB::get_property(), which are still used when the owner's class
+    // differs from the script's native class.
+    StringName native = _get_native_class(codegen.script);
+    ClassDB::ClassInfo* check = ClassDB::classes.getptr(native);
+    while (check) {
+        const ClassDB::PropertySetGet* psg =
+            check->property_setget.getptr(p_name);
+        if (psg) {
+            MethodBind* method = p_setter ? psg->_setptr : psg->_getptr;
+            if (!method || psg->index >= 0) {
+                return -1;
+            }
+            return codegen.get_native_method_pos(native, method);
+        }
+        if (!p_setter && check->constant_map.has(p_name)) {
+            return -1;
+        }
+        check = check->inherits_ptr;
+    }
+    return -1;
+}
+
+int GDScriptCompiler::_get_native_call_method(
+    CodeGen& codegen,
+    const GDScriptParser::Node* p_base,
+    const StringName& p_method
+) {
+    StringName native;
+    if (p_base->type == GDScriptParser::Node::TYPE_SELF) {
+        if (codegen.function_node && codegen.function_node->_static) {
+            return -1;
+        }
+        native = _get_native_class(codegen.script);
+    } else {
+        GDScriptParser::DataType base_type = p_base->get_datatype();
+        if (!base_type.has_type
+            || base_type.kind != GDScriptParser::DataType::NATIVE) {
+            return -1;
+        }
+        native = base_type.native_type;
+    }
+
+    MethodBind* method = ClassDB::get_method(native, p_method);
+    if (!method || method->is_vararg()) {
+        return -1;
+    }
+    return codegen.get_native_method_pos(native, method);
+}
+
 bool GDScriptCompiler::_create_unary_operator(
     CodeGen& codegen,
     const GDScriptParser::OperatorNode* on,
@@ -120,8 +258,11 @@ bool GDScriptCompiler::_create_binary_operator(
         return false;
     }
 
-    codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR
-    );                                        // perform operator
+    codegen.opcodes.push_back(_get_operator_opcode(
+        op,
+        on->arguments[0]->get_datatype(),
+        on->arguments[1]->get_datatype()
+    ));                                       // perform operator
     codegen.opcodes.push_back(op);            // which operator
     codegen.opcodes.push_back(src_address_a); // argument 1
     codegen.opcodes.push_back(src_address_b
@@ -320,10 +461,20 @@ int GDScriptCompiler::_parse_expression(
             // TRY CLASS MEMBER
             if (_is_class_member_property(codegen, identifier)) {
                 // get property
-                codegen.opcodes.push_back(GDScriptFunction::OPCODE_GET_MEMBER
+                int getter = _get_native_property_accessor(
+                    codegen,
+                    identifier,
+                    false
+                );
+                codegen.opcodes.push_back(
+                    getter < 0 ? GDScriptFunction::OPCODE_GET_MEMBER
+                               : GDScriptFunction::OPCODE_GET_MEMBER_NATIVE
                 ); // perform operator
                 codegen.opcodes.push_back(codegen.get_name_map_pos(identifier)
                 ); // argument 2 (unary only takes one parameter)
+                if (getter >= 0) {
+                    codegen.opcodes.push_back(getter);
+                }
                 int dst_addr = (p_stack_level)
                              | (GDScriptFunction::ADDR_TYPE_STACK
                                 << GDScriptFunction::ADDR_BITS);
@@ -882,14 +1033,40 @@ int GDScriptCompiler::_parse_expression(
                             arguments.push_back(ret);
                         }
 
-                        codegen.opcodes.push_back(
-                            p_root ? GDScriptFunction::OPCODE_CALL
-                                   : GDScriptFunction::OPCODE_CALL_RETURN
-                        ); // perform operator
+                        int native = _get_native_call_method(
+                            codegen,
+                            instance,
+                            static_cast<const GDScriptParser::IdentifierNode*>(
+                                on->arguments[1]
+                            )
+                                ->name
+                        );
+                        if (native < 0) {
+                            codegen.opcodes.push_back(
+                                p_root ? GDScriptFunction::OPCODE_CALL
+                                       : GDScriptFunction::OPCODE_CALL_RETURN
+                            ); // perform operator
+                        } else {
+                            codegen.opcodes.push_back(
+                                p_root ? GDScriptFunction::OPCODE_CALL_NATIVE
+                                       : GDScriptFunction::
+                                           OPCODE_CALL_NATIVE_RETURN
+                            );
+                        }
                         codegen.opcodes.push_back(on->arguments.size() - 2);
                         codegen.alloc_call(on->arguments.size() - 2);
                         for (int i = 0; i < arguments.size(); i++) {
                             codegen.opcodes.push_back(arguments[i]);
+                            if (i == 1) {
+                                // after the method name, the native method if
+                                // any, and the inline cache
+                                if (native >= 0) {
+                                    codegen.opcodes.push_back(native);
+                                }
+                                codegen.opcodes.push_back(
+                                    codegen.alloc_inline_cache()
+                                );
+                            }
                         }
                     }
                 } break;
@@ -1048,6 +1225,9 @@ int GDScriptCompiler::_parse_expression(
                     codegen.opcodes.push_back(from); // argument 1
                     codegen.opcodes.push_back(index
                     ); // argument 2 (unary only takes one parameter)
+                    if (named) {
+                        codegen.opcodes.push_back(codegen.alloc_inline_cache());
+                    }
 
                 } break;
                 case GDScriptParser::OperatorNode::OP_AND: {
@@ -1609,12 +1789,22 @@ int GDScriptCompiler::_parse_expression(
                         if (assign_property != StringName()) {
                             // recover and assign at the end, this allows stuff
                             // like position.x+=2.0 in Node2D
+                            int setter = _get_native_property_accessor(
+                                codegen,
+                                assign_property,
+                                true
+                            );
                             setchain.push_back(prev_pos);
+                            if (setter >= 0) {
+                                setchain.push_back(setter);
+                            }
                             setchain.push_back(
                                 codegen.get_name_map_pos(assign_property)
                             );
                             setchain.push_back(
-                                GDScriptFunction::OPCODE_SET_MEMBER
+                                setter < 0
+                                    ? GDScriptFunction::OPCODE_SET_MEMBER
+                                    : GDScriptFunction::OPCODE_SET_MEMBER_NATIVE
                             );
                         }
 
@@ -1669,6 +1859,11 @@ int GDScriptCompiler::_parse_expression(
                             );
                             codegen.opcodes.push_back(prev_pos);
                             codegen.opcodes.push_back(key_idx);
+                            if (named) {
+                                codegen.opcodes.push_back(
+                                    codegen.alloc_inline_cache()
+                                );
+                            }
                             slevel++;
                             codegen.alloc_stack(slevel);
                             int dst_pos = (GDScriptFunction::ADDR_TYPE_STACK
@@ -1774,11 +1969,18 @@ int GDScriptCompiler::_parse_expression(
                             )
                                 ->name;
 
+                        int setter =
+                            _get_native_property_accessor(codegen, name, true);
                         codegen.opcodes.push_back(
-                            GDScriptFunction::OPCODE_SET_MEMBER
+                            setter < 0
+                                ? GDScriptFunction::OPCODE_SET_MEMBER
+                                : GDScriptFunction::OPCODE_SET_MEMBER_NATIVE
                         );
                         codegen.opcodes.push_back(codegen.get_name_map_pos(name)
                         );
+                        if (setter >= 0) {
+                            codegen.opcodes.push_back(setter);
+                        }
                         codegen.opcodes.push_back(src_address);
 
                         return GDScriptFunction::ADDR_TYPE_NIL
@@ -2453,13 +2655,14 @@ Error GDScriptCompiler::_parse_function(
     Vector<int> bytecode;
     CodeGen codegen;
 
-    codegen.class_node    = p_class;
-    codegen.script        = p_script;
-    codegen.function_node = p_func;
-    codegen.stack_max     = 0;
-    codegen.current_line  = 0;
-    codegen.call_max      = 0;
-    codegen.debug_stack   = ScriptDebugger::get_singleton() != nullptr;
+    codegen.class_node         = p_class;
+    codegen.script             = p_script;
+    codegen.function_node      = p_func;
+    codegen.stack_max          = 0;
+    codegen.current_line       = 0;
+    codegen.call_max           = 0;
+    codegen.debug_stack        = ScriptDebugger::get_singleton() != nullptr;
+    codegen.inline_cache_count = 0;
     Vector<StringName> argnames;
 
     int stack_level = 0;
@@ -2604,6 +2807,18 @@ Error GDScriptCompiler::_parse_function(
         gdfunc->_constants_ptr  = nullptr;
         gdfunc->_constant_count = 0;
     }
+    // native methods
+    gdfunc->native_methods       = codegen.native_methods;
+    gdfunc->_native_methods_ptr  = gdfunc->native_methods.ptr();
+    gdfunc->_native_method_count = gdfunc->native_methods.size();
+    // inline caches
+    gdfunc->inline_caches.resize(codegen.inline_cache_count);
+    for (int i = 0; i < gdfunc->inline_caches.size(); i++) {
+        gdfunc->inline_caches.write[i].version = 0;
+        gdfunc->inline_caches.write[i].count   = 0;
+    }
+    gdfunc->_inline_caches_ptr  = gdfunc->inline_caches.ptrw();
+    gdfunc->_inline_cache_count = gdfunc->inline_caches.size();
     // global names
     if (codegen.name_map.size()) {
         gdfunc->global_names.resize(codegen.name_map.size());
@@ -2753,6 +2968,7 @@ Error GDScriptCompiler::_parse_class_level(
         memdelete(E->get());
     }
     p_script->member_functions.clear();
+    GDScriptLanguage::get_singleton()->invalidate_inline_caches();
     p_script->member_indices.clear();
     p_script->member_info.clear();
     p_script->_signals.clear();
@@ -98,6 +98,31 @@ class GDScriptCompiler {
             return pos;
         }
 
+        Vector<GDScriptFunction::NativeMethod> native_methods;
+
+        int get_native_method_pos(
+            const StringName& p_class,
+            MethodBind* p_method
+        ) {
+            for (int i = 0; i < native_methods.size(); i++) {
+                if (native_methods[i].method == p_method
+                    && native_methods[i].class_name == p_class) {
+                    return i;
+                }
+            }
+            GDScriptFunction::NativeMethod native_method;
+            native_method.class_name = p_class;
+            native_method.method     = p_method;
+            native_methods.push_back(native_method);
+            return native_methods.size() - 1;
+        }
+
+        int inline_cache_count;
+
+        int alloc_inline_cache() {
+            return inline_cache_count++;
+        }
+
         Vector<int> opcodes;
 
         void alloc_stack(int p_level) {
@@ -122,6 +147,23 @@ class GDScriptCompiler {
 
     void _set_error(const String& p_error, const GDScriptParser::Node* p_node);
 
+    StringName _get_native_class(const GDScript* p_script) const;
+    GDScriptFunction::Opcode _get_operator_opcode(
+        Variant::Operator p_op,
+        const GDScriptParser::DataType& p_a,
+        const GDScriptParser::DataType& p_b
+    ) const;
+    int _get_native_property_accessor(
+        CodeGen& codegen,
+        const StringName& p_name,
+        bool p_setter
+    );
+    int _get_native_call_method(
+        CodeGen& codegen,
+        const GDScriptParser::Node* p_base,
+        const StringName& p_method
+    );
+
     bool _create_unary_operator(
         CodeGen& codegen,
         const GDScriptParser::OperatorNode* on,
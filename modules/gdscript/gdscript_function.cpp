@@ -6,6 +6,7 @@
 
 #include "gdscript_function.h"
 
+#include "core/core_string_names.h"
 #include "core/os/os.h"
 #include "gdscript.h"
 #include "gdscript_functions.h"
@@ -200,10 +201,467 @@ String GDScriptFunction::_get_call_error(
     return err_text;
 }
 
+bool GDScriptFunction::_evaluate_operator(
+    Variant::Operator p_op,
+    const Variant* p_a,
+    const Variant* p_b,
+    Variant* r_dst,
+    String& r_error
+) const {
+    bool valid;
+#ifdef DEBUG_ENABLED
+    Variant ret;
+    Variant::evaluate(p_op, *p_a, *p_b, ret, valid);
+    if (!valid) {
+        if (ret.get_type() == Variant::STRING) {
+            // return a string when invalid with the error
+            r_error  = ret;
+            r_error += " in operator '" + Variant::get_operator_name(p_op)
+                     + "'.";
+        } else {
+            r_error = "Invalid operands '"
+                    + Variant::get_type_name(p_a->get_type()) + "' and '"
+                    + Variant::get_type_name(p_b->get_type())
+                    + "' in operator '" + Variant::get_operator_name(p_op)
+                    + "'.";
+        }
+        return false;
+    }
+    *r_dst = ret;
+#else
+    Variant::evaluate(p_op, *p_a, *p_b, *r_dst, valid);
+#endif
+    return true;
+}
+
+void GDScriptFunction::_set_bool(Variant* r_dst, bool p_value) {
+    if (r_dst->type == Variant::BOOL) {
+        r_dst->_data._bool = p_value;
+    } else {
+        *r_dst = p_value;
+    }
+}
+
+void GDScriptFunction::_set_int(Variant* r_dst, int64_t p_value) {
+    if (r_dst->type == Variant::INT) {
+        r_dst->_data._int = p_value;
+    } else {
+        *r_dst = p_value;
+    }
+}
+
+void GDScriptFunction::_set_real(Variant* r_dst, double p_value) {
+    if (r_dst->type == Variant::REAL) {
+        r_dst->_data._real = p_value;
+    } else {
+        *r_dst = p_value;
+    }
+}
+
+void GDScriptFunction::_set_vector2(Variant* r_dst, const Vector2& p_value) {
+    if (r_dst->type == Variant::VECTOR2) {
+        *reinterpret_cast<Vector2*>(r_dst->_data._mem) = p_value;
+    } else {
+        *r_dst = p_value;
+    }
+}
+
+void GDScriptFunction::_set_vector3(Variant* r_dst, const Vector3& p_value) {
+    if (r_dst->type == Variant::VECTOR3) {
+        *reinterpret_cast<Vector3*>(r_dst->_data._mem) = p_value;
+    } else {
+        *r_dst = p_value;
+    }
+}
+
+bool GDScriptFunction::_evaluate_int(
+    Variant::Operator p_op,
+    const Variant* p_a,
+    const Variant* p_b,
+    Variant* r_dst
+) {
+    if (p_a->type != Variant::INT || p_b->type != Variant::INT) {
+        return false;
+    }
+    const int64_t a = p_a->_data._int;
+    const int64_t b = p_b->_data._int;
+    switch (p_op) {
+        case Variant::OP_EQUAL: {
+            _set_bool(r_dst, a == b);
+        } break;
+        case Variant::OP_NOT_EQUAL: {
+            _set_bool(r_dst, a != b);
+        } break;
+        case Variant::OP_LESS: {
+            _set_bool(r_dst, a < b);
+        } break;
+        case Variant::OP_LESS_EQUAL: {
+            _set_bool(r_dst, a <= b);
+        } break;
+        case Variant::OP_GREATER: {
+            _set_bool(r_dst, a > b);
+        } break;
+        case Variant::OP_GREATER_EQUAL: {
+            _set_bool(r_dst, a >= b);
+        } break;
+        case Variant::OP_ADD: {
+            _set_int(r_dst, a + b);
+        } break;
+        case Variant::OP_SUBTRACT: {
+            _set_int(r_dst, a - b);
+        } break;
+        case Variant::OP_MULTIPLY: {
+            _set_int(r_dst, a * b);
+        } break;
+        default: {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GDScriptFunction::_evaluate_real(
+    Variant::Operator p_op,
+    const Variant* p_a,
+    const Variant* p_b,
+    Variant* r_dst
+) {
+    // Mixed operands give the same results as Variant::evaluate(), but two
+    // integers must use integer arithmetic.
+    double a;
+    double b;
+    if (p_a->type == Variant::REAL) {
+        a = p_a->_data._real;
+        if (p_b->type == Variant::REAL) {
+            b = p_b->_data._real;
+        } else if (p_b->type == Variant::INT) {
+            b = p_b->_data._int;
+        } else {
+            return false;
+        }
+    } else if (p_a->type == Variant::INT && p_b->type == Variant::REAL) {
+        a = p_a->_data._int;
+        b = p_b->_data._real;
+    } else {
+        return false;
+    }
+    switch (p_op) {
+        case Variant::OP_EQUAL: {
+            _set_bool(r_dst, a == b);
+        } break;
+        case Variant::OP_NOT_EQUAL: {
+            _set_bool(r_dst, a != b);
+        } break;
+        case Variant::OP_LESS: {
+            _set_bool(r_dst, a < b);
+        } break;
+        case Variant::OP_LESS_EQUAL: {
+            _set_bool(r_dst, a <= b);
+        } break;
+        case Variant::OP_GREATER: {
+            _set_bool(r_dst, a > b);
+        } break;
+        case Variant::OP_GREATER_EQUAL: {
+            _set_bool(r_dst, a >= b);
+        } break;
+        case Variant::OP_ADD: {
+            _set_real(r_dst, a + b);
+        } break;
+        case Variant::OP_SUBTRACT: {
+            _set_real(r_dst, a - b);
+        } break;
+        case Variant::OP_MULTIPLY: {
+            _set_real(r_dst, a * b);
+        } break;
+        case Variant::OP_DIVIDE: {
+            if (b == 0) {
+                // Leave the division by zero error to Variant::evaluate().
+                return false;
+            }
+            _set_real(r_dst, a / b);
+        } break;
+        default: {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GDScriptFunction::_evaluate_vector2(
+    Variant::Operator p_op,
+    const Variant* p_a,
+    const Variant* p_b,
+    Variant* r_dst
+) {
+    if (p_a->type != Variant::VECTOR2) {
+        return false;
+    }
+    const Vector2& a = *reinterpret_cast<const Vector2*>(p_a->_data._mem);
+    if (p_b->type == Variant::VECTOR2) {
+        const Vector2& b = *reinterpret_cast<const Vector2*>(p_b->_data._mem);
+        switch (p_op) {
+            case Variant::OP_EQUAL: {
+                _set_bool(r_dst, a == b);
+            } break;
+            case Variant::OP_NOT_EQUAL: {
+                _set_bool(r_dst, a != b);
+            } break;
+            case Variant::OP_ADD: {
+                _set_vector2(r_dst, a + b);
+            } break;
+            case Variant::OP_SUBTRACT: {
+                _set_vector2(r_dst, a - b);
+            } break;
+            case Variant::OP_MULTIPLY: {
+                _set_vector2(r_dst, a * b);
+            } break;
+            case Variant::OP_DIVIDE: {
+                _set_vector2(r_dst, a / b);
+            } break;
+            default: {
+                return false;
+            }
+        }
+        return true;
+    }
+    real_t b;
+    if (p_b->type == Variant::REAL) {
+        b = p_b->_data._real;
+    } else if (p_b->type == Variant::INT) {
+        b = p_b->_data._int;
+    } else {
+        return false;
+    }
+    switch (p_op) {
+        case Variant::OP_MULTIPLY: {
+            _set_vector2(r_dst, a * b);
+        } break;
+        case Variant::OP_DIVIDE: {
+            _set_vector2(r_dst, a / b);
+        } break;
+        default: {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GDScriptFunction::_evaluate_vector3(
+    Variant::Operator p_op,
+    const Variant* p_a,
+    const Variant* p_b,
+    Variant* r_dst
+) {
+    if (p_a->type != Variant::VECTOR3) {
+        return false;
+    }
+    const Vector3& a = *reinterpret_cast<const Vector3*>(p_a->_data._mem);
+    if (p_b->type == Variant::VECTOR3) {
+        const Vector3& b = *reinterpret_cast<const Vector3*>(p_b->_data._mem);
+        switch (p_op) {
+            case Variant::OP_EQUAL: {
+                _set_bool(r_dst, a == b);
+            } break;
+            case Variant::OP_NOT_EQUAL: {
+                _set_bool(r_dst, a != b);
+            } break;
+            case Variant::OP_ADD: {
+                _set_vector3(r_dst, a + b);
+            } break;
+            case Variant::OP_SUBTRACT: {
+                _set_vector3(r_dst, a - b);
+            } break;
+            case Variant::OP_MULTIPLY: {
+                _set_vector3(r_dst, a * b);
+            } break;
+            case Variant::OP_DIVIDE: {
+                _set_vector3(r_dst, a / b);
+            } break;
+            default: {
+                return false;
+            }
+        }
+        return true;
+    }
+    real_t b;
+    if (p_b->type == Variant::REAL) {
+        b = p_b->_data._real;
+    } else if (p_b->type == Variant::INT) {
+        b = p_b->_data._int;
+    } else {
+        return false;
+    }
+    switch (p_op) {
+        case Variant::OP_MULTIPLY: {
+            _set_vector3(r_dst, a * b);
+        } break;
+        case Variant::OP_DIVIDE: {
+            _set_vector3(r_dst, a / b);
+        } break;
+        default: {
+            return false;
+        }
+    }
+    return true;
+}
+
+MethodBind* GDScriptFunction::_get_native_method(
+    int p_index,
+    const Object* p_object
+) const {
+    const NativeMethod& native_method = _native_methods_ptr[p_index];
+    if (!p_object || p_object->get_class_name() != native_method.class_name) {
+        return nullptr;
+    }
+    return native_method.method;
+}
+
+GDScriptFunction::InlineCache::Entry* GDScriptFunction::_get_inline_cache(
+    int p_cache,
+    Object* p_object,
+    GDScript*& r_script
+) const {
+    // The caches aren't synchronized, so other threads don't use them.
+    if (Thread::get_caller_id() != Thread::get_main_id()) {
+        return nullptr;
+    }
+
+    r_script                 = nullptr;
+    ScriptInstance* instance = p_object->get_script_instance();
+    if (instance) {
+        if (instance->is_placeholder()
+            || instance->get_language() != GDScriptLanguage::get_singleton()) {
+            return nullptr;
+        }
+        r_script = static_cast<GDScriptInstance*>(instance)->script.ptr();
+    }
+
+    InlineCache& cache = _inline_caches_ptr[p_cache];
+    uint32_t version =
+        GDScriptLanguage::get_singleton()->get_inline_cache_version();
+    if (unlikely(cache.version != version)) {
+        cache.version = version;
+        cache.count   = 0;
+    }
+
+    const StringName& class_name = p_object->get_class_name();
+    for (int i = 0; i < cache.count; i++) {
+        InlineCache::Entry& entry = cache.entries[i];
+        if (entry.script == r_script && entry.class_name == class_name) {
+            return &entry;
+        }
+    }
+
+    if (cache.count == InlineCache::MAX_ENTRIES) {
+        return nullptr;
+    }
+    InlineCache::Entry& entry = cache.entries[cache.count];
+    entry.class_name          = class_name;
+    entry.script              = r_script;
+    entry.function            = nullptr;
+    entry.method              = nullptr;
+    entry.member              = -1;
+    return &entry;
+}
+
+GDScriptFunction::InlineCache::Entry* GDScriptFunction::_get_call_cache(
+    int p_cache,
+    Object* p_object,
+    const StringName& p_method
+) const {
+    GDScript* script;
+    InlineCache::Entry* entry = _get_inline_cache(p_cache, p_object, script);
+    if (!entry || entry->function || entry->method) {
+        return entry;
+    }
+
+    // Resolve the method the same way Object::call() does.
+    if (p_method == CoreStringNames::get_singleton()->_free) {
+        return nullptr;
+    }
+    while (script) {
+        const Map<StringName, GDScriptFunction*>::Element* E =
+            script->member_functions.find(p_method);
+        if (E) {
+            entry->function = E->get();
+            break;
+        }
+        script = script->_base;
+    }
+    if (!entry->function) {
+        entry->method = ClassDB::get_method(entry->class_name, p_method);
+        if (!entry->method) {
+            return nullptr;
+        }
+    }
+
+    _inline_caches_ptr[p_cache].count++;
+    return entry;
+}
+
+GDScriptFunction::InlineCache::Entry* GDScriptFunction::_get_named_cache(
+    int p_cache,
+    Object* p_object,
+    const StringName& p_name
+) const {
+    GDScript* script;
+    InlineCache::Entry* entry = _get_inline_cache(p_cache, p_object, script);
+    if (!entry || entry->member >= 0 || entry->method) {
+        return entry;
+    }
+
+    // Resolve the property the same way Object::get() does. Only script
+    // members without getters and native properties with getters are cached.
+    if (script) {
+        const Map<StringName, GDScript::MemberInfo>::Element* E =
+            script->member_indices.find(p_name);
+        if (E) {
+            if (E->get().getter) {
+                return nullptr;
+            }
+            entry->member = E->get().index;
+            _inline_caches_ptr[p_cache].count++;
+            return entry;
+        }
+        while (script) {
+            if (script->constants.has(p_name)
+                || script->member_functions.has(
+                    GDScriptLanguage::get_singleton()->strings._get
+                )) {
+                return nullptr;
+            }
+            script = script->_base;
+        }
+    }
+
+    ClassDB::ClassInfo* check = ClassDB::classes.getptr(entry->class_name);
+    while (check) {
+        const ClassDB::PropertySetGet* psg =
+            check->property_setget.getptr(p_name);
+        if (psg) {
+            if (!psg->_getptr || psg->index >= 0) {
+                return nullptr;
+            }
+            entry->method = psg->_getptr;
+            _inline_caches_ptr[p_cache].count++;
+            return entry;
+        }
+        if (check->constant_map.has(p_name)) {
+            return nullptr;
+        }
+        check = check->inherits_ptr;
+    }
+    return nullptr;
+}
+
 #if defined(__GNUC__)
 #define OPCODES_TABLE                                                          \
     static const void* switch_table_ops[] = {                                  \
         &&OPCODE_OPERATOR,                                                     \
+        &&OPCODE_OPERATOR_INT,                                                 \
+        &&OPCODE_OPERATOR_REAL,                                                \
+        &&OPCODE_OPERATOR_VECTOR2,                                             \
+        &&OPCODE_OPERATOR_VECTOR3,                                             \
         &&OPCODE_EXTENDS_TEST,                                                 \
         &&OPCODE_IS_BUILTIN,                                                   \
         &&OPCODE_SET,                                                          \
@@ -212,6 +670,8 @@ String GDScriptFunction::_get_call_error(
         &&OPCODE_GET_NAMED,                                                    \
         &&OPCODE_SET_MEMBER,                                                   \
         &&OPCODE_GET_MEMBER,                                                   \
+        &&OPCODE_SET_MEMBER_NATIVE,                                            \
+        &&OPCODE_GET_MEMBER_NATIVE,                                            \
         &&OPCODE_ASSIGN,                                                       \
         &&OPCODE_ASSIGN_TRUE,                                                  \
         &&OPCODE_ASSIGN_FALSE,                                                 \
@@ -226,6 +686,8 @@ String GDScriptFunction::_get_call_error(
         &&OPCODE_CONSTRUCT_DICTIONARY,                                         \
         &&OPCODE_CALL,                                                         \
         &&OPCODE_CALL_RETURN,                                                  \
+        &&OPCODE_CALL_NATIVE,                                                  \
+        &&OPCODE_CALL_NATIVE_RETURN,                                           \
         &&OPCODE_CALL_BUILT_IN,                                                \
         &&OPCODE_CALL_SELF,                                                    \
         &&OPCODE_CALL_SELF_BASE,                                               \
@@ -481,7 +943,6 @@ Variant GDScriptFunction::call(
             OPCODE(OPCODE_OPERATOR) {
                 CHECK_SPACE(5);
 
-                bool valid;
                 Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
                 GD_ERR_BREAK(op >= Variant::OP_MAX);
 
@@ -489,32 +950,81 @@ Variant GDScriptFunction::call(
                 GET_VARIANT_PTR(b, 3);
                 GET_VARIANT_PTR(dst, 4);
 
-#ifdef DEBUG_ENABLED
+                if (!_evaluate_operator(op, a, b, dst, err_text)) {
+                    OPCODE_BREAK;
+                }
+                ip += 5;
+            }
+            DISPATCH_OPCODE;
 
-                Variant ret;
-                Variant::evaluate(op, *a, *b, ret, valid);
-#else
-                Variant::evaluate(op, *a, *b, *dst, valid);
-#endif
-#ifdef DEBUG_ENABLED
-                if (!valid) {
-                    if (ret.get_type() == Variant::STRING) {
-                        // return a string when invalid with the error
-                        err_text  = ret;
-                        err_text += " in operator '"
-                                  + Variant::get_operator_name(op) + "'.";
-                    } else {
-                        err_text = "Invalid operands '"
-                                 + Variant::get_type_name(a->get_type())
-                                 + "' and '"
-                                 + Variant::get_type_name(b->get_type())
-                                 + "' in operator '"
-                                 + Variant::get_operator_name(op) + "'.";
-                    }
+            OPCODE(OPCODE_OPERATOR_INT) {
+                CHECK_SPACE(5);
+
+                Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
+                GD_ERR_BREAK(op >= Variant::OP_MAX);
+
+                GET_VARIANT_PTR(a, 2);
+                GET_VARIANT_PTR(b, 3);
+                GET_VARIANT_PTR(dst, 4);
+
+                if (unlikely(!_evaluate_int(op, a, b, dst))
+                    && !_evaluate_operator(op, a, b, dst, err_text)) {
+                    OPCODE_BREAK;
+                }
+                ip += 5;
+            }
+            DISPATCH_OPCODE;
+
+            OPCODE(OPCODE_OPERATOR_REAL) {
+                CHECK_SPACE(5);
+
+                Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
+                GD_ERR_BREAK(op >= Variant::OP_MAX);
+
+                GET_VARIANT_PTR(a, 2);
+                GET_VARIANT_PTR(b, 3);
+                GET_VARIANT_PTR(dst, 4);
+
+                if (unlikely(!_evaluate_real(op, a, b, dst))
+                    && !_evaluate_operator(op, a, b, dst, err_text)) {
+                    OPCODE_BREAK;
+                }
+                ip += 5;
+            }
+            DISPATCH_OPCODE;
+
+            OPCODE(OPCODE_OPERATOR_VECTOR2) {
+                CHECK_SPACE(5);
+
+                Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
+                GD_ERR_BREAK(op >= Variant::OP_MAX);
+
+                GET_VARIANT_PTR(a, 2);
+                GET_VARIANT_PTR(b, 3);
+                GET_VARIANT_PTR(dst, 4);
+
+                if (unlikely(!_evaluate_vector2(op, a, b, dst))
+                    && !_evaluate_operator(op, a, b, dst, err_text)) {
+                    OPCODE_BREAK;
+                }
+                ip += 5;
+            }
+            DISPATCH_OPCODE;
+
+            OPCODE(OPCODE_OPERATOR_VECTOR3) {
+                CHECK_SPACE(5);
+
+                Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
+                GD_ERR_BREAK(op >= Variant::OP_MAX);
+
+                GET_VARIANT_PTR(a, 2);
+                GET_VARIANT_PTR(b, 3);
+                GET_VARIANT_PTR(dst, 4);
+
+                if (unlikely(!_evaluate_vector3(op, a, b, dst))
+                    && !_evaluate_operator(op, a, b, dst, err_text)) {
                     OPCODE_BREAK;
                 }
-                *dst = ret;
-#endif
                 ip += 5;
             }
             DISPATCH_OPCODE;
@@ -703,16 +1213,43 @@ Variant GDScriptFunction::call(
             DISPATCH_OPCODE;
 
             OPCODE(OPCODE_GET_NAMED) {
-                CHECK_SPACE(4);
+                CHECK_SPACE(5);
 
                 GET_VARIANT_PTR(src, 1);
-                GET_VARIANT_PTR(dst, 3);
+                GET_VARIANT_PTR(dst, 4);
 
                 int indexname = _code_ptr[ip + 2];
 
                 GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
                 const StringName* index = &_global_names_ptr[indexname];
 
+                int cache = _code_ptr[ip + 3];
+                GD_ERR_BREAK(cache < 0 || cache >= _inline_cache_count);
+
+                Object* object = src->get_type() == Variant::OBJECT
+                                   ? src->operator Object*()
+                                   : nullptr;
+                const InlineCache::Entry* entry =
+                    object ? _get_named_cache(cache, object, *index) : nullptr;
+                if (likely(entry)) {
+                    // Read into a temporary in case src and dst are the same
+                    // stack position.
+                    Variant ret;
+                    if (entry->method) {
+                        Variant::CallError err;
+                        ret = entry->method->call(object, nullptr, 0, err);
+                    } else {
+                        GDScriptInstance* instance =
+                            static_cast<GDScriptInstance*>(
+                                object->get_script_instance()
+                            );
+                        ret = instance->members[entry->member];
+                    }
+                    *dst = ret;
+                    ip += 5;
+                    DISPATCH_OPCODE;
+                }
+
                 bool valid;
 #ifdef DEBUG_ENABLED
                 // allow better error message in cases where src and dst are the
@@ -740,7 +1277,7 @@ Variant GDScriptFunction::call(
                 }
                 *dst = ret;
 #endif
-                ip += 4;
+                ip += 5;
             }
             DISPATCH_OPCODE;
 
@@ -798,6 +1335,92 @@ Variant GDScriptFunction::call(
             }
             DISPATCH_OPCODE;
 
+            OPCODE(OPCODE_SET_MEMBER_NATIVE) {
+                CHECK_SPACE(4);
+                int indexname = _code_ptr[ip + 1];
+                GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+                const StringName* index = &_global_names_ptr[indexname];
+                int native = _code_ptr[ip + 2];
+                GD_ERR_BREAK(native < 0 || native >= _native_method_count);
+                GET_VARIANT_PTR(src, 3);
+
+                bool valid;
+                MethodBind* setter =
+                    _get_native_method(native, p_instance->owner);
+                if (likely(setter)) {
+                    Variant::CallError err;
+                    setter->call(
+                        p_instance->owner,
+                        (const Variant**)&src,
+                        1,
+                        err
+                    );
+                    valid = err.error == Variant::CallError::CALL_OK;
+                } else {
+#ifndef DEBUG_ENABLED
+                    ClassDB::set_property(
+                        p_instance->owner,
+                        *index,
+                        *src,
+                        &valid
+                    );
+#else
+                    bool ok = ClassDB::set_property(
+                        p_instance->owner,
+                        *index,
+                        *src,
+                        &valid
+                    );
+                    if (!ok) {
+                        err_text = "Internal error setting property: "
+                                 + String(*index);
+                        OPCODE_BREAK;
+                    }
+#endif
+                }
+#ifdef DEBUG_ENABLED
+                if (!valid) {
+                    err_text = "Error setting property '" + String(*index)
+                             + "' with value of type "
+                             + Variant::get_type_name(src->get_type()) + ".";
+                    OPCODE_BREAK;
+                }
+#endif
+                ip += 4;
+            }
+            DISPATCH_OPCODE;
+
+            OPCODE(OPCODE_GET_MEMBER_NATIVE) {
+                CHECK_SPACE(4);
+                int indexname = _code_ptr[ip + 1];
+                GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+                const StringName* index = &_global_names_ptr[indexname];
+                int native = _code_ptr[ip + 2];
+                GD_ERR_BREAK(native < 0 || native >= _native_method_count);
+                GET_VARIANT_PTR(dst, 3);
+
+                MethodBind* getter =
+                    _get_native_method(native, p_instance->owner);
+                if (likely(getter)) {
+                    Variant::CallError err;
+                    *dst = getter->call(p_instance->owner, nullptr, 0, err);
+                } else {
+#ifndef DEBUG_ENABLED
+                    ClassDB::get_property(p_instance->owner, *index, *dst);
+#else
+                    bool ok =
+                        ClassDB::get_property(p_instance->owner, *index, *dst);
+                    if (!ok) {
+                        err_text = "Internal error getting property: "
+                                 + String(*index);
+                        OPCODE_BREAK;
+                    }
+#endif
+                }
+                ip += 4;
+            }
+            DISPATCH_OPCODE;
+
             OPCODE(OPCODE_ASSIGN) {
                 CHECK_SPACE(3);
                 GET_VARIANT_PTR(dst, 1);
@@ -1176,7 +1799,7 @@ Variant GDScriptFunction::call(
 
             OPCODE(OPCODE_CALL_RETURN)
             OPCODE(OPCODE_CALL) {
-                CHECK_SPACE(4);
+                CHECK_SPACE(5);
                 bool call_ret = _code_ptr[ip] == OPCODE_CALL_RETURN;
 
                 int argc = _code_ptr[ip + 1];
@@ -1186,8 +1809,11 @@ Variant GDScriptFunction::call(
                 GD_ERR_BREAK(nameg < 0 || nameg >= _global_names_count);
                 const StringName* methodname = &_global_names_ptr[nameg];
 
+                int cache = _code_ptr[ip + 4];
+                GD_ERR_BREAK(cache < 0 || cache >= _inline_cache_count);
+
                 GD_ERR_BREAK(argc < 0);
-                ip += 4;
+                ip += 5;
                 CHECK_SPACE(argc + 1);
                 Variant** argptrs = call_args;
 
@@ -1204,8 +1830,41 @@ Variant GDScriptFunction::call(
                 }
 
 #endif
+                Object* object = base->get_type() == Variant::OBJECT
+                                   ? base->operator Object*()
+                                   : nullptr;
+                const InlineCache::Entry* entry =
+                    object ? _get_call_cache(cache, object, *methodname)
+                           : nullptr;
+
                 Variant::CallError err;
-                if (call_ret) {
+                if (likely(entry)) {
+#ifdef DEBUG_ENABLED
+                    _ObjectDebugLock debug_lock(object);
+#endif
+                    Variant result;
+                    if (entry->function) {
+                        result = entry->function->call(
+                            static_cast<GDScriptInstance*>(
+                                object->get_script_instance()
+                            ),
+                            (const Variant**)argptrs,
+                            argc,
+                            err
+                        );
+                    } else {
+                        result = entry->method->call(
+                            object,
+                            (const Variant**)argptrs,
+                            argc,
+                            err
+                        );
+                    }
+                    if (call_ret && err.error == Variant::CallError::CALL_OK) {
+                        GET_VARIANT_PTR(ret, argc);
+                        *ret = result;
+                    }
+                } else if (call_ret) {
                     GET_VARIANT_PTR(ret, argc);
                     base->call_ptr(
                         *methodname,
@@ -1282,6 +1941,133 @@ Variant GDScriptFunction::call(
             }
             DISPATCH_OPCODE;
 
+            OPCODE(OPCODE_CALL_NATIVE_RETURN)
+            OPCODE(OPCODE_CALL_NATIVE) {
+                CHECK_SPACE(6);
+                bool call_ret = _code_ptr[ip] == OPCODE_CALL_NATIVE_RETURN;
+
+                int argc = _code_ptr[ip + 1];
+                GET_VARIANT_PTR(base, 2);
+                int nameg = _code_ptr[ip + 3];
+
+                GD_ERR_BREAK(nameg < 0 || nameg >= _global_names_count);
+                const StringName* methodname = &_global_names_ptr[nameg];
+
+                int native = _code_ptr[ip + 4];
+                GD_ERR_BREAK(native < 0 || native >= _native_method_count);
+
+                int cache = _code_ptr[ip + 5];
+                GD_ERR_BREAK(cache < 0 || cache >= _inline_cache_count);
+
+                GD_ERR_BREAK(argc < 0);
+                ip += 6;
+                CHECK_SPACE(argc + 1);
+                Variant** argptrs = call_args;
+
+                for (int i = 0; i < argc; i++) {
+                    GET_VARIANT_PTR(v, i);
+                    argptrs[i] = v;
+                }
+
+#ifdef DEBUG_ENABLED
+                uint64_t call_time = 0;
+
+                if (GDScriptLanguage::get_singleton()->profiling) {
+                    call_time = OS::get_singleton()->get_ticks_usec();
+                }
+
+#endif
+                // Methods of the object's script take precedence over native
+                // methods, so the method of an object with a script is
+                // resolved through the call site's inline cache. It's called
+                // by name when it can't be cached.
+                Object* object = base->get_type() == Variant::OBJECT
+                                   ? base->operator Object*()
+                                   : nullptr;
+                MethodBind* method         = _get_native_method(native, object);
+                GDScriptFunction* function = nullptr;
+                if (method && object->get_script_instance()) {
+                    const InlineCache::Entry* entry =
+                        _get_call_cache(cache, object, *methodname);
+                    method   = entry ? entry->method : nullptr;
+                    function = entry ? entry->function : nullptr;
+                }
+
+                Variant::CallError err;
+                if (likely(method)) {
+#ifdef DEBUG_ENABLED
+                    _ObjectDebugLock debug_lock(object);
+#endif
+                    if (call_ret) {
+                        GET_VARIANT_PTR(ret, argc);
+                        *ret = method->call(
+                            object,
+                            (const Variant**)argptrs,
+                            argc,
+                            err
+                        );
+                    } else {
+                        method->call(
+                            object,
+                            (const Variant**)argptrs,
+                            argc,
+                            err
+                        );
+                    }
+                } else if (function) {
+#ifdef DEBUG_ENABLED
+                    _ObjectDebugLock debug_lock(object);
+#endif
+                    Variant result = function->call(
+                        static_cast<GDScriptInstance*>(
+                            object->get_script_instance()
+                        ),
+                        (const Variant**)argptrs,
+                        argc,
+                        err
+                    );
+                    if (call_ret && err.error == Variant::CallError::CALL_OK) {
+                        GET_VARIANT_PTR(ret, argc);
+                        *ret = result;
+                    }
+                } else if (call_ret) {
+                    GET_VARIANT_PTR(ret, argc);
+                    base->call_ptr(
+                        *methodname,
+                        (const Variant**)argptrs,
+                        argc,
+                        ret,
+                        err
+                    );
+                } else {
+                    base->call_ptr(
+                        *methodname,
+                        (const Variant**)argptrs,
+                        argc,
+                        nullptr,
+                        err
+                    );
+                }
+#ifdef DEBUG_ENABLED
+                if (GDScriptLanguage::get_singleton()->profiling) {
+                    function_call_time +=
+                        OS::get_singleton()->get_ticks_usec() - call_time;
+                }
+
+                if (err.error != Variant::CallError::CALL_OK) {
+                    err_text = _get_call_error(
+                        err,
+                        "function '" + String(*methodname) + "' in base '"
+                            + _get_var_type(base) + "'",
+                        (const Variant**)argptrs
+                    );
+                    OPCODE_BREAK;
+                }
+#endif
+                ip += argc + 1;
+            }
+            DISPATCH_OPCODE;
+
             OPCODE(OPCODE_CALL_BUILT_IN) {
                 CHECK_SPACE(4);
 
@@ -1981,9 +2767,13 @@ void GDScriptFunction::debug_get_stack_member_state(
 }
 
 GDScriptFunction::GDScriptFunction() {
-    _stack_size = 0;
-    _call_size  = 0;
-    rpc_mode    = MultiplayerAPI::RPC_MODE_DISABLED;
+    _stack_size          = 0;
+    _call_size           = 0;
+    _native_methods_ptr  = nullptr;
+    _native_method_count = 0;
+    _inline_caches_ptr   = nullptr;
+    _inline_cache_count  = 0;
+    rpc_mode             = MultiplayerAPI::RPC_MODE_DISABLED;
     name        = "<anonymous>";
 #ifdef DEBUG_ENABLED
     _func_cname = nullptr;
@@ -149,6 +149,10 @@ class GDScriptFunction {
 public:
     enum Opcode {
         OPCODE_OPERATOR,
+        OPCODE_OPERATOR_INT,
+        OPCODE_OPERATOR_REAL,
+        OPCODE_OPERATOR_VECTOR2,
+        OPCODE_OPERATOR_VECTOR3,
         OPCODE_EXTENDS_TEST,
         OPCODE_IS_BUILTIN,
         OPCODE_SET,
@@ -157,6 +161,8 @@ public:
         OPCODE_GET_NAMED,
         OPCODE_SET_MEMBER,
         OPCODE_GET_MEMBER,
+        OPCODE_SET_MEMBER_NATIVE,
+        OPCODE_GET_MEMBER_NATIVE,
         OPCODE_ASSIGN,
         OPCODE_ASSIGN_TRUE,
         OPCODE_ASSIGN_FALSE,
@@ -171,6 +177,8 @@ public:
         OPCODE_CONSTRUCT_DICTIONARY,
         OPCODE_CALL,
         OPCODE_CALL_RETURN,
+        OPCODE_CALL_NATIVE,
+        OPCODE_CALL_NATIVE_RETURN,
         OPCODE_CALL_BUILT_IN,
         OPCODE_CALL_SELF,
         OPCODE_CALL_SELF_BASE,
@@ -213,6 +221,34 @@ public:
         StringName identifier;
     };
 
+    // A native method resolved by the compiler from the static type of the
+    // base. It's only called directly on objects of exactly that class.
+    struct NativeMethod {
+        StringName class_name;
+        MethodBind* method;
+    };
+
+    // Remembers how a call site or named get was resolved for the last
+    // receiver classes it has seen. Once all the entries are in use, other
+    // receivers are resolved by name every time.
+    struct InlineCache {
+        enum {
+            MAX_ENTRIES = 4
+        };
+
+        struct Entry {
+            StringName class_name;
+            GDScript* script;
+            GDScriptFunction* function;
+            MethodBind* method;
+            int member;
+        };
+
+        uint32_t version;
+        int count;
+        Entry entries[MAX_ENTRIES];
+    };
+
 private:
     friend class GDScriptCompiler;
 
@@ -227,6 +263,10 @@ private:
     const StringName* _named_globals_ptr;
     int _named_globals_count;
 #endif
+    const NativeMethod* _native_methods_ptr;
+    int _native_method_count;
+    mutable InlineCache* _inline_caches_ptr;
+    int _inline_cache_count;
     const int* _default_arg_ptr;
     int _default_arg_count;
     const int* _code_ptr;
@@ -246,6 +286,8 @@ private:
 #ifdef TOOLS_ENABLED
     Vector<StringName> named_globals;
 #endif
+    Vector<NativeMethod> native_methods;
+    Vector<InlineCache> inline_caches;
     Vector<int> default_arguments;
     Vector<int> code;
     Vector<GDScriptDataType> argument_types;
@@ -266,6 +308,72 @@ private:
         Variant* p_stack,
         String& r_error
     ) const;
+    _FORCE_INLINE_ bool _evaluate_operator(
+        Variant::Operator p_op,
+        const Variant* p_a,
+        const Variant* p_b,
+        Variant* r_dst,
+        String& r_error
+    ) const;
+    static _FORCE_INLINE_ void _set_bool(Variant* r_dst, bool p_value);
+    static _FORCE_INLINE_ void _set_int(Variant* r_dst, int64_t p_value);
+    static _FORCE_INLINE_ void _set_real(Variant* r_dst, double p_value);
+    static _FORCE_INLINE_ void _set_vector2(
+        Variant* r_dst,
+        const Vector2& p_value
+    );
+    static _FORCE_INLINE_ void _set_vector3(
+        Variant* r_dst,
+        const Vector3& p_value
+    );
+    // The typed operators return false when the operands don't have the types
+    // they are specialized for, so the generic operator is used instead. Only
+    // binary operators are specialized.
+    static _FORCE_INLINE_ bool _evaluate_int(
+        Variant::Operator p_op,
+        const Variant* p_a,
+        const Variant* p_b,
+        Variant* r_dst
+    );
+    static _FORCE_INLINE_ bool _evaluate_real(
+        Variant::Operator p_op,
+        const Variant* p_a,
+        const Variant* p_b,
+        Variant* r_dst
+    );
+    static _FORCE_INLINE_ bool _evaluate_vector2(
+        Variant::Operator p_op,
+        const Variant* p_a,
+        const Variant* p_b,
+        Variant* r_dst
+    );
+    static _FORCE_INLINE_ bool _evaluate_vector3(
+        Variant::Operator p_op,
+        const Variant* p_a,
+        const Variant* p_b,
+        Variant* r_dst
+    );
+    _FORCE_INLINE_ MethodBind* _get_native_method(
+        int p_index,
+        const Object* p_object
+    ) const;
+    // Return the entry of the inline cache for p_object, or nullptr when the
+    // call or get must be resolved by name.
+    InlineCache::Entry* _get_inline_cache(
+        int p_cache,
+        Object* p_object,
+        GDScript*& r_script
+    ) const;
+    InlineCache::Entry* _get_call_cache(
+        int p_cache,
+        Object* p_object,
+        const StringName& p_method
+    ) const;
+    InlineCache::Entry* _get_named_cache(
+        int p_cache,
+        Object* p_object,
+        const StringName& p_name
+    ) const;
     _FORCE_INLINE_ String _get_call_error(
         const Variant::CallError& p_err,
         const String& p_where,
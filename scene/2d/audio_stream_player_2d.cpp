@@ -10,6 +10,7 @@
 #include "scene/2d/area_2d.h"
 #include "scene/2d/listener_2d.h"
 #include "scene/main/viewport.h"
+#include "servers/audio/audio_mix_kernels.h"
 
 void AudioStreamPlayer2D::_mix_audio() {
     if (!stream_playback.is_valid() || !active.is_set()
@@ -66,7 +67,6 @@ void AudioStreamPlayer2D::_mix_audio() {
         AudioFrame vol_prev =
             stream_paused_fade_in ? AudioFrame(0.f, 0.f) : prev_outputs[i].vol;
         AudioFrame vol_inc = (target_volume - vol_prev) / float(buffer_size);
-        AudioFrame vol     = vol_prev;
 
         int cc = AudioServer::get_singleton()->get_channel_count();
 
@@ -82,10 +82,13 @@ void AudioStreamPlayer2D::_mix_audio() {
                     0
                 );
 
-            for (int j = 0; j < buffer_size; j++) {
-                target[j] += buffer[j] * vol;
-                vol       += vol_inc;
-            }
+            AudioMixKernels::mix_ramp(
+                target,
+                buffer,
+                buffer_size,
+                vol_prev,
+                vol_inc
+            );
 
         } else {
             AudioFrame* targets[4];
@@ -112,12 +115,14 @@ void AudioStreamPlayer2D::_mix_audio() {
                 continue;
             }
 
-            for (int j = 0; j < buffer_size; j++) {
-                AudioFrame frame = buffer[j] * vol;
-                for (int k = 0; k < cc; k++) {
-                    targets[k][j] += frame;
-                }
-                vol += vol_inc;
+            for (int k = 0; k < cc; k++) {
+                AudioMixKernels::mix_ramp(
+                    targets[k],
+                    buffer,
+                    buffer_size,
+                    vol_prev,
+                    vol_inc
+                );
             }
         }
 
@@ -7,8 +7,11 @@
 #include "cpu_particles_2d.h"
 
 #include "core/core_string_names.h"
+#include "core/math/random_pcg.h"
 #include "scene/2d/canvas_item.h"
 #include "scene/2d/particles_2d.h"
+#include "scene/main/cpu_particles_kernels.h"
+#include "scene/main/cpu_particles_work_pool.h"
 #include "scene/resources/particles_material.h"
 #include "servers/visual_server.h"
 
@@ -41,6 +44,16 @@ void CPUParticles2D::set_amount(int p_amount) {
         // method per item but the generated code will be far less efficient.
     }
 
+    for (int c = 0; c < COMPONENTS; c++) {
+        transforms[c].resize(p_amount);
+        memset(transforms[c].ptr(), 0, p_amount * sizeof(float));
+    }
+    for (int axis = 0; axis < 2; axis++) {
+        velocities[axis].resize(p_amount);
+        memset(velocities[axis].ptr(), 0, p_amount * sizeof(float));
+    }
+    steps.resize(p_amount);
+
     particle_data.resize((8 + 4 + 1) * p_amount);
     VS::get_singleton()->multimesh_allocate(
         multimesh,
@@ -632,8 +645,6 @@ void CPUParticles2D::_particles_process(float p_delta) {
     int pcount                    = particles.size();
     PoolVector<Particle>::Write w = particles.write();
 
-    Particle* parray = w.ptr();
-
     float prev_time  = time;
     time            += p_delta;
     if (time > lifetime) {
@@ -645,24 +656,75 @@ void CPUParticles2D::_particles_process(float p_delta) {
         }
     }
 
-    Transform2D emission_xform;
-    Transform2D velocity_xform;
+    ProcessState& s  = process_state;
+    s.delta          = p_delta;
+    s.prev_time      = prev_time;
+    s.system_phase   = time / lifetime;
+    s.seed           = Math::rand();
+    s.particles      = w.ptr();
+    s.particle_count = pcount;
+    for (int c = 0; c < COMPONENTS; c++) {
+        s.transforms[c] = transforms[c].ptr();
+    }
+    for (int axis = 0; axis < 2; axis++) {
+        s.velocities[axis] = velocities[axis].ptr();
+    }
+    s.steps = steps.ptr();
     if (!local_coords) {
-        emission_xform    = get_global_transform();
-        velocity_xform    = emission_xform;
-        velocity_xform[2] = Vector2();
+        s.emission_xform    = get_global_transform();
+        s.velocity_xform    = s.emission_xform;
+        s.velocity_xform[2] = Vector2();
     }
 
-    float system_phase = time / lifetime;
+    PoolVector<Vector2>::Read points_read  = emission_points.read();
+    PoolVector<Vector2>::Read normals_read = emission_normals.read();
+    PoolVector<Color>::Read colors_read    = emission_colors.read();
+    s.points                               = points_read.ptr();
+    s.normals                              = normals_read.ptr();
+    s.colors                               = colors_read.ptr();
+
+    // Sorts the gradient's points, so the chunks only read the gradient.
+    if (color_ramp.is_valid()) {
+        color_ramp->get_color_at_offset(0.0);
+    }
+
+    uint32_t chunks = (pcount + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    CPUParticlesWorkPool::get_singleton()->do_work(
+        chunks,
+        this,
+        &CPUParticles2D::_process_chunk,
+        nullptr
+    );
+}
+
+void CPUParticles2D::_process_chunk(uint32_t p_chunk, void* p_userdata) {
+    const ProcessState& state         = process_state;
+    const float delta                 = state.delta;
+    const float prev_time             = state.prev_time;
+    const float system_phase          = state.system_phase;
+    const Transform2D& emission_xform = state.emission_xform;
+    const Transform2D& velocity_xform = state.velocity_xform;
+    const int pcount                  = state.particle_count;
+    Particle* parray                  = state.particles;
+    float* const* components          = state.transforms;
+    float* const* velocities          = state.velocities;
+    float* steps                      = state.steps;
 
-    for (int i = 0; i < pcount; i++) {
+    int from = p_chunk * CHUNK_SIZE;
+    int to   = MIN(from + (int)CHUNK_SIZE, pcount);
+
+    for (int i = from; i < to; i++) {
         Particle& p = parray[i];
+        steps[i]    = 0.0;
 
         if (!emitting && !p.active) {
             continue;
         }
 
-        float local_delta = p_delta;
+        float local_delta     = delta;
+        Transform2D transform =
+            CPUParticlesKernels::load_transform_2d(components, i);
+        Vector2 velocity(velocities[0][i], velocities[1][i]);
 
         // The phase is a ratio between 0 (birth) and 1 (end of life) for each
         // particle. While we use time in tests later on, for randomness we use
@@ -741,21 +803,25 @@ void CPUParticles2D::_particles_process(float p_delta) {
                     curve_parameters[PARAM_ANGLE]->interpolate(tv);
             }
 
-            p.seed = Math::rand();
+            // Every particle draws from its own sequence, so the result
+            // doesn't depend on which thread processes it.
+            RandomPCG rng(((uint64_t)state.seed << 32) | uint32_t(i));
+
+            p.seed = rng.rand();
 
-            p.angle_rand       = Math::randf();
-            p.scale_rand       = Math::randf();
-            p.hue_rot_rand     = Math::randf();
-            p.anim_offset_rand = Math::randf();
+            p.angle_rand       = rng.randf();
+            p.scale_rand       = rng.randf();
+            p.hue_rot_rand     = rng.randf();
+            p.anim_offset_rand = rng.randf();
 
             float angle1_rad =
                 Math::atan2(direction.y, direction.x)
-                + (Math::randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
+                + (rng.randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
             Vector2 rot = Vector2(Math::cos(angle1_rad), Math::sin(angle1_rad));
-            p.velocity  = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY]
+            velocity    = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY]
                        * Math::lerp(
                              1.0f,
-                             float(Math::randf()),
+                             float(rng.randf()),
                              randomness[PARAM_INITIAL_LINEAR_VELOCITY]
                        );
 
@@ -773,9 +839,9 @@ void CPUParticles2D::_particles_process(float p_delta) {
                               randomness[PARAM_ANIM_OFFSET]
                         ); // animation phase [0..1]
             p.custom[3] = 0.0;
-            p.transform = Transform2D();
+            transform   = Transform2D();
             p.time      = 0;
-            p.lifetime = lifetime * (1.0 - Math::randf() * lifetime_randomness);
+            p.lifetime = lifetime * (1.0 - rng.randf() * lifetime_randomness);
             p.base_color = Color(1, 1, 1, 1);
 
             switch (emission_shape) {
@@ -783,18 +849,17 @@ void CPUParticles2D::_particles_process(float p_delta) {
                     // do none
                 } break;
                 case EMISSION_SHAPE_SPHERE: {
-                    float s = Math::randf(), t = 2.0 * Math_PI * Math::randf();
+                    float s = rng.randf(), t = 2.0 * Math_PI * rng.randf();
                     float radius =
                         emission_sphere_radius * Math::sqrt(1.0 - s * s);
-                    p.transform[2] =
-                        Vector2(Math::cos(t), Math::sin(t)) * radius;
+                    transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
                 } break;
                 case EMISSION_SHAPE_RECTANGLE: {
-                    p.transform[2] = Vector2(
-                                         Math::randf() * 2.0 - 1.0,
-                                         Math::randf() * 2.0 - 1.0
-                                     )
-                                   * emission_rect_extents;
+                    transform[2] = Vector2(
+                                       rng.randf() * 2.0 - 1.0,
+                                       rng.randf() * 2.0 - 1.0
+                                   )
+                                 * emission_rect_extents;
                 } break;
                 case EMISSION_SHAPE_POINTS:
                 case EMISSION_SHAPE_DIRECTED_POINTS: {
@@ -803,21 +868,21 @@ void CPUParticles2D::_particles_process(float p_delta) {
                         break;
                     }
 
-                    int random_idx = Math::rand() % pc;
+                    int random_idx = rng.rand() % pc;
 
-                    p.transform[2] = emission_points.get(random_idx);
+                    transform[2] = state.points[random_idx];
 
                     if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS
                         && emission_normals.size() == pc) {
-                        Vector2 normal = emission_normals.get(random_idx);
+                        Vector2 normal = state.normals[random_idx];
                         Transform2D m2;
                         m2.set_axis(0, normal);
                         m2.set_axis(1, normal.tangent());
-                        p.velocity = m2.basis_xform(p.velocity);
+                        velocity = m2.basis_xform(velocity);
                     }
 
                     if (emission_colors.size() == pc) {
-                        p.base_color = emission_colors.get(random_idx);
+                        p.base_color = state.colors[random_idx];
                     }
                 } break;
                 case EMISSION_SHAPE_MAX: { // Max value for validity check.
@@ -826,8 +891,8 @@ void CPUParticles2D::_particles_process(float p_delta) {
             }
 
             if (!local_coords) {
-                p.velocity  = velocity_xform.xform(p.velocity);
-                p.transform = emission_xform * p.transform;
+                velocity  = velocity_xform.xform(velocity);
+                transform = emission_xform * transform;
             }
 
         } else if (!p.active) {
@@ -901,12 +966,12 @@ void CPUParticles2D::_particles_process(float p_delta) {
             }
 
             Vector2 force = gravity;
-            Vector2 pos   = p.transform[2];
+            Vector2 pos   = transform[2];
 
             // apply linear acceleration
             force +=
-                p.velocity.length() > 0.0
-                    ? p.velocity.normalized()
+                velocity.length() > 0.0
+                    ? velocity.normalized()
                           * (parameters[PARAM_LINEAR_ACCEL] + tex_linear_accel)
                           * Math::lerp(
                               1.0f,
@@ -940,7 +1005,7 @@ void CPUParticles2D::_particles_process(float p_delta) {
                                 ))
                             : Vector2();
             // apply attractor forces
-            p.velocity += force * local_delta;
+            velocity += force * local_delta;
             // orbit velocity
             float orbit_amount =
                 (parameters[PARAM_ORBIT_VELOCITY] + tex_orbit_velocity)
@@ -955,15 +1020,15 @@ void CPUParticles2D::_particles_process(float p_delta) {
                 // rotation matrix, but we use -ang here to reproduce its
                 // behavior.
                 Transform2D rot  = Transform2D(-ang, Vector2());
-                p.transform[2]  -= diff;
-                p.transform[2]  += rot.basis_xform(diff);
+                transform[2]    -= diff;
+                transform[2]    += rot.basis_xform(diff);
             }
             if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-                p.velocity = p.velocity.normalized() * tex_linear_velocity;
+                velocity = velocity.normalized() * tex_linear_velocity;
             }
 
             if (parameters[PARAM_DAMPING] + tex_damping > 0.0) {
-                float v    = p.velocity.length();
+                float v    = velocity.length();
                 float damp = (parameters[PARAM_DAMPING] + tex_damping)
                            * Math::lerp(
                                  1.0f,
@@ -972,9 +1037,9 @@ void CPUParticles2D::_particles_process(float p_delta) {
                            );
                 v -= damp * local_delta;
                 if (v < 0.0) {
-                    p.velocity = Vector2();
+                    velocity = Vector2();
                 } else {
-                    p.velocity = p.velocity.normalized() * v;
+                    velocity = velocity.normalized() * v;
                 }
             }
             float base_angle =
@@ -1086,15 +1151,15 @@ void CPUParticles2D::_particles_process(float p_delta) {
         p.color *= p.base_color;
 
         if (flags[FLAG_ALIGN_Y_TO_VELOCITY]) {
-            if (p.velocity.length() > 0.0) {
-                p.transform.elements[1] = p.velocity.normalized();
-                p.transform.elements[0] = p.transform.elements[1].tangent();
+            if (velocity.length() > 0.0) {
+                transform.elements[1] = velocity.normalized();
+                transform.elements[0] = transform.elements[1].tangent();
             }
 
         } else {
-            p.transform.elements[0] =
+            transform.elements[0] =
                 Vector2(Math::cos(p.rotation), -Math::sin(p.rotation));
-            p.transform.elements[1] =
+            transform.elements[1] =
                 Vector2(Math::sin(p.rotation), Math::cos(p.rotation));
         }
 
@@ -1109,10 +1174,23 @@ void CPUParticles2D::_particles_process(float p_delta) {
             base_scale = 0.000001f;
         }
 
-        p.transform.elements[0] *= base_scale;
-        p.transform.elements[1] *= base_scale;
+        transform.elements[0] *= base_scale;
+        transform.elements[1] *= base_scale;
+
+        CPUParticlesKernels::store_transform_2d(components, i, transform);
+        velocities[0][i] = velocity.x;
+        velocities[1][i] = velocity.y;
+        steps[i]         = local_delta;
+    }
 
-        p.transform[2] += p.velocity * local_delta;
+    for (int axis = 0; axis < 2; axis++) {
+        CPUParticlesKernels::move(
+            components[axis * 3 + 2],
+            velocities[axis],
+            steps,
+            from,
+            to
+        );
     }
 }
 
@@ -1125,10 +1203,6 @@ void CPUParticles2D::_update_particle_data_buffer() {
         PoolVector<int>::Write ow;
         int* order = nullptr;
 
-        PoolVector<float>::Write w   = particle_data.write();
-        PoolVector<Particle>::Read r = particles.read();
-        float* ptr                   = w.ptr();
-
         if (draw_order != DRAW_ORDER_INDEX) {
             ow    = particle_order.write();
             order = ow.ptr();
@@ -1137,52 +1211,84 @@ void CPUParticles2D::_update_particle_data_buffer() {
                 order[i] = i;
             }
             if (draw_order == DRAW_ORDER_LIFETIME) {
+                PoolVector<Particle>::Read r = particles.read();
                 SortArray<int, SortLifetime> sorter;
                 sorter.compare.particles = r.ptr();
                 sorter.sort(order, pc);
             }
         }
 
-        for (int i = 0; i < pc; i++) {
-            int idx = order ? order[i] : i;
+        _write_particle_data(order);
+    }
 
-            Transform2D t = r[idx].transform;
+    update_mutex.unlock();
+}
 
-            if (!local_coords) {
-                t = inv_emission_transform * t;
-            }
+// Writes the particles to the multimesh buffer, in p_order if it isn't null.
+void CPUParticles2D::_write_particle_data(const int* p_order) {
+    PoolVector<float>::Write w   = particle_data.write();
+    PoolVector<Particle>::Read r = particles.read();
 
-            if (r[idx].active) {
-                ptr[0] = t.elements[0][0];
-                ptr[1] = t.elements[1][0];
-                ptr[2] = 0;
-                ptr[3] = t.elements[2][0];
-                ptr[4] = t.elements[0][1];
-                ptr[5] = t.elements[1][1];
-                ptr[6] = 0;
-                ptr[7] = t.elements[2][1];
-
-                Color c        = r[idx].color;
-                uint8_t* data8 = (uint8_t*)&ptr[8];
-                data8[0]       = CLAMP(c.r * 255.0, 0, 255);
-                data8[1]       = CLAMP(c.g * 255.0, 0, 255);
-                data8[2]       = CLAMP(c.b * 255.0, 0, 255);
-                data8[3]       = CLAMP(c.a * 255.0, 0, 255);
-
-                ptr[9]  = r[idx].custom[0];
-                ptr[10] = r[idx].custom[1];
-                ptr[11] = r[idx].custom[2];
-                ptr[12] = r[idx].custom[3];
-
-            } else {
-                memset(ptr, 0, sizeof(float) * 13);
-            }
+    BufferState& b   = buffer_state;
+    b.particles      = r.ptr();
+    b.particle_count = particles.size();
+    b.order          = p_order;
+    b.buffer         = w.ptr();
+    for (int c = 0; c < COMPONENTS; c++) {
+        b.transforms[c] = transforms[c].ptr();
+    }
+
+    uint32_t chunks = (b.particle_count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    CPUParticlesWorkPool::get_singleton()->do_work(
+        chunks,
+        this,
+        &CPUParticles2D::_write_chunk,
+        nullptr
+    );
+}
+
+void CPUParticles2D::_write_chunk(uint32_t p_chunk, void* p_userdata) {
+    const BufferState& state = buffer_state;
+    const Particle* r        = state.particles;
+    const int* order         = state.order;
+    const int pc             = state.particle_count;
+
+    int from   = p_chunk * CHUNK_SIZE;
+    int to     = MIN(from + (int)CHUNK_SIZE, pc);
+    float* ptr = state.buffer + from * 13;
+
+    CPUParticlesKernels::write_transforms_2d(
+        state.transforms,
+        order,
+        from,
+        to,
+        local_coords ? nullptr : &inv_emission_transform,
+        ptr,
+        13
+    );
+
+    for (int i = from; i < to; i++) {
+        int idx = order ? order[i] : i;
+
+        if (r[idx].active) {
+            Color c        = r[idx].color;
+            uint8_t* data8 = (uint8_t*)&ptr[8];
+            data8[0]       = CLAMP(c.r * 255.0, 0, 255);
+            data8[1]       = CLAMP(c.g * 255.0, 0, 255);
+            data8[2]       = CLAMP(c.b * 255.0, 0, 255);
+            data8[3]       = CLAMP(c.a * 255.0, 0, 255);
+
+            ptr[9]  = r[idx].custom[0];
+            ptr[10] = r[idx].custom[1];
+            ptr[11] = r[idx].custom[2];
+            ptr[12] = r[idx].custom[3];
 
-            ptr += 13;
+        } else {
+            memset(ptr, 0, sizeof(float) * 13);
         }
-    }
 
-    update_mutex.unlock();
+        ptr += 13;
+    }
 }
 
 void CPUParticles2D::_set_redraw(bool p_redraw) {
@@ -1272,31 +1378,8 @@ void CPUParticles2D::_notification(int p_what) {
         inv_emission_transform = get_global_transform().affine_inverse();
 
         if (!local_coords) {
-            int pc = particles.size();
-
-            PoolVector<float>::Write w   = particle_data.write();
-            PoolVector<Particle>::Read r = particles.read();
-            float* ptr                   = w.ptr();
-
-            for (int i = 0; i < pc; i++) {
-                Transform2D t = inv_emission_transform * r[i].transform;
-
-                if (r[i].active) {
-                    ptr[0] = t.elements[0][0];
-                    ptr[1] = t.elements[1][0];
-                    ptr[2] = 0;
-                    ptr[3] = t.elements[2][0];
-                    ptr[4] = t.elements[0][1];
-                    ptr[5] = t.elements[1][1];
-                    ptr[6] = 0;
-                    ptr[7] = t.elements[2][1];
-
-                } else {
-                    memset(ptr, 0, sizeof(float) * 8);
-                }
-
-                ptr += 13;
-            }
+            // in index order, the next update sorts the particles again
+            _write_particle_data(nullptr);
         }
     }
 }
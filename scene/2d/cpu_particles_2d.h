@@ -7,8 +7,10 @@
 #ifndef CPU_PARTICLES_2D_H
 #define CPU_PARTICLES_2D_H
 
+#include "core/local_vector.h"
 #include "core/rid.h"
 #include "scene/2d/node_2d.h"
+#include "scene/main/cpu_particles_kernels.h"
 #include "scene/resources/texture.h"
 
 class CPUParticles2D : public Node2D {
@@ -58,12 +60,12 @@ private:
 
     // warning - beware of adding non-trivial types
     // to this structure as it is zeroed to initialize in set_amount()
+    // The transforms and velocities are kept in the structures of arrays
+    // below.
     struct Particle {
-        Transform2D transform;
         Color color;
         float custom[4];
         float rotation;
-        Vector2 velocity;
         bool active;
         float angle_rand;
         float scale_rand;
@@ -89,6 +91,17 @@ private:
     PoolVector<float> particle_data;
     PoolVector<int> particle_order;
 
+    enum {
+        COMPONENTS = CPUParticlesKernels::COMPONENTS_2D,
+    };
+
+    // The transforms and velocities of the particles, one array per
+    // component. See CPUParticles.
+    LocalVector<float> transforms[COMPONENTS];
+    LocalVector<float> velocities[2];
+    // How long each particle moves at its velocity in the current step.
+    LocalVector<float> steps;
+
     struct SortLifetime {
         const Particle* particles;
 
@@ -98,12 +111,13 @@ private:
     };
 
     struct SortAxis {
-        const Particle* particles;
+        const float* x;
+        const float* y;
         Vector2 axis;
 
         bool operator()(int p_a, int p_b) const {
-            return axis.dot(particles[p_a].transform[2])
-                 < axis.dot(particles[p_b].transform[2]);
+            return axis.dot(Vector2(x[p_a], y[p_a]))
+                 < axis.dot(Vector2(x[p_b], y[p_b]));
         }
     };
 
@@ -152,9 +166,46 @@ private:
 
     Vector2 gravity;
 
+    // The particles are processed, and written to the multimesh buffer, in
+    // chunks on a work pool shared by all the emitters. See CPUParticles.
+    enum {
+        CHUNK_SIZE = 256,
+    };
+
+    struct ProcessState {
+        float delta;
+        float prev_time;
+        float system_phase;
+        uint32_t seed;
+        Transform2D emission_xform;
+        Transform2D velocity_xform;
+        Particle* particles;
+        float* transforms[COMPONENTS];
+        float* velocities[2];
+        float* steps;
+        int particle_count;
+        const Vector2* points;
+        const Vector2* normals;
+        const Color* colors;
+    };
+
+    struct BufferState {
+        const Particle* particles;
+        const float* transforms[COMPONENTS];
+        int particle_count;
+        const int* order;
+        float* buffer;
+    };
+
+    ProcessState process_state;
+    BufferState buffer_state;
+
     void _update_internal();
     void _particles_process(float p_delta);
+    void _process_chunk(uint32_t p_chunk, void* p_userdata);
     void _update_particle_data_buffer();
+    void _write_particle_data(const int* p_order);
+    void _write_chunk(uint32_t p_chunk, void* p_userdata);
 
     Mutex update_mutex;
 
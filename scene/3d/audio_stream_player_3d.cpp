@@ -11,28 +11,32 @@
 #include "scene/3d/camera.h"
 #include "scene/3d/listener.h"
 #include "scene/main/viewport.h"
+#include "servers/audio/audio_mix_kernels.h"
 
 // Based on "A Novel Multichannel Panning Method for Standard and Arbitrary
 // Loudspeaker Configurations" by Ramy Sadek and Chris Kyriakakis (2004)
 // Speaker-Placement Correction Amplitude Panning (SPCAP)
 class Spcap {
 private:
+    enum {
+        MAX_SPEAKERS = 7,
+    };
+
     struct Speaker {
         Vector3 direction;
         real_t effective_number_of_speakers; // precalculated
-        mutable real_t squared_gain;         // temporary
     };
 
-    PoolVector<Speaker> speakers;
+    Speaker speakers[MAX_SPEAKERS];
+    unsigned int speaker_count;
 
 public:
     Spcap(unsigned int speaker_count, const Vector3* speaker_directions) {
-        this->speakers.resize(speaker_count);
-        PoolVector<Speaker>::Write w = this->speakers.write();
+        this->speaker_count = speaker_count;
+        Speaker* w          = this->speakers;
         for (unsigned int speaker_num = 0; speaker_num < speaker_count;
              speaker_num++) {
             w[speaker_num].direction    = speaker_directions[speaker_num];
-            w[speaker_num].squared_gain = 0.0;
             w[speaker_num].effective_number_of_speakers = 0.0;
             for (unsigned int other_speaker_num = 0;
                  other_speaker_num < speaker_count;
@@ -48,11 +52,11 @@ public:
     }
 
     unsigned int get_speaker_count() const {
-        return (unsigned int)this->speakers.size();
+        return this->speaker_count;
     }
 
     Vector3 get_speaker_direction(unsigned int index) const {
-        return this->speakers.read()[index].direction;
+        return this->speakers[index].direction;
     }
 
     void calculate(
@@ -61,10 +65,10 @@ public:
         unsigned int volume_count,
         real_t* volumes
     ) const {
-        PoolVector<Speaker>::Read r = this->speakers.read();
-        real_t sum_squared_gains    = 0.0;
-        for (unsigned int speaker_num = 0;
-             speaker_num < (unsigned int)this->speakers.size();
+        const Speaker* r = this->speakers;
+        real_t squared_gains[MAX_SPEAKERS];
+        real_t sum_squared_gains = 0.0;
+        for (unsigned int speaker_num = 0; speaker_num < this->speaker_count;
              speaker_num++) {
             real_t initial_gain =
                 0.5
@@ -73,16 +77,15 @@ public:
                     tightness
                 )
                 / r[speaker_num].effective_number_of_speakers;
-            r[speaker_num].squared_gain  = initial_gain * initial_gain;
-            sum_squared_gains           += r[speaker_num].squared_gain;
+            squared_gains[speaker_num]  = initial_gain * initial_gain;
+            sum_squared_gains          += squared_gains[speaker_num];
         }
 
         for (unsigned int speaker_num = 0;
-             speaker_num
-             < MIN(volume_count, (unsigned int)this->speakers.size());
+             speaker_num < MIN(volume_count, this->speaker_count);
              speaker_num++) {
             volumes[speaker_num] =
-                sqrtf(r[speaker_num].squared_gain / sum_squared_gains);
+                sqrtf(squared_gains[speaker_num] / sum_squared_gains);
         }
     }
 };
@@ -99,33 +102,103 @@ static const Vector3 speaker_directions[7] = {
     Vector3(1.0, 0.0, 0.0).normalized(),   // side-right
 };
 
+// The listener of a viewport that is an audio listener.
+struct AudioListenerState {
+    ObjectID viewport_id;
+    ObjectID camera_id;
+    Viewport* viewport;
+    Camera* camera;
+    bool is_camera;
+    Transform transform;
+    Transform inverse;
+    Transform orthonormalized_inverse;
+
+    // Looks the viewport and camera up again. Returns false if either was
+    // freed.
+    bool update() {
+        viewport =
+            Object::cast_to<Viewport>(ObjectDB::get_instance(viewport_id));
+        camera = Object::cast_to<Camera>(ObjectDB::get_instance(camera_id));
+        return viewport && camera;
+    }
+};
+
+// The listeners only depend on the world, so they are found, and their
+// transforms inverted, once per physics frame for all the players.
+static const LocalVector<AudioListenerState>& _get_listener_states(
+    World* p_world
+) {
+    static LocalVector<AudioListenerState> states;
+    static ObjectID states_world = 0;
+    static uint64_t states_frame = 0;
+
+    uint64_t frame = Engine::get_singleton()->get_physics_frames();
+    if (p_world->get_instance_id() == states_world && frame == states_frame) {
+        // A camera or viewport can be freed during the frame.
+        for (uint32_t i = 0; i < states.size();) {
+            if (states[i].update()) {
+                i++;
+            } else {
+                states.remove(i);
+            }
+        }
+        return states;
+    }
+    states_world = p_world->get_instance_id();
+    states_frame = frame;
+    states.clear();
+
+    List<Camera*> cameras;
+    p_world->get_camera_list(&cameras);
+
+    for (List<Camera*>::Element* E = cameras.front(); E; E = E->next()) {
+        Camera* camera = E->get();
+        Viewport* vp   = camera->get_viewport();
+        if (!vp->is_audio_listener()) {
+            continue;
+        }
+
+        AudioListenerState state;
+        state.viewport_id = vp->get_instance_id();
+        state.camera_id   = camera->get_instance_id();
+        state.viewport    = vp;
+        state.camera      = camera;
+        state.is_camera   = true;
+
+        Spatial* listener_node = camera;
+        Listener* listener     = vp->get_listener();
+        if (listener) {
+            listener_node   = listener;
+            state.is_camera = false;
+        }
+
+        state.transform = listener_node->get_global_transform();
+        state.inverse   = state.transform.affine_inverse();
+        state.orthonormalized_inverse =
+            state.transform.orthonormalized().affine_inverse();
+        states.push_back(state);
+    }
+    return states;
+}
+
 void AudioStreamPlayer3D::_calc_output_vol(
     const Vector3& source_dir,
     real_t tightness,
     AudioStreamPlayer3D::Output& output
 ) {
-    unsigned int speaker_count; // only main speakers (no LFE)
-    switch (AudioServer::get_singleton()->get_speaker_mode()) {
-        default: // fallthrough
-        case AudioServer::SPEAKER_MODE_STEREO:
-            speaker_count = 2;
-            break;
-        case AudioServer::SPEAKER_SURROUND_31:
-            speaker_count = 3;
-            break;
-        case AudioServer::SPEAKER_SURROUND_51:
-            speaker_count = 5;
-            break;
-        case AudioServer::SPEAKER_SURROUND_71:
-            speaker_count = 7;
-            break;
-    }
+    // The panners only depend on the speaker mode, so they are made once.
+    // Only main speakers (no LFE).
+    static const Spcap panners[] = {
+        Spcap(2, speaker_directions), // stereo
+        Spcap(3, speaker_directions), // 3.1
+        Spcap(5, speaker_directions), // 5.1
+        Spcap(7, speaker_directions), // 7.1
+    };
+    int speaker_mode = AudioServer::get_singleton()->get_speaker_mode();
+
+    const Spcap& spcap         = panners[CLAMP(speaker_mode, 0, 3)];
+    unsigned int speaker_count = spcap.get_speaker_count();
 
-    Spcap spcap(
-        speaker_count,
-        speaker_directions
-    ); // TODO: should only be created/recreated once the speaker mode / speaker
-       // positions changes
     real_t volumes[7];
     spcap.calculate(source_dir, tightness, speaker_count, volumes);
 
@@ -161,30 +234,43 @@ void AudioStreamPlayer3D::_mix_audio() {
         started = true;
     }
 
+    bool fade_in  = stream_paused_fade_in;
+    bool fade_out = stream_paused_fade_out;
+
+    // A voice that becomes virtual fades out for a short block first, unless
+    // it has just started, and fades in when it is mixed again.
+    AudioVoiceManager* voice_manager =
+        AudioServer::get_singleton()->get_voice_manager();
+
+    bool was_virtual = voice_virtual;
+    voice_virtual    = voice >= 0 && voice_manager->is_voice_virtual(voice);
+    if (voice_virtual) {
+        if (was_virtual || started) {
+            _mix_virtual(started);
+            return;
+        }
+        fade_out = true;
+    } else if (was_virtual && !started) {
+        stream_playback->seek(virtual_position);
+        fade_in = true;
+    }
+
     // get data
     AudioFrame* buffer = mix_buffer.ptrw();
     int buffer_size    = mix_buffer.size();
 
-    if (stream_paused_fade_out) {
+    if (fade_out) {
         // Short fadeout ramp
         buffer_size = MIN(buffer_size, 128);
     }
 
     // Mix if we're not paused or we're fading out
     if ((output_count.get() > 0 || out_of_range_mode == OUT_OF_RANGE_MIX)) {
-        float output_pitch_scale = 0.0;
-        if (output_count.get()) {
-            // used for doppler, not realistic but good enough
-            for (int i = 0; i < output_count.get(); i++) {
-                output_pitch_scale += outputs[i].pitch_scale;
-            }
-            output_pitch_scale /= float(output_count.get());
-        } else {
-            output_pitch_scale = 1.0;
-        }
-
-        stream_playback
-            ->mix(buffer, pitch_scale * output_pitch_scale, buffer_size);
+        stream_playback->mix(
+            buffer,
+            pitch_scale * _get_output_pitch_scale(),
+            buffer_size
+        );
     }
 
     // write all outputs
@@ -222,10 +308,9 @@ void AudioStreamPlayer3D::_mix_audio() {
 
         for (int k = 0; k < buffers; k++) {
             AudioFrame target_volume =
-                stream_paused_fade_out ? AudioFrame(0.f, 0.f) : current.vol[k];
-            AudioFrame vol_prev = stream_paused_fade_in
-                                    ? AudioFrame(0.f, 0.f)
-                                    : prev_outputs[i].vol[k];
+                fade_out ? AudioFrame(0.f, 0.f) : current.vol[k];
+            AudioFrame vol_prev =
+                fade_in ? AudioFrame(0.f, 0.f) : prev_outputs[i].vol[k];
             AudioFrame vol_inc =
                 (target_volume - vol_prev) / float(buffer_size);
             AudioFrame vol = vol_prev;
@@ -311,17 +396,22 @@ void AudioStreamPlayer3D::_mix_audio() {
                     AudioFrame rvol_inc =
                         (current.reverb_vol[k] - prev_outputs[i].reverb_vol[k])
                         / float(buffer_size);
-                    AudioFrame rvol = prev_outputs[i].reverb_vol[k];
 
-                    for (int j = 0; j < buffer_size; j++) {
-                        rtarget[j] += buffer[j] * rvol;
-                        rvol       += rvol_inc;
-                    }
+                    AudioMixKernels::mix_ramp(
+                        rtarget,
+                        buffer,
+                        buffer_size,
+                        prev_outputs[i].reverb_vol[k],
+                        rvol_inc
+                    );
                 } else {
-                    AudioFrame rvol = current.reverb_vol[k];
-                    for (int j = 0; j < buffer_size; j++) {
-                        rtarget[j] += buffer[j] * rvol;
-                    }
+                    AudioMixKernels::mix_ramp(
+                        rtarget,
+                        buffer,
+                        buffer_size,
+                        current.reverb_vol[k],
+                        AudioFrame(0, 0)
+                    );
                 }
             }
         }
@@ -331,6 +421,10 @@ void AudioStreamPlayer3D::_mix_audio() {
 
     prev_output_count = output_count.get();
 
+    if (voice_virtual) {
+        virtual_position = stream_playback->get_playback_position();
+    }
+
     // stream is no longer active, disable this.
     if (!stream_playback->is_playing()) {
         active.clear();
@@ -341,6 +435,51 @@ void AudioStreamPlayer3D::_mix_audio() {
     stream_paused_fade_out = false;
 }
 
+float AudioStreamPlayer3D::_get_output_pitch_scale() const {
+    if (!output_count.get()) {
+        return 1.0;
+    }
+    // used for doppler, not realistic but good enough
+    float output_pitch_scale = 0.0;
+    for (int i = 0; i < output_count.get(); i++) {
+        output_pitch_scale += outputs[i].pitch_scale;
+    }
+    return output_pitch_scale / float(output_count.get());
+}
+
+// Keeps track of the playback position of a virtual voice, without mixing.
+void AudioStreamPlayer3D::_mix_virtual(bool p_started) {
+    if (p_started) {
+        virtual_position = stream_playback->get_playback_position();
+    }
+
+    // Paused out of range voices don't advance, like when they are mixed.
+    if (output_count.get() > 0 || out_of_range_mode == OUT_OF_RANGE_MIX) {
+        float mix_rate    = AudioServer::get_singleton()->get_mix_rate();
+        int buffer_size   = mix_buffer.size();
+        float pitch       = pitch_scale * _get_output_pitch_scale();
+        float duration    = pitch * buffer_size / mix_rate;
+        virtual_position += duration;
+
+        // The end of the stream is mixed, and discarded, so that the stream
+        // loops or stops like it would have if it had been mixed.
+        float length = stream->get_length();
+        if (length > 0 && virtual_position >= length) {
+            stream_playback->seek(MAX(length - duration, 0));
+            stream_playback->mix(mix_buffer.ptrw(), pitch, buffer_size);
+            virtual_position = stream_playback->get_playback_position();
+        }
+    }
+
+    if (!stream_playback->is_playing()) {
+        active.clear();
+    }
+
+    output_ready.clear();
+    stream_paused_fade_in  = false;
+    stream_paused_fade_out = false;
+}
+
 float AudioStreamPlayer3D::_get_attenuation_db(float p_distance) const {
     float att = 0;
     switch (attenuation_model) {
@@ -377,6 +516,7 @@ void _update_sound() {}
 void AudioStreamPlayer3D::_notification(int p_what) {
     if (p_what == NOTIFICATION_ENTER_TREE) {
         velocity_tracker->reset(get_global_transform().origin);
+        voice = AudioServer::get_singleton()->get_voice_manager()->add_voice();
         AudioServer::get_singleton()->add_callback(_mix_audios, this);
         if (autoplay && !Engine::get_singleton()->is_editor_hint()) {
             play();
@@ -385,6 +525,8 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 
     if (p_what == NOTIFICATION_EXIT_TREE) {
         AudioServer::get_singleton()->remove_callback(_mix_audios, this);
+        AudioServer::get_singleton()->get_voice_manager()->remove_voice(voice);
+        voice = -1;
     }
 
     if (p_what == NOTIFICATION_PAUSED) {
@@ -465,30 +607,15 @@ void AudioStreamPlayer3D::_notification(int p_what) {
                 break;
             }
 
-            List<Camera*> cameras;
-            world->get_camera_list(&cameras);
+            const LocalVector<AudioListenerState>& listeners =
+                _get_listener_states(world.ptr());
 
-            for (List<Camera*>::Element* E = cameras.front(); E;
-                 E                         = E->next()) {
-                Camera* camera = E->get();
-                Viewport* vp   = camera->get_viewport();
-                if (!vp->is_audio_listener()) {
-                    continue;
-                }
+            for (uint32_t l = 0; l < listeners.size(); l++) {
+                const AudioListenerState& listener = listeners[l];
+                Viewport* vp                       = listener.viewport;
 
-                bool listener_is_camera = true;
-                Spatial* listener_node  = camera;
-
-                Listener* listener = vp->get_listener();
-                if (listener) {
-                    listener_node      = listener;
-                    listener_is_camera = false;
-                }
-
-                Vector3 local_pos = listener_node->get_global_transform()
-                                        .orthonormalized()
-                                        .affine_inverse()
-                                        .xform(global_pos);
+                Vector3 local_pos =
+                    listener.orthonormalized_inverse.xform(global_pos);
 
                 float dist = local_pos.length();
 
@@ -500,11 +627,9 @@ void AudioStreamPlayer3D::_notification(int p_what) {
                     area_sound_pos =
                         space_state->get_closest_point_to_object_volume(
                             area->get_rid(),
-                            listener_node->get_global_transform().origin
+                            listener.transform.origin
                         );
-                    listener_area_pos = listener_node->get_global_transform()
-                                            .affine_inverse()
-                                            .xform(area_sound_pos);
+                    listener_area_pos = listener.inverse.xform(area_sound_pos);
                 }
 
                 if (max_distance > 0) {
@@ -534,8 +659,7 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 
                 if (emission_angle_enabled) {
                     Vector3 listenertopos =
-                        global_pos
-                        - listener_node->get_global_transform().origin;
+                        global_pos - listener.transform.origin;
                     float c = listenertopos.normalized().dot(
                         get_global_transform().basis.get_axis(2).normalized()
                     ); // it's z negative
@@ -675,17 +799,16 @@ void AudioStreamPlayer3D::_notification(int p_what) {
                 if (doppler_tracking != DOPPLER_TRACKING_DISABLED) {
                     Vector3 listener_velocity;
 
-                    if (listener_is_camera) {
+                    if (listener.is_camera) {
                         listener_velocity =
-                            camera->get_doppler_tracked_velocity();
+                            listener.camera->get_doppler_tracked_velocity();
                     }
 
+                    // The inverse of an orthonormal basis is its transpose.
                     Vector3 local_velocity =
-                        listener_node->get_global_transform()
-                            .orthonormalized()
-                            .basis.xform_inv(
-                                linear_velocity - listener_velocity
-                            );
+                        listener.orthonormalized_inverse.basis.xform(
+                            linear_velocity - listener_velocity
+                        );
 
                     if (local_velocity == Vector3()) {
                         output.pitch_scale = 1.0;
@@ -725,6 +848,26 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 
             output_count.set(new_output_count);
             output_ready.set();
+
+            // The voice is as audible as its loudest output.
+            unsigned int cc =
+                AudioServer::get_singleton()->get_channel_count();
+            float audibility = 0;
+            for (int i = 0; i < new_output_count; i++) {
+                const Output& output = outputs[i];
+                for (unsigned int k = 0; k < cc; k++) {
+                    audibility = MAX(audibility, output.vol[k].l);
+                    audibility = MAX(audibility, output.vol[k].r);
+                    audibility = MAX(audibility, output.reverb_vol[k].l);
+                    audibility = MAX(audibility, output.reverb_vol[k].r);
+                }
+            }
+            AudioServer::get_singleton()->get_voice_manager()->set_voice_state(
+                voice,
+                voice_priority,
+                audibility,
+                active.is_set() || setplay.get() >= 0.0
+            );
         }
 
         // start playing if requested
@@ -739,6 +882,12 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 
         // stop playing if no longer active
         if (!active.is_set()) {
+            AudioServer::get_singleton()->get_voice_manager()->set_voice_state(
+                voice,
+                voice_priority,
+                0,
+                false
+            );
             set_physics_process_internal(false);
             // do not update, this makes it easier to animate (will shut off
             // otherwise) _change_notify("playing"); //update property in editor
@@ -840,6 +989,15 @@ void AudioStreamPlayer3D::stop() {
         active.clear();
         set_physics_process_internal(false);
         setplay.set(-1);
+        // The physics process, which would release the voice, has stopped.
+        if (voice >= 0) {
+            AudioServer::get_singleton()->get_voice_manager()->set_voice_state(
+                voice,
+                voice_priority,
+                0,
+                false
+            );
+        }
     }
 }
 
@@ -1039,6 +1197,14 @@ bool AudioStreamPlayer3D::get_stream_paused() const {
     return stream_paused;
 }
 
+void AudioStreamPlayer3D::set_voice_priority(int p_priority) {
+    voice_priority = p_priority;
+}
+
+int AudioStreamPlayer3D::get_voice_priority() const {
+    return voice_priority;
+}
+
 Ref<AudioStreamPlayback> AudioStreamPlayer3D::get_stream_playback() {
     return stream_playback;
 }
@@ -1232,6 +1398,15 @@ void AudioStreamPlayer3D::_bind_methods() {
         &AudioStreamPlayer3D::get_stream_paused
     );
 
+    ClassDB::bind_method(
+        D_METHOD("set_voice_priority", "priority"),
+        &AudioStreamPlayer3D::set_voice_priority
+    );
+    ClassDB::bind_method(
+        D_METHOD("get_voice_priority"),
+        &AudioStreamPlayer3D::get_voice_priority
+    );
+
     ClassDB::bind_method(
         D_METHOD("get_stream_playback"),
         &AudioStreamPlayer3D::get_stream_playback
@@ -1347,6 +1522,11 @@ void AudioStreamPlayer3D::_bind_methods() {
         "set_area_mask",
         "get_area_mask"
     );
+    ADD_PROPERTY(
+        PropertyInfo(Variant::INT, "voice_priority"),
+        "set_voice_priority",
+        "get_voice_priority"
+    );
     ADD_GROUP("Emission Angle", "emission_angle");
     ADD_PROPERTY(
         PropertyInfo(Variant::BOOL, "emission_angle_enabled"),
@@ -1443,6 +1623,10 @@ AudioStreamPlayer3D::AudioStreamPlayer3D() {
     stream_paused                        = false;
     stream_paused_fade_in                = false;
     stream_paused_fade_out               = false;
+    voice                                = -1;
+    voice_priority                       = 0;
+    voice_virtual                        = false;
+    virtual_position                     = 0;
 
     velocity_tracker.instance();
     AudioServer::get_singleton()
@@ -91,12 +91,21 @@ private:
     bool stream_paused_fade_out;
     StringName bus;
 
+    // The voice manager's ID for this player, while it is in the tree.
+    int voice;
+    int voice_priority;
+    // Only used by the audio thread.
+    bool voice_virtual;
+    float virtual_position;
+
     static void _calc_output_vol(
         const Vector3& source_dir,
         real_t tightness,
         Output& output
     );
+    float _get_output_pitch_scale() const;
     void _mix_audio();
+    void _mix_virtual(bool p_started);
 
     static void _mix_audios(void* self) {
         reinterpret_cast<AudioStreamPlayer3D*>(self)->_mix_audio();
@@ -191,6 +200,9 @@ public:
     void set_stream_paused(bool p_pause);
     bool get_stream_paused() const;
 
+    void set_voice_priority(int p_priority);
+    int get_voice_priority() const;
+
     Ref<AudioStreamPlayback> get_stream_playback();
 
     AudioStreamPlayer3D();
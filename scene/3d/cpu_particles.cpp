@@ -6,8 +6,11 @@
 
 #include "cpu_particles.h"
 
+#include "core/math/random_pcg.h"
 #include "scene/3d/camera.h"
 #include "scene/3d/particles.h"
+#include "scene/main/cpu_particles_kernels.h"
+#include "scene/main/cpu_particles_work_pool.h"
 #include "scene/resources/particles_material.h"
 #include "servers/visual_server.h"
 
@@ -52,6 +55,20 @@ void CPUParticles::set_amount(int p_amount) {
         }
     }
 
+    float* components[COMPONENTS];
+    for (int c = 0; c < COMPONENTS; c++) {
+        transforms[c].resize(p_amount);
+        components[c] = transforms[c].ptr();
+    }
+    for (int i = 0; i < p_amount; i++) {
+        CPUParticlesKernels::store_transform(components, i, Transform());
+    }
+    for (int axis = 0; axis < 3; axis++) {
+        velocities[axis].resize(p_amount);
+        memset(velocities[axis].ptr(), 0, p_amount * sizeof(float));
+    }
+    steps.resize(p_amount);
+
     particle_data.resize((12 + 4 + 1) * p_amount);
     VS::get_singleton()->multimesh_allocate(
         multimesh,
@@ -628,8 +645,6 @@ void CPUParticles::_particles_process(float p_delta) {
     int pcount                    = particles.size();
     PoolVector<Particle>::Write w = particles.write();
 
-    Particle* parray = w.ptr();
-
     float prev_time  = time;
     time            += p_delta;
     if (time > lifetime) {
@@ -641,23 +656,74 @@ void CPUParticles::_particles_process(float p_delta) {
         }
     }
 
-    Transform emission_xform;
-    Basis velocity_xform;
+    ProcessState& s  = process_state;
+    s.delta          = p_delta;
+    s.prev_time      = prev_time;
+    s.system_phase   = time / lifetime;
+    s.seed           = Math::rand();
+    s.particles      = w.ptr();
+    s.particle_count = pcount;
+    for (int c = 0; c < COMPONENTS; c++) {
+        s.transforms[c] = transforms[c].ptr();
+    }
+    for (int axis = 0; axis < 3; axis++) {
+        s.velocities[axis] = velocities[axis].ptr();
+    }
+    s.steps = steps.ptr();
     if (!local_coords) {
-        emission_xform = get_global_transform();
-        velocity_xform = emission_xform.basis;
+        s.emission_xform = get_global_transform();
+        s.velocity_xform = s.emission_xform.basis;
+    }
+
+    PoolVector<Vector3>::Read points_read  = emission_points.read();
+    PoolVector<Vector3>::Read normals_read = emission_normals.read();
+    PoolVector<Color>::Read colors_read    = emission_colors.read();
+    s.points                               = points_read.ptr();
+    s.normals                              = normals_read.ptr();
+    s.colors                               = colors_read.ptr();
+
+    // Sorts the gradient's points, so the chunks only read the gradient.
+    if (color_ramp.is_valid()) {
+        color_ramp->get_color_at_offset(0.0);
     }
 
-    float system_phase = time / lifetime;
+    uint32_t chunks = (pcount + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    CPUParticlesWorkPool::get_singleton()->do_work(
+        chunks,
+        this,
+        &CPUParticles::_process_chunk,
+        nullptr
+    );
+}
+
+void CPUParticles::_process_chunk(uint32_t p_chunk, void* p_userdata) {
+    const ProcessState& state       = process_state;
+    const float delta               = state.delta;
+    const float prev_time           = state.prev_time;
+    const float system_phase        = state.system_phase;
+    const Transform& emission_xform = state.emission_xform;
+    const Basis& velocity_xform     = state.velocity_xform;
+    const int pcount                = state.particle_count;
+    Particle* parray                = state.particles;
+    float* const* components        = state.transforms;
+    float* const* velocities        = state.velocities;
+    float* steps                    = state.steps;
+
+    int from = p_chunk * CHUNK_SIZE;
+    int to   = MIN(from + (int)CHUNK_SIZE, pcount);
 
-    for (int i = 0; i < pcount; i++) {
+    for (int i = from; i < to; i++) {
         Particle& p = parray[i];
+        steps[i]    = 0.0;
 
         if (!emitting && !p.active) {
             continue;
         }
 
-        float local_delta = p_delta;
+        float local_delta   = delta;
+        Transform transform =
+            CPUParticlesKernels::load_transform(components, i);
+        Vector3 velocity(velocities[0][i], velocities[1][i], velocities[2][i]);
 
         // The phase is a ratio between 0 (birth) and 1 (end of life) for each
         // particle. While we use time in tests later on, for randomness we use
@@ -736,30 +802,34 @@ void CPUParticles::_particles_process(float p_delta) {
                     curve_parameters[PARAM_ANGLE]->interpolate(tv);
             }
 
-            p.seed = Math::rand();
+            // Every particle draws from its own sequence, so the result
+            // doesn't depend on which thread processes it.
+            RandomPCG rng(((uint64_t)state.seed << 32) | uint32_t(i));
 
-            p.angle_rand       = Math::randf();
-            p.scale_rand       = Math::randf();
-            p.hue_rot_rand     = Math::randf();
-            p.anim_offset_rand = Math::randf();
+            p.seed = rng.rand();
+
+            p.angle_rand       = rng.randf();
+            p.scale_rand       = rng.randf();
+            p.hue_rot_rand     = rng.randf();
+            p.anim_offset_rand = rng.randf();
 
             if (flags[FLAG_DISABLE_Z]) {
                 float angle1_rad =
                     Math::atan2(direction.y, direction.x)
-                    + (Math::randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
+                    + (rng.randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
                 Vector3 rot =
                     Vector3(Math::cos(angle1_rad), Math::sin(angle1_rad), 0.0);
-                p.velocity = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY]
-                           * Math::lerp(
-                                 1.0f,
-                                 float(Math::randf()),
-                                 randomness[PARAM_INITIAL_LINEAR_VELOCITY]
-                           );
+                velocity = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY]
+                         * Math::lerp(
+                               1.0f,
+                               float(rng.randf()),
+                               randomness[PARAM_INITIAL_LINEAR_VELOCITY]
+                         );
             } else {
                 // initiate velocity spread in 3D
                 float angle1_rad =
-                    (Math::randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
-                float angle2_rad = (Math::randf() * 2.0 - 1.0)
+                    (rng.randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
+                float angle2_rad = (rng.randf() * 2.0 - 1.0)
                                  * (1.0 - flatness) * Math_PI * spread / 180.0;
 
                 Vector3 direction_xz =
@@ -788,13 +858,13 @@ void CPUParticles::_particles_process(float p_delta) {
                 spread_direction = binormal * spread_direction.x
                                  + normal * spread_direction.y
                                  + direction_nrm * spread_direction.z;
-                p.velocity = spread_direction
-                           * parameters[PARAM_INITIAL_LINEAR_VELOCITY]
-                           * Math::lerp(
-                                 1.0f,
-                                 float(Math::randf()),
-                                 randomness[PARAM_INITIAL_LINEAR_VELOCITY]
-                           );
+                velocity = spread_direction
+                         * parameters[PARAM_INITIAL_LINEAR_VELOCITY]
+                         * Math::lerp(
+                               1.0f,
+                               float(rng.randf()),
+                               randomness[PARAM_INITIAL_LINEAR_VELOCITY]
+                         );
             }
 
             float base_angle =
@@ -808,9 +878,9 @@ void CPUParticles::_particles_process(float p_delta) {
                               p.anim_offset_rand,
                               randomness[PARAM_ANIM_OFFSET]
                         ); // animation offset (0-1)
-            p.transform = Transform();
-            p.time      = 0;
-            p.lifetime = lifetime * (1.0 - Math::randf() * lifetime_randomness);
+            transform = Transform();
+            p.time    = 0;
+            p.lifetime = lifetime * (1.0 - rng.randf() * lifetime_randomness);
             p.base_color = Color(1, 1, 1, 1);
 
             switch (emission_shape) {
@@ -818,23 +888,23 @@ void CPUParticles::_particles_process(float p_delta) {
                     // do none
                 } break;
                 case EMISSION_SHAPE_SPHERE: {
-                    float s = 2.0 * Math::randf() - 1.0,
-                          t = 2.0 * Math_PI * Math::randf();
+                    float s = 2.0 * rng.randf() - 1.0,
+                          t = 2.0 * Math_PI * rng.randf();
                     float radius =
                         emission_sphere_radius * Math::sqrt(1.0 - s * s);
-                    p.transform.origin = Vector3(
+                    transform.origin = Vector3(
                         radius * Math::cos(t),
                         radius * Math::sin(t),
                         emission_sphere_radius * s
                     );
                 } break;
                 case EMISSION_SHAPE_BOX: {
-                    p.transform.origin = Vector3(
-                                             Math::randf() * 2.0 - 1.0,
-                                             Math::randf() * 2.0 - 1.0,
-                                             Math::randf() * 2.0 - 1.0
-                                         )
-                                       * emission_box_extents;
+                    transform.origin = Vector3(
+                                           rng.randf() * 2.0 - 1.0,
+                                           rng.randf() * 2.0 - 1.0,
+                                           rng.randf() * 2.0 - 1.0
+                                       )
+                                     * emission_box_extents;
                 } break;
                 case EMISSION_SHAPE_POINTS:
                 case EMISSION_SHAPE_DIRECTED_POINTS: {
@@ -843,24 +913,24 @@ void CPUParticles::_particles_process(float p_delta) {
                         break;
                     }
 
-                    int random_idx = Math::rand() % pc;
+                    int random_idx = rng.rand() % pc;
 
-                    p.transform.origin = emission_points.get(random_idx);
+                    transform.origin = state.points[random_idx];
 
                     if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS
                         && emission_normals.size() == pc) {
                         if (flags[FLAG_DISABLE_Z]) {
-                            Vector3 normal = emission_normals.get(random_idx);
+                            Vector3 normal = state.normals[random_idx];
                             Vector2 normal_2d(normal.x, normal.y);
                             Transform2D m2;
                             m2.set_axis(0, normal_2d);
                             m2.set_axis(1, normal_2d.tangent());
-                            Vector2 velocity_2d(p.velocity.x, p.velocity.y);
+                            Vector2 velocity_2d(velocity.x, velocity.y);
                             velocity_2d  = m2.basis_xform(velocity_2d);
-                            p.velocity.x = velocity_2d.x;
-                            p.velocity.y = velocity_2d.y;
+                            velocity.x = velocity_2d.x;
+                            velocity.y = velocity_2d.y;
                         } else {
-                            Vector3 normal  = emission_normals.get(random_idx);
+                            Vector3 normal  = state.normals[random_idx];
                             Vector3 v0      = Math::abs(normal.z) < 0.999
                                                 ? Vector3(0.0, 0.0, 1.0)
                                                 : Vector3(0, 1.0, 0.0);
@@ -871,18 +941,18 @@ void CPUParticles::_particles_process(float p_delta) {
                             m3.set_axis(0, tangent);
                             m3.set_axis(1, bitangent);
                             m3.set_axis(2, normal);
-                            p.velocity = m3.xform(p.velocity);
+                            velocity = m3.xform(velocity);
                         }
                     }
 
                     if (emission_colors.size() == pc) {
-                        p.base_color = emission_colors.get(random_idx);
+                        p.base_color = state.colors[random_idx];
                     }
                 } break;
                 case EMISSION_SHAPE_RING: {
-                    float ring_random_angle = Math::randf() * 2.0 * Math_PI;
+                    float ring_random_angle = rng.randf() * 2.0 * Math_PI;
                     float ring_random_radius =
-                        Math::randf(
+                        rng.randf(
                         ) * (emission_ring_radius - emission_ring_inner_radius)
                         + emission_ring_inner_radius;
                     Vector3 axis       = emission_ring_axis.normalized();
@@ -895,10 +965,10 @@ void CPUParticles::_particles_process(float p_delta) {
                     ortho_axis = ortho_axis.normalized();
                     ortho_axis.rotate(axis, ring_random_angle);
                     ortho_axis         = ortho_axis.normalized();
-                    p.transform.origin = ortho_axis * ring_random_radius
-                                       + (Math::randf() * emission_ring_height
-                                          - emission_ring_height / 2.0)
-                                             * axis;
+                    transform.origin = ortho_axis * ring_random_radius
+                                     + (rng.randf() * emission_ring_height
+                                        - emission_ring_height / 2.0)
+                                           * axis;
                 }
                 case EMISSION_SHAPE_MAX: { // Max value for validity check.
                     break;
@@ -906,13 +976,13 @@ void CPUParticles::_particles_process(float p_delta) {
             }
 
             if (!local_coords) {
-                p.velocity  = velocity_xform.xform(p.velocity);
-                p.transform = emission_xform * p.transform;
+                velocity  = velocity_xform.xform(velocity);
+                transform = emission_xform * transform;
             }
 
             if (flags[FLAG_DISABLE_Z]) {
-                p.velocity.z         = 0.0;
-                p.transform.origin.z = 0.0;
+                velocity.z         = 0.0;
+                transform.origin.z = 0.0;
             }
 
         } else if (!p.active) {
@@ -988,14 +1058,14 @@ void CPUParticles::_particles_process(float p_delta) {
             }
 
             Vector3 force    = gravity;
-            Vector3 position = p.transform.origin;
+            Vector3 position = transform.origin;
             if (flags[FLAG_DISABLE_Z]) {
                 position.z = 0.0;
             }
             // apply linear acceleration
             force +=
-                p.velocity.length() > 0.0
-                    ? p.velocity.normalized()
+                velocity.length() > 0.0
+                    ? velocity.normalized()
                           * (parameters[PARAM_LINEAR_ACCEL] + tex_linear_accel)
                           * Math::lerp(
                               1.0f,
@@ -1046,7 +1116,7 @@ void CPUParticles::_particles_process(float p_delta) {
                            : Vector3();
             }
             // apply attractor forces
-            p.velocity += force * local_delta;
+            velocity += force * local_delta;
             // orbit velocity
             if (flags[FLAG_DISABLE_Z]) {
                 float orbit_amount =
@@ -1063,15 +1133,15 @@ void CPUParticles::_particles_process(float p_delta) {
                     // behavior.
                     Transform2D rot = Transform2D(-ang, Vector2());
                     Vector2 rotv    = rot.basis_xform(Vector2(diff.x, diff.y));
-                    p.transform.origin -= Vector3(diff.x, diff.y, 0);
-                    p.transform.origin += Vector3(rotv.x, rotv.y, 0);
+                    transform.origin -= Vector3(diff.x, diff.y, 0);
+                    transform.origin += Vector3(rotv.x, rotv.y, 0);
                 }
             }
             if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-                p.velocity = p.velocity.normalized() * tex_linear_velocity;
+                velocity = velocity.normalized() * tex_linear_velocity;
             }
             if (parameters[PARAM_DAMPING] + tex_damping > 0.0) {
-                float v    = p.velocity.length();
+                float v    = velocity.length();
                 float damp = (parameters[PARAM_DAMPING] + tex_damping)
                            * Math::lerp(
                                  1.0f,
@@ -1080,9 +1150,9 @@ void CPUParticles::_particles_process(float p_delta) {
                            );
                 v -= damp * local_delta;
                 if (v < 0.0) {
-                    p.velocity = Vector3();
+                    velocity = Vector3();
                 } else {
-                    p.velocity = p.velocity.normalized() * v;
+                    velocity = velocity.normalized() * v;
                 }
             }
             float base_angle =
@@ -1194,24 +1264,21 @@ void CPUParticles::_particles_process(float p_delta) {
 
         if (flags[FLAG_DISABLE_Z]) {
             if (flags[FLAG_ALIGN_Y_TO_VELOCITY]) {
-                if (p.velocity.length() > 0.0) {
-                    p.transform.basis.set_axis(1, p.velocity.normalized());
+                if (velocity.length() > 0.0) {
+                    transform.basis.set_axis(1, velocity.normalized());
                 } else {
-                    p.transform.basis.set_axis(
-                        1,
-                        p.transform.basis.get_axis(1)
-                    );
+                    transform.basis.set_axis(1, transform.basis.get_axis(1));
                 }
-                p.transform.basis.set_axis(
+                transform.basis.set_axis(
                     0,
-                    p.transform.basis.get_axis(1)
-                        .cross(p.transform.basis.get_axis(2))
+                    transform.basis.get_axis(1)
+                        .cross(transform.basis.get_axis(2))
                         .normalized()
                 );
-                p.transform.basis.set_axis(2, Vector3(0, 0, 1));
+                transform.basis.set_axis(2, Vector3(0, 0, 1));
 
             } else {
-                p.transform.basis.set_axis(
+                transform.basis.set_axis(
                     0,
                     Vector3(
                         Math::cos(p.custom[0]),
@@ -1219,60 +1286,60 @@ void CPUParticles::_particles_process(float p_delta) {
                         0.0
                     )
                 );
-                p.transform.basis.set_axis(
+                transform.basis.set_axis(
                     1,
                     Vector3(Math::sin(p.custom[0]), Math::cos(p.custom[0]), 0.0)
                 );
-                p.transform.basis.set_axis(2, Vector3(0, 0, 1));
+                transform.basis.set_axis(2, Vector3(0, 0, 1));
             }
 
         } else {
             // orient particle Y towards velocity
             if (flags[FLAG_ALIGN_Y_TO_VELOCITY]) {
-                if (p.velocity.length() > 0.0) {
-                    p.transform.basis.set_axis(1, p.velocity.normalized());
+                if (velocity.length() > 0.0) {
+                    transform.basis.set_axis(1, velocity.normalized());
                 } else {
-                    p.transform.basis.set_axis(
+                    transform.basis.set_axis(
                         1,
-                        p.transform.basis.get_axis(1).normalized()
+                        transform.basis.get_axis(1).normalized()
                     );
                 }
-                if (p.transform.basis.get_axis(1)
-                    == p.transform.basis.get_axis(0)) {
-                    p.transform.basis.set_axis(
+                if (transform.basis.get_axis(1)
+                    == transform.basis.get_axis(0)) {
+                    transform.basis.set_axis(
                         0,
-                        p.transform.basis.get_axis(1)
-                            .cross(p.transform.basis.get_axis(2))
+                        transform.basis.get_axis(1)
+                            .cross(transform.basis.get_axis(2))
                             .normalized()
                     );
-                    p.transform.basis.set_axis(
+                    transform.basis.set_axis(
                         2,
-                        p.transform.basis.get_axis(0)
-                            .cross(p.transform.basis.get_axis(1))
+                        transform.basis.get_axis(0)
+                            .cross(transform.basis.get_axis(1))
                             .normalized()
                     );
                 } else {
-                    p.transform.basis.set_axis(
+                    transform.basis.set_axis(
                         2,
-                        p.transform.basis.get_axis(0)
-                            .cross(p.transform.basis.get_axis(1))
+                        transform.basis.get_axis(0)
+                            .cross(transform.basis.get_axis(1))
                             .normalized()
                     );
-                    p.transform.basis.set_axis(
+                    transform.basis.set_axis(
                         0,
-                        p.transform.basis.get_axis(1)
-                            .cross(p.transform.basis.get_axis(2))
+                        transform.basis.get_axis(1)
+                            .cross(transform.basis.get_axis(2))
                             .normalized()
                     );
                 }
             } else {
-                p.transform.basis.orthonormalize();
+                transform.basis.orthonormalize();
             }
 
             // turn particle by rotation in Y
             if (flags[FLAG_ROTATE_Y]) {
                 Basis rot_y(Vector3(0, 1, 0), p.custom[0]);
-                p.transform.basis = p.transform.basis * rot_y;
+                transform.basis = transform.basis * rot_y;
             }
         }
 
@@ -1287,14 +1354,28 @@ void CPUParticles::_particles_process(float p_delta) {
             base_scale = 0.000001f;
         }
 
-        p.transform.basis.scale(Vector3(1, 1, 1) * base_scale);
+        transform.basis.scale(Vector3(1, 1, 1) * base_scale);
 
         if (flags[FLAG_DISABLE_Z]) {
-            p.velocity.z         = 0.0;
-            p.transform.origin.z = 0.0;
+            velocity.z         = 0.0;
+            transform.origin.z = 0.0;
         }
 
-        p.transform.origin += p.velocity * local_delta;
+        CPUParticlesKernels::store_transform(components, i, transform);
+        velocities[0][i] = velocity.x;
+        velocities[1][i] = velocity.y;
+        velocities[2][i] = velocity.z;
+        steps[i]         = local_delta;
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        CPUParticlesKernels::move(
+            components[axis * 4 + 3],
+            velocities[axis],
+            steps,
+            from,
+            to
+        );
     }
 }
 
@@ -1307,10 +1388,6 @@ void CPUParticles::_update_particle_data_buffer() {
         PoolVector<int>::Write ow;
         int* order = nullptr;
 
-        PoolVector<float>::Write w   = particle_data.write();
-        PoolVector<Particle>::Read r = particles.read();
-        float* ptr                   = w.ptr();
-
         if (draw_order != DRAW_ORDER_INDEX) {
             ow    = particle_order.write();
             order = ow.ptr();
@@ -1319,6 +1396,7 @@ void CPUParticles::_update_particle_data_buffer() {
                 order[i] = i;
             }
             if (draw_order == DRAW_ORDER_LIFETIME) {
+                PoolVector<Particle>::Read r = particles.read();
                 SortArray<int, SortLifetime> sorter;
                 sorter.compare.particles = r.ptr();
                 sorter.sort(order, pc);
@@ -1339,58 +1417,87 @@ void CPUParticles::_update_particle_data_buffer() {
                     }
 
                     SortArray<int, SortAxis> sorter;
-                    sorter.compare.particles = r.ptr();
-                    sorter.compare.axis      = dir;
+                    sorter.compare.x    = transforms[3].ptr();
+                    sorter.compare.y    = transforms[7].ptr();
+                    sorter.compare.z    = transforms[11].ptr();
+                    sorter.compare.axis = dir;
                     sorter.sort(order, pc);
                 }
             }
         }
 
-        for (int i = 0; i < pc; i++) {
-            int idx = order ? order[i] : i;
+        _write_particle_data(order);
 
-            Transform t = r[idx].transform;
+        can_update.set();
+    }
 
-            if (!local_coords) {
-                t = inv_emission_transform * t;
-            }
+    update_mutex.unlock();
+}
 
-            if (r[idx].active) {
-                ptr[0]  = t.basis.elements[0][0];
-                ptr[1]  = t.basis.elements[0][1];
-                ptr[2]  = t.basis.elements[0][2];
-                ptr[3]  = t.origin.x;
-                ptr[4]  = t.basis.elements[1][0];
-                ptr[5]  = t.basis.elements[1][1];
-                ptr[6]  = t.basis.elements[1][2];
-                ptr[7]  = t.origin.y;
-                ptr[8]  = t.basis.elements[2][0];
-                ptr[9]  = t.basis.elements[2][1];
-                ptr[10] = t.basis.elements[2][2];
-                ptr[11] = t.origin.z;
-            } else {
-                memset(ptr, 0, sizeof(float) * 12);
-            }
+// Writes the particles to the multimesh buffer, in p_order if it isn't null.
+void CPUParticles::_write_particle_data(const int* p_order) {
+    PoolVector<float>::Write w   = particle_data.write();
+    PoolVector<Particle>::Read r = particles.read();
+
+    BufferState& b   = buffer_state;
+    b.particles      = r.ptr();
+    b.particle_count = particles.size();
+    b.order          = p_order;
+    b.buffer         = w.ptr();
+    for (int c = 0; c < COMPONENTS; c++) {
+        b.transforms[c] = transforms[c].ptr();
+    }
 
-            Color c        = r[idx].color;
-            uint8_t* data8 = (uint8_t*)&ptr[12];
-            data8[0]       = CLAMP(c.r * 255.0, 0, 255);
-            data8[1]       = CLAMP(c.g * 255.0, 0, 255);
-            data8[2]       = CLAMP(c.b * 255.0, 0, 255);
-            data8[3]       = CLAMP(c.a * 255.0, 0, 255);
+    uint32_t chunks = (b.particle_count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    CPUParticlesWorkPool::get_singleton()->do_work(
+        chunks,
+        this,
+        &CPUParticles::_write_chunk,
+        nullptr
+    );
+}
 
-            ptr[13] = r[idx].custom[0];
-            ptr[14] = r[idx].custom[1];
-            ptr[15] = r[idx].custom[2];
-            ptr[16] = r[idx].custom[3];
+void CPUParticles::_write_chunk(uint32_t p_chunk, void* p_userdata) {
+    const BufferState& state = buffer_state;
+    const Particle* r        = state.particles;
+    const int* order         = state.order;
+    const int pc             = state.particle_count;
 
-            ptr += 17;
+    int from   = p_chunk * CHUNK_SIZE;
+    int to     = MIN(from + (int)CHUNK_SIZE, pc);
+    float* ptr = state.buffer + from * 17;
+
+    CPUParticlesKernels::write_transforms(
+        state.transforms,
+        order,
+        from,
+        to,
+        local_coords ? nullptr : &inv_emission_transform,
+        ptr,
+        17
+    );
+
+    for (int i = from; i < to; i++) {
+        int idx = order ? order[i] : i;
+
+        if (!r[idx].active) {
+            memset(ptr, 0, sizeof(float) * 12);
         }
 
-        can_update.set();
-    }
+        Color c        = r[idx].color;
+        uint8_t* data8 = (uint8_t*)&ptr[12];
+        data8[0]       = CLAMP(c.r * 255.0, 0, 255);
+        data8[1]       = CLAMP(c.g * 255.0, 0, 255);
+        data8[2]       = CLAMP(c.b * 255.0, 0, 255);
+        data8[3]       = CLAMP(c.a * 255.0, 0, 255);
 
-    update_mutex.unlock();
+        ptr[13] = r[idx].custom[0];
+        ptr[14] = r[idx].custom[1];
+        ptr[15] = r[idx].custom[2];
+        ptr[16] = r[idx].custom[3];
+
+        ptr += 17;
+    }
 }
 
 void CPUParticles::_set_redraw(bool p_redraw) {
@@ -1472,35 +1579,8 @@ void CPUParticles::_notification(int p_what) {
         inv_emission_transform = get_global_transform().affine_inverse();
 
         if (!local_coords) {
-            int pc = particles.size();
-
-            PoolVector<float>::Write w   = particle_data.write();
-            PoolVector<Particle>::Read r = particles.read();
-            float* ptr                   = w.ptr();
-
-            for (int i = 0; i < pc; i++) {
-                Transform t = inv_emission_transform * r[i].transform;
-
-                if (r[i].active) {
-                    ptr[0]  = t.basis.elements[0][0];
-                    ptr[1]  = t.basis.elements[0][1];
-                    ptr[2]  = t.basis.elements[0][2];
-                    ptr[3]  = t.origin.x;
-                    ptr[4]  = t.basis.elements[1][0];
-                    ptr[5]  = t.basis.elements[1][1];
-                    ptr[6]  = t.basis.elements[1][2];
-                    ptr[7]  = t.origin.y;
-                    ptr[8]  = t.basis.elements[2][0];
-                    ptr[9]  = t.basis.elements[2][1];
-                    ptr[10] = t.basis.elements[2][2];
-                    ptr[11] = t.origin.z;
-                } else {
-                    memset(ptr, 0, sizeof(float) * 12);
-                }
-
-                ptr += 17;
-            }
-
+            // in index order, the next update sorts the particles again
+            _write_particle_data(nullptr);
             can_update.set();
         }
     }
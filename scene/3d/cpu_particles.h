@@ -7,9 +7,11 @@
 #ifndef CPU_PARTICLES_H
 #define CPU_PARTICLES_H
 
+#include "core/local_vector.h"
 #include "core/rid.h"
 #include "core/safe_refcount.h"
 #include "scene/3d/visual_instance.h"
+#include "scene/main/cpu_particles_kernels.h"
 
 class CPUParticles : public GeometryInstance {
 private:
@@ -59,11 +61,11 @@ public:
 private:
     bool emitting;
 
+    // The transforms and velocities are kept in the structures of arrays
+    // below.
     struct Particle {
-        Transform transform;
         Color color;
         float custom[4];
-        Vector3 velocity;
         bool active;
         float angle_rand;
         float scale_rand;
@@ -88,6 +90,18 @@ private:
     PoolVector<float> particle_data;
     PoolVector<int> particle_order;
 
+    enum {
+        COMPONENTS = CPUParticlesKernels::COMPONENTS_3D,
+    };
+
+    // The transforms and velocities of the particles, one array per
+    // component, so that CPUParticlesKernels move them, and write them to the
+    // multimesh buffer, with SIMD.
+    LocalVector<float> transforms[COMPONENTS];
+    LocalVector<float> velocities[3];
+    // How long each particle moves at its velocity in the current step.
+    LocalVector<float> steps;
+
     struct SortLifetime {
         const Particle* particles;
 
@@ -97,12 +111,14 @@ private:
     };
 
     struct SortAxis {
-        const Particle* particles;
+        const float* x;
+        const float* y;
+        const float* z;
         Vector3 axis;
 
         bool operator()(int p_a, int p_b) const {
-            return axis.dot(particles[p_a].transform.origin)
-                 < axis.dot(particles[p_b].transform.origin);
+            return axis.dot(Vector3(x[p_a], y[p_a], z[p_a]))
+                 < axis.dot(Vector3(x[p_b], y[p_b], z[p_b]));
         }
     };
 
@@ -157,9 +173,48 @@ private:
 
     Vector3 gravity;
 
+    // The particles are processed, and written to the multimesh buffer, in
+    // chunks on a work pool shared by all the emitters. Every particle only
+    // depends on its own state and draws its own random numbers, so the
+    // result doesn't depend on the number of threads.
+    enum {
+        CHUNK_SIZE = 256,
+    };
+
+    struct ProcessState {
+        float delta;
+        float prev_time;
+        float system_phase;
+        uint32_t seed;
+        Transform emission_xform;
+        Basis velocity_xform;
+        Particle* particles;
+        float* transforms[COMPONENTS];
+        float* velocities[3];
+        float* steps;
+        int particle_count;
+        const Vector3* points;
+        const Vector3* normals;
+        const Color* colors;
+    };
+
+    struct BufferState {
+        const Particle* particles;
+        const float* transforms[COMPONENTS];
+        int particle_count;
+        const int* order;
+        float* buffer;
+    };
+
+    ProcessState process_state;
+    BufferState buffer_state;
+
     void _update_internal();
     void _particles_process(float p_delta);
+    void _process_chunk(uint32_t p_chunk, void* p_userdata);
     void _update_particle_data_buffer();
+    void _write_particle_data(const int* p_order);
+    void _write_chunk(uint32_t p_chunk, void* p_userdata);
 
     Mutex update_mutex;
 
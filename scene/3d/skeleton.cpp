@@ -230,75 +230,19 @@ void Skeleton::_notification(int p_what) {
             Bone* bonesptr   = bones.ptrw();
             int len          = bones.size();
 
-            _update_process_order();
+            if (!pose_updated) {
+                // also updated directly, without being made dirty
+                _queue_pose_update();
+                _update_pending_poses();
+            }
 
             const int* order = process_order.ptr();
 
             for (int i = 0; i < len; i++) {
                 Bone& b = bonesptr[order[i]];
 
-                if (b.disable_rest) {
-                    if (b.enabled) {
-                        Transform pose = b.pose;
-                        if (b.custom_pose_enable) {
-                            pose = b.custom_pose * pose;
-                        }
-                        if (b.parent >= 0) {
-                            b.pose_global =
-                                bonesptr[b.parent].pose_global * pose;
-                            b.pose_global_no_override =
-                                bonesptr[b.parent].pose_global_no_override
-                                * pose;
-                        } else {
-                            b.pose_global             = pose;
-                            b.pose_global_no_override = pose;
-                        }
-                    } else {
-                        if (b.parent >= 0) {
-                            b.pose_global = bonesptr[b.parent].pose_global;
-                            b.pose_global_no_override =
-                                bonesptr[b.parent].pose_global_no_override;
-                        } else {
-                            b.pose_global             = Transform();
-                            b.pose_global_no_override = Transform();
-                        }
-                    }
-                } else {
-                    if (b.enabled) {
-                        Transform pose = b.pose;
-                        if (b.custom_pose_enable) {
-                            pose = b.custom_pose * pose;
-                        }
-                        if (b.parent >= 0) {
-                            b.pose_global = bonesptr[b.parent].pose_global
-                                          * (b.rest * pose);
-                            b.pose_global_no_override =
-                                bonesptr[b.parent].pose_global_no_override
-                                * (b.rest * pose);
-                        } else {
-                            b.pose_global             = b.rest * pose;
-                            b.pose_global_no_override = b.rest * pose;
-                        }
-                    } else {
-                        if (b.parent >= 0) {
-                            b.pose_global =
-                                bonesptr[b.parent].pose_global * b.rest;
-                            b.pose_global_no_override =
-                                bonesptr[b.parent].pose_global_no_override
-                                * b.rest;
-                        } else {
-                            b.pose_global             = b.rest;
-                            b.pose_global_no_override = b.rest;
-                        }
-                    }
-                }
-
-                if (b.global_pose_override_amount >= CMP_EPSILON) {
-                    b.pose_global = b.pose_global.interpolate_with(
-                        b.global_pose_override,
-                        b.global_pose_override_amount
-                    );
-                }
+                b.pose_global             = pose.get_global(i);
+                b.pose_global_no_override = pose.get_global_no_override(i);
 
                 if (b.global_pose_override_reset) {
                     b.global_pose_override_amount = 0.0;
@@ -377,16 +321,34 @@ void Skeleton::_notification(int p_what) {
                     E->get()->skeleton_version = version;
                 }
 
-                for (uint32_t i = 0; i < bind_count; i++) {
-                    uint32_t bone_index = E->get()->skin_bone_indices_ptrs[i];
-                    ERR_CONTINUE(bone_index >= (uint32_t)len);
-                    vs->skeleton_bone_set_transform(
-                        skeleton,
-                        i,
-                        bonesptr[bone_index].pose_global
-                            * skin->get_bind_pose(i)
-                    );
+                // upload all the bones at once
+                PoolVector<float>& bone_transforms = E->get()->bone_transforms;
+                bone_transforms.resize(bind_count * 12);
+                {
+                    PoolVector<float>::Write w = bone_transforms.write();
+                    for (uint32_t i = 0; i < bind_count; i++) {
+                        uint32_t bone_index =
+                            E->get()->skin_bone_indices_ptrs[i];
+                        Transform t;
+                        if (bone_index < (uint32_t)len) {
+                            t = bonesptr[bone_index].pose_global
+                              * skin->get_bind_pose(i);
+                        } else {
+                            ERR_PRINT(
+                                "Skin bind #" + itos(i)
+                                + " is bound to a bone that doesn't exist."
+                            );
+                        }
+                        float* dst = &w[i * 12];
+                        for (int row = 0; row < 3; row++) {
+                            dst[row * 4 + 0] = t.basis[row].x;
+                            dst[row * 4 + 1] = t.basis[row].y;
+                            dst[row * 4 + 2] = t.basis[row].z;
+                            dst[row * 4 + 3] = t.origin[row];
+                        }
+                    }
                 }
+                vs->skeleton_set_as_bulk_array(skeleton, bone_transforms);
             }
 
             dirty = false;
@@ -645,6 +607,9 @@ Transform Skeleton::get_bone_custom_pose(int p_bone) const {
 }
 
 void Skeleton::_make_dirty() {
+    // even if the update is already queued, the poses must be computed again
+    _queue_pose_update();
+
     if (dirty) {
         return;
     }
@@ -656,6 +621,104 @@ void Skeleton::_make_dirty() {
     dirty = true;
 }
 
+void Skeleton::_queue_pose_update() {
+    pose_updated = false;
+
+    // the list is only drained on the main thread, so once queued the poses
+    // are computed with the latest bones and the lock can be skipped
+    if (pose_update_list.in_list()) {
+        return;
+    }
+
+    pending_pose_updates_mutex.lock();
+    pending_pose_updates->add(&pose_update_list);
+    pending_pose_updates_mutex.unlock();
+}
+
+void Skeleton::_prepare_pose() {
+    _update_process_order();
+
+    const Bone* bonesptr = bones.ptr();
+    int len              = bones.size();
+    const int* order     = process_order.ptr();
+
+    LocalVector<int> positions;
+    positions.resize(len);
+    for (int i = 0; i < len; i++) {
+        positions[order[i]] = i;
+    }
+
+    pose.resize(len);
+    for (int i = 0; i < len; i++) {
+        const Bone& b = bonesptr[order[i]];
+        int parent    = b.parent >= 0 ? positions[b.parent] : -1;
+
+        Transform rest;
+        if (!b.disable_rest) {
+            rest = b.rest;
+        }
+
+        Transform local_pose;
+        if (b.enabled) {
+            local_pose = b.pose;
+            if (b.custom_pose_enable) {
+                local_pose = b.custom_pose * local_pose;
+            }
+        }
+
+        pose.set_bone(i, parent, rest, local_pose);
+
+        if (b.global_pose_override_amount >= CMP_EPSILON) {
+            pose.set_bone_global_override(
+                i,
+                b.global_pose_override,
+                b.global_pose_override_amount
+            );
+        }
+    }
+}
+
+namespace {
+struct PoseUpdater {
+    LocalVector<SkeletonPose*> poses;
+
+    void update(uint32_t p_index, void* p_userdata) {
+        poses[p_index]->update();
+    }
+};
+} // namespace
+
+void Skeleton::_update_pending_poses() {
+    LocalVector<Skeleton*> skeletons;
+
+    pending_pose_updates_mutex.lock();
+    while (SelfList<Skeleton>* E = pending_pose_updates->first()) {
+        skeletons.push_back(E->self());
+        pending_pose_updates->remove(E);
+    }
+    pending_pose_updates_mutex.unlock();
+
+    // the bones are gathered on this thread, and only the pose math is done
+    // in parallel
+    PoseUpdater updater;
+    updater.poses.resize(skeletons.size());
+    for (unsigned int i = 0; i < skeletons.size(); i++) {
+        skeletons[i]->_prepare_pose();
+        updater.poses[i] = &skeletons[i]->pose;
+    }
+
+    pose_work_pool->do_work(
+        updater.poses.size(),
+        &updater,
+        &PoseUpdater::update,
+        nullptr
+    );
+
+    for (unsigned int i = 0; i < skeletons.size(); i++) {
+        skeletons[i]->pose_updated = true;
+    }
+}
+
 int Skeleton::get_process_order(int p_idx) {
     ERR_FAIL_INDEX_V(p_idx, bones.size(), -1);
     _update_process_order();
@@ -1052,13 +1115,41 @@ void Skeleton::_bind_methods() {
     BIND_CONSTANT(NOTIFICATION_UPDATE_SKELETON);
 }
 
-Skeleton::Skeleton() {
+SelfList<Skeleton>::List* Skeleton::pending_pose_updates = nullptr;
+Mutex Skeleton::pending_pose_updates_mutex;
+ThreadWorkPool* Skeleton::pose_work_pool = nullptr;
+
+void Skeleton::initialize_skeletons() {
+    pending_pose_updates = memnew(SelfList<Skeleton>::List);
+
+    int thread_count = ThreadWorkPool::define_thread_count_setting(
+        "rendering/threads/skeleton_pose_thread_count"
+    );
+    pose_work_pool = memnew(ThreadWorkPool);
+    pose_work_pool->init(thread_count);
+}
+
+void Skeleton::finish_skeletons() {
+    memdelete(pose_work_pool);
+    pose_work_pool = nullptr;
+    memdelete(pending_pose_updates);
+    pending_pose_updates = nullptr;
+}
+
+Skeleton::Skeleton() : pose_update_list(this) {
     dirty               = false;
     version             = 1;
     process_order_dirty = true;
+    pose_updated        = false;
 }
 
 Skeleton::~Skeleton() {
+    pending_pose_updates_mutex.lock();
+    if (pose_update_list.in_list()) {
+        pending_pose_updates->remove(&pose_update_list);
+    }
+    pending_pose_updates_mutex.unlock();
+
     // some skins may remain bound
     for (Set<SkinReference*>::Element* E = skin_bindings.front(); E;
          E                               = E->next()) {
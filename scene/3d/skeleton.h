@@ -7,7 +7,11 @@
 #ifndef SKELETON_H
 #define SKELETON_H
 
+#include "core/os/mutex.h"
+#include "core/os/thread_work_pool.h"
 #include "core/rid.h"
+#include "core/self_list.h"
+#include "scene/3d/skeleton_pose.h"
 #include "scene/3d/spatial.h"
 #include "scene/resources/skin.h"
 
@@ -30,6 +34,7 @@ class SkinReference : public Reference {
     uint64_t skeleton_version = 0;
     Vector<uint32_t> skin_bone_indices;
     uint32_t* skin_bone_indices_ptrs = nullptr;
+    PoolVector<float> bone_transforms;
     void _skin_changed();
 
 protected:
@@ -103,6 +108,20 @@ private:
 
     uint64_t version;
 
+    // The global poses are computed for all the skeletons waiting for an
+    // update at once, in parallel, when the first of them is updated.
+    static SelfList<Skeleton>::List* pending_pose_updates;
+    static Mutex pending_pose_updates_mutex;
+    static ThreadWorkPool* pose_work_pool;
+
+    SelfList<Skeleton> pose_update_list;
+    SkeletonPose pose;
+    bool pose_updated;
+
+    void _queue_pose_update();
+    void _prepare_pose();
+    static void _update_pending_poses();
+
     // bind helpers
     Array _get_bound_child_nodes_to_bone(int p_bone) const {
         Array bound;
@@ -204,6 +223,9 @@ public:
 #endif // _3D_DISABLED
 
 public:
+    static void initialize_skeletons();
+    static void finish_skeletons();
+
     Skeleton();
     ~Skeleton();
 };
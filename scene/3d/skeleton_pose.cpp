@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "skeleton_pose.h"
+
+#include "core/math/simd.h"
+
+void SkeletonPose::resize(int p_bone_count) {
+    // pad the components, so the SIMD loop doesn't need a scalar tail
+    int padded = (p_bone_count + SimdFloat::WIDTH - 1) / SimdFloat::WIDTH
+               * SimdFloat::WIDTH;
+    if ((int)rests[0].size() != padded) {
+        for (int c = 0; c < COMPONENTS; c++) {
+            rests[c].resize(padded);
+            poses[c].resize(padded);
+            locals[c].resize(padded);
+        }
+        // the padding is computed but never read, so just keep it finite
+        for (int i = p_bone_count; i < padded; i++) {
+            _store(rests, i, Transform());
+            _store(poses, i, Transform());
+        }
+    }
+    parents.resize(p_bone_count);
+    globals.resize(p_bone_count);
+    overrides.clear();
+}
+
+void SkeletonPose::set_bone(
+    int p_index,
+    int p_parent,
+    const Transform& p_rest,
+    const Transform& p_pose
+) {
+    parents[p_index] = p_parent;
+    _store(rests, p_index, p_rest);
+    _store(poses, p_index, p_pose);
+}
+
+void SkeletonPose::set_bone_global_override(
+    int p_index,
+    const Transform& p_pose,
+    float p_amount
+) {
+    Override o;
+    o.index  = p_index;
+    o.amount = p_amount;
+    o.pose   = p_pose;
+    overrides.push_back(o);
+}
+
+void SkeletonPose::update() {
+    _compute_locals();
+
+    int count = globals.size();
+    if (overrides.size()) {
+        globals_no_override.resize(count);
+    }
+
+    unsigned int next_override = 0;
+    for (int i = 0; i < count; i++) {
+        Transform local = _get_local(i);
+        int parent      = parents[i];
+
+        if (parent >= 0) {
+            globals[i] = globals[parent] * local;
+        } else {
+            globals[i] = local;
+        }
+
+        if (!overrides.size()) {
+            continue;
+        }
+
+        // the children of overridden bones follow the overridden pose, but
+        // keep the pose without overrides too
+        if (parent >= 0) {
+            globals_no_override[i] = globals_no_override[parent] * local;
+        } else {
+            globals_no_override[i] = local;
+        }
+
+        if (next_override < overrides.size()
+            && overrides[next_override].index == i) {
+            const Override& o = overrides[next_override++];
+            globals[i]        = globals[i].interpolate_with(o.pose, o.amount);
+        }
+    }
+}
+
+void SkeletonPose::_store(
+    LocalVector<float>* r_components,
+    int p_index,
+    const Transform& p_transform
+) {
+    for (int row = 0; row < 3; row++) {
+        const Vector3& basis_row           = p_transform.basis[row];
+        r_components[row * 4 + 0][p_index] = basis_row.x;
+        r_components[row * 4 + 1][p_index] = basis_row.y;
+        r_components[row * 4 + 2][p_index] = basis_row.z;
+        r_components[row * 4 + 3][p_index] = p_transform.origin[row];
+    }
+}
+
+// Computes rest * pose for all the bones, SimdFloat::WIDTH bones at a time.
+void SkeletonPose::_compute_locals() {
+    int count = rests[0].size();
+    for (int i = 0; i < count; i += SimdFloat::WIDTH) {
+        SimdFloat a[COMPONENTS];
+        SimdFloat b[COMPONENTS];
+        for (int c = 0; c < COMPONENTS; c++) {
+            a[c] = SimdFloat::load(&rests[c][i]);
+            b[c] = SimdFloat::load(&poses[c][i]);
+        }
+
+        for (int row = 0; row < 3; row++) {
+            const SimdFloat& a0 = a[row * 4 + 0];
+            const SimdFloat& a1 = a[row * 4 + 1];
+            const SimdFloat& a2 = a[row * 4 + 2];
+            for (int column = 0; column < 3; column++) {
+                SimdFloat value = a0 * b[column] + a1 * b[4 + column]
+                                + a2 * b[8 + column];
+                value.store(&locals[row * 4 + column][i]);
+            }
+            SimdFloat origin =
+                a0 * b[3] + a1 * b[7] + a2 * b[11] + a[row * 4 + 3];
+            origin.store(&locals[row * 4 + 3][i]);
+        }
+    }
+}
+
+Transform SkeletonPose::_get_local(int p_index) const {
+    Transform local;
+    for (int row = 0; row < 3; row++) {
+        local.basis[row].x = locals[row * 4 + 0][p_index];
+        local.basis[row].y = locals[row * 4 + 1][p_index];
+        local.basis[row].z = locals[row * 4 + 2][p_index];
+        local.origin[row]  = locals[row * 4 + 3][p_index];
+    }
+    return local;
+}
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef SKELETON_POSE_H
+#define SKELETON_POSE_H
+
+#include "core/local_vector.h"
+#include "core/math/transform.h"
+
+// Computes the global poses of a skeleton's bones.
+//
+// The bones are stored in process order, so every bone comes after its
+// parent. Their rests and poses are kept as structures of arrays, one array
+// per transform component, so that the local transforms of several bones are
+// computed at once with SIMD. The local transforms are then concatenated with
+// their parents' global transforms in order.
+class SkeletonPose {
+public:
+    // Also clears the global pose overrides.
+    void resize(int p_bone_count);
+
+    _FORCE_INLINE_ int size() const {
+        return globals.size();
+    }
+
+    // p_parent is the process order index of the bone's parent, or -1.
+    void set_bone(
+        int p_index,
+        int p_parent,
+        const Transform& p_rest,
+        const Transform& p_pose
+    );
+    // Overrides must be set in process order.
+    void set_bone_global_override(
+        int p_index,
+        const Transform& p_pose,
+        float p_amount
+    );
+
+    // Computes the global poses. Only touches this pose's data, so different
+    // skeletons can be updated on different threads.
+    void update();
+
+    _FORCE_INLINE_ const Transform& get_global(int p_index) const {
+        return globals[p_index];
+    }
+
+    _FORCE_INLINE_ const Transform& get_global_no_override(int p_index) const {
+        return overrides.size() ? globals_no_override[p_index]
+                                : globals[p_index];
+    }
+
+private:
+    enum {
+        COMPONENTS = 12,
+    };
+
+    struct Override {
+        int index;
+        float amount;
+        Transform pose;
+    };
+
+    LocalVector<int> parents;
+    // Rows of the basis followed by the origin's component:
+    // xx, xy, xz, ox, yx, yy, yz, oy, zx, zy, zz, oz.
+    LocalVector<float> rests[COMPONENTS];
+    LocalVector<float> poses[COMPONENTS];
+    LocalVector<float> locals[COMPONENTS];
+    // In process order.
+    LocalVector<Override> overrides;
+    LocalVector<Transform> globals;
+    LocalVector<Transform> globals_no_override;
+
+    static void _store(
+        LocalVector<float>* r_components,
+        int p_index,
+        const Transform& p_transform
+    );
+    void _compute_locals();
+    Transform _get_local(int p_index) const;
+};
+
+#endif // SKELETON_POSE_H
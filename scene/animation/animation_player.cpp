@@ -248,9 +248,11 @@ void AnimationPlayer::_ensure_node_caches(
     Animation* a = p_anim->animation.operator->();
 
     p_anim->node_cache.resize(a->get_track_count());
+    p_anim->track_cursors.resize(a->get_track_count());
 
     for (int i = 0; i < a->get_track_count(); i++) {
-        p_anim->node_cache.write[i] = NULL;
+        p_anim->node_cache.write[i]    = NULL;
+        p_anim->track_cursors.write[i] = 0;
         RES resource;
         Vector<StringName> leftover_path;
         Node* child = parent->get_node_and_resource(
@@ -432,7 +434,8 @@ void AnimationPlayer::_animation_process_animation(
                     p_time,
                     &loc,
                     &rot,
-                    &scale
+                    &scale,
+                    &p_anim->track_cursors.write[i]
                 );
                 // ERR_CONTINUE(err!=OK); //used for testing, should be removed
 
@@ -168,6 +168,8 @@ private:
         String name;
         StringName next;
         Vector<TrackNodeCache*> node_cache;
+        // Key hints for Animation::transform_track_interpolate().
+        Vector<int> track_cursors;
         Ref<Animation> animation;
     };
 
@@ -8,6 +8,7 @@
 
 #include "animation_blend_tree.h"
 #include "core/engine.h"
+#include "core/message_queue.h"
 #include "core/method_bind_ext.gen.inc"
 #include "scene/scene_string_names.h"
 #include "servers/audio/audio_stream.h"
@@ -39,26 +40,24 @@ void AnimationNode::set_parameter(
     const Variant& p_value
 ) {
     ERR_FAIL_COND(!state);
-    ERR_FAIL_COND(!state->tree->property_parent_map.has(base_path));
-    ERR_FAIL_COND(!state->tree->property_parent_map[base_path].has(p_name));
-    StringName path = state->tree->property_parent_map[base_path][p_name];
+    const HashMap<StringName, StringName>* paths =
+        state->tree->property_parent_map.getptr(base_path);
+    ERR_FAIL_COND(!paths);
+    const StringName* path = paths->getptr(p_name);
+    ERR_FAIL_COND(!path);
 
-    state->tree->property_map[path] = p_value;
+    state->tree->property_map[*path] = p_value;
 }
 
 Variant AnimationNode::get_parameter(const StringName& p_name) const {
     ERR_FAIL_COND_V(!state, Variant());
-    ERR_FAIL_COND_V(
-        !state->tree->property_parent_map.has(base_path),
-        Variant()
-    );
-    ERR_FAIL_COND_V(
-        !state->tree->property_parent_map[base_path].has(p_name),
-        Variant()
-    );
+    const HashMap<StringName, StringName>* paths =
+        state->tree->property_parent_map.getptr(base_path);
+    ERR_FAIL_COND_V(!paths, Variant());
+    const StringName* path = paths->getptr(p_name);
+    ERR_FAIL_COND_V(!path, Variant());
 
-    StringName path = state->tree->property_parent_map[base_path][p_name];
-    return state->tree->property_map[path];
+    return state->tree->property_map[*path];
 }
 
 void AnimationNode::get_child_nodes(List<ChildNode>* r_child_nodes) {
@@ -106,14 +105,23 @@ void AnimationNode::blend_animation(
 
     ERR_FAIL_COND(!animation.is_valid());
 
-    AnimationState anim_state;
-    anim_state.blend        = p_blend;
-    anim_state.track_blends = &blends;
-    anim_state.delta        = p_delta;
-    anim_state.time         = p_time;
-    anim_state.animation    = animation;
-    anim_state.seeked       = p_seeked;
+    ERR_FAIL_COND(blends.size() != state->track_count);
+    AnimationTree::AnimationTracks* tracks =
+        state->tree->_get_animation_tracks(animation.ptr());
 
+    AnimationState anim_state;
+    anim_state.blend         = p_blend;
+    anim_state.track_blends  = state->track_blends.size();
+    anim_state.track_slots   = tracks->slots.ptr();
+    anim_state.track_cursors = tracks->cursors.ptr();
+    anim_state.delta         = p_delta;
+    anim_state.time          = p_time;
+    anim_state.animation     = animation;
+    anim_state.seeked        = p_seeked;
+
+    for (int i = 0; i < blends.size(); i++) {
+        state->track_blends.push_back(blends[i]);
+    }
     state->animation_states.push_back(anim_state);
 }
 
@@ -337,19 +345,18 @@ float AnimationNode::_blend_node(
         return 0;
     }
 
-    String new_path;
+    StringName new_path;
     AnimationNode* new_parent;
 
-    // this is the slowest part of processing, but as strings process in powers
-    // of 2, and the paths always exist, it will not result in that many
-    // allocations
+    // the paths are only built once, and then looked up
     if (p_new_parent) {
         new_parent = p_new_parent;
-        new_path   = String(base_path) + String(p_subpath) + "/";
+        new_path   = state->tree->_get_node_path(base_path, p_subpath);
     } else {
         ERR_FAIL_COND_V(!parent, 0);
         new_parent = parent;
-        new_path   = String(parent->base_path) + String(p_subpath) + "/";
+        new_path =
+            state->tree->_get_node_path(parent->base_path, p_subpath);
     }
     return p_node->_pre_process(
         new_path,
@@ -896,22 +903,80 @@ bool AnimationTree::_update_caches(AnimationPlayer* player) {
     }
 
     state.track_map.clear();
+    track_slots.clear();
 
     K       = nullptr;
     int idx = 0;
     while ((K = track_cache.next(K))) {
+        TrackCache* track   = track_cache[*K];
+        track->root_motion  = root_motion_track == *K;
         state.track_map[*K] = idx;
+        track_slots.push_back(track);
         idx++;
     }
 
     state.track_count = idx;
+    transform_blends.resize(idx);
+
+    // resolve the tracks of every animation once, instead of every frame
+    animation_tracks.clear();
+    for (List<StringName>::Element* E = sname.front(); E; E = E->next()) {
+        Ref<Animation> anim = player->get_animation(E->get());
+        _resolve_animation_tracks(
+            anim.ptr(),
+            animation_tracks[anim->get_instance_id()]
+        );
+    }
 
     cache_valid = true;
 
     return true;
 }
 
+void AnimationTree::_resolve_animation_tracks(
+    const Animation* p_animation,
+    AnimationTracks& r_tracks
+) const {
+    int track_count = p_animation->get_track_count();
+    r_tracks.slots.resize(track_count);
+    r_tracks.cursors.resize(track_count);
+
+    for (int i = 0; i < track_count; i++) {
+        r_tracks.slots[i]   = -1;
+        r_tracks.cursors[i] = 0;
+
+        NodePath path   = p_animation->track_get_path(i);
+        const int* slot = state.track_map.getptr(path);
+        if (slot
+            && track_slots[*slot]->type == p_animation->track_get_type(i)) {
+            r_tracks.slots[i] = *slot;
+        }
+    }
+}
+
+AnimationTree::AnimationTracks* AnimationTree::_get_animation_tracks(
+    const Animation* p_animation
+) {
+    ObjectID id             = p_animation->get_instance_id();
+    int track_count         = p_animation->get_track_count();
+    AnimationTracks* tracks = animation_tracks.getptr(id);
+    if (likely(tracks && (int)tracks->slots.size() == track_count)) {
+        return tracks;
+    }
+
+    // The animation was added or replaced since the caches were updated.
+    // Its tracks are resolved with the current caches for now, and the
+    // caches are updated on the next process to include its tracks.
+    cache_valid = false;
+    tracks      = &animation_tracks[id];
+    _resolve_animation_tracks(p_animation, *tracks);
+    return tracks;
+}
+
 void AnimationTree::_clear_caches() {
+    // the pending blend uses the caches
+    _cancel_blend();
+
     const NodePath* K = nullptr;
     while ((K = track_cache.next(K))) {
         memdelete(track_cache[*K]);
@@ -919,10 +984,15 @@ void AnimationTree::_clear_caches() {
     playing_caches.clear();
 
     track_cache.clear();
+    track_slots.clear();
+    animation_tracks.clear();
     cache_valid = false;
 }
 
 void AnimationTree::_process_graph(float p_delta) {
+    // processed again before the last blend was applied
+    _finish_blend();
+
     _update_properties(); // if properties need updating, update them
 
     // check all tracks, see if they need modification
@@ -995,6 +1065,7 @@ void AnimationTree::_process_graph(float p_delta) {
         state.valid           = true;
         state.invalid_reasons = "";
         state.animation_states.clear(); // will need to be re-created
+        state.track_blends.clear();
         state.valid     = true;
         state.player    = player;
         state.last_pass = process_pass;
@@ -1038,109 +1109,77 @@ void AnimationTree::_process_graph(float p_delta) {
     if (!state.valid) {
         return; // state is not valid. do nothing.
     }
-    // apply value/transform/bezier blends to track caches and execute
-    // method/audio/animation tracks
 
-    {
-        bool can_call =
-            is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
-
-        for (List<AnimationNode::AnimationState>::Element* E =
-                 state.animation_states.front();
-             E;
-             E = E->next()) {
-            const AnimationNode::AnimationState& as = E->get();
-
-            Ref<Animation> a = as.animation;
-            float time       = as.time;
-            float delta      = as.delta;
-            float weight     = as.blend;
-            bool seeked      = as.seeked;
-
-            for (int i = 0; i < a->get_track_count(); i++) {
-                NodePath path = a->track_get_path(i);
-
-                ERR_CONTINUE(!track_cache.has(path));
-
-                TrackCache* track = track_cache[path];
-                if (track->type != a->track_get_type(i)) {
-                    continue; // may happen should not
-                }
-
-                track->root_motion = root_motion_track == path;
-
-                ERR_CONTINUE(!state.track_map.has(path));
-                int blend_idx = state.track_map[path];
+    // the animations are sampled and blended later, together with the other
+    // trees', unless the tree is advanced manually
+    if (process_mode != ANIMATION_PROCESS_MANUAL
+        && blend_work_pool->get_thread_count() > 1) {
+        _queue_blend();
+        return;
+    }
 
-                ERR_CONTINUE(blend_idx < 0 || blend_idx >= state.track_count);
+    _blend_tracks();
+    _apply_tracks();
+}
 
-                float blend = (*as.track_blends)[blend_idx] * weight;
+// Samples and blends the transform and bezier tracks. Only touches this
+// tree's caches, so different trees can be blended on different threads.
+void AnimationTree::_blend_tracks() {
+    const float* track_blends = state.track_blends.ptr();
 
-                if (blend < CMP_EPSILON) {
-                    continue; // nothing to blend
-                }
+    for (uint32_t s = 0; s < state.animation_states.size(); s++) {
+        const AnimationNode::AnimationState& as = state.animation_states[s];
 
-                switch (track->type) {
-                    case Animation::TYPE_TRANSFORM: {
-                        TrackCacheTransform* t =
-                            static_cast<TrackCacheTransform*>(track);
+        const Animation* a = as.animation.ptr();
+        float time         = as.time;
+        float delta        = as.delta;
+        float weight       = as.blend;
 
-                        if (track->root_motion) {
-                            if (t->process_pass != process_pass) {
-                                t->process_pass    = process_pass;
-                                t->loc             = Vector3();
-                                t->rot             = Quat();
-                                t->rot_blend_accum = 0;
-                                t->scale           = Vector3(1, 1, 1);
-                            }
+        for (int i = 0; i < a->get_track_count(); i++) {
+            int slot = as.track_slots[i];
+            if (slot < 0) {
+                continue; // not resolved, or another type of track
+            }
 
-                            float prev_time = time - delta;
-                            if (prev_time < 0) {
-                                if (!a->has_loop()) {
-                                    prev_time = 0;
-                                } else {
-                                    prev_time = a->get_length() + prev_time;
-                                }
-                            }
+            TrackCache* track = track_slots[slot];
+            if (track->type != Animation::TYPE_TRANSFORM
+                && track->type != Animation::TYPE_BEZIER) {
+                continue;
+            }
 
-                            Vector3 loc[2];
-                            Quat rot[2];
-                            Vector3 scale[2];
-
-                            if (prev_time > time) {
-                                Error err = a->transform_track_interpolate(
-                                    i,
-                                    prev_time,
-                                    &loc[0],
-                                    &rot[0],
-                                    &scale[0]
-                                );
-                                if (err != OK) {
-                                    continue;
-                                }
+            float blend = track_blends[as.track_blends + slot] * weight;
 
-                                a->transform_track_interpolate(
-                                    i,
-                                    a->get_length(),
-                                    &loc[1],
-                                    &rot[1],
-                                    &scale[1]
-                                );
+            if (blend < CMP_EPSILON) {
+                continue; // nothing to blend
+            }
 
-                                t->loc   += (loc[1] - loc[0]) * blend;
-                                t->scale += (scale[1] - scale[0]) * blend;
-                                Quat q    = Quat()
-                                             .slerp(
-                                                 rot[0].normalized().inverse()
-                                                     * rot[1].normalized(),
-                                                 blend
-                                             )
-                                             .normalized();
-                                t->rot = (t->rot * q).normalized();
+            switch (track->type) {
+                case Animation::TYPE_TRANSFORM: {
+                    TransformBlend* t = &transform_blends[slot];
+
+                    if (track->root_motion) {
+                        if (track->process_pass != process_pass) {
+                            track->process_pass = process_pass;
+                            t->loc              = Vector3();
+                            t->rot              = Quat();
+                            t->rot_blend_accum  = 0;
+                            t->scale            = Vector3(1, 1, 1);
+                        }
 
+                        float prev_time = time - delta;
+                        if (prev_time < 0) {
+                            if (!a->has_loop()) {
                                 prev_time = 0;
+                            } else {
+                                prev_time = a->get_length() + prev_time;
                             }
+                        }
+
+                        Vector3 loc[2];
+                        Quat rot[2];
+                        Vector3 scale[2];
 
+                        if (prev_time > time) {
                             Error err = a->transform_track_interpolate(
                                 i,
                                 prev_time,
@@ -1154,7 +1193,7 @@ void AnimationTree::_process_graph(float p_delta) {
 
                             a->transform_track_interpolate(
                                 i,
-                                time,
+                                a->get_length(),
                                 &loc[1],
                                 &rot[1],
                                 &scale[1]
@@ -1172,52 +1211,140 @@ void AnimationTree::_process_graph(float p_delta) {
                             t->rot = (t->rot * q).normalized();
 
                             prev_time = 0;
+                        }
 
-                        } else {
-                            Vector3 loc;
-                            Quat rot;
-                            Vector3 scale;
+                        Error err = a->transform_track_interpolate(
+                            i,
+                            prev_time,
+                            &loc[0],
+                            &rot[0],
+                            &scale[0]
+                        );
+                        if (err != OK) {
+                            continue;
+                        }
 
-                            Error err = a->transform_track_interpolate(
-                                i,
-                                time,
-                                &loc,
-                                &rot,
-                                &scale
-                            );
-                            // ERR_CONTINUE(err!=OK); //used for testing, should
-                            // be removed
+                        a->transform_track_interpolate(
+                            i,
+                            time,
+                            &loc[1],
+                            &rot[1],
+                            &scale[1]
+                        );
 
-                            if (t->process_pass != process_pass) {
-                                t->process_pass    = process_pass;
-                                t->loc             = loc;
-                                t->rot             = rot;
-                                t->rot_blend_accum = 0;
-                                t->scale           = scale;
-                            }
+                        t->loc   += (loc[1] - loc[0]) * blend;
+                        t->scale += (scale[1] - scale[0]) * blend;
+                        Quat q    = Quat()
+                                     .slerp(
+                                         rot[0].normalized().inverse()
+                                             * rot[1].normalized(),
+                                         blend
+                                     )
+                                     .normalized();
+                        t->rot = (t->rot * q).normalized();
 
-                            if (err != OK) {
-                                continue;
-                            }
+                        prev_time = 0;
 
-                            t->loc = t->loc.linear_interpolate(loc, blend);
-                            if (t->rot_blend_accum == 0) {
-                                t->rot             = rot;
-                                t->rot_blend_accum = blend;
-                            } else {
-                                float rot_total = t->rot_blend_accum + blend;
-                                t->rot          = rot.slerp(
-                                                t->rot,
-                                                t->rot_blend_accum / rot_total
-                                )
-                                             .normalized();
-                                t->rot_blend_accum = rot_total;
-                            }
-                            t->scale =
-                                t->scale.linear_interpolate(scale, blend);
+                    } else {
+                        Vector3 loc;
+                        Quat rot;
+                        Vector3 scale;
+
+                        Error err = a->transform_track_interpolate(
+                            i,
+                            time,
+                            &loc,
+                            &rot,
+                            &scale,
+                            &as.track_cursors[i]
+                        );
+                        // ERR_CONTINUE(err!=OK); //used for testing, should be
+                        // removed
+
+                        if (track->process_pass != process_pass) {
+                            track->process_pass = process_pass;
+                            t->loc              = loc;
+                            t->rot              = rot;
+                            t->rot_blend_accum  = 0;
+                            t->scale            = scale;
                         }
 
-                    } break;
+                        if (err != OK) {
+                            continue;
+                        }
+
+                        t->loc = t->loc.linear_interpolate(loc, blend);
+                        if (t->rot_blend_accum == 0) {
+                            t->rot             = rot;
+                            t->rot_blend_accum = blend;
+                        } else {
+                            float rot_total    = t->rot_blend_accum + blend;
+                            float amount       = t->rot_blend_accum / rot_total;
+                            Quat blended       = rot.slerp(t->rot, amount);
+                            t->rot             = blended.normalized();
+                            t->rot_blend_accum = rot_total;
+                        }
+                        t->scale = t->scale.linear_interpolate(scale, blend);
+                    }
+
+                } break;
+                case Animation::TYPE_BEZIER: {
+                    TrackCacheBezier* t = static_cast<TrackCacheBezier*>(track);
+
+                    float bezier = a->bezier_track_interpolate(i, time);
+
+                    if (t->process_pass != process_pass) {
+                        t->value        = bezier;
+                        t->process_pass = process_pass;
+                    }
+
+                    t->value = Math::lerp(t->value, bezier, blend);
+
+                } break;
+                default: {
+                } // applied by _apply_tracks()
+            }
+        }
+    }
+}
+
+// Applies the blended tracks to their nodes.
+void AnimationTree::_apply_tracks() {
+    // apply value blends to track caches and execute method/audio/animation
+    // tracks
+    {
+        bool can_call =
+            is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
+        const float* track_blends = state.track_blends.ptr();
+
+        for (uint32_t s = 0; s < state.animation_states.size(); s++) {
+            const AnimationNode::AnimationState& as = state.animation_states[s];
+
+            Ref<Animation> a = as.animation;
+            float time       = as.time;
+            float delta      = as.delta;
+            float weight     = as.blend;
+            bool seeked      = as.seeked;
+
+            for (int i = 0; i < a->get_track_count(); i++) {
+                int slot = as.track_slots[i];
+                if (slot < 0) {
+                    continue; // not resolved, or another type of track
+                }
+
+                TrackCache* track = track_slots[slot];
+                if (track->type == Animation::TYPE_TRANSFORM
+                    || track->type == Animation::TYPE_BEZIER) {
+                    continue; // already blended
+                }
+
+                float blend = track_blends[as.track_blends + slot] * weight;
+
+                if (blend < CMP_EPSILON) {
+                    continue; // nothing to blend
+                }
+
+                switch (track->type) {
                     case Animation::TYPE_VALUE: {
                         TrackCacheValue* t =
                             static_cast<TrackCacheValue*>(track);
@@ -1304,20 +1431,6 @@ void AnimationTree::_process_graph(float p_delta) {
                             }
                         }
 
-                    } break;
-                    case Animation::TYPE_BEZIER: {
-                        TrackCacheBezier* t =
-                            static_cast<TrackCacheBezier*>(track);
-
-                        float bezier = a->bezier_track_interpolate(i, time);
-
-                        if (t->process_pass != process_pass) {
-                            t->value        = bezier;
-                            t->process_pass = process_pass;
-                        }
-
-                        t->value = Math::lerp(t->value, bezier, blend);
-
                     } break;
                     case Animation::TYPE_AUDIO: {
                         TrackCacheAudio* t =
@@ -1532,6 +1645,8 @@ void AnimationTree::_process_graph(float p_delta) {
                         }
 
                     } break;
+                    default: {
+                    } // blended by _blend_tracks()
                 }
             }
         }
@@ -1539,9 +1654,8 @@ void AnimationTree::_process_graph(float p_delta) {
 
     {
         // finally, set the tracks
-        const NodePath* K = nullptr;
-        while ((K = track_cache.next(K))) {
-            TrackCache* track = track_cache[*K];
+        for (uint32_t i = 0; i < track_slots.size(); i++) {
+            TrackCache* track = track_slots[i];
             if (track->process_pass != process_pass) {
                 continue; // not processed, ignore
             }
@@ -1550,11 +1664,12 @@ void AnimationTree::_process_graph(float p_delta) {
                 case Animation::TYPE_TRANSFORM: {
                     TrackCacheTransform* t =
                         static_cast<TrackCacheTransform*>(track);
+                    const TransformBlend& blend = transform_blends[i];
 
                     Transform xform;
-                    xform.origin = t->loc;
+                    xform.origin = blend.loc;
 
-                    xform.basis.set_quat_scale(t->rot, t->scale);
+                    xform.basis.set_quat_scale(blend.rot, blend.scale);
 
                     if (t->root_motion) {
                         root_motion_transform = xform;
@@ -1593,6 +1708,79 @@ void AnimationTree::_process_graph(float p_delta) {
     }
 }
 
+void AnimationTree::_queue_blend() {
+    blend_pending = true;
+
+    pending_blends_mutex.lock();
+    if (!blend_list.in_list()) {
+        pending_blends->add(&blend_list);
+    }
+    pending_blends_mutex.unlock();
+
+    MessageQueue::get_singleton()->push_call(this, "_apply_pending_blend");
+}
+
+// Blends the tree now, if it is still queued, and applies the blend.
+void AnimationTree::_finish_blend() {
+    if (!blend_pending) {
+        return;
+    }
+
+    pending_blends_mutex.lock();
+    bool queued = blend_list.in_list();
+    if (queued) {
+        pending_blends->remove(&blend_list);
+    }
+    pending_blends_mutex.unlock();
+
+    if (queued) {
+        _blend_tracks();
+    }
+    _apply_tracks();
+    blend_pending = false;
+}
+
+void AnimationTree::_cancel_blend() {
+    pending_blends_mutex.lock();
+    if (blend_list.in_list()) {
+        pending_blends->remove(&blend_list);
+    }
+    pending_blends_mutex.unlock();
+
+    blend_pending = false;
+}
+
+void AnimationTree::_apply_pending_blend() {
+    if (!blend_pending) {
+        return;
+    }
+    // the first tree to be applied blends all the queued trees
+    _blend_pending_trees();
+    _finish_blend();
+}
+
+void AnimationTree::_blend_pending_trees() {
+    TreeBlender blender;
+
+    pending_blends_mutex.lock();
+    while (SelfList<AnimationTree>* E = pending_blends->first()) {
+        blender.trees.push_back(E->self());
+        pending_blends->remove(E);
+    }
+    pending_blends_mutex.unlock();
+
+    blend_work_pool->do_work(
+        blender.trees.size(),
+        &blender,
+        &TreeBlender::blend,
+        nullptr
+    );
+}
+
+void AnimationTree::TreeBlender::blend(uint32_t p_index, void* p_userdata) {
+    trees[p_index]->_blend_tracks();
+}
+
 void AnimationTree::advance(float p_time) {
     _process_graph(p_time);
 }
@@ -1696,6 +1884,8 @@ String AnimationTree::get_configuration_warning() const {
 
 void AnimationTree::set_root_motion_track(const NodePath& p_track) {
     root_motion_track = p_track;
+    // the root motion track is resolved with the caches
+    cache_valid = false;
 }
 
 NodePath AnimationTree::get_root_motion_track() const {
@@ -1768,6 +1958,20 @@ void AnimationTree::_update_properties_for_node(
     }
 }
 
+StringName AnimationTree::_get_node_path(
+    const StringName& p_base_path,
+    const StringName& p_sub_path
+) {
+    HashMap<StringName, StringName>& paths = node_path_map[p_base_path];
+    const StringName* path                 = paths.getptr(p_sub_path);
+    if (path) {
+        return *path;
+    }
+    StringName new_path = String(p_base_path) + String(p_sub_path) + "/";
+    paths[p_sub_path]   = new_path;
+    return new_path;
+}
+
 void AnimationTree::_update_properties() {
     if (!properties_dirty) {
         return;
@@ -1775,6 +1979,7 @@ void AnimationTree::_update_properties() {
 
     properties.clear();
     property_parent_map.clear();
+    node_path_map.clear();
     input_activity_map.clear();
     input_activity_map_get.clear();
 
@@ -1940,6 +2145,10 @@ void AnimationTree::_bind_methods() {
         D_METHOD("_clear_caches"),
         &AnimationTree::_clear_caches
     );
+    ClassDB::bind_method(
+        D_METHOD("_apply_pending_blend"),
+        &AnimationTree::_apply_pending_blend
+    );
 
     ADD_PROPERTY(
         PropertyInfo(
@@ -1988,7 +2197,38 @@ void AnimationTree::_bind_methods() {
     BIND_ENUM_CONSTANT(ANIMATION_PROCESS_MANUAL);
 }
 
-AnimationTree::AnimationTree() {
+SelfList<AnimationTree>::List* AnimationTree::pending_blends = nullptr;
+Mutex AnimationTree::pending_blends_mutex;
+ThreadWorkPool* AnimationTree::blend_work_pool = nullptr;
+
+void AnimationTree::initialize_animation_trees() {
+    pending_blends = memnew(SelfList<AnimationTree>::List);
+
+    int thread_count = ThreadWorkPool::define_thread_count_setting(
+        "rendering/threads/animation_tree_thread_count"
+    );
+    blend_work_pool = memnew(ThreadWorkPool);
+    blend_work_pool->init(thread_count);
+}
+
+void AnimationTree::set_blend_thread_count(int p_thread_count) {
+    ERR_FAIL_COND_MSG(
+        pending_blends->first(),
+        "Can't restart the blend threads while trees are waiting to be "
+        "blended."
+    );
+    blend_work_pool->finish();
+    blend_work_pool->init(p_thread_count);
+}
+
+void AnimationTree::finish_animation_trees() {
+    memdelete(blend_work_pool);
+    blend_work_pool = nullptr;
+    memdelete(pending_blends);
+    pending_blends = nullptr;
+}
+
+AnimationTree::AnimationTree() : blend_list(this) {
     process_mode          = ANIMATION_PROCESS_IDLE;
     active                = false;
     cache_valid           = false;
@@ -1997,6 +2237,9 @@ AnimationTree::AnimationTree() {
     started               = true;
     properties_dirty      = true;
     last_animation_player = 0;
+    blend_pending         = false;
 }
 
-AnimationTree::~AnimationTree() {}
+AnimationTree::~AnimationTree() {
+    _cancel_blend();
+}
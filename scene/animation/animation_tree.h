@@ -8,6 +8,10 @@
 #define ANIMATION_GRAPH_PLAYER_H
 
 #include "animation_player.h"
+#include "core/local_vector.h"
+#include "core/os/mutex.h"
+#include "core/os/thread_work_pool.h"
+#include "core/self_list.h"
 #include "scene/3d/skeleton.h"
 #include "scene/3d/spatial.h"
 #include "scene/resources/animation.h"
@@ -41,7 +45,11 @@ public:
         Ref<Animation> animation;
         float time;
         float delta;
-        const Vector<float>* track_blends;
+        // Offset of the track blends in State::track_blends.
+        int track_blends;
+        // The track cache slot of each of the animation's tracks, or -1.
+        const int* track_slots;
+        int* track_cursors;
         float blend;
         bool seeked;
     };
@@ -49,7 +57,10 @@ public:
     struct State {
         int track_count;
         HashMap<NodePath, int> track_map;
-        List<AnimationState> animation_states;
+        LocalVector<AnimationState> animation_states;
+        // Copied for every animation state, because the nodes, and their
+        // blends, may be shared with other trees.
+        LocalVector<float> track_blends;
         bool valid;
         AnimationPlayer* player;
         AnimationTree* tree;
@@ -209,10 +220,6 @@ private:
         Spatial* spatial;
         Skeleton* skeleton;
         int bone_idx;
-        Vector3 loc;
-        Quat rot;
-        float rot_blend_accum;
-        Vector3 scale;
 
         TrackCacheTransform() {
             type     = Animation::TYPE_TRANSFORM;
@@ -269,8 +276,28 @@ private:
         }
     };
 
+    struct TransformBlend {
+        Vector3 loc;
+        Quat rot;
+        float rot_blend_accum;
+        Vector3 scale;
+    };
+
+    // The track slots of an animation, and the key cursors of its tracks.
+    struct AnimationTracks {
+        LocalVector<int> slots;
+        LocalVector<int> cursors;
+    };
+
     HashMap<NodePath, TrackCache*> track_cache;
     Set<TrackCache*> playing_caches;
+    // The track caches in track_map order.
+    LocalVector<TrackCache*> track_slots;
+    // Indexed by track slot, only used by transform tracks.
+    LocalVector<TransformBlend> transform_blends;
+    // By animation instance ID, so renamed animations keep their tracks and
+    // replaced ones are resolved again.
+    HashMap<ObjectID, AnimationTracks> animation_tracks;
 
     Ref<AnimationNode> root;
 
@@ -285,7 +312,33 @@ private:
 
     void _clear_caches();
     bool _update_caches(AnimationPlayer* player);
+    void _resolve_animation_tracks(
+        const Animation* p_animation,
+        AnimationTracks& r_tracks
+    ) const;
+    AnimationTracks* _get_animation_tracks(const Animation* p_animation);
     void _process_graph(float p_delta);
+    void _blend_tracks();
+    void _apply_tracks();
+
+    struct TreeBlender {
+        LocalVector<AnimationTree*> trees;
+
+        void blend(uint32_t p_index, void* p_userdata);
+    };
+
+    static SelfList<AnimationTree>::List* pending_blends;
+    static Mutex pending_blends_mutex;
+    static ThreadWorkPool* blend_work_pool;
+
+    SelfList<AnimationTree> blend_list;
+    bool blend_pending;
+
+    void _queue_blend();
+    void _finish_blend();
+    void _cancel_blend();
+    void _apply_pending_blend();
+    static void _blend_pending_trees();
 
     uint64_t setup_pass;
     uint64_t process_pass;
@@ -301,6 +354,7 @@ private:
     void _update_properties();
     List<PropertyInfo> properties;
     HashMap<StringName, HashMap<StringName, StringName>> property_parent_map;
+    HashMap<StringName, HashMap<StringName, StringName>> node_path_map;
     HashMap<StringName, Variant> property_map;
 
     struct Activity {
@@ -315,6 +369,10 @@ private:
         const String& p_base_path,
         Ref<AnimationNode> node
     );
+    StringName _get_node_path(
+        const StringName& p_base_path,
+        const StringName& p_sub_path
+    );
 
     ObjectID last_animation_player;
 
@@ -356,6 +414,14 @@ public:
     void rename_parameter(const String& p_base, const String& p_new_base);
 
     uint64_t get_last_process_pass() const;
+
+    static void initialize_animation_trees();
+    static void finish_animation_trees();
+
+    // Restarts the blend threads with p_thread_count threads, overriding
+    // rendering/threads/animation_tree_thread_count.
+    static void set_blend_thread_count(int p_thread_count);
+
     AnimationTree();
     ~AnimationTree();
 };
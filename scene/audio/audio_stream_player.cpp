@@ -7,6 +7,7 @@
 #include "audio_stream_player.h"
 
 #include "core/engine.h"
+#include "servers/audio/audio_mix_kernels.h"
 
 void AudioStreamPlayer::_mix_to_bus(const AudioFrame* p_frames, int p_amount) {
     int bus_index = AudioServer::get_singleton()->thread_find_bus_index(bus);
@@ -43,9 +44,7 @@ void AudioStreamPlayer::_mix_to_bus(const AudioFrame* p_frames, int p_amount) {
         if (!targets[c]) {
             break;
         }
-        for (int i = 0; i < p_amount; i++) {
-            targets[c][i] += p_frames[i];
-        }
+        AudioMixKernels::mix(targets[c], p_frames, p_amount);
     }
 }
 
@@ -66,10 +65,7 @@ void AudioStreamPlayer::_mix_internal(bool p_fadeout) {
     float vol           = Math::db2linear(mix_volume_db);
     float vol_inc = (Math::db2linear(target_volume) - vol) / float(buffer_size);
 
-    for (int i = 0; i < buffer_size; i++) {
-        buffer[i] *= vol;
-        vol       += vol_inc;
-    }
+    AudioMixKernels::apply_ramp(buffer, buffer_size, vol, vol_inc);
 
     // set volume for next mix
     mix_volume_db = target_volume;
@@ -176,10 +172,7 @@ void AudioStreamPlayer::set_stream(Ref<AudioStream> p_stream) {
         float vol_inc =
             (Math::db2linear(target_volume) - vol) / float(buffer_size);
 
-        for (int i = 0; i < buffer_size; i++) {
-            buffer[i] *= vol;
-            vol       += vol_inc;
-        }
+        AudioMixKernels::apply_ramp(buffer, buffer_size, vol, vol_inc);
 
         use_fadeout = true;
     }
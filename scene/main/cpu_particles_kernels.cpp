@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "cpu_particles_kernels.h"
+
+#include "core/math/simd.h"
+
+// Loads p_component_count components of the particles p_index to
+// p_index + SimdFloat::WIDTH - 1, or of the particles they are sorted to.
+// Lanes past p_to repeat the last particle.
+static _FORCE_INLINE_ void _load_lanes(
+    const float* const* p_components,
+    int p_component_count,
+    const int* p_order,
+    int p_index,
+    int p_to,
+    SimdFloat* r_lanes
+) {
+    if (!p_order && p_index + SimdFloat::WIDTH <= p_to) {
+        for (int c = 0; c < p_component_count; c++) {
+            r_lanes[c] = SimdFloat::load(&p_components[c][p_index]);
+        }
+        return;
+    }
+
+    int indices[SimdFloat::WIDTH];
+    for (int k = 0; k < SimdFloat::WIDTH; k++) {
+        int i      = MIN(p_index + k, p_to - 1);
+        indices[k] = p_order ? p_order[i] : i;
+    }
+    for (int c = 0; c < p_component_count; c++) {
+        float gathered[SimdFloat::WIDTH];
+        for (int k = 0; k < SimdFloat::WIDTH; k++) {
+            gathered[k] = p_components[c][indices[k]];
+        }
+        r_lanes[c] = SimdFloat::load(gathered);
+    }
+}
+
+void CPUParticlesKernels::move(
+    float* r_position,
+    const float* p_velocity,
+    const float* p_steps,
+    int p_from,
+    int p_to
+) {
+    int i = p_from;
+    for (; i + SimdFloat::WIDTH <= p_to; i += SimdFloat::WIDTH) {
+        SimdFloat position = SimdFloat::load(r_position + i);
+        SimdFloat velocity = SimdFloat::load(p_velocity + i);
+        SimdFloat step     = SimdFloat::load(p_steps + i);
+        (position + velocity * step).store(r_position + i);
+    }
+
+    for (; i < p_to; i++) {
+        r_position[i] += p_velocity[i] * p_steps[i];
+    }
+}
+
+void CPUParticlesKernels::write_transforms(
+    const float* const* p_components,
+    const int* p_order,
+    int p_from,
+    int p_to,
+    const Transform* p_xform,
+    float* r_dst,
+    int p_dst_stride
+) {
+    SimdFloat a[COMPONENTS_3D];
+    if (p_xform) {
+        for (int row = 0; row < 3; row++) {
+            a[row * 4 + 0] = SimdFloat::splat(p_xform->basis[row].x);
+            a[row * 4 + 1] = SimdFloat::splat(p_xform->basis[row].y);
+            a[row * 4 + 2] = SimdFloat::splat(p_xform->basis[row].z);
+            a[row * 4 + 3] = SimdFloat::splat(p_xform->origin[row]);
+        }
+    }
+
+    float* dst = r_dst;
+    for (int i = p_from; i < p_to; i += SimdFloat::WIDTH) {
+        SimdFloat t[COMPONENTS_3D];
+        _load_lanes(p_components, COMPONENTS_3D, p_order, i, p_to, t);
+
+        float lanes[COMPONENTS_3D][SimdFloat::WIDTH];
+        if (p_xform) {
+            // p_xform * t, like Transform::operator*.
+            for (int row = 0; row < 3; row++) {
+                const SimdFloat& a0 = a[row * 4 + 0];
+                const SimdFloat& a1 = a[row * 4 + 1];
+                const SimdFloat& a2 = a[row * 4 + 2];
+                for (int column = 0; column < 3; column++) {
+                    SimdFloat value = a0 * t[column] + a1 * t[4 + column]
+                                    + a2 * t[8 + column];
+                    value.store(lanes[row * 4 + column]);
+                }
+                SimdFloat origin =
+                    a0 * t[3] + a1 * t[7] + a2 * t[11] + a[row * 4 + 3];
+                origin.store(lanes[row * 4 + 3]);
+            }
+        } else {
+            for (int c = 0; c < COMPONENTS_3D; c++) {
+                t[c].store(lanes[c]);
+            }
+        }
+
+        int count = MIN((int)SimdFloat::WIDTH, p_to - i);
+        for (int k = 0; k < count; k++) {
+            for (int c = 0; c < COMPONENTS_3D; c++) {
+                dst[c] = lanes[c][k];
+            }
+            dst += p_dst_stride;
+        }
+    }
+}
+
+void CPUParticlesKernels::write_transforms_2d(
+    const float* const* p_components,
+    const int* p_order,
+    int p_from,
+    int p_to,
+    const Transform2D* p_xform,
+    float* r_dst,
+    int p_dst_stride
+) {
+    SimdFloat a[COMPONENTS_2D];
+    if (p_xform) {
+        for (int row = 0; row < 2; row++) {
+            a[row * 3 + 0] = SimdFloat::splat(p_xform->elements[0][row]);
+            a[row * 3 + 1] = SimdFloat::splat(p_xform->elements[1][row]);
+            a[row * 3 + 2] = SimdFloat::splat(p_xform->elements[2][row]);
+        }
+    }
+
+    float* dst = r_dst;
+    for (int i = p_from; i < p_to; i += SimdFloat::WIDTH) {
+        SimdFloat t[COMPONENTS_2D];
+        _load_lanes(p_components, COMPONENTS_2D, p_order, i, p_to, t);
+
+        float lanes[COMPONENTS_2D][SimdFloat::WIDTH];
+        if (p_xform) {
+            // p_xform * t, like Transform2D::operator*.
+            for (int row = 0; row < 2; row++) {
+                const SimdFloat& a0 = a[row * 3 + 0];
+                const SimdFloat& a1 = a[row * 3 + 1];
+                for (int column = 0; column < 2; column++) {
+                    SimdFloat value = a0 * t[column] + a1 * t[3 + column];
+                    value.store(lanes[row * 3 + column]);
+                }
+                SimdFloat origin = a0 * t[2] + a1 * t[5] + a[row * 3 + 2];
+                origin.store(lanes[row * 3 + 2]);
+            }
+        } else {
+            for (int c = 0; c < COMPONENTS_2D; c++) {
+                t[c].store(lanes[c]);
+            }
+        }
+
+        int count = MIN((int)SimdFloat::WIDTH, p_to - i);
+        for (int k = 0; k < count; k++) {
+            dst[0] = lanes[0][k];
+            dst[1] = lanes[1][k];
+            dst[2] = 0;
+            dst[3] = lanes[2][k];
+            dst[4] = lanes[3][k];
+            dst[5] = lanes[4][k];
+            dst[6] = 0;
+            dst[7] = lanes[5][k];
+            dst   += p_dst_stride;
+        }
+    }
+}
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef CPU_PARTICLES_KERNELS_H
+#define CPU_PARTICLES_KERNELS_H
+
+#include "core/math/transform.h"
+#include "core/math/transform_2d.h"
+
+// The inner loops of CPUParticles and CPUParticles2D.
+//
+// The transforms and velocities of the particles are stored as structures of
+// arrays, one array per component, so the loops process SimdFloat::WIDTH
+// particles at a time with the SIMD instruction set selected at build time.
+// They do the same operations in the same order as the Transform and
+// Transform2D operators they replace.
+class CPUParticlesKernels {
+public:
+    enum {
+        // The rows of the basis followed by the origin's component, like the
+        // multimesh buffer: xx, xy, xz, ox, yx, yy, yz, oy, zx, zy, zz, oz.
+        COMPONENTS_3D = 12,
+        // The rows of the matrix, like the multimesh buffer without its
+        // zeros: xx, yx, ox, xy, yy, oy.
+        COMPONENTS_2D = 6,
+    };
+
+    static _FORCE_INLINE_ Transform
+    load_transform(const float* const* p_components, int p_index) {
+        Transform transform;
+        for (int row = 0; row < 3; row++) {
+            transform.basis[row].x = p_components[row * 4 + 0][p_index];
+            transform.basis[row].y = p_components[row * 4 + 1][p_index];
+            transform.basis[row].z = p_components[row * 4 + 2][p_index];
+            transform.origin[row]  = p_components[row * 4 + 3][p_index];
+        }
+        return transform;
+    }
+
+    static _FORCE_INLINE_ void store_transform(
+        float* const* r_components,
+        int p_index,
+        const Transform& p_transform
+    ) {
+        for (int row = 0; row < 3; row++) {
+            const Vector3& basis_row           = p_transform.basis[row];
+            r_components[row * 4 + 0][p_index] = basis_row.x;
+            r_components[row * 4 + 1][p_index] = basis_row.y;
+            r_components[row * 4 + 2][p_index] = basis_row.z;
+            r_components[row * 4 + 3][p_index] = p_transform.origin[row];
+        }
+    }
+
+    static _FORCE_INLINE_ Transform2D
+    load_transform_2d(const float* const* p_components, int p_index) {
+        Transform2D transform;
+        for (int row = 0; row < 2; row++) {
+            transform.elements[0][row] = p_components[row * 3 + 0][p_index];
+            transform.elements[1][row] = p_components[row * 3 + 1][p_index];
+            transform.elements[2][row] = p_components[row * 3 + 2][p_index];
+        }
+        return transform;
+    }
+
+    static _FORCE_INLINE_ void store_transform_2d(
+        float* const* r_components,
+        int p_index,
+        const Transform2D& p_transform
+    ) {
+        for (int row = 0; row < 2; row++) {
+            r_components[row * 3 + 0][p_index] = p_transform.elements[0][row];
+            r_components[row * 3 + 1][p_index] = p_transform.elements[1][row];
+            r_components[row * 3 + 2][p_index] = p_transform.elements[2][row];
+        }
+    }
+
+    // Adds p_velocity times p_steps to r_position, for the particles p_from
+    // to p_to - 1. Called once per axis.
+    static void move(
+        float* r_position,
+        const float* p_velocity,
+        const float* p_steps,
+        int p_from,
+        int p_to
+    );
+
+    // Writes the transforms of the particles p_from to p_to - 1 to r_dst,
+    // p_dst_stride floats apart. If p_order isn't null, the particles
+    // p_order[p_from] to p_order[p_to - 1] are written instead. Unless
+    // p_xform is null, the transforms are multiplied by it first.
+    static void write_transforms(
+        const float* const* p_components,
+        const int* p_order,
+        int p_from,
+        int p_to,
+        const Transform* p_xform,
+        float* r_dst,
+        int p_dst_stride
+    );
+
+    // Like write_transforms(), with the 8 floats of a 2D multimesh transform.
+    static void write_transforms_2d(
+        const float* const* p_components,
+        const int* p_order,
+        int p_from,
+        int p_to,
+        const Transform2D* p_xform,
+        float* r_dst,
+        int p_dst_stride
+    );
+};
+
+#endif // CPU_PARTICLES_KERNELS_H
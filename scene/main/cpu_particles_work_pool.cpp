@@ -0,0 +1,19 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "cpu_particles_work_pool.h"
+
+ThreadWorkPool* CPUParticlesWorkPool::work_pool = nullptr;
+
+void CPUParticlesWorkPool::initialize() {
+    work_pool = memnew(ThreadWorkPool);
+    work_pool->init(ThreadWorkPool::define_thread_count_setting(
+        "rendering/threads/cpu_particles_thread_count"
+    ));
+}
+
+void CPUParticlesWorkPool::finish() {
+    memdelete(work_pool);
+    work_pool = nullptr;
+}
@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef CPU_PARTICLES_WORK_POOL_H
+#define CPU_PARTICLES_WORK_POOL_H
+
+#include "core/os/thread_work_pool.h"
+
+// The work pool that both CPUParticles and CPUParticles2D nodes process their
+// particles on, sized by rendering/threads/cpu_particles_thread_count.
+class CPUParticlesWorkPool {
+    static ThreadWorkPool* work_pool;
+
+public:
+    _FORCE_INLINE_ static ThreadWorkPool* get_singleton() {
+        return work_pool;
+    }
+
+    static void initialize();
+    static void finish();
+};
+
+#endif // CPU_PARTICLES_WORK_POOL_H
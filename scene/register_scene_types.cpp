@@ -100,6 +100,7 @@
 #include "scene/gui/video_player.h"
 #include "scene/gui/viewport_container.h"
 #include "scene/main/canvas_layer.h"
+#include "scene/main/cpu_particles_work_pool.h"
 #include "scene/main/http_request.h"
 #include "scene/main/instance_placeholder.h"
 #include "scene/main/resource_preloader.h"
@@ -356,11 +357,13 @@ void register_scene_types() {
     ClassDB::register_class<Spatial>();
     ClassDB::register_virtual_class<SpatialGizmo>();
     ClassDB::register_class<Skeleton>();
+    Skeleton::initialize_skeletons();
     ClassDB::register_class<AnimationPlayer>();
     ClassDB::register_class<Tween>();
 
     ClassDB::register_class<AnimationTreePlayer>();
     ClassDB::register_class<AnimationTree>();
+    AnimationTree::initialize_animation_trees();
     ClassDB::register_class<AnimationNode>();
     ClassDB::register_class<AnimationRootNode>();
     ClassDB::register_class<AnimationNodeBlendTree>();
@@ -547,6 +550,7 @@ void register_scene_types() {
     CanvasItemMaterial::init_shaders();
     ClassDB::register_class<Node2D>();
     ClassDB::register_class<CPUParticles2D>();
+    CPUParticlesWorkPool::initialize();
     ClassDB::register_class<Particles2D>();
     // ClassDB::register_class<ParticleAttractor2D>();
     ClassDB::register_class<Sprite>();
@@ -639,6 +643,7 @@ void register_scene_types() {
     ClassDB::register_class<ConcavePolygonShape>();
     ClassDB::register_virtual_class<OccluderShape>();
     ClassDB::register_class<OccluderShapeSphere>();
+    ClassDB::register_class<OccluderShapeMesh>();
 
     OS::get_singleton()->yield(); // may take time to init
 
@@ -821,6 +826,10 @@ void unregister_scene_types() {
     DynamicFont::finish_dynamic_fonts();
 #endif // MODULE_FREETYPE_ENABLED
 
+    AnimationTree::finish_animation_trees();
+    Skeleton::finish_skeletons();
+    CPUParticlesWorkPool::finish();
+
     ResourceLoader::remove_resource_format_loader(
         resource_loader_texture_layered
     );
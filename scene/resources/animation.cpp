@@ -6,6 +6,7 @@
 
 #include "animation.h"
 
+#include "core/io/marshalls.h"
 #include "core/math/geometry.h"
 #include "scene/scene_string_names.h"
 
@@ -57,6 +58,12 @@ bool Animation::_set(const StringName& p_name, const Variant& p_value) {
             if (track_get_type(track) == TYPE_TRANSFORM) {
                 TransformTrack* tt =
                     static_cast<TransformTrack*>(tracks[track]);
+                if (p_value.get_type() == Variant::DICTIONARY) {
+                    tt->transforms.clear();
+                    return tt->compressed.set_data(p_value);
+                }
+                tt->compressed.clear();
+
                 PoolVector<float> values = p_value;
                 int vcount               = values.size();
                 ERR_FAIL_COND_V(vcount % 12, false); // should be multiple of 11
@@ -332,7 +339,13 @@ bool Animation::_get(const StringName& p_name, Variant& r_ret) const {
         } else if (what == "enabled") {
             r_ret = track_is_enabled(track);
         } else if (what == "keys") {
-            if (track_get_type(track) == TYPE_TRANSFORM) {
+            if (_is_transform_track_compressed(track)) {
+                const TransformTrack* tt =
+                    static_cast<const TransformTrack*>(tracks[track]);
+                r_ret = tt->compressed.get_data();
+                return true;
+
+            } else if (track_get_type(track) == TYPE_TRANSFORM) {
                 PoolVector<real_t> keys;
                 int kk = track_get_key_count(track);
                 keys.resize(kk * 12);
@@ -669,6 +682,7 @@ void Animation::remove_track(int p_track) {
         case TYPE_TRANSFORM: {
             TransformTrack* tt = static_cast<TransformTrack*>(t);
             _clear(tt->transforms);
+            tt->compressed.clear();
 
         } break;
         case TYPE_VALUE: {
@@ -829,16 +843,22 @@ Error Animation::transform_track_get_key(
 
     TransformTrack* tt = static_cast<TransformTrack*>(t);
     ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, ERR_INVALID_PARAMETER);
-    ERR_FAIL_INDEX_V(p_key, tt->transforms.size(), ERR_INVALID_PARAMETER);
+    ERR_FAIL_INDEX_V(
+        p_key,
+        track_get_key_count(p_track),
+        ERR_INVALID_PARAMETER
+    );
 
+    TransformKey key = tt->compressed.size() ? tt->compressed.get_value(p_key)
+                                             : tt->transforms[p_key].value;
     if (r_loc) {
-        *r_loc = tt->transforms[p_key].value.loc;
+        *r_loc = key.loc;
     }
     if (r_rot) {
-        *r_rot = tt->transforms[p_key].value.rot;
+        *r_rot = key.rot;
     }
     if (r_scale) {
-        *r_scale = tt->transforms[p_key].value.scale;
+        *r_scale = key.scale;
     }
 
     return OK;
@@ -856,6 +876,7 @@ int Animation::transform_track_insert_key(
     ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, -1);
 
     TransformTrack* tt = static_cast<TransformTrack*>(t);
+    _transform_track_decompress(tt);
 
     TKey<TransformKey> tkey;
     tkey.time        = p_time;
@@ -881,6 +902,7 @@ void Animation::track_remove_key(int p_track, int p_idx) {
     switch (t->type) {
         case TYPE_TRANSFORM: {
             TransformTrack* tt = static_cast<TransformTrack*>(t);
+            _transform_track_decompress(tt);
             ERR_FAIL_INDEX(p_idx, tt->transforms.size());
             tt->transforms.remove(p_idx);
 
@@ -927,7 +949,17 @@ int Animation::track_find_key(int p_track, float p_time, bool p_exact) const {
     switch (t->type) {
         case TYPE_TRANSFORM: {
             TransformTrack* tt = static_cast<TransformTrack*>(t);
-            int k              = _find(tt->transforms, p_time);
+            if (tt->compressed.size()) {
+                int k = _find(tt->compressed, p_time);
+                if (k < 0 || k >= tt->compressed.size()) {
+                    return -1;
+                }
+                if (tt->compressed.get_time(k) != p_time && p_exact) {
+                    return -1;
+                }
+                return k;
+            }
+            int k = _find(tt->transforms, p_time);
             if (k < 0 || k >= tt->transforms.size()) {
                 return -1;
             }
@@ -1119,6 +1151,9 @@ int Animation::track_get_key_count(int p_track) const {
     switch (t->type) {
         case TYPE_TRANSFORM: {
             TransformTrack* tt = static_cast<TransformTrack*>(t);
+            if (tt->compressed.size()) {
+                return tt->compressed.size();
+            }
             return tt->transforms.size();
         } break;
         case TYPE_VALUE: {
@@ -1153,13 +1188,17 @@ Variant Animation::track_get_key_value(int p_track, int p_key_idx) const {
 
     switch (t->type) {
         case TYPE_TRANSFORM: {
-            TransformTrack* tt = static_cast<TransformTrack*>(t);
-            ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), Variant());
+            Vector3 loc;
+            Quat rot;
+            Vector3 scale;
+            Error err =
+                transform_track_get_key(p_track, p_key_idx, &loc, &rot, &scale);
+            ERR_FAIL_COND_V(err != OK, Variant());
 
             Dictionary d;
-            d["location"] = tt->transforms[p_key_idx].value.loc;
-            d["rotation"] = tt->transforms[p_key_idx].value.rot;
-            d["scale"]    = tt->transforms[p_key_idx].value.scale;
+            d["location"] = loc;
+            d["rotation"] = rot;
+            d["scale"]    = scale;
 
             return d;
         } break;
@@ -1222,6 +1261,10 @@ float Animation::track_get_key_time(int p_track, int p_key_idx) const {
     switch (t->type) {
         case TYPE_TRANSFORM: {
             TransformTrack* tt = static_cast<TransformTrack*>(t);
+            if (tt->compressed.size()) {
+                ERR_FAIL_INDEX_V(p_key_idx, tt->compressed.size(), -1);
+                return tt->compressed.get_time(p_key_idx);
+            }
             ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
             return tt->transforms[p_key_idx].time;
         } break;
@@ -1267,6 +1310,7 @@ void Animation::track_set_key_time(int p_track, int p_key_idx, float p_time) {
     switch (t->type) {
         case TYPE_TRANSFORM: {
             TransformTrack* tt = static_cast<TransformTrack*>(t);
+            _transform_track_decompress(tt);
             ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
             TKey<TransformKey> key = tt->transforms[p_key_idx];
             key.time               = p_time;
@@ -1331,6 +1375,10 @@ float Animation::track_get_key_transition(int p_track, int p_key_idx) const {
     switch (t->type) {
         case TYPE_TRANSFORM: {
             TransformTrack* tt = static_cast<TransformTrack*>(t);
+            if (tt->compressed.size()) {
+                ERR_FAIL_INDEX_V(p_key_idx, tt->compressed.size(), -1);
+                return 1.0f;
+            }
             ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
             return tt->transforms[p_key_idx].transition;
         } break;
@@ -1371,6 +1419,7 @@ void Animation::track_set_key_value(
     switch (t->type) {
         case TYPE_TRANSFORM: {
             TransformTrack* tt = static_cast<TransformTrack*>(t);
+            _transform_track_decompress(tt);
             ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 
             Dictionary d = p_value;
@@ -1458,6 +1507,7 @@ void Animation::track_set_key_transition(
     switch (t->type) {
         case TYPE_TRANSFORM: {
             TransformTrack* tt = static_cast<TransformTrack*>(t);
+            _transform_track_decompress(tt);
             ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
             tt->transforms.write[p_key_idx].transition = p_transition;
         } break;
@@ -1484,12 +1534,33 @@ void Animation::track_set_key_transition(
 }
 
 template <class K>
-int Animation::_find(const Vector<K>& p_keys, float p_time) const {
+int Animation::_find(const K& p_keys, float p_time, int* r_cursor) const {
     int len = p_keys.size();
     if (len == 0) {
         return -2;
     }
 
+    if (r_cursor) {
+        // when playing, the time is usually still between the same keys, or
+        // has moved on to the next ones
+        int cursor = *r_cursor;
+        for (int i = MAX(cursor, 0); i < len && i <= cursor + 1; i++) {
+            float time = _get_key_time(p_keys, i);
+            if (time > p_time && !Math::is_equal_approx(p_time, time)) {
+                break;
+            }
+            if (i + 1 < len) {
+                float next_time = _get_key_time(p_keys, i + 1);
+                if (p_time > next_time
+                    || Math::is_equal_approx(p_time, next_time)) {
+                    continue;
+                }
+            }
+            *r_cursor = i;
+            return i;
+        }
+    }
+
     int low    = 0;
     int high   = len - 1;
     int middle = 0;
@@ -1500,24 +1571,30 @@ int Animation::_find(const Vector<K>& p_keys, float p_time) const {
     }
 #endif
 
-    const K* keys = &p_keys[0];
-
     while (low <= high) {
         middle = (low + high) / 2;
 
-        if (Math::is_equal_approx(p_time, keys[middle].time)) { // match
+        float time = _get_key_time(p_keys, middle);
+        if (Math::is_equal_approx(p_time, time)) { // match
+            if (r_cursor) {
+                *r_cursor = middle;
+            }
             return middle;
-        } else if (p_time < keys[middle].time) {
+        } else if (p_time < time) {
             high = middle - 1; // search low end of array
         } else {
             low = middle + 1; // search high end of array
         }
     }
 
-    if (keys[middle].time > p_time) {
+    if (_get_key_time(p_keys, middle) > p_time) {
         middle--;
     }
 
+    if (r_cursor && middle >= 0) {
+        *r_cursor = middle;
+    }
+
     return middle;
 }
 
@@ -1714,16 +1791,21 @@ float Animation::_cubic_interpolate(
     return _interpolate(p_a, p_b, p_c);
 }
 
-template <class T>
+template <class T, class K>
 T Animation::_interpolate(
-    const Vector<TKey<T>>& p_keys,
+    const K& p_keys,
     float p_time,
     InterpolationType p_interp,
     bool p_loop_wrap,
-    bool* p_ok
+    bool* p_ok,
+    int* r_cursor
 ) const {
-    int len = _find(p_keys, length)
-            + 1; // try to find last key (there may be more past the end)
+    int len = p_keys.size();
+    if (len == 0 || _get_key_time(p_keys, len - 1) > length
+        || Math::is_equal_approx(_get_key_time(p_keys, len - 1), length)) {
+        // try to find last key (there may be more past the end)
+        len = _find(p_keys, length) + 1;
+    }
 
     if (len <= 0) {
         // (-1 or -2 returned originally) (plus one above)
@@ -1737,10 +1819,10 @@ T Animation::_interpolate(
         if (p_ok) {
             *p_ok = true;
         }
-        return p_keys[0].value;
+        return _get_key_value(p_keys, 0);
     }
 
-    int idx = _find(p_keys, p_time);
+    int idx = _find(p_keys, p_time, r_cursor);
 
     ERR_FAIL_COND_V(idx == -2, T());
 
@@ -1754,8 +1836,9 @@ T Animation::_interpolate(
         if (idx >= 0) {
             if ((idx + 1) < len) {
                 next        = idx + 1;
-                float delta = p_keys[next].time - p_keys[idx].time;
-                float from  = p_time - p_keys[idx].time;
+                float delta =
+                    _get_key_time(p_keys, next) - _get_key_time(p_keys, idx);
+                float from  = p_time - _get_key_time(p_keys, idx);
 
                 if (Math::is_zero_approx(delta)) {
                     c = 0;
@@ -1765,8 +1848,9 @@ T Animation::_interpolate(
 
             } else {
                 next        = 0;
-                float delta = (length - p_keys[idx].time) + p_keys[next].time;
-                float from  = p_time - p_keys[idx].time;
+                float delta = (length - _get_key_time(p_keys, idx))
+                            + _get_key_time(p_keys, next);
+                float from  = p_time - _get_key_time(p_keys, idx);
 
                 if (Math::is_zero_approx(delta)) {
                     c = 0;
@@ -1779,11 +1863,11 @@ T Animation::_interpolate(
             // on loop, behind first key
             idx           = len - 1;
             next          = 0;
-            float endtime = (length - p_keys[idx].time);
+            float endtime = (length - _get_key_time(p_keys, idx));
             if (endtime < 0) { // may be keys past the end
                 endtime = 0;
             }
-            float delta = endtime + p_keys[next].time;
+            float delta = endtime + _get_key_time(p_keys, next);
             float from  = endtime + p_time;
 
             if (Math::is_zero_approx(delta)) {
@@ -1798,8 +1882,9 @@ T Animation::_interpolate(
         if (idx >= 0) {
             if ((idx + 1) < len) {
                 next        = idx + 1;
-                float delta = p_keys[next].time - p_keys[idx].time;
-                float from  = p_time - p_keys[idx].time;
+                float delta =
+                    _get_key_time(p_keys, next) - _get_key_time(p_keys, idx);
+                float from  = p_time - _get_key_time(p_keys, idx);
 
                 if (Math::is_zero_approx(delta)) {
                     c = 0;
@@ -1828,11 +1913,11 @@ T Animation::_interpolate(
         return T();
     }
 
-    float tr = p_keys[idx].transition;
+    float tr = _get_key_transition(p_keys, idx);
 
     if (tr == 0 || idx == next) {
         // don't interpolate if not needed
-        return p_keys[idx].value;
+        return _get_key_value(p_keys, idx);
     }
 
     if (tr != 1.0) {
@@ -1841,10 +1926,14 @@ T Animation::_interpolate(
 
     switch (p_interp) {
         case INTERPOLATION_NEAREST: {
-            return p_keys[idx].value;
+            return _get_key_value(p_keys, idx);
         } break;
         case INTERPOLATION_LINEAR: {
-            return _interpolate(p_keys[idx].value, p_keys[next].value, c);
+            return _interpolate(
+                _get_key_value(p_keys, idx),
+                _get_key_value(p_keys, next),
+                c
+            );
         } break;
         case INTERPOLATION_CUBIC: {
             int pre = idx - 1;
@@ -1865,16 +1954,16 @@ T Animation::_interpolate(
             }
 
             return _cubic_interpolate(
-                p_keys[pre].value,
-                p_keys[idx].value,
-                p_keys[next].value,
-                p_keys[post].value,
+                _get_key_value(p_keys, pre),
+                _get_key_value(p_keys, idx),
+                _get_key_value(p_keys, next),
+                _get_key_value(p_keys, post),
                 c
             );
 
         } break;
         default:
-            return p_keys[idx].value;
+            return _get_key_value(p_keys, idx);
     }
 
     // do a barrel roll
@@ -1885,7 +1974,8 @@ Error Animation::transform_track_interpolate(
     float p_time,
     Vector3* r_loc,
     Quat* r_rot,
-    Vector3* r_scale
+    Vector3* r_scale,
+    int* r_cursor
 ) const {
     ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
     Track* t = tracks[p_track];
@@ -1895,13 +1985,26 @@ Error Animation::transform_track_interpolate(
 
     bool ok = false;
 
-    TransformKey tk = _interpolate(
-        tt->transforms,
-        p_time,
-        tt->interpolation,
-        tt->loop_wrap,
-        &ok
-    );
+    TransformKey tk;
+    if (tt->compressed.size()) {
+        tk = _interpolate<TransformKey>(
+            tt->compressed,
+            p_time,
+            tt->interpolation,
+            tt->loop_wrap,
+            &ok,
+            r_cursor
+        );
+    } else {
+        tk = _interpolate<TransformKey>(
+            tt->transforms,
+            p_time,
+            tt->interpolation,
+            tt->loop_wrap,
+            &ok,
+            r_cursor
+        );
+    }
 
     if (!ok) {
         return ERR_UNAVAILABLE;
@@ -1930,7 +2033,7 @@ Variant Animation::value_track_interpolate(int p_track, float p_time) const {
 
     bool ok = false;
 
-    Variant res = _interpolate(
+    Variant res = _interpolate<Variant>(
         vt->values,
         p_time,
         (vt->update_mode == UPDATE_CONTINUOUS
@@ -2065,9 +2168,9 @@ Animation::UpdateMode Animation::value_track_get_update_mode(int p_track
     return vt->update_mode;
 }
 
-template <class T>
+template <class K>
 void Animation::_track_get_key_indices_in_range(
-    const Vector<T>& p_array,
+    const K& p_array,
     float from_time,
     float to_time,
     List<int>* p_indices
@@ -2082,7 +2185,7 @@ void Animation::_track_get_key_indices_in_range(
     // if event>=len then it will probably never be requested by the anim
     // player.
 
-    if (to >= 0 && p_array[to].time >= to_time) {
+    if (to >= 0 && _get_key_time(p_array, to) >= to_time) {
         to--;
     }
 
@@ -2093,7 +2196,7 @@ void Animation::_track_get_key_indices_in_range(
     int from = _find(p_array, from_time);
 
     // position in the right first event.+
-    if (from < 0 || p_array[from].time < from_time) {
+    if (from < 0 || _get_key_time(p_array, from) < from_time) {
         from++;
     }
 
@@ -2137,6 +2240,21 @@ void Animation::track_get_key_indices_in_range(
                 case TYPE_TRANSFORM: {
                     const TransformTrack* tt =
                         static_cast<const TransformTrack*>(t);
+                    if (tt->compressed.size()) {
+                        _track_get_key_indices_in_range(
+                            tt->compressed,
+                            from_time,
+                            length,
+                            p_indices
+                        );
+                        _track_get_key_indices_in_range(
+                            tt->compressed,
+                            0,
+                            to_time,
+                            p_indices
+                        );
+                        break;
+                    }
                     _track_get_key_indices_in_range(
                         tt->transforms,
                         from_time,
@@ -2254,6 +2372,15 @@ void Animation::track_get_key_indices_in_range(
     switch (t->type) {
         case TYPE_TRANSFORM: {
             const TransformTrack* tt = static_cast<const TransformTrack*>(t);
+            if (tt->compressed.size()) {
+                _track_get_key_indices_in_range(
+                    tt->compressed,
+                    from_time,
+                    to_time,
+                    p_indices
+                );
+                break;
+            }
             _track_get_key_indices_in_range(
                 tt->transforms,
                 from_time,
@@ -3027,6 +3154,10 @@ void Animation::_bind_methods() {
         D_METHOD("track_is_imported", "track_idx"),
         &Animation::track_is_imported
     );
+    ClassDB::bind_method(
+        D_METHOD("track_is_compressed", "track_idx"),
+        &Animation::track_is_compressed
+    );
 
     ClassDB::bind_method(
         D_METHOD("track_set_enabled", "track_idx", "enabled"),
@@ -3319,6 +3450,7 @@ void Animation::_bind_methods() {
         D_METHOD("copy_track", "track_idx", "to_animation"),
         &Animation::copy_track
     );
+    ClassDB::bind_method(D_METHOD("compress"), &Animation::compress);
 
     ADD_PROPERTY(
         PropertyInfo(
@@ -3561,7 +3693,11 @@ void Animation::_transform_track_optimize(
     ERR_FAIL_INDEX(p_idx, tracks.size());
     ERR_FAIL_COND(tracks[p_idx]->type != TYPE_TRANSFORM);
     TransformTrack* tt = static_cast<TransformTrack*>(tracks[p_idx]);
-    bool prev_erased   = false;
+    if (tt->compressed.size()) {
+        // compressed tracks are optimized before they are compressed
+        return;
+    }
+    bool prev_erased = false;
     TKey<TransformKey> first_erased;
 
     Vector3 norm;
@@ -3631,6 +3767,297 @@ void Animation::optimize(
     }
 }
 
+namespace {
+_FORCE_INLINE_ uint16_t quantize(float p_value, float p_begin, float p_range) {
+    if (p_range <= 0) {
+        return 0;
+    }
+    float value = (p_value - p_begin) / p_range * 65535.0f;
+    return (uint16_t)CLAMP(Math::fast_ftoi(value), 0, 65535);
+}
+
+_FORCE_INLINE_ float dequantize(
+    uint16_t p_value,
+    float p_begin,
+    float p_range
+) {
+    return p_begin + p_value * p_range * (1.0f / 65535.0f);
+}
+
+_FORCE_INLINE_ uint16_t quantize_unit(float p_value) {
+    int value = CLAMP(Math::fast_ftoi(p_value * 32767.0f), -32767, 32767);
+    return (uint16_t)(int16_t)value;
+}
+
+_FORCE_INLINE_ float dequantize_unit(uint16_t p_value) {
+    return (int16_t)p_value * (1.0f / 32767.0f);
+}
+} // namespace
+
+Animation::TransformKey Animation::CompressedTransformKeys::get_value(
+    int p_index
+) const {
+    const Page& page = pages.ptr()[p_index / PAGE_KEYS];
+    // skip the time
+    const uint16_t* value = data.ptr() + p_index * get_stride() + 1;
+
+    TransformKey key;
+    if (has_loc) {
+        for (int i = 0; i < 3; i++) {
+            key.loc[i] =
+                dequantize(*value++, page.loc_begin[i], page.loc_range[i]);
+        }
+    } else {
+        key.loc = loc;
+    }
+
+    key.rot.x = dequantize_unit(*value++);
+    key.rot.y = dequantize_unit(*value++);
+    key.rot.z = dequantize_unit(*value++);
+    key.rot.w = dequantize_unit(*value++);
+    key.rot.normalize();
+
+    if (has_scale) {
+        for (int i = 0; i < 3; i++) {
+            key.scale[i] =
+                dequantize(*value++, page.scale_begin[i], page.scale_range[i]);
+        }
+    } else {
+        key.scale = scale;
+    }
+
+    return key;
+}
+
+Animation::TKey<Animation::TransformKey>
+Animation::CompressedTransformKeys::operator[](int p_index) const {
+    TKey<TransformKey> key;
+    key.time  = get_time(p_index);
+    key.value = get_value(p_index);
+    return key;
+}
+
+void Animation::CompressedTransformKeys::compress(
+    const Vector<TKey<TransformKey>>& p_keys
+) {
+    clear();
+
+    key_count = p_keys.size();
+    if (key_count == 0) {
+        return;
+    }
+
+    const TKey<TransformKey>* keys = p_keys.ptr();
+    loc                            = keys[0].value.loc;
+    scale                          = keys[0].value.scale;
+    for (int i = 1; i < key_count; i++) {
+        has_loc   = has_loc || keys[i].value.loc != loc;
+        has_scale = has_scale || keys[i].value.scale != scale;
+    }
+
+    int page_count = (key_count + PAGE_KEYS - 1) / PAGE_KEYS;
+    pages.resize(page_count);
+    data.resize(key_count * get_stride());
+    uint16_t* value = data.ptrw();
+
+    for (int p = 0; p < page_count; p++) {
+        int begin = p * PAGE_KEYS;
+        int end   = MIN(begin + PAGE_KEYS, key_count);
+
+        Page& page      = pages.write[p];
+        page.time_begin = keys[begin].time;
+        page.time_range = keys[end - 1].time - keys[begin].time;
+
+        AABB loc_bounds(keys[begin].value.loc, Vector3());
+        AABB scale_bounds(keys[begin].value.scale, Vector3());
+        for (int i = begin + 1; i < end; i++) {
+            loc_bounds.expand_to(keys[i].value.loc);
+            scale_bounds.expand_to(keys[i].value.scale);
+        }
+        page.loc_begin   = loc_bounds.position;
+        page.loc_range   = loc_bounds.size;
+        page.scale_begin = scale_bounds.position;
+        page.scale_range = scale_bounds.size;
+
+        for (int i = begin; i < end; i++) {
+            const TransformKey& key = keys[i].value;
+
+            *value++ = quantize(keys[i].time, page.time_begin, page.time_range);
+            if (has_loc) {
+                for (int c = 0; c < 3; c++) {
+                    *value++ = quantize(
+                        key.loc[c],
+                        page.loc_begin[c],
+                        page.loc_range[c]
+                    );
+                }
+            }
+            *value++ = quantize_unit(key.rot.x);
+            *value++ = quantize_unit(key.rot.y);
+            *value++ = quantize_unit(key.rot.z);
+            *value++ = quantize_unit(key.rot.w);
+            if (has_scale) {
+                for (int c = 0; c < 3; c++) {
+                    *value++ = quantize(
+                        key.scale[c],
+                        page.scale_begin[c],
+                        page.scale_range[c]
+                    );
+                }
+            }
+        }
+    }
+}
+
+void Animation::CompressedTransformKeys::decompress(
+    Vector<TKey<TransformKey>>& r_keys
+) const {
+    r_keys.resize(key_count);
+    for (int i = 0; i < key_count; i++) {
+        r_keys.write[i] = (*this)[i];
+    }
+}
+
+void Animation::CompressedTransformKeys::clear() {
+    key_count = 0;
+    has_loc   = false;
+    has_scale = false;
+    loc       = Vector3();
+    scale     = Vector3();
+    pages.clear();
+    data.clear();
+}
+
+Dictionary Animation::CompressedTransformKeys::get_data() const {
+    PoolVector<float> page_data;
+    page_data.resize(pages.size() * 14);
+    {
+        PoolVector<float>::Write w = page_data.write();
+        int idx                    = 0;
+        for (int p = 0; p < pages.size(); p++) {
+            const Page& page = pages[p];
+            w[idx++]         = page.time_begin;
+            w[idx++]         = page.time_range;
+            for (int c = 0; c < 3; c++) {
+                w[idx++] = page.loc_begin[c];
+                w[idx++] = page.loc_range[c];
+                w[idx++] = page.scale_begin[c];
+                w[idx++] = page.scale_range[c];
+            }
+        }
+    }
+
+    PoolVector<uint8_t> key_data;
+    key_data.resize(data.size() * 2);
+    {
+        PoolVector<uint8_t>::Write w = key_data.write();
+        for (int i = 0; i < data.size(); i++) {
+            encode_uint16(data[i], &w[i * 2]);
+        }
+    }
+
+    Dictionary d;
+    d["count"] = key_count;
+    if (!has_loc) {
+        d["location"] = loc;
+    }
+    if (!has_scale) {
+        d["scale"] = scale;
+    }
+    d["pages"] = page_data;
+    d["keys"]  = key_data;
+    return d;
+}
+
+bool Animation::CompressedTransformKeys::set_data(const Dictionary& p_data) {
+    clear();
+    ERR_FAIL_COND_V(!p_data.has("count"), false);
+    ERR_FAIL_COND_V(!p_data.has("pages"), false);
+    ERR_FAIL_COND_V(!p_data.has("keys"), false);
+
+    int count = p_data["count"];
+    ERR_FAIL_COND_V(count < 0, false);
+    has_loc   = !p_data.has("location");
+    has_scale = !p_data.has("scale");
+    if (!has_loc) {
+        loc = p_data["location"];
+    }
+    if (!has_scale) {
+        scale = p_data["scale"];
+    }
+
+    PoolVector<float> page_data = p_data["pages"];
+    PoolVector<uint8_t> key_data = p_data["keys"];
+    int page_count               = (count + PAGE_KEYS - 1) / PAGE_KEYS;
+    ERR_FAIL_COND_V(page_data.size() != page_count * 14, false);
+    ERR_FAIL_COND_V(key_data.size() != count * get_stride() * 2, false);
+
+    pages.resize(page_count);
+    PoolVector<float>::Read page_read = page_data.read();
+    int idx                           = 0;
+    for (int p = 0; p < page_count; p++) {
+        Page& page      = pages.write[p];
+        page.time_begin = page_read[idx++];
+        page.time_range = page_read[idx++];
+        for (int c = 0; c < 3; c++) {
+            page.loc_begin[c]   = page_read[idx++];
+            page.loc_range[c]   = page_read[idx++];
+            page.scale_begin[c] = page_read[idx++];
+            page.scale_range[c] = page_read[idx++];
+        }
+    }
+
+    data.resize(count * get_stride());
+    PoolVector<uint8_t>::Read key_read = key_data.read();
+    for (int i = 0; i < data.size(); i++) {
+        data.write[i] = decode_uint16(&key_read[i * 2]);
+    }
+
+    key_count = count;
+    return true;
+}
+
+void Animation::_transform_track_decompress(TransformTrack* p_track) {
+    if (!p_track->compressed.size()) {
+        return;
+    }
+    p_track->compressed.decompress(p_track->transforms);
+    p_track->compressed.clear();
+}
+
+void Animation::compress() {
+    for (int i = 0; i < tracks.size(); i++) {
+        if (tracks[i]->type != TYPE_TRANSFORM) {
+            continue;
+        }
+        TransformTrack* tt = static_cast<TransformTrack*>(tracks[i]);
+        if (tt->compressed.size() || tt->transforms.empty()) {
+            continue;
+        }
+
+        // compressed keys can't be eased
+        bool eased = false;
+        for (int k = 0; k < tt->transforms.size(); k++) {
+            if (tt->transforms[k].transition != 1.0f) {
+                eased = true;
+                break;
+            }
+        }
+        if (eased) {
+            continue;
+        }
+
+        tt->compressed.compress(tt->transforms);
+        tt->transforms.clear();
+    }
+    emit_changed();
+}
+
+bool Animation::track_is_compressed(int p_track) const {
+    ERR_FAIL_INDEX_V(p_track, tracks.size(), false);
+    return _is_transform_track_compressed(p_track);
+}
+
 Animation::Animation() {
     step   = 0.1f;
     loop   = false;
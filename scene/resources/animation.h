@@ -78,10 +78,68 @@ private:
         Vector3 scale;
     };
 
+    /* COMPRESSED TRANSFORM KEYS */
+
+    // Transform keys quantized to 16 bits per component. The keys are split
+    // into pages of PAGE_KEYS keys, and each page has its own time, location
+    // and scale ranges. Locations and scales that never change are only
+    // stored once. Compressed keys always have a transition of 1.
+    struct CompressedTransformKeys {
+        enum {
+            PAGE_KEYS = 256,
+        };
+
+        struct Page {
+            float time_begin;
+            float time_range;
+            Vector3 loc_begin;
+            Vector3 loc_range;
+            Vector3 scale_begin;
+            Vector3 scale_range;
+        };
+
+        int key_count  = 0;
+        bool has_loc   = false;
+        bool has_scale = false;
+        Vector3 loc;
+        Vector3 scale;
+        Vector<Page> pages;
+        // Per key: time, location (if has_loc), rotation and scale (if
+        // has_scale).
+        Vector<uint16_t> data;
+
+        _FORCE_INLINE_ int size() const {
+            return key_count;
+        }
+
+        _FORCE_INLINE_ int get_stride() const {
+            return 5 + (has_loc ? 3 : 0) + (has_scale ? 3 : 0);
+        }
+
+        _FORCE_INLINE_ float get_time(int p_index) const {
+            const Page& page = pages.ptr()[p_index / PAGE_KEYS];
+            return page.time_begin
+                 + data.ptr()[p_index * get_stride()] * page.time_range
+                       * (1.0f / 65535.0f);
+        }
+
+        TransformKey get_value(int p_index) const;
+        TKey<TransformKey> operator[](int p_index) const;
+
+        void compress(const Vector<TKey<TransformKey>>& p_keys);
+        void decompress(Vector<TKey<TransformKey>>& r_keys) const;
+        void clear();
+
+        Dictionary get_data() const;
+        bool set_data(const Dictionary& p_data);
+    };
+
     /* TRANSFORM TRACK */
 
     struct TransformTrack : public Track {
         Vector<TKey<TransformKey>> transforms;
+        // Replaces the transforms when the track is compressed.
+        CompressedTransformKeys compressed;
 
         TransformTrack() {
             type = TYPE_TRANSFORM;
@@ -176,7 +234,63 @@ private:
     int _insert(float p_time, T& p_keys, const V& p_value);
 
     template <class K>
-    inline int _find(const Vector<K>& p_keys, float p_time) const;
+    static _FORCE_INLINE_ float _get_key_time(
+        const Vector<K>& p_keys,
+        int p_index
+    ) {
+        return p_keys.ptr()[p_index].time;
+    }
+
+    static _FORCE_INLINE_ float _get_key_time(
+        const CompressedTransformKeys& p_keys,
+        int p_index
+    ) {
+        return p_keys.get_time(p_index);
+    }
+
+    template <class K>
+    static _FORCE_INLINE_ float _get_key_transition(
+        const Vector<K>& p_keys,
+        int p_index
+    ) {
+        return p_keys.ptr()[p_index].transition;
+    }
+
+    static _FORCE_INLINE_ float _get_key_transition(
+        const CompressedTransformKeys& p_keys,
+        int p_index
+    ) {
+        return 1.0f;
+    }
+
+    // Compressed keys are decoded on every call.
+    template <class T>
+    static _FORCE_INLINE_ const T& _get_key_value(
+        const Vector<TKey<T>>& p_keys,
+        int p_index
+    ) {
+        return p_keys.ptr()[p_index].value;
+    }
+
+    static _FORCE_INLINE_ TransformKey _get_key_value(
+        const CompressedTransformKeys& p_keys,
+        int p_index
+    ) {
+        return p_keys.get_value(p_index);
+    }
+
+    // r_cursor, if given, is the key found by the previous search, which is
+    // checked before searching, and is updated with the key found.
+    template <class K>
+    inline int _find(const K& p_keys, float p_time, int* r_cursor = nullptr)
+        const;
+
+    _FORCE_INLINE_ bool _is_transform_track_compressed(int p_track) const {
+        return tracks[p_track]->type == TYPE_TRANSFORM
+            && static_cast<TransformTrack*>(tracks[p_track])->compressed.size();
+    }
+
+    void _transform_track_decompress(TransformTrack* p_track);
 
     _FORCE_INLINE_ Animation::TransformKey _interpolate(
         const Animation::TransformKey& p_a,
@@ -232,18 +346,19 @@ private:
         float p_c
     ) const;
 
-    template <class T>
+    template <class T, class K>
     _FORCE_INLINE_ T _interpolate(
-        const Vector<TKey<T>>& p_keys,
+        const K& p_keys,
         float p_time,
         InterpolationType p_interp,
         bool p_loop_wrap,
-        bool* p_ok
+        bool* p_ok,
+        int* r_cursor = nullptr
     ) const;
 
-    template <class T>
+    template <class K>
     _FORCE_INLINE_ void _track_get_key_indices_in_range(
-        const Vector<T>& p_array,
+        const K& p_array,
         float from_time,
         float to_time,
         List<int>* p_indices
@@ -460,12 +575,15 @@ public:
     void track_set_interpolation_loop_wrap(int p_track, bool p_enable);
     bool track_get_interpolation_loop_wrap(int p_track) const;
 
+    // r_cursor, if given, speeds up sampling the same track repeatedly. It
+    // must start at 0, and be kept between calls for the same track.
     Error transform_track_interpolate(
         int p_track,
         float p_time,
         Vector3* r_loc,
         Quat* r_rot,
-        Vector3* r_scale
+        Vector3* r_scale,
+        int* r_cursor = nullptr
     ) const;
 
     Variant value_track_interpolate(int p_track, float p_time) const;
@@ -513,6 +631,9 @@ public:
         float p_max_optimizable_angle = Math_PI * 0.125
     );
 
+    void compress();
+    bool track_is_compressed(int p_track) const;
+
     Animation();
     ~Animation();
 };
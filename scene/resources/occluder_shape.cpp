@@ -233,3 +233,130 @@ void OccluderShapeSphere::set_sphere_radius(int p_idx, real_t p_radius) {
 
 OccluderShapeSphere::OccluderShapeSphere() :
     OccluderShape(VisualServer::get_singleton()->occluder_create()) {}
+
+//////////////////////////////////////////////
+
+void OccluderShapeMesh::_bind_methods() {
+    ClassDB::bind_method(
+        D_METHOD("set_vertices", "vertices"),
+        &OccluderShapeMesh::set_vertices
+    );
+    ClassDB::bind_method(
+        D_METHOD("get_vertices"),
+        &OccluderShapeMesh::get_vertices
+    );
+    ClassDB::bind_method(
+        D_METHOD("set_indices", "indices"),
+        &OccluderShapeMesh::set_indices
+    );
+    ClassDB::bind_method(
+        D_METHOD("get_indices"),
+        &OccluderShapeMesh::get_indices
+    );
+
+    ADD_PROPERTY(
+        PropertyInfo(Variant::POOL_VECTOR3_ARRAY, "vertices"),
+        "set_vertices",
+        "get_vertices"
+    );
+    ADD_PROPERTY(
+        PropertyInfo(Variant::POOL_INT_ARRAY, "indices"),
+        "set_indices",
+        "get_indices"
+    );
+}
+
+void OccluderShapeMesh::update_shape_to_visual_server() {
+    VisualServer::get_singleton()->occluder_mesh_update(
+        get_shape(),
+        _vertices,
+        _indices
+    );
+}
+
+Transform OccluderShapeMesh::center_node(
+    const Transform& p_global_xform,
+    const Transform& p_parent_xform,
+    real_t p_snap
+) {
+    if (!_vertices.size()) {
+        return Transform();
+    }
+
+    // world space vertices
+    PoolVector<Vector3> vertices_world_space = _vertices;
+    {
+        PoolVector<Vector3>::Write w = vertices_world_space.write();
+        for (int n = 0; n < vertices_world_space.size(); n++) {
+            w[n] = p_global_xform.xform(w[n]);
+        }
+    }
+
+    // first find the center
+    AABB bb;
+    bb.set_position(vertices_world_space[0]);
+    for (int n = 1; n < vertices_world_space.size(); n++) {
+        bb.expand_to(vertices_world_space[n]);
+    }
+
+    Vector3 center = bb.get_center();
+
+    // snapping
+    if (p_snap > 0.0001) {
+        center.snap(Vector3(p_snap, p_snap, p_snap));
+    }
+
+    // new transform with no rotate or scale, centered
+    Transform new_local_xform = Transform();
+    new_local_xform.translate(center.x, center.y, center.z);
+
+    Transform inv_xform = new_local_xform.affine_inverse();
+
+    // back calculate the new vertices
+    {
+        PoolVector<Vector3>::Write w = vertices_world_space.write();
+        for (int n = 0; n < vertices_world_space.size(); n++) {
+            w[n] = inv_xform.xform(w[n]);
+        }
+    }
+
+#ifdef TOOLS_ENABLED
+    if (Engine::get_singleton()->is_editor_hint()) {
+        UndoRedo* undo_redo = EditorNode::get_undo_redo();
+
+        undo_redo->create_action(TTR("OccluderShapeMesh Set Vertices"));
+        undo_redo->add_do_method(this, "set_vertices", vertices_world_space);
+        undo_redo->add_undo_method(this, "set_vertices", _vertices);
+        undo_redo->commit_action();
+    } else {
+        set_vertices(vertices_world_space);
+    }
+#else
+    set_vertices(vertices_world_space);
+#endif
+
+    notify_change_to_owners();
+
+    return new_local_xform;
+}
+
+void OccluderShapeMesh::notification_enter_world(RID p_scenario) {
+    VisualServer::get_singleton()->occluder_set_scenario(
+        get_shape(),
+        p_scenario,
+        VisualServer::OCCLUDER_TYPE_MESH
+    );
+}
+
+void OccluderShapeMesh::set_vertices(const PoolVector<Vector3>& p_vertices) {
+    _vertices = p_vertices;
+    notify_change_to_owners();
+}
+
+void OccluderShapeMesh::set_indices(const PoolVector<int>& p_indices) {
+    _indices = p_indices;
+    notify_change_to_owners();
+}
+
+OccluderShapeMesh::OccluderShapeMesh() :
+    OccluderShape(VisualServer::get_singleton()->occluder_create()) {}
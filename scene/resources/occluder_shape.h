@@ -8,6 +8,7 @@
 #define OCCLUDER_SHAPE_H
 
 #include "core/math/plane.h"
+#include "core/pool_vector.h"
 #include "core/resource.h"
 #include "core/vector.h"
 
@@ -76,4 +77,37 @@ public:
     OccluderShapeSphere();
 };
 
+class OccluderShapeMesh : public OccluderShape {
+    GDCLASS(OccluderShapeMesh, OccluderShape);
+
+    PoolVector<Vector3> _vertices;
+    PoolVector<int> _indices;
+
+protected:
+    static void _bind_methods();
+
+public:
+    void set_vertices(const PoolVector<Vector3>& p_vertices);
+
+    PoolVector<Vector3> get_vertices() const {
+        return _vertices;
+    }
+
+    void set_indices(const PoolVector<int>& p_indices);
+
+    PoolVector<int> get_indices() const {
+        return _indices;
+    }
+
+    virtual void notification_enter_world(RID p_scenario);
+    virtual void update_shape_to_visual_server();
+    virtual Transform center_node(
+        const Transform& p_global_xform,
+        const Transform& p_parent_xform,
+        real_t p_snap
+    );
+
+    OccluderShapeMesh();
+};
+
 #endif // OCCLUDER_SHAPE_H
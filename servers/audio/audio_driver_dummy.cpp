@@ -78,6 +78,12 @@ void AudioDriverDummy::finish() {
     };
 };
 
+void AudioDriverDummy::mix_audio(int p_frames, int32_t* p_buffer) {
+    lock();
+    audio_server_process(p_frames, p_buffer, false);
+    unlock();
+}
+
 AudioDriverDummy::AudioDriverDummy(){
 
 };
@@ -42,6 +42,11 @@ public:
     virtual void unlock();
     virtual void finish();
 
+    // Mixes p_frames frames into p_buffer on the calling thread, for headless
+    // benchmarks. Keep the driver locked while mixing manually, so the
+    // driver's thread doesn't mix in between.
+    void mix_audio(int p_frames, int32_t* p_buffer);
+
     AudioDriverDummy();
     ~AudioDriverDummy();
 };
@@ -0,0 +1,263 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "audio_mix_kernels.h"
+
+#include "core/math/simd.h"
+
+static_assert(
+    sizeof(AudioFrame) == 2 * sizeof(float),
+    "AudioFrame must be a pair of floats."
+);
+
+enum {
+    // The number of frames in a SimdFloat.
+    SIMD_FRAMES = SimdFloat::WIDTH / 2,
+};
+
+// Left and right values in alternate lanes.
+static _FORCE_INLINE_ SimdFloat _splat_frame(const AudioFrame& p_frame) {
+    float lanes[SimdFloat::WIDTH];
+    for (int i = 0; i < SimdFloat::WIDTH; i += 2) {
+        lanes[i]     = p_frame.l;
+        lanes[i + 1] = p_frame.r;
+    }
+    return SimdFloat::load(lanes);
+}
+
+// The offset of the frame of every lane.
+static _FORCE_INLINE_ SimdFloat _lane_frames() {
+    float lanes[SimdFloat::WIDTH];
+    for (int i = 0; i < SimdFloat::WIDTH; i++) {
+        lanes[i] = float(i / 2);
+    }
+    return SimdFloat::load(lanes);
+}
+
+void AudioMixKernels::mix(
+    AudioFrame* r_dst,
+    const AudioFrame* p_src,
+    int p_frames
+) {
+    float* dst       = &r_dst->l;
+    const float* src = &p_src->l;
+
+    int i = 0;
+    for (; i + SIMD_FRAMES <= p_frames; i += SIMD_FRAMES) {
+        SimdFloat a = SimdFloat::load(dst + i * 2);
+        SimdFloat b = SimdFloat::load(src + i * 2);
+        (a + b).store(dst + i * 2);
+    }
+
+    for (; i < p_frames; i++) {
+        r_dst[i] += p_src[i];
+    }
+}
+
+void AudioMixKernels::mix_ramp(
+    AudioFrame* r_dst,
+    const AudioFrame* p_src,
+    int p_frames,
+    const AudioFrame& p_volume,
+    const AudioFrame& p_volume_step
+) {
+    float* dst       = &r_dst->l;
+    const float* src = &p_src->l;
+
+    const SimdFloat volume      = _splat_frame(p_volume);
+    const SimdFloat volume_step = _splat_frame(p_volume_step);
+    const SimdFloat lane_frames = _lane_frames();
+
+    int i = 0;
+    for (; i + SIMD_FRAMES <= p_frames; i += SIMD_FRAMES) {
+        SimdFloat frames = SimdFloat::splat(float(i)) + lane_frames;
+        SimdFloat gain   = volume + volume_step * frames;
+        SimdFloat a      = SimdFloat::load(dst + i * 2);
+        SimdFloat b      = SimdFloat::load(src + i * 2);
+        (a + b * gain).store(dst + i * 2);
+    }
+
+    for (; i < p_frames; i++) {
+        AudioFrame gain  = p_volume + p_volume_step * float(i);
+        r_dst[i]        += p_src[i] * gain;
+    }
+}
+
+void AudioMixKernels::apply_ramp(
+    AudioFrame* r_buffer,
+    int p_frames,
+    float p_volume,
+    float p_volume_step
+) {
+    float* buffer = &r_buffer->l;
+
+    const SimdFloat volume      = SimdFloat::splat(p_volume);
+    const SimdFloat volume_step = SimdFloat::splat(p_volume_step);
+    const SimdFloat lane_frames = _lane_frames();
+
+    int i = 0;
+    for (; i + SIMD_FRAMES <= p_frames; i += SIMD_FRAMES) {
+        SimdFloat frames = SimdFloat::splat(float(i)) + lane_frames;
+        SimdFloat gain   = volume + volume_step * frames;
+        (SimdFloat::load(buffer + i * 2) * gain).store(buffer + i * 2);
+    }
+
+    for (; i < p_frames; i++) {
+        r_buffer[i] *= p_volume + p_volume_step * float(i);
+    }
+}
+
+AudioFrame AudioMixKernels::apply_volume(
+    AudioFrame* r_buffer,
+    int p_frames,
+    float p_volume
+) {
+    float* buffer = &r_buffer->l;
+
+    const SimdFloat volume = SimdFloat::splat(p_volume);
+    SimdFloat peaks        = SimdFloat::splat(0.0f);
+
+    int i = 0;
+    for (; i + SIMD_FRAMES <= p_frames; i += SIMD_FRAMES) {
+        SimdFloat value = SimdFloat::load(buffer + i * 2) * volume;
+        value.store(buffer + i * 2);
+        peaks = SimdFloat::max(peaks, SimdFloat::abs(value));
+    }
+
+    float lanes[SimdFloat::WIDTH];
+    peaks.store(lanes);
+    AudioFrame peak(0, 0);
+    for (int j = 0; j < SimdFloat::WIDTH; j += 2) {
+        peak.l = MAX(peak.l, lanes[j]);
+        peak.r = MAX(peak.r, lanes[j + 1]);
+    }
+
+    for (; i < p_frames; i++) {
+        r_buffer[i] *= p_volume;
+        peak.l       = MAX(peak.l, ABS(r_buffer[i].l));
+        peak.r       = MAX(peak.r, ABS(r_buffer[i].r));
+    }
+
+    return peak;
+}
+
+void AudioMixKernels::convert_to_int32(
+    const AudioFrame* p_src,
+    int p_frames,
+    int32_t* r_dst,
+    int p_dst_stride
+) {
+    const float* src = &p_src->l;
+
+    // The samples are converted to 20 bits, and shifted to the top of the
+    // 32 bits. Both steps are exact in floating point.
+    const SimdFloat one       = SimdFloat::splat(1.0f);
+    const SimdFloat minus_one = SimdFloat::splat(-1.0f);
+    const SimdFloat scale     = SimdFloat::splat((1 << 20) - 1);
+    const SimdFloat shift     = SimdFloat::splat(1 << 11);
+
+    int32_t samples[SimdFloat::WIDTH];
+
+    int i = 0;
+    for (; i + SIMD_FRAMES <= p_frames; i += SIMD_FRAMES) {
+        SimdFloat value = SimdFloat::load(src + i * 2);
+        value = SimdFloat::min(SimdFloat::max(value, minus_one), one) * scale;
+        value = SimdFloat::truncate(value) * shift;
+
+        if (p_dst_stride == 2) {
+            value.store_truncated(r_dst + i * 2);
+            continue;
+        }
+
+        value.store_truncated(samples);
+        for (int j = 0; j < SIMD_FRAMES; j++) {
+            r_dst[(i + j) * p_dst_stride + 0] = samples[j * 2 + 0];
+            r_dst[(i + j) * p_dst_stride + 1] = samples[j * 2 + 1];
+        }
+    }
+
+    for (; i < p_frames; i++) {
+        float l    = CLAMP(p_src[i].l, -1.0f, 1.0f);
+        int32_t vl = l * ((1 << 20) - 1);
+        float r    = CLAMP(p_src[i].r, -1.0f, 1.0f);
+        int32_t vr = r * ((1 << 20) - 1);
+        r_dst[i * p_dst_stride + 0] = (vl < 0 ? -1 : 1) * (ABS(vl) << 11);
+        r_dst[i * p_dst_stride + 1] = (vr < 0 ? -1 : 1) * (ABS(vr) << 11);
+    }
+}
+
+void AudioMixKernels::resample_cubic(
+    AudioFrame* r_dst,
+    int p_frames,
+    const AudioFrame* p_src,
+    uint64_t p_offset,
+    uint64_t p_increment,
+    int p_fraction_bits
+) {
+    const uint64_t fraction_mask = (uint64_t(1) << p_fraction_bits) - 1;
+    const float fraction_scale   = 1.0f / float(uint64_t(1) << p_fraction_bits);
+
+    const SimdFloat two   = SimdFloat::splat(2.0f);
+    const SimdFloat three = SimdFloat::splat(3.0f);
+    const SimdFloat four  = SimdFloat::splat(4.0f);
+    const SimdFloat five  = SimdFloat::splat(5.0f);
+    const SimdFloat half  = SimdFloat::splat(0.5f);
+
+    float* dst = &r_dst->l;
+
+    // The source frames are gathered into lanes, and interpolated together.
+    float y0s[SimdFloat::WIDTH];
+    float y1s[SimdFloat::WIDTH];
+    float y2s[SimdFloat::WIDTH];
+    float y3s[SimdFloat::WIDTH];
+    float mus[SimdFloat::WIDTH];
+
+    int i = 0;
+    for (; i + SIMD_FRAMES <= p_frames; i += SIMD_FRAMES) {
+        for (int j = 0; j < SIMD_FRAMES; j++) {
+            uint64_t offset      = p_offset + (i + j) * p_increment;
+            const AudioFrame* y  = p_src + (offset >> p_fraction_bits);
+            float mu             = (offset & fraction_mask) * fraction_scale;
+            y0s[j * 2]           = y[0].l;
+            y0s[j * 2 + 1]       = y[0].r;
+            y1s[j * 2]           = y[1].l;
+            y1s[j * 2 + 1]       = y[1].r;
+            y2s[j * 2]           = y[2].l;
+            y2s[j * 2 + 1]       = y[2].r;
+            y3s[j * 2]           = y[3].l;
+            y3s[j * 2 + 1]       = y[3].r;
+            mus[j * 2]           = mu;
+            mus[j * 2 + 1]       = mu;
+        }
+
+        SimdFloat y0  = SimdFloat::load(y0s);
+        SimdFloat y1  = SimdFloat::load(y1s);
+        SimdFloat y2  = SimdFloat::load(y2s);
+        SimdFloat y3  = SimdFloat::load(y3s);
+        SimdFloat mu  = SimdFloat::load(mus);
+        SimdFloat mu2 = mu * mu;
+
+        SimdFloat a0 = three * y1 - three * y2 + y3 - y0;
+        SimdFloat a1 = two * y0 - five * y1 + four * y2 - y3;
+        SimdFloat a2 = y2 - y0;
+        SimdFloat a3 = two * y1;
+
+        SimdFloat value = (a0 * mu * mu2 + a1 * mu2 + a2 * mu + a3) * half;
+        value.store(dst + i * 2);
+    }
+
+    for (; i < p_frames; i++) {
+        uint64_t offset     = p_offset + i * p_increment;
+        const AudioFrame* y = p_src + (offset >> p_fraction_bits);
+        float mu            = (offset & fraction_mask) * fraction_scale;
+        float mu2           = mu * mu;
+
+        AudioFrame a0 = 3 * y[1] - 3 * y[2] + y[3] - y[0];
+        AudioFrame a1 = 2 * y[0] - 5 * y[1] + 4 * y[2] - y[3];
+        AudioFrame a2 = y[2] - y[0];
+        AudioFrame a3 = 2 * y[1];
+
+        r_dst[i] = (a0 * mu * mu2 + a1 * mu2 + a2 * mu + a3) * 0.5f;
+    }
+}
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef AUDIO_MIX_KERNELS_H
+#define AUDIO_MIX_KERNELS_H
+
+#include "core/math/audio_frame.h"
+
+// The inner loops of audio mixing.
+//
+// An array of AudioFrames is an array of interleaved left and right floats,
+// so the loops process SimdFloat::WIDTH / 2 frames at a time with the SIMD
+// instruction set selected at build time, and the remaining frames one at a
+// time. Without SIMD, SimdFloat falls back to plain floats. The SIMD and the
+// scalar loops do the same operations in the same order, so the results only
+// depend on the build's floating-point settings.
+class AudioMixKernels {
+public:
+    // Adds p_src to r_dst.
+    static void mix(AudioFrame* r_dst, const AudioFrame* p_src, int p_frames);
+
+    // Adds p_src to r_dst with a volume that starts at p_volume, and is
+    // increased by p_volume_step every frame.
+    static void mix_ramp(
+        AudioFrame* r_dst,
+        const AudioFrame* p_src,
+        int p_frames,
+        const AudioFrame& p_volume,
+        const AudioFrame& p_volume_step
+    );
+
+    // Multiplies r_buffer by a volume that starts at p_volume, and is
+    // increased by p_volume_step every frame.
+    static void apply_ramp(
+        AudioFrame* r_buffer,
+        int p_frames,
+        float p_volume,
+        float p_volume_step
+    );
+
+    // Multiplies r_buffer by p_volume, and returns the peak absolute values.
+    static AudioFrame apply_volume(
+        AudioFrame* r_buffer,
+        int p_frames,
+        float p_volume
+    );
+
+    // Converts p_frames frames to the 32-bit samples the audio drivers
+    // output, clamped to [-1, 1] with 20 bits of precision. p_dst_stride is
+    // the number of samples between two frames of r_dst.
+    static void convert_to_int32(
+        const AudioFrame* p_src,
+        int p_frames,
+        int32_t* r_dst,
+        int p_dst_stride
+    );
+
+    // Resamples with cubic interpolation. Output frame i is interpolated at
+    // the fixed point position p_offset + i * p_increment, with
+    // p_fraction_bits fractional bits, between the source frames p_src[n + 1]
+    // and p_src[n + 2], where n is the integer part.
+    static void resample_cubic(
+        AudioFrame* r_dst,
+        int p_frames,
+        const AudioFrame* p_src,
+        uint64_t p_offset,
+        uint64_t p_increment,
+        int p_fraction_bits
+    );
+};
+
+#endif // AUDIO_MIX_KERNELS_H
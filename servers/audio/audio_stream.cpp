@@ -6,6 +6,7 @@
 
 #include "audio_stream.h"
 
+#include "audio_mix_kernels.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
 
@@ -37,26 +38,30 @@ void AudioStreamPlaybackResampled::mix(
         * double(FP_LEN)
     );
 
-    for (int i = 0; i < p_frames; i++) {
-        uint32_t idx  = CUBIC_INTERP_HISTORY + uint32_t(mix_offset >> FP_BITS);
+    // The frames are resampled in runs that only read the internal buffer,
+    // which is refilled between the runs.
+    const uint64_t buffer_end = uint64_t(INTERNAL_BUFFER_LEN) << FP_BITS;
+
+    int done = 0;
+    while (done < p_frames) {
+        int todo = p_frames - done;
+        if (mix_increment > 0) {
+            uint64_t available =
+                (buffer_end - mix_offset + mix_increment - 1) / mix_increment;
+            todo = MIN(uint64_t(todo), available);
+        }
+
         // standard cubic interpolation (great quality/performance ratio)
-        // this used to be moved to a LUT for greater performance, but nowadays
-        // CPU speed is generally faster than memory.
-        float mu      = (mix_offset & FP_MASK) / float(FP_LEN);
-        AudioFrame y0 = internal_buffer[idx - 3];
-        AudioFrame y1 = internal_buffer[idx - 2];
-        AudioFrame y2 = internal_buffer[idx - 1];
-        AudioFrame y3 = internal_buffer[idx - 0];
-
-        float mu2     = mu * mu;
-        AudioFrame a0 = 3 * y1 - 3 * y2 + y3 - y0;
-        AudioFrame a1 = 2 * y0 - 5 * y1 + 4 * y2 - y3;
-        AudioFrame a2 = y2 - y0;
-        AudioFrame a3 = 2 * y1;
-
-        p_buffer[i] = (a0 * mu * mu2 + a1 * mu2 + a2 * mu + a3) / 2;
-
-        mix_offset += mix_increment;
+        AudioMixKernels::resample_cubic(
+            p_buffer + done,
+            todo,
+            internal_buffer + CUBIC_INTERP_HISTORY - 3,
+            mix_offset,
+            mix_increment,
+            FP_BITS
+        );
+        done       += todo;
+        mix_offset += mix_increment * todo;
 
         while ((mix_offset >> FP_BITS) >= INTERNAL_BUFFER_LEN) {
             internal_buffer[0] = internal_buffer[INTERNAL_BUFFER_LEN + 0];
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "audio_voice_manager.h"
+
+#include "core/math/math_funcs.h"
+#include "core/sort_array.h"
+
+int AudioVoiceManager::add_voice() {
+    MutexLock lock(mutex);
+
+    int voice;
+    if (free_voices.size()) {
+        voice = free_voices[free_voices.size() - 1];
+        free_voices.resize(free_voices.size() - 1);
+    } else {
+        voice = voices.size();
+        voices.push_back(Voice());
+    }
+    voices[voice]      = Voice();
+    voices[voice].used = true;
+    return voice;
+}
+
+void AudioVoiceManager::remove_voice(int p_voice) {
+    MutexLock lock(mutex);
+    ERR_FAIL_INDEX(p_voice, (int)voices.size());
+    ERR_FAIL_COND(!voices[p_voice].used);
+
+    voices[p_voice].used = false;
+    free_voices.push_back(p_voice);
+}
+
+void AudioVoiceManager::set_voice_state(
+    int p_voice,
+    int p_priority,
+    float p_audibility,
+    bool p_playing
+) {
+    MutexLock lock(mutex);
+    ERR_FAIL_INDEX(p_voice, (int)voices.size());
+
+    Voice& voice = voices[p_voice];
+    // A voice that starts is mixed until the next update ranks it, so that
+    // it doesn't miss its first block.
+    if (p_playing && !voice.playing) {
+        voice.is_virtual = false;
+    }
+    voice.priority   = p_priority;
+    voice.audibility = p_audibility;
+    voice.playing    = p_playing;
+}
+
+void AudioVoiceManager::set_voice_limit(int p_limit) {
+    MutexLock lock(mutex);
+    voice_limit = MAX(p_limit, 0);
+}
+
+int AudioVoiceManager::get_voice_limit() const {
+    return voice_limit;
+}
+
+void AudioVoiceManager::set_audibility_threshold_db(float p_threshold_db) {
+    MutexLock lock(mutex);
+    audibility_threshold_db = p_threshold_db;
+    audibility_threshold    = Math::db2linear(p_threshold_db);
+}
+
+float AudioVoiceManager::get_audibility_threshold_db() const {
+    return audibility_threshold_db;
+}
+
+void AudioVoiceManager::update() {
+    MutexLock lock(mutex);
+
+    ranks.clear();
+    for (uint32_t i = 0; i < voices.size(); i++) {
+        const Voice& voice = voices[i];
+        if (!voice.used || !voice.playing) {
+            continue;
+        }
+        if (voice_limit > 0 && voice.audibility < audibility_threshold) {
+            continue;
+        }
+        Rank rank;
+        rank.voice      = i;
+        rank.priority   = voice.priority;
+        rank.audibility = voice.audibility;
+        ranks.push_back(rank);
+    }
+
+    // Only the voices within the limit need to be found, not sorted.
+    int real_count = ranks.size();
+    if (voice_limit > 0 && real_count > voice_limit) {
+        SortArray<Rank> sorter;
+        sorter.nth_element(0, real_count, voice_limit, ranks.ptr());
+        real_count = voice_limit;
+    }
+
+    for (uint32_t i = 0; i < voices.size(); i++) {
+        voices[i].is_virtual = true;
+    }
+    for (int i = 0; i < real_count; i++) {
+        voices[ranks[i].voice].is_virtual = false;
+    }
+    real_voice_count = real_count;
+}
+
+bool AudioVoiceManager::is_voice_virtual(int p_voice) const {
+    MutexLock lock(mutex);
+    ERR_FAIL_INDEX_V(p_voice, (int)voices.size(), false);
+    return voice_limit > 0 && voices[p_voice].is_virtual;
+}
+
+int AudioVoiceManager::get_real_voice_count() const {
+    return real_voice_count;
+}
+
+AudioVoiceManager::AudioVoiceManager() {
+    voice_limit             = 0;
+    audibility_threshold_db = -80;
+    audibility_threshold    = Math::db2linear(audibility_threshold_db);
+    real_voice_count        = 0;
+}
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef AUDIO_VOICE_MANAGER_H
+#define AUDIO_VOICE_MANAGER_H
+
+#include "core/local_vector.h"
+#include "core/os/mutex.h"
+
+// Limits the number of voices that are mixed.
+//
+// Players add a voice, and set its priority and audibility whenever they
+// update their outputs. When there is a limit, before every mix step, the
+// playing voices that are audible are ranked by priority, and then by
+// audibility, and only the first voice limit of them are mixed. The others
+// are virtual: their players keep track of the playback position, without
+// decoding or mixing, until they are ranked high enough again. Voices that
+// start are mixed until the next update ranks them.
+class AudioVoiceManager {
+public:
+    // Returns the new voice's ID.
+    int add_voice();
+    void remove_voice(int p_voice);
+
+    // p_audibility is the voice's loudest output volume, in linear units.
+    void set_voice_state(
+        int p_voice,
+        int p_priority,
+        float p_audibility,
+        bool p_playing
+    );
+
+    // 0 = no limit.
+    void set_voice_limit(int p_limit);
+    int get_voice_limit() const;
+
+    // When there is a limit, voices that are quieter are virtual too, even
+    // if they are within it. Without a limit, no voice is virtual.
+    void set_audibility_threshold_db(float p_threshold_db);
+    float get_audibility_threshold_db() const;
+
+    // do not use from outside audio thread
+    void update();
+    bool is_voice_virtual(int p_voice) const;
+
+    // Returns the number of voices that were mixed by the last update.
+    int get_real_voice_count() const;
+
+    AudioVoiceManager();
+
+private:
+    struct Voice {
+        int priority     = 0;
+        float audibility = 0;
+        bool playing     = false;
+        bool used        = false;
+        bool is_virtual  = false;
+    };
+
+    struct Rank {
+        int voice;
+        int priority;
+        float audibility;
+
+        // Sorts the louder voices of the higher priorities first.
+        bool operator<(const Rank& p_rank) const {
+            if (priority != p_rank.priority) {
+                return priority > p_rank.priority;
+            }
+            if (audibility != p_rank.audibility) {
+                return audibility > p_rank.audibility;
+            }
+            return voice < p_rank.voice;
+        }
+    };
+
+    mutable Mutex mutex;
+    LocalVector<Voice> voices;
+    LocalVector<int> free_voices;
+    LocalVector<Rank> ranks;
+
+    int voice_limit;
+    float audibility_threshold_db;
+    float audibility_threshold;
+    int real_voice_count;
+};
+
+#endif // AUDIO_VOICE_MANAGER_H
@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "audio_effect_convolution_reverb.h"
+
+#include "servers/audio_server.h"
+
+void AudioEffectConvolutionReverbInstance::process(
+    const AudioFrame* p_src_frames,
+    AudioFrame* p_dst_frames,
+    int p_frame_count
+) {
+    if (version != base->version) {
+        reverb.set_spectra(base->spectra);
+        version = base->version;
+    }
+    reverb.process(
+        p_src_frames,
+        p_dst_frames,
+        p_frame_count,
+        base->dry,
+        base->wet
+    );
+}
+
+AudioEffectConvolutionReverbInstance::AudioEffectConvolutionReverbInstance() {
+    version = 0;
+}
+
+Ref<AudioEffectInstance> AudioEffectConvolutionReverb::instance() {
+    Ref<AudioEffectConvolutionReverbInstance> ins;
+    ins.instance();
+    ins->base = Ref<AudioEffectConvolutionReverb>(this);
+    ins->reverb.set_spectra(spectra);
+    ins->version = version;
+    return ins;
+}
+
+// Decodes the impulse into stereo frames at the audio server's mix rate.
+void AudioEffectConvolutionReverb::_decode_impulse(
+    const Ref<AudioStreamSample>& p_impulse,
+    LocalVector<AudioFrame>& r_frames
+) {
+    r_frames.clear();
+
+    AudioStreamSample::Format format = p_impulse->get_format();
+    ERR_FAIL_COND_MSG(
+        format == AudioStreamSample::FORMAT_IMA_ADPCM,
+        "IMA ADPCM compressed impulses aren't supported."
+    );
+
+    int channels     = p_impulse->is_stereo() ? 2 : 1;
+    int sample_bytes = format == AudioStreamSample::FORMAT_16_BITS ? 2 : 1;
+
+    PoolVector<uint8_t> data = p_impulse->get_data();
+    int frame_count          = data.size() / (channels * sample_bytes);
+    if (frame_count == 0) {
+        return;
+    }
+
+    LocalVector<AudioFrame> frames;
+    frames.resize(frame_count);
+    PoolVector<uint8_t>::Read r = data.read();
+    for (int i = 0; i < frame_count; i++) {
+        float samples[2];
+        for (int c = 0; c < channels; c++) {
+            int offset = (i * channels + c) * sample_bytes;
+            if (sample_bytes == 2) {
+                int16_t sample = r[offset] | (r[offset + 1] << 8);
+                samples[c]     = sample / 32768.0f;
+            } else {
+                samples[c] = (int8_t)r[offset] / 128.0f;
+            }
+        }
+        frames[i] = AudioFrame(samples[0], samples[channels - 1]);
+    }
+
+    float mix_rate = AudioServer::get_singleton()->get_mix_rate();
+    float step     = p_impulse->get_mix_rate() / mix_rate;
+    if (step == 1.0f) {
+        r_frames = frames;
+        return;
+    }
+
+    // Linear interpolation is enough for a reverb's tail.
+    int resampled_count = MAX(1, (int)(frame_count / step));
+    r_frames.resize(resampled_count);
+    for (int i = 0; i < resampled_count; i++) {
+        float position = i * step;
+        int index      = (int)position;
+        int next       = MIN(index + 1, frame_count - 1);
+        float fraction = position - index;
+
+        r_frames[i] =
+            frames[index] * (1.0f - fraction) + frames[next] * fraction;
+    }
+}
+
+void AudioEffectConvolutionReverb::set_impulse(
+    const Ref<AudioStreamSample>& p_impulse
+) {
+    impulse = p_impulse;
+
+    // The spectra are computed outside the lock, to not stall the mix.
+    Vector<float> new_spectra;
+    if (impulse.is_valid()) {
+        LocalVector<AudioFrame> frames;
+        _decode_impulse(impulse, frames);
+        ConvolutionReverb::compute_spectra(
+            frames.ptr(),
+            frames.size(),
+            new_spectra
+        );
+    }
+
+    AudioServer::get_singleton()->lock();
+    spectra = new_spectra;
+    version++;
+    AudioServer::get_singleton()->unlock();
+}
+
+Ref<AudioStreamSample> AudioEffectConvolutionReverb::get_impulse() const {
+    return impulse;
+}
+
+void AudioEffectConvolutionReverb::set_dry(float p_dry) {
+    dry = p_dry;
+}
+
+float AudioEffectConvolutionReverb::get_dry() const {
+    return dry;
+}
+
+void AudioEffectConvolutionReverb::set_wet(float p_wet) {
+    wet = p_wet;
+}
+
+float AudioEffectConvolutionReverb::get_wet() const {
+    return wet;
+}
+
+void AudioEffectConvolutionReverb::_bind_methods() {
+    ClassDB::bind_method(
+        D_METHOD("set_impulse", "impulse"),
+        &AudioEffectConvolutionReverb::set_impulse
+    );
+    ClassDB::bind_method(
+        D_METHOD("get_impulse"),
+        &AudioEffectConvolutionReverb::get_impulse
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("set_dry", "amount"),
+        &AudioEffectConvolutionReverb::set_dry
+    );
+    ClassDB::bind_method(
+        D_METHOD("get_dry"),
+        &AudioEffectConvolutionReverb::get_dry
+    );
+
+    ClassDB::bind_method(
+        D_METHOD("set_wet", "amount"),
+        &AudioEffectConvolutionReverb::set_wet
+    );
+    ClassDB::bind_method(
+        D_METHOD("get_wet"),
+        &AudioEffectConvolutionReverb::get_wet
+    );
+
+    ADD_PROPERTY(
+        PropertyInfo(
+            Variant::OBJECT,
+            "impulse",
+            PROPERTY_HINT_RESOURCE_TYPE,
+            "AudioStreamSample"
+        ),
+        "set_impulse",
+        "get_impulse"
+    );
+    ADD_PROPERTY(
+        PropertyInfo(Variant::REAL, "dry", PROPERTY_HINT_RANGE, "0,1,0.01"),
+        "set_dry",
+        "get_dry"
+    );
+    ADD_PROPERTY(
+        PropertyInfo(Variant::REAL, "wet", PROPERTY_HINT_RANGE, "0,1,0.01"),
+        "set_wet",
+        "get_wet"
+    );
+}
+
+AudioEffectConvolutionReverb::AudioEffectConvolutionReverb() {
+    dry     = 1.0f;
+    wet     = 0.5f;
+    version = 0;
+}
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef AUDIO_EFFECT_CONVOLUTION_REVERB_H
+#define AUDIO_EFFECT_CONVOLUTION_REVERB_H
+
+#include "scene/resources/audio_stream_sample.h"
+#include "servers/audio/audio_effect.h"
+#include "servers/audio/effects/convolution_reverb.h"
+
+class AudioEffectConvolutionReverb;
+
+class AudioEffectConvolutionReverbInstance : public AudioEffectInstance {
+    GDCLASS(AudioEffectConvolutionReverbInstance, AudioEffectInstance);
+
+    friend class AudioEffectConvolutionReverb;
+
+    Ref<AudioEffectConvolutionReverb> base;
+
+    ConvolutionReverb reverb;
+    uint64_t version;
+
+public:
+    virtual void process(
+        const AudioFrame* p_src_frames,
+        AudioFrame* p_dst_frames,
+        int p_frame_count
+    );
+    AudioEffectConvolutionReverbInstance();
+};
+
+class AudioEffectConvolutionReverb : public AudioEffect {
+    GDCLASS(AudioEffectConvolutionReverb, AudioEffect);
+
+    friend class AudioEffectConvolutionReverbInstance;
+
+    Ref<AudioStreamSample> impulse;
+    float dry;
+    float wet;
+
+    // The impulse's spectra, replaced under the audio server's lock, and
+    // incremented every time they are, so the instances pick them up.
+    Vector<float> spectra;
+    uint64_t version;
+
+    static void _decode_impulse(
+        const Ref<AudioStreamSample>& p_impulse,
+        LocalVector<AudioFrame>& r_frames
+    );
+
+protected:
+    static void _bind_methods();
+
+public:
+    void set_impulse(const Ref<AudioStreamSample>& p_impulse);
+    Ref<AudioStreamSample> get_impulse() const;
+
+    void set_dry(float p_dry);
+    float get_dry() const;
+
+    void set_wet(float p_wet);
+    float get_wet() const;
+
+    Ref<AudioEffectInstance> instance();
+
+    AudioEffectConvolutionReverb();
+};
+
+#endif // AUDIO_EFFECT_CONVOLUTION_REVERB_H
@@ -0,0 +1,208 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "convolution_reverb.h"
+
+#include "core/math/simd.h"
+#include "fft.h"
+
+static_assert(
+    ConvolutionReverb::SPECTRUM_SIZE % SimdFloat::WIDTH == 0,
+    "The spectra must be padded to a multiple of the SIMD width."
+);
+
+void ConvolutionReverb::compute_spectra(
+    const AudioFrame* p_impulse,
+    int p_frame_count,
+    Vector<float>& r_spectra
+) {
+    int count = (p_frame_count + PARTITION_SIZE - 1) / PARTITION_SIZE;
+    r_spectra.resize(count * PARTITION_FLOATS);
+    float* spectra = r_spectra.ptrw();
+
+    LocalVector<float> fft;
+    fft.resize(FFT_SIZE * 2);
+
+    for (int p = 0; p < count; p++) {
+        // The partition is zero padded to the size of two partitions.
+        for (int i = 0; i < FFT_SIZE * 2; i++) {
+            fft[i] = 0;
+        }
+        int from = p * PARTITION_SIZE;
+        int to   = MIN(from + PARTITION_SIZE, p_frame_count);
+        for (int i = from; i < to; i++) {
+            fft[(i - from) * 2]     = p_impulse[i].l;
+            fft[(i - from) * 2 + 1] = p_impulse[i].r;
+        }
+
+        smbFft(fft.ptr(), FFT_SIZE, -1);
+        _split_spectra(fft.ptr(), spectra + p * PARTITION_FLOATS);
+    }
+}
+
+// Separates the spectrum of a complex signal, whose real and imaginary parts
+// are the left and right channels, into the spectra of the channels, using
+// X(k) = (Z(k) + conj(Z(N - k))) / 2 and Y(k) = (Z(k) - conj(Z(N - k))) / 2i.
+void ConvolutionReverb::_split_spectra(const float* p_fft, float* r_spectra) {
+    float* l_re = r_spectra;
+    float* l_im = r_spectra + SPECTRUM_SIZE;
+    float* r_re = r_spectra + SPECTRUM_SIZE * 2;
+    float* r_im = r_spectra + SPECTRUM_SIZE * 3;
+
+    for (int k = 0; k <= PARTITION_SIZE; k++) {
+        int n    = (FFT_SIZE - k) % FFT_SIZE;
+        float ar = p_fft[k * 2];
+        float ai = p_fft[k * 2 + 1];
+        float br = p_fft[n * 2];
+        float bi = p_fft[n * 2 + 1];
+
+        l_re[k] = (ar + br) * 0.5f;
+        l_im[k] = (ai - bi) * 0.5f;
+        r_re[k] = (ai + bi) * 0.5f;
+        r_im[k] = (br - ar) * 0.5f;
+    }
+
+    for (int k = PARTITION_SIZE + 1; k < SPECTRUM_SIZE; k++) {
+        l_re[k] = 0;
+        l_im[k] = 0;
+        r_re[k] = 0;
+        r_im[k] = 0;
+    }
+}
+
+void ConvolutionReverb::set_spectra(const Vector<float>& p_spectra) {
+    spectra   = p_spectra;
+    int count = spectra.size() / PARTITION_FLOATS;
+    if (count != partition_count) {
+        partition_count = count;
+        history.resize(partition_count * PARTITION_FLOATS);
+        clear();
+    }
+}
+
+void ConvolutionReverb::process(
+    const AudioFrame* p_src_frames,
+    AudioFrame* p_dst_frames,
+    int p_frame_count,
+    float p_dry,
+    float p_wet
+) {
+    for (int i = 0; i < p_frame_count; i++) {
+        input[PARTITION_SIZE + position] = p_src_frames[i];
+        p_dst_frames[i] = p_src_frames[i] * p_dry + output[position] * p_wet;
+
+        position++;
+        if (position == PARTITION_SIZE) {
+            _process_partition();
+            position = 0;
+        }
+    }
+}
+
+void ConvolutionReverb::_process_partition() {
+    float* fft = fft_buffer.ptr();
+
+    for (int i = 0; i < FFT_SIZE; i++) {
+        fft[i * 2]     = input[i].l;
+        fft[i * 2 + 1] = input[i].r;
+    }
+    for (int i = 0; i < PARTITION_SIZE; i++) {
+        input[i] = input[PARTITION_SIZE + i];
+    }
+
+    if (partition_count == 0) {
+        for (int i = 0; i < PARTITION_SIZE; i++) {
+            output[i] = AudioFrame(0, 0);
+        }
+        return;
+    }
+
+    smbFft(fft, FFT_SIZE, -1);
+    history_position = (history_position + 1) % partition_count;
+    _split_spectra(fft, &history[history_position * PARTITION_FLOATS]);
+
+    // Multiplies every partition of the impulse response with the input
+    // from as many partitions ago, and sums the products.
+    const SimdFloat zero = SimdFloat::splat(0.0f);
+    for (int k = 0; k < SPECTRUM_SIZE * 4; k += SimdFloat::WIDTH) {
+        zero.store(&accumulator[k]);
+    }
+
+    const float* spectrum = spectra.ptr();
+    for (int p = 0; p < partition_count; p++) {
+        int h = history_position - p;
+        if (h < 0) {
+            h += partition_count;
+        }
+        const float* x = &history[h * PARTITION_FLOATS];
+        const float* y = spectrum + p * PARTITION_FLOATS;
+
+        for (int c = 0; c < 2; c++) {
+            const float* x_re = x + SPECTRUM_SIZE * c * 2;
+            const float* x_im = x_re + SPECTRUM_SIZE;
+            const float* y_re = y + SPECTRUM_SIZE * c * 2;
+            const float* y_im = y_re + SPECTRUM_SIZE;
+            float* a_re       = &accumulator[SPECTRUM_SIZE * c * 2];
+            float* a_im       = a_re + SPECTRUM_SIZE;
+
+            for (int k = 0; k < SPECTRUM_SIZE; k += SimdFloat::WIDTH) {
+                SimdFloat xr = SimdFloat::load(x_re + k);
+                SimdFloat xi = SimdFloat::load(x_im + k);
+                SimdFloat yr = SimdFloat::load(y_re + k);
+                SimdFloat yi = SimdFloat::load(y_im + k);
+                SimdFloat ar = SimdFloat::load(a_re + k) + xr * yr - xi * yi;
+                SimdFloat ai = SimdFloat::load(a_im + k) + xr * yi + xi * yr;
+                ar.store(a_re + k);
+                ai.store(a_im + k);
+            }
+        }
+    }
+
+    // Combines the left and right spectra into the spectrum of one complex
+    // signal again, using their symmetry for the upper half.
+    const float* l_re = &accumulator[0];
+    const float* l_im = &accumulator[SPECTRUM_SIZE];
+    const float* r_re = &accumulator[SPECTRUM_SIZE * 2];
+    const float* r_im = &accumulator[SPECTRUM_SIZE * 3];
+    for (int k = 0; k <= PARTITION_SIZE; k++) {
+        fft[k * 2]     = l_re[k] - r_im[k];
+        fft[k * 2 + 1] = l_im[k] + r_re[k];
+    }
+    for (int k = PARTITION_SIZE + 1; k < FFT_SIZE; k++) {
+        int n          = FFT_SIZE - k;
+        fft[k * 2]     = l_re[n] + r_im[n];
+        fft[k * 2 + 1] = r_re[n] - l_im[n];
+    }
+
+    // The first half of the result wraps around, only the second is valid.
+    smbFft(fft, FFT_SIZE, 1);
+    const float scale = 1.0f / FFT_SIZE;
+    for (int i = 0; i < PARTITION_SIZE; i++) {
+        const float* frame = fft + (PARTITION_SIZE + i) * 2;
+        output[i]          = AudioFrame(frame[0] * scale, frame[1] * scale);
+    }
+}
+
+void ConvolutionReverb::clear() {
+    for (uint32_t i = 0; i < input.size(); i++) {
+        input[i] = AudioFrame(0, 0);
+    }
+    for (uint32_t i = 0; i < output.size(); i++) {
+        output[i] = AudioFrame(0, 0);
+    }
+    for (uint32_t i = 0; i < history.size(); i++) {
+        history[i] = 0;
+    }
+    position         = 0;
+    history_position = 0;
+}
+
+ConvolutionReverb::ConvolutionReverb() {
+    partition_count = 0;
+    input.resize(FFT_SIZE);
+    output.resize(PARTITION_SIZE);
+    accumulator.resize(PARTITION_FLOATS);
+    fft_buffer.resize(FFT_SIZE * 2);
+    clear();
+}
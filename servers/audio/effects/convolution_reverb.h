@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef CONVOLUTION_REVERB_H
+#define CONVOLUTION_REVERB_H
+
+#include "core/local_vector.h"
+#include "core/math/audio_frame.h"
+#include "core/vector.h"
+
+// Convolves stereo audio with a stereo impulse response.
+//
+// Uses uniformly partitioned overlap-save convolution: the impulse response
+// is split into partitions of PARTITION_SIZE frames, whose spectra are
+// computed once. Every PARTITION_SIZE input frames, the spectrum of the last
+// two partitions of input is added to a history, and the history is
+// multiplied by the impulse response's spectra and transformed back. The
+// latency is always PARTITION_SIZE frames, whatever the length of the
+// impulse response, and the cost grows linearly with it.
+//
+// The left and right channels are transformed together, as the real and
+// imaginary parts of one complex signal, and their spectra are separated
+// using their symmetry.
+class ConvolutionReverb {
+public:
+    enum {
+        PARTITION_SIZE   = 256,
+        FFT_SIZE         = PARTITION_SIZE * 2,
+        // The PARTITION_SIZE + 1 bins of the spectrum of a real signal,
+        // padded to a multiple of the SIMD width.
+        SPECTRUM_SIZE    = PARTITION_SIZE + 8,
+        // The real and imaginary parts of the left and right spectra.
+        PARTITION_FLOATS = SPECTRUM_SIZE * 4,
+    };
+
+    // Computes the spectra of the partitions of an impulse response, which
+    // can be shared by several reverbs.
+    static void compute_spectra(
+        const AudioFrame* p_impulse,
+        int p_frame_count,
+        Vector<float>& r_spectra
+    );
+
+    // Clears the history when the number of partitions changes.
+    void set_spectra(const Vector<float>& p_spectra);
+
+    // The output is delayed by PARTITION_SIZE frames.
+    void process(
+        const AudioFrame* p_src_frames,
+        AudioFrame* p_dst_frames,
+        int p_frame_count,
+        float p_dry,
+        float p_wet
+    );
+
+    void clear();
+
+    ConvolutionReverb();
+
+private:
+    Vector<float> spectra;
+    int partition_count;
+
+    // The last two partitions of input, and the output of the previous one.
+    LocalVector<AudioFrame> input;
+    LocalVector<AudioFrame> output;
+    int position;
+
+    // The spectra of the last partition_count pairs of input partitions.
+    LocalVector<float> history;
+    int history_position;
+
+    LocalVector<float> accumulator;
+    LocalVector<float> fft_buffer;
+
+    static void _split_spectra(const float* p_fft, float* r_spectra);
+    void _process_partition();
+};
+
+#endif // CONVOLUTION_REVERB_H
@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+// SPDX-FileCopyrightText: 2014-2022 Godot Engine contributors
+// SPDX-FileCopyrightText: 2007-2014 Juan Linietsky, Ariel Manzur
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef FFT_H
+#define FFT_H
+
+// In place complex FFT of fftFrameSize interleaved cosine and sine parts.
+// Sign = -1 is FFT, 1 is iFFT (inverse), which isn't normalized. fftFrameSize
+// must be a power of 2.
+void smbFft(float* fftBuffer, long fftFrameSize, long sign);
+
+#endif // FFT_H
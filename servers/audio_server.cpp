@@ -12,6 +12,7 @@
 #include "core/project_settings.h"
 #include "scene/resources/audio_stream_sample.h"
 #include "servers/audio/audio_driver_dummy.h"
+#include "servers/audio/audio_mix_kernels.h"
 #include "servers/audio/effects/audio_effect_compressor.h"
 
 #ifdef TOOLS_ENABLED
@@ -264,19 +265,12 @@ void AudioServer::_driver_process(int p_frames, int32_t* p_buffer) {
         for (int k = 0; k < cs; k++) {
             if (master->channels[k].active) {
                 const AudioFrame* buf = master->channels[k].buffer.ptr();
-
-                for (int j = 0; j < to_copy; j++) {
-                    float l     = CLAMP(buf[from + j].l, -1.0, 1.0);
-                    int32_t vl  = l * ((1 << 20) - 1);
-                    int32_t vl2 = (vl < 0 ? -1 : 1) * (ABS(vl) << 11);
-                    p_buffer[(from_buf + j) * (cs * 2) + k * 2 + 0] = vl2;
-
-                    float r     = CLAMP(buf[from + j].r, -1.0, 1.0);
-                    int32_t vr  = r * ((1 << 20) - 1);
-                    int32_t vr2 = (vr < 0 ? -1 : 1) * (ABS(vr) << 11);
-                    p_buffer[(from_buf + j) * (cs * 2) + k * 2 + 1] = vr2;
-                }
-
+                AudioMixKernels::convert_to_int32(
+                    buf + from,
+                    to_copy,
+                    p_buffer + from_buf * (cs * 2) + k * 2,
+                    cs * 2
+                );
             } else {
                 for (int j = 0; j < to_copy; j++) {
                     p_buffer[(from_buf + j) * (cs * 2) + k * 2 + 0] = 0;
@@ -333,156 +327,254 @@ void AudioServer::_mix_step() {
         }
     }
 
+    voice_manager.update();
+
     // make callbacks for mixing the audio
     for (Set<CallbackItem>::Element* E = callbacks.front(); E; E = E->next()) {
         E->get().callback(E->get().userdata);
     }
 
-    for (int i = buses.size() - 1; i >= 0; i--) {
-        // go bus by bus
-        Bus* bus = buses[i];
+    if (mix_work_pool.get_thread_count() > 1 && buses.size() > 1) {
+        _mix_buses_in_parallel(solo_mode);
+    } else {
+        for (int i = buses.size() - 1; i >= 0; i--) {
+            // go bus by bus
+            Bus* bus = buses[i];
+            _mix_bus(bus, solo_mode);
 
-        for (int k = 0; k < bus->channels.size(); k++) {
-            if (bus->channels[k].active && !bus->channels[k].used) {
-                // buffer was not used, but it's still active, so it must be
-                // cleaned
-                AudioFrame* buf = bus->channels.write[k].buffer.ptrw();
+            Bus* send = _get_bus_send(i);
+            if (send) {
+                _send_bus(bus, send);
+            }
+        }
+    }
 
-                for (uint32_t j = 0; j < buffer_size; j++) {
-                    buf[j] = AudioFrame(0, 0);
-                }
+    mix_frames += buffer_size;
+    to_mix      = buffer_size;
+}
+
+AudioServer::Bus* AudioServer::_get_bus_send(int p_bus) {
+    if (p_bus == 0) {
+        return nullptr;
+    }
+
+    // everything has a send save for master bus
+    Bus* bus = buses[p_bus];
+    if (!bus_map.has(bus->send)) {
+        return buses[0];
+    }
+    Bus* send = bus_map[bus->send];
+    if (send->index_cache >= bus->index_cache) { // invalid, send to master
+        return buses[0];
+    }
+    return send;
+}
+
+AudioFrame* AudioServer::_get_channel_mix_buffer(Bus* p_bus, int p_channel) {
+    Bus::Channel& channel = p_bus->channels.write[p_channel];
+    AudioFrame* data      = channel.buffer.ptrw();
+
+    if (!channel.used) {
+        channel.used                = true;
+        channel.active              = true;
+        channel.last_mix_with_audio = mix_frames;
+        for (uint32_t i = 0; i < buffer_size; i++) {
+            data[i] = AudioFrame(0, 0);
+        }
+    }
+
+    return data;
+}
+
+// Clears the unused channels, processes the effects and applies the volume.
+// Only touches p_bus, so different buses can be mixed on different threads.
+void AudioServer::_mix_bus(Bus* p_bus, bool p_solo_mode) {
+    Bus* bus = p_bus;
+
+    for (int k = 0; k < bus->channels.size(); k++) {
+        if (bus->channels[k].active && !bus->channels[k].used) {
+            // buffer was not used, but it's still active, so it must be
+            // cleaned
+            AudioFrame* buf = bus->channels.write[k].buffer.ptrw();
+
+            for (uint32_t j = 0; j < buffer_size; j++) {
+                buf[j] = AudioFrame(0, 0);
             }
         }
+    }
 
-        // process effects
-        if (!bus->bypass) {
-            for (int j = 0; j < bus->effects.size(); j++) {
-                if (!bus->effects[j].enabled) {
-                    continue;
-                }
+    // process effects
+    if (!bus->bypass) {
+        for (int j = 0; j < bus->effects.size(); j++) {
+            if (!bus->effects[j].enabled) {
+                continue;
+            }
 
 #ifdef DEBUG_ENABLED
-                uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+            uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 #endif
 
-                for (int k = 0; k < bus->channels.size(); k++) {
-                    if (!(bus->channels[k].active
-                          || bus->channels[k]
-                                 .effect_instances[j]
-                                 ->process_silence())) {
-                        continue;
-                    }
-                    bus->channels.write[k].effect_instances.write[j]->process(
-                        bus->channels[k].buffer.ptr(),
-                        temp_buffer.write[k].ptrw(),
-                        buffer_size
-                    );
+            for (int k = 0; k < bus->channels.size(); k++) {
+                if (!(bus->channels[k].active
+                      || bus->channels[k]
+                             .effect_instances[j]
+                             ->process_silence())) {
+                    continue;
                 }
+                Bus::Channel& channel = bus->channels.write[k];
+                channel.effect_instances.write[j]->process(
+                    channel.buffer.ptr(),
+                    channel.temp_buffer.ptrw(),
+                    buffer_size
+                );
+            }
 
-                // swap buffers, so internal buffer always has the right data
-                for (int k = 0; k < bus->channels.size(); k++) {
-                    if (!(buses[i]->channels[k].active
-                          || bus->channels[k]
-                                 .effect_instances[j]
-                                 ->process_silence())) {
-                        continue;
-                    }
-                    SWAP(bus->channels.write[k].buffer, temp_buffer.write[k]);
+            // swap buffers, so internal buffer always has the right data
+            for (int k = 0; k < bus->channels.size(); k++) {
+                if (!(bus->channels[k].active
+                      || bus->channels[k]
+                             .effect_instances[j]
+                             ->process_silence())) {
+                    continue;
                 }
+                Bus::Channel& channel = bus->channels.write[k];
+                SWAP(channel.buffer, channel.temp_buffer);
+            }
 
 #ifdef DEBUG_ENABLED
-                bus->effects.write[j].prof_time +=
-                    OS::get_singleton()->get_ticks_usec() - ticks;
+            bus->effects.write[j].prof_time +=
+                OS::get_singleton()->get_ticks_usec() - ticks;
 #endif
-            }
         }
+    }
 
-        // process send
+    for (int k = 0; k < bus->channels.size(); k++) {
+        if (!bus->channels[k].active) {
+            bus->channels.write[k].peak_volume =
+                AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
+            continue;
+        }
 
-        Bus* send = nullptr;
+        AudioFrame* buf = bus->channels.write[k].buffer.ptrw();
 
-        if (i > 0) {
-            // everything has a send save for master bus
-            if (!bus_map.has(bus->send)) {
-                send = buses[0];
-            } else {
-                send = bus_map[bus->send];
-                if (send->index_cache
-                    >= bus->index_cache) { // invalid, send to master
-                    send = buses[0];
-                }
-            }
-        }
+        float volume = Math::db2linear(bus->volume_db);
 
-        for (int k = 0; k < bus->channels.size(); k++) {
-            if (!bus->channels[k].active) {
-                bus->channels.write[k].peak_volume =
-                    AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
-                continue;
+        if (p_solo_mode) {
+            if (!bus->soloed) {
+                volume = 0.0;
+            }
+        } else {
+            if (bus->mute) {
+                volume = 0.0;
             }
+        }
 
-            AudioFrame* buf = bus->channels.write[k].buffer.ptrw();
+        // apply volume and compute peak
+        AudioFrame peak =
+            AudioMixKernels::apply_volume(buf, buffer_size, volume);
 
-            AudioFrame peak = AudioFrame(0, 0);
+        bus->channels.write[k].peak_volume = AudioFrame(
+            Math::linear2db(peak.l + AUDIO_PEAK_OFFSET),
+            Math::linear2db(peak.r + AUDIO_PEAK_OFFSET)
+        );
 
-            float volume = Math::db2linear(bus->volume_db);
+        if (!bus->channels[k].used) {
+            // see if any audio is contained, because channel was not used
 
-            if (solo_mode) {
-                if (!bus->soloed) {
-                    volume = 0.0;
-                }
-            } else {
-                if (bus->mute) {
-                    volume = 0.0;
-                }
+            if (MAX(peak.r, peak.l)
+                > Math::db2linear(channel_disable_threshold_db)) {
+                bus->channels.write[k].last_mix_with_audio = mix_frames;
+            } else if (mix_frames - bus->channels[k].last_mix_with_audio
+                       > channel_disable_frames) {
+                bus->channels.write[k].active = false;
             }
+        }
+    }
+}
 
-            // apply volume and compute peak
-            for (uint32_t j = 0; j < buffer_size; j++) {
-                buf[j] *= volume;
+// Adds the active channels of p_bus to p_send.
+void AudioServer::_send_bus(Bus* p_bus, Bus* p_send) {
+    for (int k = 0; k < p_bus->channels.size(); k++) {
+        if (!p_bus->channels[k].active) {
+            continue;
+        }
 
-                float l = ABS(buf[j].l);
-                if (l > peak.l) {
-                    peak.l = l;
-                }
-                float r = ABS(buf[j].r);
-                if (r > peak.r) {
-                    peak.r = r;
-                }
-            }
+        const AudioFrame* buf  = p_bus->channels[k].buffer.ptr();
+        AudioFrame* target_buf = _get_channel_mix_buffer(p_send, k);
+        AudioMixKernels::mix(target_buf, buf, buffer_size);
+    }
+}
 
-            bus->channels.write[k].peak_volume = AudioFrame(
-                Math::linear2db(peak.l + AUDIO_PEAK_OFFSET),
-                Math::linear2db(peak.r + AUDIO_PEAK_OFFSET)
-            );
-
-            if (!bus->channels[k].used) {
-                // see if any audio is contained, because channel was not used
-
-                if (MAX(peak.r, peak.l)
-                    > Math::db2linear(channel_disable_threshold_db)) {
-                    bus->channels.write[k].last_mix_with_audio = mix_frames;
-                } else if (mix_frames - bus->channels[k].last_mix_with_audio
-                           > channel_disable_frames) {
-                    bus->channels.write[k].active = false;
-                    continue; // went inactive, don't mix.
-                }
-            }
+void AudioServer::_mix_buses_in_parallel(bool p_solo_mode) {
+    int count = buses.size();
+    mix_sends.resize(count);
+    mix_depths.resize(count);
+
+    // Buses can only send to buses before them, so the depths are computed in
+    // order.
+    int depth_count = 1;
+    for (int i = 0; i < count; i++) {
+        Bus* send = _get_bus_send(i);
+        if (send) {
+            mix_sends[i]  = send->index_cache;
+            mix_depths[i] = mix_depths[mix_sends[i]] + 1;
+            depth_count   = MAX(depth_count, mix_depths[i] + 1);
+        } else {
+            mix_sends[i]  = -1;
+            mix_depths[i] = 0;
+        }
+    }
 
-            if (send) {
-                // if not master bus, send
-                AudioFrame* target_buf =
-                    thread_get_channel_mix_buffer(send->index_cache, k);
+    // Counting sort by depth. The ends are the beginnings until the buses are
+    // added.
+    mix_level_ends.resize(depth_count);
+    for (int d = 0; d < depth_count; d++) {
+        mix_level_ends[d] = 0;
+    }
+    for (int i = 0; i < count; i++) {
+        mix_level_ends[mix_depths[i]]++;
+    }
+    int begin = 0;
+    for (int d = 0; d < depth_count; d++) {
+        int size          = mix_level_ends[d];
+        mix_level_ends[d] = begin;
+        begin            += size;
+    }
+    mix_levels.resize(count);
+    for (int i = count - 1; i >= 0; i--) {
+        mix_levels[mix_level_ends[mix_depths[i]]++] = i;
+    }
 
-                for (uint32_t j = 0; j < buffer_size; j++) {
-                    target_buf[j] += buf[j];
-                }
-            }
+    mix_solo_mode    = p_solo_mode;
+    mix_sender_begin = 0;
+    mix_sender_end   = 0;
+    for (int d = depth_count - 1; d >= 0; d--) {
+        mix_level_begin = d > 0 ? mix_level_ends[d - 1] : 0;
+        mix_work_pool.do_work(
+            mix_level_ends[d] - mix_level_begin,
+            this,
+            &AudioServer::_mix_level_bus,
+            nullptr
+        );
+        mix_sender_begin = mix_level_begin;
+        mix_sender_end   = mix_level_ends[d];
+    }
+}
+
+// Sums the buses sending to a bus of the current level, which were mixed with
+// the previous level, and then mixes the bus.
+void AudioServer::_mix_level_bus(uint32_t p_index, void* p_userdata) {
+    int index = mix_levels[mix_level_begin + p_index];
+    Bus* bus  = buses[index];
+
+    for (int i = mix_sender_begin; i < mix_sender_end; i++) {
+        int sender = mix_levels[i];
+        if (mix_sends[sender] == index) {
+            _send_bus(buses[sender], bus);
         }
     }
 
-    mix_frames += buffer_size;
-    to_mix      = buffer_size;
+    _mix_bus(bus, mix_solo_mode);
 }
 
 bool AudioServer::thread_has_channel_mix_buffer(int p_bus, int p_buffer) const {
@@ -502,20 +594,7 @@ AudioFrame* AudioServer::thread_get_channel_mix_buffer(
     ERR_FAIL_INDEX_V(p_bus, buses.size(), nullptr);
     ERR_FAIL_INDEX_V(p_buffer, buses[p_bus]->channels.size(), nullptr);
 
-    AudioFrame* data =
-        buses.write[p_bus]->channels.write[p_buffer].buffer.ptrw();
-
-    if (!buses[p_bus]->channels[p_buffer].used) {
-        buses.write[p_bus]->channels.write[p_buffer].used   = true;
-        buses.write[p_bus]->channels.write[p_buffer].active = true;
-        buses.write[p_bus]->channels.write[p_buffer].last_mix_with_audio =
-            mix_frames;
-        for (uint32_t i = 0; i < buffer_size; i++) {
-            data[i] = AudioFrame(0, 0);
-        }
-    }
-
-    return data;
+    return _get_channel_mix_buffer(buses[p_bus], p_buffer);
 }
 
 int AudioServer::thread_get_mix_buffer_size() const {
@@ -530,6 +609,13 @@ int AudioServer::thread_find_bus_index(const StringName& p_name) {
     }
 }
 
+void AudioServer::set_bus_mixing_thread_count(int p_thread_count) {
+    lock();
+    mix_work_pool.finish();
+    mix_work_pool.init(p_thread_count, Thread::PRIORITY_HIGH);
+    unlock();
+}
+
 void AudioServer::set_bus_count(int p_count) {
     ERR_FAIL_COND(p_count < 1);
     ERR_FAIL_INDEX(p_count, 256);
@@ -571,7 +657,9 @@ void AudioServer::set_bus_count(int p_count) {
         buses.write[i] = memnew(Bus);
         buses.write[i]->channels.resize(channel_count);
         for (int j = 0; j < channel_count; j++) {
-            buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+            Bus::Channel& channel = buses.write[i]->channels.write[j];
+            channel.buffer.resize(buffer_size);
+            channel.temp_buffer.resize(buffer_size);
         }
         buses[i]->name      = attempt;
         buses[i]->solo      = false;
@@ -641,6 +729,7 @@ void AudioServer::add_bus(int p_at_pos) {
     bus->channels.resize(channel_count);
     for (int j = 0; j < channel_count; j++) {
         bus->channels.write[j].buffer.resize(buffer_size);
+        bus->channels.write[j].temp_buffer.resize(buffer_size);
     }
     bus->name      = attempt;
     bus->solo      = false;
@@ -984,16 +1073,13 @@ float AudioServer::get_global_rate_scale() const {
 
 void AudioServer::init_channels_and_buffers() {
     channel_count = get_channel_count();
-    temp_buffer.resize(channel_count);
-
-    for (int i = 0; i < temp_buffer.size(); i++) {
-        temp_buffer.write[i].resize(buffer_size);
-    }
 
     for (int i = 0; i < buses.size(); i++) {
         buses[i]->channels.resize(channel_count);
         for (int j = 0; j < channel_count; j++) {
-            buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+            Bus::Channel& channel = buses.write[i]->channels.write[j];
+            channel.buffer.resize(buffer_size);
+            channel.temp_buffer.resize(buffer_size);
         }
         _update_bus_effects(i);
     }
@@ -1016,6 +1102,26 @@ void AudioServer::init() {
     );
     buffer_size = 1024; // hardcoded for now
 
+    int mix_thread_count = ThreadWorkPool::define_thread_count_setting(
+        "audio/bus_mixing_thread_count",
+        true
+    );
+    mix_work_pool.init(mix_thread_count, Thread::PRIORITY_HIGH);
+
+    voice_manager.set_voice_limit(GLOBAL_DEF_RST("audio/voice_limit", 0));
+    ProjectSettings::get_singleton()->set_custom_property_info(
+        "audio/voice_limit",
+        PropertyInfo(
+            Variant::INT,
+            "audio/voice_limit",
+            PROPERTY_HINT_RANGE,
+            "0,1024,1,or_greater"
+        )
+    );
+    voice_manager.set_audibility_threshold_db(
+        GLOBAL_DEF_RST("audio/virtual_voice_threshold_db", -80.0)
+    );
+
     init_channels_and_buffers();
 
     mix_count = 0;
@@ -1130,6 +1236,8 @@ void AudioServer::finish() {
         AudioDriverManager::get_driver(i)->finish();
     }
 
+    mix_work_pool.finish();
+
     for (int i = 0; i < buses.size(); i++) {
         memdelete(buses[i]);
     }
@@ -1299,7 +1407,9 @@ void AudioServer::set_bus_layout(const Ref<AudioBusLayout>& p_bus_layout) {
 
         buses[i]->channels.resize(channel_count);
         for (int j = 0; j < channel_count; j++) {
-            buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+            Bus::Channel& channel = buses.write[i]->channels.write[j];
+            channel.buffer.resize(buffer_size);
+            channel.temp_buffer.resize(buffer_size);
         }
         _update_bus_effects(i);
     }
@@ -1589,6 +1699,10 @@ AudioServer::AudioServer() {
     mix_time          = 0;
     mix_size          = 0;
     global_rate_scale = 1;
+    mix_level_begin   = 0;
+    mix_sender_begin  = 0;
+    mix_sender_end    = 0;
+    mix_solo_mode     = false;
 }
 
 AudioServer::~AudioServer() {
@@ -7,11 +7,14 @@
 #ifndef AUDIO_SERVER_H
 #define AUDIO_SERVER_H
 
+#include "core/local_vector.h"
 #include "core/math/audio_frame.h"
 #include "core/object.h"
 #include "core/os/os.h"
+#include "core/os/thread_work_pool.h"
 #include "core/variant.h"
 #include "servers/audio/audio_effect.h"
+#include "servers/audio/audio_voice_manager.h"
 
 class AudioDriverDummy;
 class AudioStream;
@@ -208,6 +211,8 @@ private:
             bool active;
             AudioFrame peak_volume;
             Vector<AudioFrame> buffer;
+            // The output of an effect, which is then swapped with buffer.
+            Vector<AudioFrame> temp_buffer;
             Vector<Ref<AudioEffectInstance>> effect_instances;
             uint64_t last_mix_with_audio;
 
@@ -235,12 +240,38 @@ private:
         int index_cache;
     };
 
-    Vector<Vector<AudioFrame>> temp_buffer; // temp_buffer for each level
     Vector<Bus*> buses;
     Map<StringName, Bus*> bus_map;
 
     void _update_bus_effects(int p_bus);
 
+    // When there is more than one mixing thread, the buses are mixed by their
+    // depth in the graph of sends, deepest first. A bus only depends on the
+    // buses that send to it, which are one level deeper, so all the buses of
+    // a level are mixed in parallel. The buses sending to the same bus are
+    // summed in the same order as when mixing serially, so the result doesn't
+    // depend on the number of threads.
+    ThreadWorkPool mix_work_pool;
+    LocalVector<int> mix_sends;
+    LocalVector<int> mix_depths;
+    // The buses sorted by depth, and by descending index within a depth.
+    LocalVector<int> mix_levels;
+    LocalVector<int> mix_level_ends;
+    int mix_level_begin;
+    int mix_sender_begin;
+    int mix_sender_end;
+    bool mix_solo_mode;
+
+    Bus* _get_bus_send(int p_bus);
+    AudioFrame* _get_channel_mix_buffer(Bus* p_bus, int p_channel);
+    void _mix_bus(Bus* p_bus, bool p_solo_mode);
+    void _send_bus(Bus* p_bus, Bus* p_send);
+    void _mix_buses_in_parallel(bool p_solo_mode);
+    void _mix_level_bus(uint32_t p_index, void* p_userdata);
+
+    // Chooses the voices that are mixed before every mix step.
+    AudioVoiceManager voice_manager;
+
     static AudioServer* singleton;
 
     // TODO create an audiodata pool to optimize memory
@@ -297,6 +328,14 @@ public:
     int thread_get_mix_buffer_size() const;
     int thread_find_bus_index(const StringName& p_name);
 
+    // Restarts the bus mixing threads with p_thread_count threads, including
+    // the audio thread, overriding audio/bus_mixing_thread_count.
+    void set_bus_mixing_thread_count(int p_thread_count);
+
+    _FORCE_INLINE_ AudioVoiceManager* get_voice_manager() {
+        return &voice_manager;
+    }
+
     void set_bus_count(int p_count);
     int get_bus_count() const;
 
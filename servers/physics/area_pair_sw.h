@@ -19,6 +19,10 @@ class AreaPairSW : public ConstraintSW {
     bool colliding;
 
 public:
+    ConstraintType get_constraint_type() const {
+        return CONSTRAINT_TYPE_AREA_PAIR;
+    }
+
     bool setup(real_t p_step);
     void solve(real_t p_step);
 
@@ -39,6 +43,10 @@ class Area2PairSW : public ConstraintSW {
     bool colliding;
 
 public:
+    ConstraintType get_constraint_type() const {
+        return CONSTRAINT_TYPE_AREA_PAIR;
+    }
+
     bool setup(real_t p_step);
     void solve(real_t p_step);
 
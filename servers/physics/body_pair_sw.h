@@ -10,6 +10,11 @@
 #include "body_sw.h"
 #include "constraint_sw.h"
 
+#define MIN_VELOCITY      0.0001
+#define MAX_BIAS_ROTATION (Math_PI / 8)
+
+real_t combine_friction(BodySW* A, BodySW* B);
+
 class BodyPairSW : public ConstraintSW {
     enum {
         MAX_CONTACTS = 4
@@ -80,7 +85,13 @@ class BodyPairSW : public ConstraintSW {
 
     SpaceSW* space;
 
+    friend class ContactSolverSW;
+
 public:
+    ConstraintType get_constraint_type() const {
+        return CONSTRAINT_TYPE_BODY_PAIR;
+    }
+
     bool setup(real_t p_step);
     void solve(real_t p_step);
 
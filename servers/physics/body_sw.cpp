@@ -801,6 +801,8 @@ BodySW::BodySW() : CollisionObjectSW(TYPE_BODY), locked_axis(0) {
     omit_force_integration = false;
     // applied_torque=0;
     island_step            = 0;
+    solver_pack_id         = 0;
+    solver_index           = 0;
     island_next            = nullptr;
     island_list_next       = nullptr;
     first_time_kinematic   = false;
@@ -122,6 +122,10 @@ class BodySW : public CollisionObjectSW {
     BodySW* island_next;
     BodySW* island_list_next;
 
+    // Where the packed contact solver stored this body in the current step.
+    uint64_t solver_pack_id;
+    uint32_t solver_index;
+
     _FORCE_INLINE_ void _compute_area_gravity_and_dampenings(
         const AreaSW* p_area
     );
@@ -231,6 +235,22 @@ public:
         island_list_next = p_next;
     }
 
+    _FORCE_INLINE_ uint64_t get_solver_pack_id() const {
+        return solver_pack_id;
+    }
+
+    _FORCE_INLINE_ void set_solver_pack_id(uint64_t p_pack_id) {
+        solver_pack_id = p_pack_id;
+    }
+
+    _FORCE_INLINE_ uint32_t get_solver_index() const {
+        return solver_index;
+    }
+
+    _FORCE_INLINE_ void set_solver_index(uint32_t p_index) {
+        solver_index = p_index;
+    }
+
     _FORCE_INLINE_ void add_constraint(ConstraintSW* p_constraint, int p_pos) {
         constraint_map[p_constraint] = p_pos;
     }
@@ -285,15 +305,34 @@ public:
         return angular_velocity;
     }
 
+    _FORCE_INLINE_ void set_biased_linear_velocity(const Vector3& p_velocity) {
+        biased_linear_velocity = p_velocity;
+    }
+
     _FORCE_INLINE_ const Vector3& get_biased_linear_velocity() const {
         return biased_linear_velocity;
     }
 
+    _FORCE_INLINE_ void set_biased_angular_velocity(const Vector3& p_velocity
+    ) {
+        biased_angular_velocity = p_velocity;
+    }
+
     _FORCE_INLINE_ const Vector3& get_biased_angular_velocity() const {
         return biased_angular_velocity;
     }
 
+    // Static and kinematic bodies have no inverse mass, so impulses never
+    // change them. They can also be shared by islands that are solved on
+    // different threads, so they must not be written to at all.
+    _FORCE_INLINE_ bool is_impulse_static() const {
+        return mode <= PhysicsServer::BODY_MODE_KINEMATIC;
+    }
+
     _FORCE_INLINE_ void apply_central_impulse(const Vector3& p_j) {
+        if (is_impulse_static()) {
+            return;
+        }
         linear_velocity += p_j * _inv_mass;
     }
 
@@ -301,12 +340,18 @@ public:
         const Vector3& p_pos,
         const Vector3& p_j
     ) {
+        if (is_impulse_static()) {
+            return;
+        }
         linear_velocity += p_j * _inv_mass;
         angular_velocity +=
             _inv_inertia_tensor.xform((p_pos - center_of_mass).cross(p_j));
     }
 
     _FORCE_INLINE_ void apply_torque_impulse(const Vector3& p_j) {
+        if (is_impulse_static()) {
+            return;
+        }
         angular_velocity += _inv_inertia_tensor.xform(p_j);
     }
 
@@ -315,6 +360,9 @@ public:
         const Vector3& p_j,
         real_t p_max_delta_av = -1.0
     ) {
+        if (is_impulse_static()) {
+            return;
+        }
         biased_linear_velocity += p_j * _inv_mass;
         if (p_max_delta_av != 0.0) {
             Vector3 delta_av =
@@ -327,6 +375,9 @@ public:
     }
 
     _FORCE_INLINE_ void apply_bias_torque_impulse(const Vector3& p_j) {
+        if (is_impulse_static()) {
+            return;
+        }
         biased_angular_velocity += _inv_inertia_tensor.xform(p_j);
     }
 
@@ -30,6 +30,12 @@ protected:
     }
 
 public:
+    enum ConstraintType {
+        CONSTRAINT_TYPE_BODY_PAIR,
+        CONSTRAINT_TYPE_AREA_PAIR,
+        CONSTRAINT_TYPE_JOINT,
+    };
+
     _FORCE_INLINE_ void set_self(const RID& p_self) {
         self = p_self;
     }
@@ -87,6 +93,8 @@ public:
         return disabled_collisions_between_bodies;
     }
 
+    virtual ConstraintType get_constraint_type() const = 0;
+
     virtual bool setup(real_t p_step) = 0;
     virtual void solve(real_t p_step) = 0;
 
@@ -0,0 +1,897 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "contact_solver_sw.h"
+
+namespace {
+
+struct SimdVector3 {
+    SimdFloat x;
+    SimdFloat y;
+    SimdFloat z;
+
+    static _FORCE_INLINE_ SimdVector3
+    load(const float p_src[3][SimdFloat::WIDTH]) {
+        return {
+            SimdFloat::load(p_src[0]),
+            SimdFloat::load(p_src[1]),
+            SimdFloat::load(p_src[2])
+        };
+    }
+
+    _FORCE_INLINE_ void store(float p_dst[3][SimdFloat::WIDTH]) const {
+        x.store(p_dst[0]);
+        y.store(p_dst[1]);
+        z.store(p_dst[2]);
+    }
+
+    _FORCE_INLINE_ SimdVector3 operator+(const SimdVector3& p_v) const {
+        return {x + p_v.x, y + p_v.y, z + p_v.z};
+    }
+
+    _FORCE_INLINE_ SimdVector3 operator-(const SimdVector3& p_v) const {
+        return {x - p_v.x, y - p_v.y, z - p_v.z};
+    }
+
+    _FORCE_INLINE_ SimdVector3 operator-() const {
+        return {-x, -y, -z};
+    }
+
+    _FORCE_INLINE_ SimdVector3 operator*(const SimdFloat& p_scalar) const {
+        return {x * p_scalar, y * p_scalar, z * p_scalar};
+    }
+
+    _FORCE_INLINE_ SimdVector3 operator/(const SimdFloat& p_scalar) const {
+        return {x / p_scalar, y / p_scalar, z / p_scalar};
+    }
+
+    _FORCE_INLINE_ SimdFloat dot(const SimdVector3& p_v) const {
+        return x * p_v.x + y * p_v.y + z * p_v.z;
+    }
+
+    _FORCE_INLINE_ SimdVector3 cross(const SimdVector3& p_v) const {
+        return {
+            (y * p_v.z) - (z * p_v.y),
+            (z * p_v.x) - (x * p_v.z),
+            (x * p_v.y) - (y * p_v.x)
+        };
+    }
+
+    _FORCE_INLINE_ SimdFloat length() const {
+        return SimdFloat::sqrt(dot(*this));
+    }
+
+    static _FORCE_INLINE_ SimdVector3 select(
+        const SimdMask& p_mask,
+        const SimdVector3& p_a,
+        const SimdVector3& p_b
+    ) {
+        return {
+            SimdFloat::select(p_mask, p_a.x, p_b.x),
+            SimdFloat::select(p_mask, p_a.y, p_b.y),
+            SimdFloat::select(p_mask, p_a.z, p_b.z)
+        };
+    }
+
+    static _FORCE_INLINE_ SimdVector3
+    gather(const Vector3* p_src, const uint32_t* p_index) {
+        float v[3][SimdFloat::WIDTH];
+        for (int i = 0; i < SimdFloat::WIDTH; i++) {
+            const Vector3& src = p_src[p_index[i]];
+            v[0][i]            = src.x;
+            v[1][i]            = src.y;
+            v[2][i]            = src.z;
+        }
+        return load(v);
+    }
+
+    _FORCE_INLINE_ void scatter(
+        Vector3* p_dst,
+        const uint32_t* p_index,
+        const bool* p_write,
+        uint32_t p_count
+    ) const {
+        float v[3][SimdFloat::WIDTH];
+        store(v);
+        for (uint32_t i = 0; i < p_count; i++) {
+            if (p_write[i]) {
+                p_dst[p_index[i]] = Vector3(v[0][i], v[1][i], v[2][i]);
+            }
+        }
+    }
+};
+
+// A row major 3x3 matrix, like Basis.
+struct SimdBasis {
+    SimdFloat elements[9];
+
+    static _FORCE_INLINE_ SimdBasis
+    load(const float p_src[9][SimdFloat::WIDTH]) {
+        SimdBasis b;
+        for (int i = 0; i < 9; i++) {
+            b.elements[i] = SimdFloat::load(p_src[i]);
+        }
+        return b;
+    }
+
+    _FORCE_INLINE_ SimdVector3 xform(const SimdVector3& p_v) const {
+        return {
+            elements[0] * p_v.x + elements[1] * p_v.y + elements[2] * p_v.z,
+            elements[3] * p_v.x + elements[4] * p_v.y + elements[5] * p_v.z,
+            elements[6] * p_v.x + elements[7] * p_v.y + elements[8] * p_v.z
+        };
+    }
+};
+
+} // namespace
+
+void ContactSolverSW::Bodies::clear() {
+    body.clear();
+    linear_velocity.clear();
+    angular_velocity.clear();
+    biased_linear_velocity.clear();
+    biased_angular_velocity.clear();
+    inv_inertia_tensor.clear();
+    inv_mass.clear();
+    dynamic.clear();
+}
+
+uint32_t ContactSolverSW::Bodies::add(BodySW* p_body) {
+    body.push_back(p_body);
+    linear_velocity.push_back(p_body->get_linear_velocity());
+    angular_velocity.push_back(p_body->get_angular_velocity());
+    biased_linear_velocity.push_back(p_body->get_biased_linear_velocity());
+    biased_angular_velocity.push_back(p_body->get_biased_angular_velocity());
+    inv_inertia_tensor.push_back(p_body->get_inv_inertia_tensor());
+    inv_mass.push_back(p_body->get_inv_mass());
+    dynamic.push_back(!p_body->is_impulse_static());
+    return body.size() - 1;
+}
+
+void ContactSolverSW::Contacts::clear() {
+    contact.clear();
+    body_A.clear();
+    body_B.clear();
+    normal.clear();
+    rA.clear();
+    rB.clear();
+    impulse_rA.clear();
+    impulse_rB.clear();
+    mass_normal.clear();
+    inv_mass_sum.clear();
+    bias.clear();
+    bounce.clear();
+    friction.clear();
+    acc_normal_impulse.clear();
+    acc_tangent_impulse.clear();
+    acc_bias_impulse.clear();
+    acc_bias_impulse_center_of_mass.clear();
+    active.clear();
+}
+
+void ContactSolverSW::Contacts::add(
+    BodyPairSW* p_pair,
+    BodyPairSW::Contact* p_contact,
+    uint32_t p_body_A,
+    uint32_t p_body_B
+) {
+    BodySW* A                    = p_pair->A;
+    BodySW* B                    = p_pair->B;
+    const BodyPairSW::Contact& c = *p_contact;
+
+    contact.push_back(p_contact);
+    body_A.push_back(p_body_A);
+    body_B.push_back(p_body_B);
+    normal.push_back(c.normal);
+    rA.push_back(c.rA);
+    rB.push_back(c.rB);
+    // BodySW applies impulses at (rA + center_of_mass) - center_of_mass.
+    impulse_rA.push_back(
+        (c.rA + A->get_center_of_mass()) - A->get_center_of_mass()
+    );
+    impulse_rB.push_back(
+        (c.rB + B->get_center_of_mass()) - B->get_center_of_mass()
+    );
+    mass_normal.push_back(c.mass_normal);
+    inv_mass_sum.push_back(A->get_inv_mass() + B->get_inv_mass());
+    bias.push_back(c.bias);
+    bounce.push_back(c.bounce);
+    friction.push_back(combine_friction(A, B));
+    acc_normal_impulse.push_back(c.acc_normal_impulse);
+    acc_tangent_impulse.push_back(c.acc_tangent_impulse);
+    acc_bias_impulse.push_back(c.acc_bias_impulse);
+    acc_bias_impulse_center_of_mass.push_back(c.acc_bias_impulse_center_of_mass
+    );
+    active.push_back(true);
+}
+
+bool ContactSolverSW::_can_pack_island(ConstraintSW* p_island) const {
+    for (ConstraintSW* ci = p_island; ci; ci = ci->get_island_next()) {
+        // Joints and solver priorities need the constraint order of the
+        // island, so those islands are solved by StepSW.
+        if (ci->get_constraint_type() == ConstraintSW::CONSTRAINT_TYPE_JOINT
+            || ci->get_priority() != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ContactSolverSW::_pack_island(ConstraintSW* p_island, Island& r_island) {
+    r_island.body_begin    = bodies.body.size();
+    r_island.contact_begin = contacts.contact.size();
+
+    for (ConstraintSW* ci = p_island; ci; ci = ci->get_island_next()) {
+        if (ci->get_constraint_type()
+            != ConstraintSW::CONSTRAINT_TYPE_BODY_PAIR) {
+            continue; // area pairs don't solve anything
+        }
+
+        BodyPairSW* pair = static_cast<BodyPairSW*>(ci);
+        if (!pair->collided) {
+            continue;
+        }
+
+        uint32_t body_index[2] = {0, 0};
+        for (int i = 0; i < 2; i++) {
+            BodySW* body = pair->_arr[i];
+            // Static bodies can be shared with islands packed before, but
+            // they are never written to, so they are only packed once.
+            if (body->get_solver_pack_id() != pack_id) {
+                body->set_solver_pack_id(pack_id);
+                body->set_solver_index(bodies.add(body));
+            }
+            body_index[i] = body->get_solver_index();
+        }
+
+        for (int i = 0; i < pair->contact_count; i++) {
+            BodyPairSW::Contact* c = &pair->contacts[i];
+            if (!c->active) {
+                continue;
+            }
+            contacts.add(pair, c, body_index[0], body_index[1]);
+        }
+    }
+
+    r_island.body_end    = bodies.body.size();
+    r_island.contact_end = contacts.contact.size();
+}
+
+void ContactSolverSW::_add_to_batch(Batch& r_batch, uint32_t p_contact) {
+    const uint32_t lane = r_batch.count++;
+    const uint32_t A    = contacts.body_A[p_contact];
+    const uint32_t B    = contacts.body_B[p_contact];
+
+    r_batch.contact[lane] = p_contact;
+    r_batch.body_A[lane]  = A;
+    r_batch.body_B[lane]  = B;
+    r_batch.write_A[lane] = bodies.dynamic[A];
+    r_batch.write_B[lane] = bodies.dynamic[B];
+
+    for (int i = 0; i < 3; i++) {
+        r_batch.normal[i][lane]     = contacts.normal[p_contact][i];
+        r_batch.rA[i][lane]         = contacts.rA[p_contact][i];
+        r_batch.rB[i][lane]         = contacts.rB[p_contact][i];
+        r_batch.impulse_rA[i][lane] = contacts.impulse_rA[p_contact][i];
+        r_batch.impulse_rB[i][lane] = contacts.impulse_rB[p_contact][i];
+        r_batch.acc_tangent_impulse[i][lane] =
+            contacts.acc_tangent_impulse[p_contact][i];
+    }
+
+    // Impulses don't change static and kinematic bodies.
+    Basis no_inertia;
+    no_inertia.set_zero();
+    const Basis& inv_inertia_tensor_A =
+        bodies.dynamic[A] ? bodies.inv_inertia_tensor[A] : no_inertia;
+    const Basis& inv_inertia_tensor_B =
+        bodies.dynamic[B] ? bodies.inv_inertia_tensor[B] : no_inertia;
+    r_batch.inv_mass_A[lane] = bodies.dynamic[A] ? bodies.inv_mass[A] : 0;
+    r_batch.inv_mass_B[lane] = bodies.dynamic[B] ? bodies.inv_mass[B] : 0;
+    for (int i = 0; i < 9; i++) {
+        r_batch.inv_inertia_tensor_A[i][lane] =
+            inv_inertia_tensor_A.elements[i / 3][i % 3];
+        r_batch.inv_inertia_tensor_B[i][lane] =
+            inv_inertia_tensor_B.elements[i / 3][i % 3];
+    }
+
+    r_batch.mass_normal[lane]        = contacts.mass_normal[p_contact];
+    r_batch.inv_mass_sum[lane]       = contacts.inv_mass_sum[p_contact];
+    r_batch.bias[lane]               = contacts.bias[p_contact];
+    r_batch.bounce[lane]             = contacts.bounce[p_contact];
+    r_batch.friction[lane]           = contacts.friction[p_contact];
+    r_batch.acc_normal_impulse[lane] = contacts.acc_normal_impulse[p_contact];
+    r_batch.acc_bias_impulse[lane]   = contacts.acc_bias_impulse[p_contact];
+    r_batch.acc_bias_impulse_center_of_mass[lane] =
+        contacts.acc_bias_impulse_center_of_mass[p_contact];
+    r_batch.active[lane] = 1.0;
+}
+
+void ContactSolverSW::_batch_island(Island& r_island) {
+    r_island.batch_begin = batches.size();
+
+    for (uint32_t i = r_island.contact_begin; i < r_island.contact_end; i++) {
+        const uint32_t A = contacts.body_A[i];
+        const uint32_t B = contacts.body_B[i];
+
+        // Place the contact after the batches that already use its dynamic
+        // bodies, so the contacts of every body are solved in island order.
+        uint32_t batch = r_island.batch_begin;
+        if (bodies.dynamic[A]) {
+            batch = MAX(batch, body_next_batch[A]);
+        }
+        if (bodies.dynamic[B]) {
+            batch = MAX(batch, body_next_batch[B]);
+        }
+        while (batch < batches.size() && batches[batch].count == LANES) {
+            batch++;
+        }
+        if (batch == batches.size()) {
+            batches.resize(batch + 1);
+            memset(&batches[batch], 0, sizeof(Batch));
+        }
+
+        _add_to_batch(batches[batch], i);
+
+        if (bodies.dynamic[A]) {
+            body_next_batch[A] = batch + 1;
+        }
+        if (bodies.dynamic[B]) {
+            body_next_batch[B] = batch + 1;
+        }
+    }
+
+    r_island.batch_end = batches.size();
+
+    // Unused lanes are inactive and massless, but point to the bodies of the
+    // first lane, so reading them doesn't touch other islands' bodies.
+    for (uint32_t i = r_island.batch_begin; i < r_island.batch_end; i++) {
+        Batch& batch = batches[i];
+        for (uint32_t lane = batch.count; lane < LANES; lane++) {
+            batch.body_A[lane] = batch.body_A[0];
+            batch.body_B[lane] = batch.body_B[0];
+        }
+    }
+}
+
+void ContactSolverSW::set_batched(bool p_batched) {
+#ifdef REAL_T_IS_DOUBLE
+    // The lanes only hold single precision floats.
+    batched = false;
+#else
+    batched = p_batched;
+#endif
+}
+
+void ContactSolverSW::pack(const LocalVector<ConstraintSW*>& p_islands) {
+    pack_id++;
+    bodies.clear();
+    contacts.clear();
+    batches.clear();
+    islands.resize(p_islands.size());
+    unpacked_island_count = 0;
+
+    for (uint32_t i = 0; i < p_islands.size(); i++) {
+        Island& island = islands[i];
+        island.packed  = _can_pack_island(p_islands[i]);
+        if (island.packed) {
+            _pack_island(p_islands[i], island);
+        } else {
+            unpacked_island_count++;
+        }
+    }
+
+    if (!batched) {
+        return;
+    }
+
+    body_next_batch.resize(bodies.body.size());
+    for (uint32_t i = 0; i < body_next_batch.size(); i++) {
+        body_next_batch[i] = 0;
+    }
+    for (uint32_t i = 0; i < islands.size(); i++) {
+        if (islands[i].packed) {
+            _batch_island(islands[i]);
+        }
+    }
+}
+
+void ContactSolverSW::_apply_impulse(
+    uint32_t p_body,
+    const Vector3& p_offset,
+    const Vector3& p_j
+) {
+    if (!bodies.dynamic[p_body]) {
+        return;
+    }
+    bodies.linear_velocity[p_body] += p_j * bodies.inv_mass[p_body];
+    bodies.angular_velocity[p_body] +=
+        bodies.inv_inertia_tensor[p_body].xform(p_offset.cross(p_j));
+}
+
+void ContactSolverSW::_apply_bias_impulse(
+    uint32_t p_body,
+    const Vector3& p_offset,
+    const Vector3& p_j,
+    real_t p_max_delta_av
+) {
+    if (!bodies.dynamic[p_body]) {
+        return;
+    }
+    bodies.biased_linear_velocity[p_body] += p_j * bodies.inv_mass[p_body];
+    Vector3 delta_av =
+        bodies.inv_inertia_tensor[p_body].xform(p_offset.cross(p_j));
+    if (p_max_delta_av > 0 && delta_av.length() > p_max_delta_av) {
+        delta_av = delta_av.normalized() * p_max_delta_av;
+    }
+    bodies.biased_angular_velocity[p_body] += delta_av;
+}
+
+void ContactSolverSW::_apply_bias_central_impulse(
+    uint32_t p_body,
+    const Vector3& p_j
+) {
+    if (!bodies.dynamic[p_body]) {
+        return;
+    }
+    bodies.biased_linear_velocity[p_body] += p_j * bodies.inv_mass[p_body];
+}
+
+void ContactSolverSW::_solve_batch(Batch& r_batch, real_t p_max_bias_rotation) {
+    const SimdFloat zero              = SimdFloat::splat(0.0f);
+    const SimdFloat min_velocity      = SimdFloat::splat(MIN_VELOCITY);
+    const SimdFloat epsilon           = SimdFloat::splat(CMP_EPSILON);
+    const SimdFloat max_bias_rotation = SimdFloat::splat(p_max_bias_rotation);
+
+    const Vector3* linear_velocity_ptr  = bodies.linear_velocity.ptr();
+    const Vector3* angular_velocity_ptr = bodies.angular_velocity.ptr();
+    const Vector3* biased_linear_velocity_ptr =
+        bodies.biased_linear_velocity.ptr();
+    const Vector3* biased_angular_velocity_ptr =
+        bodies.biased_angular_velocity.ptr();
+
+    SimdVector3 lvA = SimdVector3::gather(linear_velocity_ptr, r_batch.body_A);
+    SimdVector3 lvB = SimdVector3::gather(linear_velocity_ptr, r_batch.body_B);
+    SimdVector3 avA = SimdVector3::gather(angular_velocity_ptr, r_batch.body_A);
+    SimdVector3 avB = SimdVector3::gather(angular_velocity_ptr, r_batch.body_B);
+    SimdVector3 blvA =
+        SimdVector3::gather(biased_linear_velocity_ptr, r_batch.body_A);
+    SimdVector3 blvB =
+        SimdVector3::gather(biased_linear_velocity_ptr, r_batch.body_B);
+    SimdVector3 bavA =
+        SimdVector3::gather(biased_angular_velocity_ptr, r_batch.body_A);
+    SimdVector3 bavB =
+        SimdVector3::gather(biased_angular_velocity_ptr, r_batch.body_B);
+
+    const SimdVector3 normal     = SimdVector3::load(r_batch.normal);
+    const SimdVector3 rA         = SimdVector3::load(r_batch.rA);
+    const SimdVector3 rB         = SimdVector3::load(r_batch.rB);
+    const SimdVector3 impulse_rA = SimdVector3::load(r_batch.impulse_rA);
+    const SimdVector3 impulse_rB = SimdVector3::load(r_batch.impulse_rB);
+    const SimdBasis inv_inertia_tensor_A =
+        SimdBasis::load(r_batch.inv_inertia_tensor_A);
+    const SimdBasis inv_inertia_tensor_B =
+        SimdBasis::load(r_batch.inv_inertia_tensor_B);
+    const SimdFloat inv_mass_A   = SimdFloat::load(r_batch.inv_mass_A);
+    const SimdFloat inv_mass_B   = SimdFloat::load(r_batch.inv_mass_B);
+    const SimdFloat inv_mass_sum = SimdFloat::load(r_batch.inv_mass_sum);
+    const SimdFloat mass_normal  = SimdFloat::load(r_batch.mass_normal);
+    const SimdFloat bias         = SimdFloat::load(r_batch.bias);
+
+    // try to deactivate, will activate itself if still needed
+    const SimdMask active = SimdFloat::load(r_batch.active) > zero;
+
+    // bias impulse
+
+    SimdVector3 crbA = bavA.cross(rA);
+    SimdVector3 crbB = bavB.cross(rB);
+    SimdVector3 dbv  = blvB + crbB - blvA - crbA;
+
+    SimdFloat vbn = dbv.dot(normal);
+
+    const SimdMask bias_mask =
+        active & (SimdFloat::abs(bias - vbn) > min_velocity);
+    if (bias_mask.any()) {
+        SimdFloat jbn    = (bias - vbn) * mass_normal;
+        SimdFloat jbnOld = SimdFloat::load(r_batch.acc_bias_impulse);
+        SimdFloat acc_bias_impulse = SimdFloat::select(
+            bias_mask,
+            SimdFloat::max(jbnOld + jbn, zero),
+            jbnOld
+        );
+        acc_bias_impulse.store(r_batch.acc_bias_impulse);
+
+        SimdVector3 jb = normal * (acc_bias_impulse - jbnOld);
+
+        blvA = blvA - jb * inv_mass_A;
+        blvB = blvB + jb * inv_mass_B;
+
+        SimdVector3 delta_avA =
+            inv_inertia_tensor_A.xform(impulse_rA.cross(-jb));
+        SimdVector3 delta_avB =
+            inv_inertia_tensor_B.xform(impulse_rB.cross(jb));
+        SimdFloat delta_avA_length = delta_avA.length();
+        SimdFloat delta_avB_length = delta_avB.length();
+
+        delta_avA = SimdVector3::select(
+            delta_avA_length > max_bias_rotation,
+            delta_avA / delta_avA_length * max_bias_rotation,
+            delta_avA
+        );
+        delta_avB = SimdVector3::select(
+            delta_avB_length > max_bias_rotation,
+            delta_avB / delta_avB_length * max_bias_rotation,
+            delta_avB
+        );
+        bavA = bavA + delta_avA;
+        bavB = bavB + delta_avB;
+
+        crbA = bavA.cross(rA);
+        crbB = bavB.cross(rB);
+        dbv  = blvB + crbB - blvA - crbA;
+
+        vbn = dbv.dot(normal);
+
+        const SimdMask com_mask =
+            bias_mask & (SimdFloat::abs(bias - vbn) > min_velocity);
+        SimdFloat jbn_com    = (bias - vbn) / inv_mass_sum;
+        SimdFloat jbnOld_com =
+            SimdFloat::load(r_batch.acc_bias_impulse_center_of_mass);
+        SimdFloat acc_bias_impulse_center_of_mass = SimdFloat::select(
+            com_mask,
+            SimdFloat::max(jbnOld_com + jbn_com, zero),
+            jbnOld_com
+        );
+        acc_bias_impulse_center_of_mass.store(
+            r_batch.acc_bias_impulse_center_of_mass
+        );
+
+        SimdVector3 jb_com =
+            normal * (acc_bias_impulse_center_of_mass - jbnOld_com);
+
+        blvA = blvA - jb_com * inv_mass_A;
+        blvB = blvB + jb_com * inv_mass_B;
+    }
+
+    SimdVector3 crA = avA.cross(rA);
+    SimdVector3 crB = avB.cross(rB);
+    SimdVector3 dv  = lvB + crB - lvA - crA;
+
+    // normal impulse
+    SimdFloat vn = dv.dot(normal);
+
+    const SimdMask normal_mask = active & (SimdFloat::abs(vn) > min_velocity);
+    SimdFloat jn    = -(SimdFloat::load(r_batch.bounce) + vn) * mass_normal;
+    SimdFloat jnOld = SimdFloat::load(r_batch.acc_normal_impulse);
+    SimdFloat acc_normal_impulse =
+        SimdFloat::select(normal_mask, SimdFloat::max(jnOld + jn, zero), jnOld);
+    acc_normal_impulse.store(r_batch.acc_normal_impulse);
+
+    SimdVector3 j = normal * (acc_normal_impulse - jnOld);
+
+    lvA = lvA - j * inv_mass_A;
+    lvB = lvB + j * inv_mass_B;
+    avA = avA + inv_inertia_tensor_A.xform(impulse_rA.cross(-j));
+    avB = avB + inv_inertia_tensor_B.xform(impulse_rB.cross(j));
+
+    // friction impulse
+
+    SimdVector3 tlvA = lvA + avA.cross(rA);
+    SimdVector3 tlvB = lvB + avB.cross(rB);
+
+    SimdVector3 dtv = tlvB - tlvA;
+    SimdFloat tn    = normal.dot(dtv);
+
+    // tangential velocity
+    SimdVector3 tv = dtv - normal * tn;
+    SimdFloat tvl  = tv.length();
+
+    const SimdMask friction_mask = active & (tvl > min_velocity);
+    if (friction_mask.any()) {
+        tv = tv / tvl;
+
+        SimdVector3 temp1 = inv_inertia_tensor_A.xform(rA.cross(tv));
+        SimdVector3 temp2 = inv_inertia_tensor_B.xform(rB.cross(tv));
+
+        SimdFloat t =
+            -tvl / (inv_mass_sum + tv.dot(temp1.cross(rA) + temp2.cross(rB)));
+
+        SimdVector3 jt = tv * t;
+
+        SimdVector3 jtOld = SimdVector3::load(r_batch.acc_tangent_impulse);
+        SimdVector3 acc_tangent_impulse = jtOld + jt;
+
+        SimdFloat fi_len = acc_tangent_impulse.length();
+        SimdFloat jtMax =
+            acc_normal_impulse * SimdFloat::load(r_batch.friction);
+
+        acc_tangent_impulse = SimdVector3::select(
+            (fi_len > epsilon) & (fi_len > jtMax),
+            acc_tangent_impulse * (jtMax / fi_len),
+            acc_tangent_impulse
+        );
+        acc_tangent_impulse =
+            SimdVector3::select(friction_mask, acc_tangent_impulse, jtOld);
+        acc_tangent_impulse.store(r_batch.acc_tangent_impulse);
+
+        jt = acc_tangent_impulse - jtOld;
+
+        lvA = lvA - jt * inv_mass_A;
+        lvB = lvB + jt * inv_mass_B;
+        avA = avA + inv_inertia_tensor_A.xform(impulse_rA.cross(-jt));
+        avB = avB + inv_inertia_tensor_B.xform(impulse_rB.cross(jt));
+    }
+
+    SimdFloat::select(
+        bias_mask | normal_mask | friction_mask,
+        SimdFloat::splat(1.0f),
+        zero
+    )
+        .store(r_batch.active);
+
+    // Lanes never share a dynamic body, so the stores don't overlap.
+    const uint32_t count = r_batch.count;
+    lvA.scatter(
+        bodies.linear_velocity.ptr(),
+        r_batch.body_A,
+        r_batch.write_A,
+        count
+    );
+    lvB.scatter(
+        bodies.linear_velocity.ptr(),
+        r_batch.body_B,
+        r_batch.write_B,
+        count
+    );
+    avA.scatter(
+        bodies.angular_velocity.ptr(),
+        r_batch.body_A,
+        r_batch.write_A,
+        count
+    );
+    avB.scatter(
+        bodies.angular_velocity.ptr(),
+        r_batch.body_B,
+        r_batch.write_B,
+        count
+    );
+    blvA.scatter(
+        bodies.biased_linear_velocity.ptr(),
+        r_batch.body_A,
+        r_batch.write_A,
+        count
+    );
+    blvB.scatter(
+        bodies.biased_linear_velocity.ptr(),
+        r_batch.body_B,
+        r_batch.write_B,
+        count
+    );
+    bavA.scatter(
+        bodies.biased_angular_velocity.ptr(),
+        r_batch.body_A,
+        r_batch.write_A,
+        count
+    );
+    bavB.scatter(
+        bodies.biased_angular_velocity.ptr(),
+        r_batch.body_B,
+        r_batch.write_B,
+        count
+    );
+}
+
+void ContactSolverSW::solve_island(
+    uint32_t p_island,
+    int p_iterations,
+    real_t p_step
+) {
+    const Island& island = islands[p_island];
+
+    if (batched) {
+        for (int iteration = 0; iteration < p_iterations; iteration++) {
+            for (uint32_t i = island.batch_begin; i < island.batch_end; i++) {
+                _solve_batch(batches[i], MAX_BIAS_ROTATION / p_step);
+            }
+        }
+        return;
+    }
+
+    Vector3* linear_velocity         = bodies.linear_velocity.ptr();
+    Vector3* angular_velocity        = bodies.angular_velocity.ptr();
+    Vector3* biased_linear_velocity  = bodies.biased_linear_velocity.ptr();
+    Vector3* biased_angular_velocity = bodies.biased_angular_velocity.ptr();
+
+    const real_t max_bias_rotation = MAX_BIAS_ROTATION / p_step;
+
+    for (int iteration = 0; iteration < p_iterations; iteration++) {
+        for (uint32_t i = island.contact_begin; i < island.contact_end; i++) {
+            if (!contacts.active[i]) {
+                continue;
+            }
+
+            // try to deactivate, will activate itself if still needed
+            contacts.active[i] = false;
+
+            const uint32_t A      = contacts.body_A[i];
+            const uint32_t B      = contacts.body_B[i];
+            const Vector3& normal = contacts.normal[i];
+            const Vector3& rA     = contacts.rA[i];
+            const Vector3& rB     = contacts.rB[i];
+            const real_t bias     = contacts.bias[i];
+
+            // bias impulse
+
+            Vector3 crbA = biased_angular_velocity[A].cross(rA);
+            Vector3 crbB = biased_angular_velocity[B].cross(rB);
+            Vector3 dbv  = biased_linear_velocity[B] + crbB
+                        - biased_linear_velocity[A] - crbA;
+
+            real_t vbn = dbv.dot(normal);
+
+            if (Math::abs(-vbn + bias) > MIN_VELOCITY) {
+                real_t jbn    = (-vbn + bias) * contacts.mass_normal[i];
+                real_t jbnOld = contacts.acc_bias_impulse[i];
+                contacts.acc_bias_impulse[i] = MAX(jbnOld + jbn, 0.0f);
+
+                Vector3 jb = normal * (contacts.acc_bias_impulse[i] - jbnOld);
+
+                _apply_bias_impulse(
+                    A,
+                    contacts.impulse_rA[i],
+                    -jb,
+                    max_bias_rotation
+                );
+                _apply_bias_impulse(
+                    B,
+                    contacts.impulse_rB[i],
+                    jb,
+                    max_bias_rotation
+                );
+
+                crbA = biased_angular_velocity[A].cross(rA);
+                crbB = biased_angular_velocity[B].cross(rB);
+                dbv  = biased_linear_velocity[B] + crbB
+                    - biased_linear_velocity[A] - crbA;
+
+                vbn = dbv.dot(normal);
+
+                if (Math::abs(-vbn + bias) > MIN_VELOCITY) {
+                    real_t jbn_com =
+                        (-vbn + bias) / contacts.inv_mass_sum[i];
+                    real_t jbnOld_com =
+                        contacts.acc_bias_impulse_center_of_mass[i];
+                    contacts.acc_bias_impulse_center_of_mass[i] =
+                        MAX(jbnOld_com + jbn_com, 0.0f);
+
+                    Vector3 jb_com =
+                        normal
+                        * (contacts.acc_bias_impulse_center_of_mass[i]
+                           - jbnOld_com);
+
+                    _apply_bias_central_impulse(A, -jb_com);
+                    _apply_bias_central_impulse(B, jb_com);
+                }
+
+                contacts.active[i] = true;
+            }
+
+            Vector3 crA = angular_velocity[A].cross(rA);
+            Vector3 crB = angular_velocity[B].cross(rB);
+            Vector3 dv  = linear_velocity[B] + crB - linear_velocity[A] - crA;
+
+            // normal impulse
+            real_t vn = dv.dot(normal);
+
+            if (Math::abs(vn) > MIN_VELOCITY) {
+                real_t jn =
+                    -(contacts.bounce[i] + vn) * contacts.mass_normal[i];
+                real_t jnOld = contacts.acc_normal_impulse[i];
+                contacts.acc_normal_impulse[i] = MAX(jnOld + jn, 0.0f);
+
+                Vector3 j = normal * (contacts.acc_normal_impulse[i] - jnOld);
+
+                _apply_impulse(A, contacts.impulse_rA[i], -j);
+                _apply_impulse(B, contacts.impulse_rB[i], j);
+
+                contacts.active[i] = true;
+            }
+
+            // friction impulse
+
+            Vector3 lvA = linear_velocity[A] + angular_velocity[A].cross(rA);
+            Vector3 lvB = linear_velocity[B] + angular_velocity[B].cross(rB);
+
+            Vector3 dtv = lvB - lvA;
+            real_t tn   = normal.dot(dtv);
+
+            // tangential velocity
+            Vector3 tv = dtv - normal * tn;
+            real_t tvl = tv.length();
+
+            if (tvl > MIN_VELOCITY) {
+                tv /= tvl;
+
+                Vector3 temp1 =
+                    bodies.inv_inertia_tensor[A].xform(rA.cross(tv));
+                Vector3 temp2 =
+                    bodies.inv_inertia_tensor[B].xform(rB.cross(tv));
+
+                real_t t = -tvl
+                         / (contacts.inv_mass_sum[i]
+                            + tv.dot(temp1.cross(rA) + temp2.cross(rB)));
+
+                Vector3 jt = t * tv;
+
+                Vector3 jtOld = contacts.acc_tangent_impulse[i];
+                contacts.acc_tangent_impulse[i] += jt;
+
+                real_t fi_len = contacts.acc_tangent_impulse[i].length();
+                real_t jtMax =
+                    contacts.acc_normal_impulse[i] * contacts.friction[i];
+
+                if (fi_len > CMP_EPSILON && fi_len > jtMax) {
+                    contacts.acc_tangent_impulse[i] *= jtMax / fi_len;
+                }
+
+                jt = contacts.acc_tangent_impulse[i] - jtOld;
+
+                _apply_impulse(A, contacts.impulse_rA[i], -jt);
+                _apply_impulse(B, contacts.impulse_rB[i], jt);
+
+                contacts.active[i] = true;
+            }
+        }
+    }
+}
+
+void ContactSolverSW::unpack_island(uint32_t p_island) {
+    const Island& island = islands[p_island];
+
+    for (uint32_t i = island.body_begin; i < island.body_end; i++) {
+        if (!bodies.dynamic[i]) {
+            continue;
+        }
+        BodySW* body = bodies.body[i];
+        body->set_linear_velocity(bodies.linear_velocity[i]);
+        body->set_angular_velocity(bodies.angular_velocity[i]);
+        body->set_biased_linear_velocity(bodies.biased_linear_velocity[i]);
+        body->set_biased_angular_velocity(bodies.biased_angular_velocity[i]);
+    }
+
+    if (batched) {
+        for (uint32_t i = island.batch_begin; i < island.batch_end; i++) {
+            const Batch& batch = batches[i];
+            for (uint32_t lane = 0; lane < batch.count; lane++) {
+                BodyPairSW::Contact& c = *contacts.contact[batch.contact[lane]];
+                c.acc_normal_impulse   = batch.acc_normal_impulse[lane];
+                c.acc_tangent_impulse  = Vector3(
+                    batch.acc_tangent_impulse[0][lane],
+                    batch.acc_tangent_impulse[1][lane],
+                    batch.acc_tangent_impulse[2][lane]
+                );
+                c.acc_bias_impulse = batch.acc_bias_impulse[lane];
+                c.acc_bias_impulse_center_of_mass =
+                    batch.acc_bias_impulse_center_of_mass[lane];
+                c.active = batch.active[lane] > 0;
+            }
+        }
+        return;
+    }
+
+    for (uint32_t i = island.contact_begin; i < island.contact_end; i++) {
+        BodyPairSW::Contact& c = *contacts.contact[i];
+        c.acc_normal_impulse   = contacts.acc_normal_impulse[i];
+        c.acc_tangent_impulse  = contacts.acc_tangent_impulse[i];
+        c.acc_bias_impulse     = contacts.acc_bias_impulse[i];
+        c.acc_bias_impulse_center_of_mass =
+            contacts.acc_bias_impulse_center_of_mass[i];
+        c.active = contacts.active[i];
+    }
+}
+
+ContactSolverSW::ContactSolverSW() {
+    pack_id               = 0;
+    unpacked_island_count = 0;
+    batched               = false;
+}
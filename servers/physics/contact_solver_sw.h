@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef CONTACT_SOLVER_SW_H
+#define CONTACT_SOLVER_SW_H
+
+#include "body_pair_sw.h"
+#include "core/local_vector.h"
+#include "core/math/simd.h"
+
+// Solves islands that only contain contacts from contiguous arrays.
+//
+// The contacts and bodies of every island are packed once per step into
+// structures of arrays. The solver iterations then walk these arrays instead
+// of following the island lists and the body pointers of every contact. The
+// contacts are solved in the same order and with the same operations as
+// BodyPairSW::solve(), so the results are identical.
+//
+// When batching is enabled, the contacts of an island are also grouped into
+// batches of contacts that don't share a dynamic body, and every batch is
+// solved at once in the lanes of SimdFloat. This changes the order the
+// contacts are solved in, so the results differ slightly from the unbatched
+// solver, but the order of the contacts of every body is kept.
+class ContactSolverSW {
+    enum {
+        LANES = SimdFloat::WIDTH
+    };
+
+    struct Bodies {
+        LocalVector<BodySW*> body;
+        LocalVector<Vector3> linear_velocity;
+        LocalVector<Vector3> angular_velocity;
+        LocalVector<Vector3> biased_linear_velocity;
+        LocalVector<Vector3> biased_angular_velocity;
+        LocalVector<Basis> inv_inertia_tensor;
+        LocalVector<real_t> inv_mass;
+        LocalVector<uint8_t> dynamic;
+
+        void clear();
+        uint32_t add(BodySW* p_body);
+    };
+
+    struct Contacts {
+        LocalVector<BodyPairSW::Contact*> contact;
+        LocalVector<uint32_t> body_A;
+        LocalVector<uint32_t> body_B;
+        LocalVector<Vector3> normal;
+        // Offsets from the center of mass.
+        LocalVector<Vector3> rA;
+        LocalVector<Vector3> rB;
+        // Offsets used to apply the impulses, rounded like BodySW does.
+        LocalVector<Vector3> impulse_rA;
+        LocalVector<Vector3> impulse_rB;
+        LocalVector<real_t> mass_normal;
+        LocalVector<real_t> inv_mass_sum;
+        LocalVector<real_t> bias;
+        LocalVector<real_t> bounce;
+        LocalVector<real_t> friction;
+        LocalVector<real_t> acc_normal_impulse;
+        LocalVector<Vector3> acc_tangent_impulse;
+        LocalVector<real_t> acc_bias_impulse;
+        LocalVector<real_t> acc_bias_impulse_center_of_mass;
+        LocalVector<uint8_t> active;
+
+        void clear();
+        void add(
+            BodyPairSW* p_pair,
+            BodyPairSW::Contact* p_contact,
+            uint32_t p_body_A,
+            uint32_t p_body_B
+        );
+    };
+
+    // The contact data of a batch, with one lane per contact. Unused lanes
+    // are inactive and have no mass.
+    struct Batch {
+        uint32_t count;
+        uint32_t contact[LANES];
+        uint32_t body_A[LANES];
+        uint32_t body_B[LANES];
+        // Whether the lane's body is dynamic, so its velocity is written back.
+        bool write_A[LANES];
+        bool write_B[LANES];
+        float normal[3][LANES];
+        float rA[3][LANES];
+        float rB[3][LANES];
+        float impulse_rA[3][LANES];
+        float impulse_rB[3][LANES];
+        float inv_mass_A[LANES];
+        float inv_mass_B[LANES];
+        float inv_inertia_tensor_A[9][LANES];
+        float inv_inertia_tensor_B[9][LANES];
+        float mass_normal[LANES];
+        float inv_mass_sum[LANES];
+        float bias[LANES];
+        float bounce[LANES];
+        float friction[LANES];
+        float acc_normal_impulse[LANES];
+        float acc_tangent_impulse[3][LANES];
+        float acc_bias_impulse[LANES];
+        float acc_bias_impulse_center_of_mass[LANES];
+        float active[LANES];
+    };
+
+    struct Island {
+        uint32_t body_begin;
+        uint32_t body_end;
+        uint32_t contact_begin;
+        uint32_t contact_end;
+        uint32_t batch_begin;
+        uint32_t batch_end;
+        bool packed;
+    };
+
+    Bodies bodies;
+    Contacts contacts;
+    LocalVector<Batch> batches;
+    LocalVector<uint32_t> body_next_batch;
+    LocalVector<Island> islands;
+    uint64_t pack_id;
+    int unpacked_island_count;
+    bool batched;
+
+    bool _can_pack_island(ConstraintSW* p_island) const;
+    void _pack_island(ConstraintSW* p_island, Island& r_island);
+    void _batch_island(Island& r_island);
+    void _add_to_batch(Batch& r_batch, uint32_t p_contact);
+    void _solve_batch(Batch& r_batch, real_t p_max_bias_rotation);
+
+    _FORCE_INLINE_ void _apply_impulse(
+        uint32_t p_body,
+        const Vector3& p_offset,
+        const Vector3& p_j
+    );
+    _FORCE_INLINE_ void _apply_bias_impulse(
+        uint32_t p_body,
+        const Vector3& p_offset,
+        const Vector3& p_j,
+        real_t p_max_delta_av
+    );
+    _FORCE_INLINE_ void _apply_bias_central_impulse(
+        uint32_t p_body,
+        const Vector3& p_j
+    );
+
+public:
+    void set_batched(bool p_batched);
+
+    _FORCE_INLINE_ bool is_batched() const {
+        return batched;
+    }
+
+    // Packs every island of p_islands that can be solved from the arrays.
+    void pack(const LocalVector<ConstraintSW*>& p_islands);
+
+    _FORCE_INLINE_ bool is_island_packed(uint32_t p_island) const {
+        return islands[p_island].packed;
+    }
+
+    // Solving and unpacking only access the island's own bodies and contacts,
+    // so different islands can be processed concurrently.
+    void solve_island(uint32_t p_island, int p_iterations, real_t p_step);
+    void unpack_island(uint32_t p_island);
+
+    _FORCE_INLINE_ int get_packed_contact_count() const {
+        return contacts.contact.size();
+    }
+
+    _FORCE_INLINE_ int get_unpacked_island_count() const {
+        return unpacked_island_count;
+    }
+
+    ContactSolverSW();
+};
+
+#endif // CONTACT_SOLVER_SW_H
@@ -14,6 +14,10 @@ class JointSW : public ConstraintSW {
 public:
     virtual PhysicsServer::JointType get_type() const = 0;
 
+    ConstraintType get_constraint_type() const {
+        return CONSTRAINT_TYPE_JOINT;
+    }
+
     _FORCE_INLINE_ JointSW(
         BodySW** p_body_ptr = nullptr,
         int p_body_count    = 0
@@ -1591,15 +1591,23 @@ void PhysicsServerSW::step(real_t p_step) {
     last_step                                 = p_step;
     PhysicsDirectBodyStateSW::singleton->step = p_step;
 
-    island_count    = 0;
-    active_objects  = 0;
-    collision_pairs = 0;
+    island_count          = 0;
+    active_objects        = 0;
+    collision_pairs       = 0;
+    packed_contact_count  = 0;
+    unpacked_island_count = 0;
+    solve_time            = 0;
     for (Set<const SpaceSW*>::Element* E = active_spaces.front(); E;
          E                               = E->next()) {
         stepper->step((SpaceSW*)E->get(), p_step, iterations);
-        island_count    += E->get()->get_island_count();
-        active_objects  += E->get()->get_active_objects();
-        collision_pairs += E->get()->get_collision_pairs();
+        island_count          += E->get()->get_island_count();
+        active_objects        += E->get()->get_active_objects();
+        collision_pairs       += E->get()->get_collision_pairs();
+        packed_contact_count  += E->get()->get_packed_contact_count();
+        unpacked_island_count += E->get()->get_unpacked_island_count();
+        solve_time += E->get()->get_elapsed_time(
+            SpaceSW::ELAPSED_TIME_SOLVE_CONSTRAINTS
+        );
     }
 #endif
 }
@@ -1681,6 +1689,15 @@ int PhysicsServerSW::get_process_info(ProcessInfo p_info) {
         case INFO_ISLAND_COUNT: {
             return island_count;
         } break;
+        case INFO_PACKED_CONTACT_COUNT: {
+            return packed_contact_count;
+        } break;
+        case INFO_UNPACKED_ISLAND_COUNT: {
+            return unpacked_island_count;
+        } break;
+        case INFO_SOLVE_TIME: {
+            return solve_time;
+        } break;
     }
 
     return 0;
@@ -1744,9 +1761,12 @@ PhysicsServerSW::PhysicsServerSW() {
         BroadPhaseSW::create_func = BroadPhaseOctree::_create;
     }
 
-    island_count    = 0;
-    active_objects  = 0;
-    collision_pairs = 0;
+    island_count          = 0;
+    active_objects        = 0;
+    collision_pairs       = 0;
+    packed_contact_count  = 0;
+    unpacked_island_count = 0;
+    solve_time            = 0;
 
     active           = true;
     flushing_queries = false;
@@ -24,6 +24,9 @@ class PhysicsServerSW : public PhysicsServer {
     int island_count;
     int active_objects;
     int collision_pairs;
+    int packed_contact_count;
+    int unpacked_island_count;
+    uint64_t solve_time;
 
     bool flushing_queries;
 
@@ -1683,10 +1683,12 @@ PhysicsDirectSpaceStateSW* SpaceSW::get_direct_state() {
 }
 
 SpaceSW::SpaceSW() {
-    collision_pairs     = 0;
-    active_objects      = 0;
-    island_count        = 0;
-    contact_debug_count = 0;
+    collision_pairs       = 0;
+    active_objects        = 0;
+    island_count          = 0;
+    packed_contact_count  = 0;
+    unpacked_island_count = 0;
+    contact_debug_count   = 0;
 
     locked                          = false;
     contact_recycle_radius          = 0.01f;
@@ -163,6 +163,8 @@ private:
     int island_count;
     int active_objects;
     int collision_pairs;
+    int packed_contact_count;
+    int unpacked_island_count;
 
     RID static_global_body;
 
@@ -274,6 +276,22 @@ public:
         return collision_pairs;
     }
 
+    void set_packed_contact_count(int p_packed_contact_count) {
+        packed_contact_count = p_packed_contact_count;
+    }
+
+    int get_packed_contact_count() const {
+        return packed_contact_count;
+    }
+
+    void set_unpacked_island_count(int p_unpacked_island_count) {
+        unpacked_island_count = p_unpacked_island_count;
+    }
+
+    int get_unpacked_island_count() const {
+        return unpacked_island_count;
+    }
+
     PhysicsDirectSpaceStateSW* get_direct_state();
 
     void set_debug_contacts(int p_amount) {
@@ -7,6 +7,7 @@
 #include "step_sw.h"
 
 #include "core/os/os.h"
+#include "core/project_settings.h"
 #include "joints_sw.h"
 
 void StepSW::_populate_island(
@@ -96,6 +97,15 @@ void StepSW::_solve_island(
     }
 }
 
+void StepSW::_solve_island_thread(uint32_t p_index, void* p_userdata) {
+    if (packed_contact_solver && contact_solver.is_island_packed(p_index)) {
+        contact_solver.solve_island(p_index, solve_iterations, solve_delta);
+        contact_solver.unpack_island(p_index);
+        return;
+    }
+    _solve_island(constraint_islands[p_index], solve_iterations, solve_delta);
+}
+
 void StepSW::_check_suspend(BodySW* p_island, real_t p_delta) {
     bool can_sleep = true;
 
@@ -250,12 +260,37 @@ void StepSW::step(SpaceSW* p_space, real_t p_delta, int p_iterations) {
     /* SOLVE CONSTRAINT ISLANDS */
 
     {
+        // Every island is solved on a single thread in the same order as the
+        // serial path, so the results don't depend on the thread count.
+        constraint_islands.clear();
         ConstraintSW* ci = constraint_island_list;
         while (ci) {
-            // iterating each island separatedly improves cache efficiency
-            _solve_island(ci, p_iterations, p_delta);
+            constraint_islands.push_back(ci);
             ci = ci->get_island_list_next();
         }
+
+        if (packed_contact_solver) {
+            contact_solver.pack(constraint_islands);
+            p_space->set_packed_contact_count(
+                contact_solver.get_packed_contact_count()
+            );
+            p_space->set_unpacked_island_count(
+                contact_solver.get_unpacked_island_count()
+            );
+        } else {
+            p_space->set_packed_contact_count(0);
+            p_space->set_unpacked_island_count(constraint_islands.size());
+        }
+
+        solve_iterations = p_iterations;
+        solve_delta      = p_delta;
+        // iterating each island separatedly improves cache efficiency
+        work_pool.do_work(
+            constraint_islands.size(),
+            this,
+            &StepSW::_solve_island_thread,
+            nullptr
+        );
     }
 
     { // profile
@@ -300,5 +335,22 @@ void StepSW::step(SpaceSW* p_space, real_t p_delta, int p_iterations) {
 }
 
 StepSW::StepSW() {
-    _step = 1;
+    _step            = 1;
+    solve_iterations = 0;
+    solve_delta      = 0;
+
+    int thread_count = ThreadWorkPool::define_thread_count_setting(
+        "physics/3d/rebel_physics/solver_thread_count"
+    );
+    work_pool.init(thread_count);
+
+    packed_contact_solver =
+        GLOBAL_DEF("physics/3d/rebel_physics/packed_contact_solver", true);
+    contact_solver.set_batched(
+        GLOBAL_DEF("physics/3d/rebel_physics/batched_contact_solver", false)
+    );
+}
+
+StepSW::~StepSW() {
+    work_pool.finish();
 }
@@ -7,11 +7,23 @@
 #ifndef STEP_SW_H
 #define STEP_SW_H
 
+#include "contact_solver_sw.h"
+#include "core/local_vector.h"
+#include "core/os/thread_work_pool.h"
 #include "space_sw.h"
 
 class StepSW {
     uint64_t _step;
 
+    // Islands don't share any dynamic bodies, so they are solved concurrently.
+    ThreadWorkPool work_pool;
+    LocalVector<ConstraintSW*> constraint_islands;
+    int solve_iterations;
+    real_t solve_delta;
+
+    ContactSolverSW contact_solver;
+    bool packed_contact_solver;
+
     void _populate_island(
         BodySW* p_body,
         BodySW** p_island,
@@ -23,11 +35,13 @@ class StepSW {
         int p_iterations,
         real_t p_delta
     );
+    void _solve_island_thread(uint32_t p_index, void* p_userdata);
     void _check_suspend(BodySW* p_island, real_t p_delta);
 
 public:
     void step(SpaceSW* p_space, real_t p_delta, int p_iterations);
     StepSW();
+    ~StepSW();
 };
 
 #endif // STEP__SW_H
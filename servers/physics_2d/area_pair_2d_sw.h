@@ -19,6 +19,14 @@ class AreaPair2DSW : public Constraint2DSW {
     bool colliding;
 
 public:
+    ConstraintType get_constraint_type() const {
+        return CONSTRAINT_TYPE_AREA_PAIR;
+    }
+
+    SetupMode get_setup_mode() const {
+        return SETUP_MODE_DEFERRED;
+    }
+
     bool setup(real_t p_step);
     void solve(real_t p_step);
 
@@ -39,6 +47,14 @@ class Area2Pair2DSW : public Constraint2DSW {
     bool colliding;
 
 public:
+    ConstraintType get_constraint_type() const {
+        return CONSTRAINT_TYPE_AREA_PAIR;
+    }
+
+    SetupMode get_setup_mode() const {
+        return SETUP_MODE_DEFERRED;
+    }
+
     bool setup(real_t p_step);
     void solve(real_t p_step);
 
@@ -409,7 +409,9 @@ void Body2DSW::_compute_area_gravity_and_dampenings(const Area2DSW* p_area) {
     area_angular_damp += p_area->get_angular_damp();
 }
 
-void Body2DSW::integrate_forces(real_t p_step) {
+void Body2DSW::integrate_forces_local(real_t p_step) {
+    pending_motion_update = false;
+
     if (mode == Physics2DServer::BODY_MODE_STATIC) {
         return;
     }
@@ -535,7 +537,8 @@ void Body2DSW::integrate_forces(real_t p_step) {
     biased_linear_velocity  = Vector2();
 
     if (do_motion) { // shapes temporarily extend for raycast
-        _update_shapes_with_motion(motion);
+        pending_motion        = motion;
+        pending_motion_update = true;
     }
 
     // damp_area=NULL; // clear the area, so it is set in the next frame
@@ -543,22 +546,23 @@ void Body2DSW::integrate_forces(real_t p_step) {
     contact_count = 0;
 }
 
-void Body2DSW::integrate_velocities(real_t p_step) {
-    if (mode == Physics2DServer::BODY_MODE_STATIC) {
-        return;
+void Body2DSW::integrate_forces_commit() {
+    if (pending_motion_update) {
+        _update_shapes_with_motion(pending_motion);
+        pending_motion_update = false;
     }
+}
 
-    if (fi_callback) {
-        get_space()->body_add_to_state_query_list(&direct_state_query_list);
+void Body2DSW::integrate_velocities_local(real_t p_step) {
+    pending_shape_update = false;
+
+    if (mode == Physics2DServer::BODY_MODE_STATIC) {
+        return;
     }
 
     if (mode == Physics2DServer::BODY_MODE_KINEMATIC) {
         _set_transform(new_transform, false);
         _set_inv_transform(new_transform.affine_inverse());
-        if (contacts.size() == 0 && linear_velocity == Vector2()
-            && angular_velocity == 0) {
-            set_active(false); // stopped moving, deactivate
-        }
         return;
     }
 
@@ -569,11 +573,10 @@ void Body2DSW::integrate_velocities(real_t p_step) {
         get_transform().get_rotation() + total_angular_velocity * p_step;
     Vector2 pos = get_transform().get_origin() + total_linear_velocity * p_step;
 
-    _set_transform(
-        Transform2D(angle, pos),
-        continuous_cd_mode == Physics2DServer::CCD_MODE_DISABLED
-    );
+    _set_transform(Transform2D(angle, pos), false);
     _set_inv_transform(get_transform().inverse());
+    pending_shape_update =
+        continuous_cd_mode == Physics2DServer::CCD_MODE_DISABLED;
 
     if (continuous_cd_mode != Physics2DServer::CCD_MODE_DISABLED) {
         new_transform = get_transform();
@@ -582,6 +585,29 @@ void Body2DSW::integrate_velocities(real_t p_step) {
     //_update_inertia_tensor();
 }
 
+void Body2DSW::integrate_velocities_commit() {
+    if (mode == Physics2DServer::BODY_MODE_STATIC) {
+        return;
+    }
+
+    if (fi_callback) {
+        get_space()->body_add_to_state_query_list(&direct_state_query_list);
+    }
+
+    if (mode == Physics2DServer::BODY_MODE_KINEMATIC) {
+        if (contacts.size() == 0 && linear_velocity == Vector2()
+            && angular_velocity == 0) {
+            set_active(false); // stopped moving, deactivate
+        }
+        return;
+    }
+
+    if (pending_shape_update) {
+        _update_shapes();
+        pending_shape_update = false;
+    }
+}
+
 void Body2DSW::wakeup_neighbours() {
     for (Map<Constraint2DSW*, int>::Element* E = constraint_map.front(); E;
          E                                     = E->next()) {
@@ -686,17 +712,21 @@ Body2DSW::Body2DSW() : CollisionObject2DSW(TYPE_BODY) {
     omit_force_integration  = false;
     applied_torque          = 0;
     island_step             = 0;
+    solver_pack_id          = 0;
+    solver_index            = 0;
     island_next             = nullptr;
     island_list_next        = nullptr;
     _set_static(false);
-    first_time_kinematic = false;
-    linear_damp          = -1;
-    angular_damp         = -1;
-    area_angular_damp    = 0;
-    area_linear_damp     = 0;
-    contact_count        = 0;
-    gravity_scale        = 1.0;
-    first_integration    = false;
+    first_time_kinematic  = false;
+    linear_damp           = -1;
+    angular_damp          = -1;
+    area_angular_damp     = 0;
+    area_linear_damp      = 0;
+    contact_count         = 0;
+    gravity_scale         = 1.0;
+    first_integration     = false;
+    pending_motion_update = false;
+    pending_shape_update  = false;
 
     still_time         = 0;
     continuous_cd_mode = Physics2DServer::CCD_MODE_DISABLED;
@@ -59,6 +59,11 @@ class Body2DSW : public CollisionObject2DSW {
     virtual void _shapes_changed();
     Transform2D new_transform;
 
+    // Space updates left by the thread-safe part of the integration.
+    Vector2 pending_motion;
+    bool pending_motion_update;
+    bool pending_shape_update;
+
     Map<Constraint2DSW*, int> constraint_map;
 
     struct AreaCMP {
@@ -110,6 +115,10 @@ class Body2DSW : public CollisionObject2DSW {
     Body2DSW* island_next;
     Body2DSW* island_list_next;
 
+    // Where the batched contact solver stored this body in the current step.
+    uint64_t solver_pack_id;
+    uint32_t solver_index;
+
     _FORCE_INLINE_ void _compute_area_gravity_and_dampenings(
         const Area2DSW* p_area
     );
@@ -211,6 +220,22 @@ public:
         island_list_next = p_next;
     }
 
+    _FORCE_INLINE_ uint64_t get_solver_pack_id() const {
+        return solver_pack_id;
+    }
+
+    _FORCE_INLINE_ void set_solver_pack_id(uint64_t p_pack_id) {
+        solver_pack_id = p_pack_id;
+    }
+
+    _FORCE_INLINE_ uint32_t get_solver_index() const {
+        return solver_index;
+    }
+
+    _FORCE_INLINE_ void set_solver_index(uint32_t p_index) {
+        solver_index = p_index;
+    }
+
     _FORCE_INLINE_ void add_constraint(
         Constraint2DSW* p_constraint,
         int p_pos
@@ -271,7 +296,17 @@ public:
         return biased_angular_velocity;
     }
 
+    // Static and kinematic bodies have no inverse mass, so impulses never
+    // change them. They can also be shared by islands that are solved on
+    // different threads, so they must not be written to at all.
+    _FORCE_INLINE_ bool is_impulse_static() const {
+        return mode <= Physics2DServer::BODY_MODE_KINEMATIC;
+    }
+
     _FORCE_INLINE_ void apply_central_impulse(const Vector2& p_impulse) {
+        if (is_impulse_static()) {
+            return;
+        }
         linear_velocity += p_impulse * _inv_mass;
     }
 
@@ -279,11 +314,17 @@ public:
         const Vector2& p_offset,
         const Vector2& p_impulse
     ) {
+        if (is_impulse_static()) {
+            return;
+        }
         linear_velocity  += p_impulse * _inv_mass;
         angular_velocity += _inv_inertia * p_offset.cross(p_impulse);
     }
 
     _FORCE_INLINE_ void apply_torque_impulse(real_t p_torque) {
+        if (is_impulse_static()) {
+            return;
+        }
         angular_velocity += _inv_inertia * p_torque;
     }
 
@@ -291,6 +332,9 @@ public:
         const Vector2& p_pos,
         const Vector2& p_j
     ) {
+        if (is_impulse_static()) {
+            return;
+        }
         biased_linear_velocity  += p_j * _inv_mass;
         biased_angular_velocity += _inv_inertia * p_pos.cross(p_j);
     }
@@ -396,8 +440,13 @@ public:
         return angular_damp;
     }
 
-    void integrate_forces(real_t p_step);
-    void integrate_velocities(real_t p_step);
+    // The integration is split in a part that only changes this body, which
+    // can run on any thread, and a part that updates the space (broadphase,
+    // query and active lists), which must run on the physics thread.
+    void integrate_forces_local(real_t p_step);
+    void integrate_forces_commit();
+    void integrate_velocities_local(real_t p_step);
+    void integrate_velocities_commit();
 
     _FORCE_INLINE_ Vector2 get_velocity_in_local_point(const Vector2& rel_pos
     ) const {
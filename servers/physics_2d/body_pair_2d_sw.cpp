@@ -225,6 +225,20 @@ real_t combine_friction(Body2DSW* A, Body2DSW* B) {
     return ABS(MIN(A->get_friction(), B->get_friction()));
 }
 
+Constraint2DSW::SetupMode BodyPair2DSW::get_setup_mode() const {
+#ifdef DEBUG_ENABLED
+    if (space->is_debugging_contacts()) {
+        return SETUP_MODE_SERIAL;
+    }
+#endif
+    // Static and kinematic bodies can be shared with other islands.
+    if ((A->is_impulse_static() && A->can_report_contacts())
+        || (B->is_impulse_static() && B->can_report_contacts())) {
+        return SETUP_MODE_SERIAL;
+    }
+    return SETUP_MODE_THREAD_SAFE;
+}
+
 bool BodyPair2DSW::setup(real_t p_step) {
     // cannot collide
     if (!A->test_collision_mask(B) || A->has_exception(B->get_self())
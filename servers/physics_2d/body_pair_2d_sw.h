@@ -10,6 +10,8 @@
 #include "body_2d_sw.h"
 #include "constraint_2d_sw.h"
 
+real_t combine_friction(Body2DSW* A, Body2DSW* B);
+
 class BodyPair2DSW : public Constraint2DSW {
     enum {
         MAX_CONTACTS = 2
@@ -78,7 +80,14 @@ class BodyPair2DSW : public Constraint2DSW {
         const Vector2& p_point_B
     );
 
+    friend class ContactSolver2DSW;
+
 public:
+    ConstraintType get_constraint_type() const {
+        return CONSTRAINT_TYPE_BODY_PAIR;
+    }
+
+    SetupMode get_setup_mode() const;
     bool setup(real_t p_step);
     void solve(real_t p_step);
 
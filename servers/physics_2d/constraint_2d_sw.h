@@ -16,6 +16,7 @@ class Constraint2DSW : public RID_Data {
     Constraint2DSW* island_next;
     Constraint2DSW* island_list_next;
     bool disabled_collisions_between_bodies;
+    bool setup_result;
 
     RID self;
 
@@ -25,9 +26,27 @@ protected:
         _body_count                        = p_body_count;
         island_step                        = 0;
         disabled_collisions_between_bodies = true;
+        setup_result                       = false;
     }
 
 public:
+    enum ConstraintType {
+        CONSTRAINT_TYPE_BODY_PAIR,
+        CONSTRAINT_TYPE_AREA_PAIR,
+        CONSTRAINT_TYPE_JOINT,
+    };
+
+    // How setup() can be scheduled when islands are set up concurrently.
+    enum SetupMode {
+        // Only changes this constraint and the dynamic bodies of its island.
+        SETUP_MODE_THREAD_SAFE,
+        // Changes shared state, but doesn't change the island bodies'
+        // velocities, so it can run on the physics thread after the island.
+        SETUP_MODE_DEFERRED,
+        // Changes shared state and the island bodies' velocities.
+        SETUP_MODE_SERIAL,
+    };
+
     _FORCE_INLINE_ void set_self(const RID& p_self) {
         self = p_self;
     }
@@ -77,6 +96,20 @@ public:
         return disabled_collisions_between_bodies;
     }
 
+    _FORCE_INLINE_ void set_setup_result(bool p_result) {
+        setup_result = p_result;
+    }
+
+    _FORCE_INLINE_ bool get_setup_result() const {
+        return setup_result;
+    }
+
+    virtual SetupMode get_setup_mode() const {
+        return SETUP_MODE_THREAD_SAFE;
+    }
+
+    virtual ConstraintType get_constraint_type() const = 0;
+
     virtual bool setup(real_t p_step) = 0;
     virtual void solve(real_t p_step) = 0;
 
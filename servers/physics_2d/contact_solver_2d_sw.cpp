@@ -0,0 +1,419 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "contact_solver_2d_sw.h"
+
+namespace {
+
+struct SimdVector2 {
+    SimdFloat x;
+    SimdFloat y;
+
+    static _FORCE_INLINE_ SimdVector2
+    load(const float p_src[2][SimdFloat::WIDTH]) {
+        return {SimdFloat::load(p_src[0]), SimdFloat::load(p_src[1])};
+    }
+
+    _FORCE_INLINE_ SimdVector2 operator+(const SimdVector2& p_v) const {
+        return {x + p_v.x, y + p_v.y};
+    }
+
+    _FORCE_INLINE_ SimdVector2 operator-(const SimdVector2& p_v) const {
+        return {x - p_v.x, y - p_v.y};
+    }
+
+    _FORCE_INLINE_ SimdVector2 operator-() const {
+        return {-x, -y};
+    }
+
+    _FORCE_INLINE_ SimdVector2 operator*(const SimdFloat& p_scalar) const {
+        return {x * p_scalar, y * p_scalar};
+    }
+
+    _FORCE_INLINE_ SimdFloat dot(const SimdVector2& p_v) const {
+        return x * p_v.x + y * p_v.y;
+    }
+
+    _FORCE_INLINE_ SimdFloat cross(const SimdVector2& p_v) const {
+        return x * p_v.y - y * p_v.x;
+    }
+
+    _FORCE_INLINE_ SimdVector2 tangent() const {
+        return {y, -x};
+    }
+
+    static _FORCE_INLINE_ SimdVector2
+    gather(const Vector2* p_src, const uint32_t* p_index) {
+        float v[2][SimdFloat::WIDTH];
+        for (int i = 0; i < SimdFloat::WIDTH; i++) {
+            const Vector2& src = p_src[p_index[i]];
+            v[0][i]            = src.x;
+            v[1][i]            = src.y;
+        }
+        return load(v);
+    }
+
+    _FORCE_INLINE_ void scatter(
+        Vector2* p_dst,
+        const uint32_t* p_index,
+        const bool* p_write,
+        uint32_t p_count
+    ) const {
+        float v[2][SimdFloat::WIDTH];
+        x.store(v[0]);
+        y.store(v[1]);
+        for (uint32_t i = 0; i < p_count; i++) {
+            if (p_write[i]) {
+                p_dst[p_index[i]] = Vector2(v[0][i], v[1][i]);
+            }
+        }
+    }
+};
+
+_FORCE_INLINE_ SimdFloat gather(const real_t* p_src, const uint32_t* p_index) {
+    float v[SimdFloat::WIDTH];
+    for (int i = 0; i < SimdFloat::WIDTH; i++) {
+        v[i] = p_src[p_index[i]];
+    }
+    return SimdFloat::load(v);
+}
+
+_FORCE_INLINE_ void scatter(
+    const SimdFloat& p_value,
+    real_t* p_dst,
+    const uint32_t* p_index,
+    const bool* p_write,
+    uint32_t p_count
+) {
+    float v[SimdFloat::WIDTH];
+    p_value.store(v);
+    for (uint32_t i = 0; i < p_count; i++) {
+        if (p_write[i]) {
+            p_dst[p_index[i]] = v[i];
+        }
+    }
+}
+
+} // namespace
+
+void ContactSolver2DSW::Bodies::clear() {
+    body.clear();
+    linear_velocity.clear();
+    angular_velocity.clear();
+    biased_linear_velocity.clear();
+    biased_angular_velocity.clear();
+    dynamic.clear();
+    next_batch.clear();
+}
+
+uint32_t ContactSolver2DSW::Bodies::add(Body2DSW* p_body) {
+    body.push_back(p_body);
+    linear_velocity.push_back(p_body->get_linear_velocity());
+    angular_velocity.push_back(p_body->get_angular_velocity());
+    biased_linear_velocity.push_back(p_body->get_biased_linear_velocity());
+    biased_angular_velocity.push_back(p_body->get_biased_angular_velocity());
+    dynamic.push_back(!p_body->is_impulse_static());
+    next_batch.push_back(0);
+    return body.size() - 1;
+}
+
+bool ContactSolver2DSW::_can_pack_island(Constraint2DSW* p_island) const {
+    for (Constraint2DSW* ci = p_island; ci; ci = ci->get_island_next()) {
+        if (ci->get_constraint_type()
+            == Constraint2DSW::CONSTRAINT_TYPE_JOINT) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ContactSolver2DSW::_add_contact(
+    Island& r_island,
+    BodyPair2DSW* p_pair,
+    BodyPair2DSW::Contact* p_contact,
+    uint32_t p_body_A,
+    uint32_t p_body_B
+) {
+    // Place the contact after the batches that already use its dynamic
+    // bodies, so the contacts of every body are solved in island order.
+    uint32_t batch_index = r_island.batch_begin;
+    if (bodies.dynamic[p_body_A]) {
+        batch_index = MAX(batch_index, bodies.next_batch[p_body_A]);
+    }
+    if (bodies.dynamic[p_body_B]) {
+        batch_index = MAX(batch_index, bodies.next_batch[p_body_B]);
+    }
+    while (batch_index < batches.size()
+           && batches[batch_index].count == LANES) {
+        batch_index++;
+    }
+    if (batch_index == batches.size()) {
+        batches.resize(batch_index + 1);
+        memset(&batches[batch_index], 0, sizeof(Batch));
+    }
+    if (bodies.dynamic[p_body_A]) {
+        bodies.next_batch[p_body_A] = batch_index + 1;
+    }
+    if (bodies.dynamic[p_body_B]) {
+        bodies.next_batch[p_body_B] = batch_index + 1;
+    }
+
+    Body2DSW* A                    = p_pair->A;
+    Body2DSW* B                    = p_pair->B;
+    const BodyPair2DSW::Contact& c = *p_contact;
+    Batch& batch                   = batches[batch_index];
+    const uint32_t lane            = batch.count++;
+
+    batch.contact[lane] = p_contact;
+    batch.body_A[lane]  = p_body_A;
+    batch.body_B[lane]  = p_body_B;
+    batch.write_A[lane] = bodies.dynamic[p_body_A];
+    batch.write_B[lane] = bodies.dynamic[p_body_B];
+
+    for (int i = 0; i < 2; i++) {
+        batch.normal[i][lane] = c.normal[i];
+        batch.rA[i][lane]     = c.rA[i];
+        batch.rB[i][lane]     = c.rB[i];
+    }
+
+    // Impulses don't change static and kinematic bodies.
+    if (bodies.dynamic[p_body_A]) {
+        batch.inv_mass_A[lane]    = A->get_inv_mass();
+        batch.inv_inertia_A[lane] = A->get_inv_inertia();
+    }
+    if (bodies.dynamic[p_body_B]) {
+        batch.inv_mass_B[lane]    = B->get_inv_mass();
+        batch.inv_inertia_B[lane] = B->get_inv_inertia();
+    }
+
+    batch.mass_normal[lane]         = c.mass_normal;
+    batch.mass_tangent[lane]        = c.mass_tangent;
+    batch.bias[lane]                = c.bias;
+    batch.bounce[lane]              = c.bounce;
+    batch.friction[lane]            = combine_friction(A, B);
+    batch.acc_normal_impulse[lane]  = c.acc_normal_impulse;
+    batch.acc_tangent_impulse[lane] = c.acc_tangent_impulse;
+    batch.acc_bias_impulse[lane]    = c.acc_bias_impulse;
+}
+
+void ContactSolver2DSW::_pack_island(
+    Constraint2DSW* p_island,
+    Island& r_island
+) {
+    r_island.body_begin  = bodies.body.size();
+    r_island.batch_begin = batches.size();
+
+    for (Constraint2DSW* ci = p_island; ci; ci = ci->get_island_next()) {
+        if (ci->get_constraint_type()
+            != Constraint2DSW::CONSTRAINT_TYPE_BODY_PAIR) {
+            continue; // area pairs don't solve anything
+        }
+
+        BodyPair2DSW* pair = static_cast<BodyPair2DSW*>(ci);
+        if (!pair->collided) {
+            continue;
+        }
+
+        uint32_t body_index[2] = {0, 0};
+        for (int i = 0; i < 2; i++) {
+            Body2DSW* body = pair->_arr[i];
+            // Static bodies can be shared with islands packed before, but
+            // they are never written to, so they are only packed once.
+            if (body->get_solver_pack_id() != pack_id) {
+                body->set_solver_pack_id(pack_id);
+                body->set_solver_index(bodies.add(body));
+            }
+            body_index[i] = body->get_solver_index();
+        }
+
+        for (int i = 0; i < pair->contact_count; i++) {
+            BodyPair2DSW::Contact* c = &pair->contacts[i];
+            if (!c->active) {
+                continue;
+            }
+            _add_contact(r_island, pair, c, body_index[0], body_index[1]);
+            packed_contact_count++;
+        }
+    }
+
+    r_island.body_end  = bodies.body.size();
+    r_island.batch_end = batches.size();
+
+    // Unused lanes are massless, but point to the bodies of the first lane,
+    // so reading them doesn't touch other islands' bodies.
+    for (uint32_t i = r_island.batch_begin; i < r_island.batch_end; i++) {
+        Batch& batch = batches[i];
+        for (uint32_t lane = batch.count; lane < LANES; lane++) {
+            batch.body_A[lane] = batch.body_A[0];
+            batch.body_B[lane] = batch.body_B[0];
+        }
+    }
+}
+
+void ContactSolver2DSW::pack(const LocalVector<Constraint2DSW*>& p_islands) {
+    pack_id++;
+    bodies.clear();
+    batches.clear();
+    islands.resize(p_islands.size());
+    packed_contact_count  = 0;
+    unpacked_island_count = 0;
+
+    for (uint32_t i = 0; i < p_islands.size(); i++) {
+        Island& island = islands[i];
+        island.packed  = _can_pack_island(p_islands[i]);
+        if (island.packed) {
+            _pack_island(p_islands[i], island);
+        } else {
+            unpacked_island_count++;
+        }
+    }
+}
+
+void ContactSolver2DSW::_solve_batch(Batch& r_batch) {
+    const SimdFloat zero = SimdFloat::splat(0.0f);
+    const uint32_t count = r_batch.count;
+
+    Vector2* linear_velocity_ptr        = bodies.linear_velocity.ptr();
+    real_t* angular_velocity_ptr        = bodies.angular_velocity.ptr();
+    Vector2* biased_linear_velocity_ptr = bodies.biased_linear_velocity.ptr();
+    real_t* biased_angular_velocity_ptr = bodies.biased_angular_velocity.ptr();
+
+    SimdVector2 lvA = SimdVector2::gather(linear_velocity_ptr, r_batch.body_A);
+    SimdVector2 lvB = SimdVector2::gather(linear_velocity_ptr, r_batch.body_B);
+    SimdFloat avA   = gather(angular_velocity_ptr, r_batch.body_A);
+    SimdFloat avB   = gather(angular_velocity_ptr, r_batch.body_B);
+    SimdVector2 blvA =
+        SimdVector2::gather(biased_linear_velocity_ptr, r_batch.body_A);
+    SimdVector2 blvB =
+        SimdVector2::gather(biased_linear_velocity_ptr, r_batch.body_B);
+    SimdFloat bavA = gather(biased_angular_velocity_ptr, r_batch.body_A);
+    SimdFloat bavB = gather(biased_angular_velocity_ptr, r_batch.body_B);
+
+    const SimdVector2 normal      = SimdVector2::load(r_batch.normal);
+    const SimdVector2 rA          = SimdVector2::load(r_batch.rA);
+    const SimdVector2 rB          = SimdVector2::load(r_batch.rB);
+    const SimdFloat inv_mass_A    = SimdFloat::load(r_batch.inv_mass_A);
+    const SimdFloat inv_mass_B    = SimdFloat::load(r_batch.inv_mass_B);
+    const SimdFloat inv_inertia_A = SimdFloat::load(r_batch.inv_inertia_A);
+    const SimdFloat inv_inertia_B = SimdFloat::load(r_batch.inv_inertia_B);
+    const SimdFloat mass_normal   = SimdFloat::load(r_batch.mass_normal);
+
+    // Relative velocity at contact
+
+    SimdVector2 crA  = {-avA * rA.y, avA * rA.x};
+    SimdVector2 crB  = {-avB * rB.y, avB * rB.x};
+    SimdVector2 dv   = lvB + crB - lvA - crA;
+    SimdVector2 crbA = {-bavA * rA.y, bavA * rA.x};
+    SimdVector2 crbB = {-bavB * rB.y, bavB * rB.x};
+    SimdVector2 dbv  = blvB + crbB - blvA - crbA;
+
+    SimdFloat vn        = dv.dot(normal);
+    SimdFloat vbn       = dbv.dot(normal);
+    SimdVector2 tangent = normal.tangent();
+    SimdFloat vt        = dv.dot(tangent);
+
+    SimdFloat jbn    = (SimdFloat::load(r_batch.bias) - vbn) * mass_normal;
+    SimdFloat jbnOld = SimdFloat::load(r_batch.acc_bias_impulse);
+    SimdFloat acc_bias_impulse = SimdFloat::max(jbnOld + jbn, zero);
+    acc_bias_impulse.store(r_batch.acc_bias_impulse);
+
+    SimdVector2 jb = normal * (acc_bias_impulse - jbnOld);
+
+    blvA = blvA + (-jb) * inv_mass_A;
+    bavA = bavA + inv_inertia_A * rA.cross(-jb);
+    blvB = blvB + jb * inv_mass_B;
+    bavB = bavB + inv_inertia_B * rB.cross(jb);
+
+    SimdFloat jn    = -(SimdFloat::load(r_batch.bounce) + vn) * mass_normal;
+    SimdFloat jnOld = SimdFloat::load(r_batch.acc_normal_impulse);
+    SimdFloat acc_normal_impulse = SimdFloat::max(jnOld + jn, zero);
+    acc_normal_impulse.store(r_batch.acc_normal_impulse);
+
+    SimdFloat jtMax = SimdFloat::load(r_batch.friction) * acc_normal_impulse;
+    SimdFloat jt    = -vt * SimdFloat::load(r_batch.mass_tangent);
+    SimdFloat jtOld = SimdFloat::load(r_batch.acc_tangent_impulse);
+    SimdFloat acc_tangent_impulse =
+        SimdFloat::min(SimdFloat::max(jtOld + jt, -jtMax), jtMax);
+    acc_tangent_impulse.store(r_batch.acc_tangent_impulse);
+
+    SimdVector2 j = normal * (acc_normal_impulse - jnOld)
+                  + tangent * (acc_tangent_impulse - jtOld);
+
+    lvA = lvA + (-j) * inv_mass_A;
+    avA = avA + inv_inertia_A * rA.cross(-j);
+    lvB = lvB + j * inv_mass_B;
+    avB = avB + inv_inertia_B * rB.cross(j);
+
+    // Lanes never share a dynamic body, so the stores don't overlap.
+    lvA.scatter(linear_velocity_ptr, r_batch.body_A, r_batch.write_A, count);
+    lvB.scatter(linear_velocity_ptr, r_batch.body_B, r_batch.write_B, count);
+    scatter(avA, angular_velocity_ptr, r_batch.body_A, r_batch.write_A, count);
+    scatter(avB, angular_velocity_ptr, r_batch.body_B, r_batch.write_B, count);
+    blvA.scatter(
+        biased_linear_velocity_ptr,
+        r_batch.body_A,
+        r_batch.write_A,
+        count
+    );
+    blvB.scatter(
+        biased_linear_velocity_ptr,
+        r_batch.body_B,
+        r_batch.write_B,
+        count
+    );
+    scatter(
+        bavA,
+        biased_angular_velocity_ptr,
+        r_batch.body_A,
+        r_batch.write_A,
+        count
+    );
+    scatter(
+        bavB,
+        biased_angular_velocity_ptr,
+        r_batch.body_B,
+        r_batch.write_B,
+        count
+    );
+}
+
+void ContactSolver2DSW::solve_island(uint32_t p_island, int p_iterations) {
+    const Island& island = islands[p_island];
+    for (int iteration = 0; iteration < p_iterations; iteration++) {
+        for (uint32_t i = island.batch_begin; i < island.batch_end; i++) {
+            _solve_batch(batches[i]);
+        }
+    }
+}
+
+void ContactSolver2DSW::unpack_island(uint32_t p_island) {
+    const Island& island = islands[p_island];
+
+    for (uint32_t i = island.body_begin; i < island.body_end; i++) {
+        if (!bodies.dynamic[i]) {
+            continue;
+        }
+        Body2DSW* body = bodies.body[i];
+        body->set_linear_velocity(bodies.linear_velocity[i]);
+        body->set_angular_velocity(bodies.angular_velocity[i]);
+        body->set_biased_linear_velocity(bodies.biased_linear_velocity[i]);
+        body->set_biased_angular_velocity(bodies.biased_angular_velocity[i]);
+    }
+
+    for (uint32_t i = island.batch_begin; i < island.batch_end; i++) {
+        const Batch& batch = batches[i];
+        for (uint32_t lane = 0; lane < batch.count; lane++) {
+            BodyPair2DSW::Contact& c = *batch.contact[lane];
+            c.acc_normal_impulse     = batch.acc_normal_impulse[lane];
+            c.acc_tangent_impulse    = batch.acc_tangent_impulse[lane];
+            c.acc_bias_impulse       = batch.acc_bias_impulse[lane];
+        }
+    }
+}
+
+ContactSolver2DSW::ContactSolver2DSW() {
+    pack_id               = 0;
+    packed_contact_count  = 0;
+    unpacked_island_count = 0;
+}
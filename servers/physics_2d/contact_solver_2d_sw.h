@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef CONTACT_SOLVER_2D_SW_H
+#define CONTACT_SOLVER_2D_SW_H
+
+#include "body_pair_2d_sw.h"
+#include "core/local_vector.h"
+#include "core/math/simd.h"
+
+// Solves the contacts of islands without joints in batches.
+//
+// Once per step, the active contacts of every island are grouped into
+// batches of contacts that don't share a dynamic body, and every batch is
+// solved at once in the lanes of SimdFloat. The contacts of every body are
+// solved in island order, but contacts of different bodies may be solved in
+// a different order than BodyPair2DSW::solve() would, so the results differ
+// slightly.
+class ContactSolver2DSW {
+    enum {
+        LANES = SimdFloat::WIDTH
+    };
+
+    struct Bodies {
+        LocalVector<Body2DSW*> body;
+        LocalVector<Vector2> linear_velocity;
+        LocalVector<real_t> angular_velocity;
+        LocalVector<Vector2> biased_linear_velocity;
+        LocalVector<real_t> biased_angular_velocity;
+        LocalVector<uint8_t> dynamic;
+        // The first batch of the island the body's next contact can go in.
+        LocalVector<uint32_t> next_batch;
+
+        void clear();
+        uint32_t add(Body2DSW* p_body);
+    };
+
+    // The contact data of a batch, with one lane per contact. Unused lanes
+    // have no mass.
+    struct Batch {
+        uint32_t count;
+        BodyPair2DSW::Contact* contact[LANES];
+        uint32_t body_A[LANES];
+        uint32_t body_B[LANES];
+        // Whether the lane's body is dynamic, so its velocity is written back.
+        bool write_A[LANES];
+        bool write_B[LANES];
+        float normal[2][LANES];
+        float rA[2][LANES];
+        float rB[2][LANES];
+        float inv_mass_A[LANES];
+        float inv_mass_B[LANES];
+        float inv_inertia_A[LANES];
+        float inv_inertia_B[LANES];
+        float mass_normal[LANES];
+        float mass_tangent[LANES];
+        float bias[LANES];
+        float bounce[LANES];
+        float friction[LANES];
+        float acc_normal_impulse[LANES];
+        float acc_tangent_impulse[LANES];
+        float acc_bias_impulse[LANES];
+    };
+
+    struct Island {
+        uint32_t body_begin;
+        uint32_t body_end;
+        uint32_t batch_begin;
+        uint32_t batch_end;
+        bool packed;
+    };
+
+    Bodies bodies;
+    LocalVector<Batch> batches;
+    LocalVector<Island> islands;
+    uint64_t pack_id;
+    int packed_contact_count;
+    int unpacked_island_count;
+
+    bool _can_pack_island(Constraint2DSW* p_island) const;
+    void _pack_island(Constraint2DSW* p_island, Island& r_island);
+    void _add_contact(
+        Island& r_island,
+        BodyPair2DSW* p_pair,
+        BodyPair2DSW::Contact* p_contact,
+        uint32_t p_body_A,
+        uint32_t p_body_B
+    );
+    void _solve_batch(Batch& r_batch);
+
+public:
+    // Packs every island of p_islands that can be solved in batches.
+    void pack(const LocalVector<Constraint2DSW*>& p_islands);
+
+    _FORCE_INLINE_ bool is_island_packed(uint32_t p_island) const {
+        return islands[p_island].packed;
+    }
+
+    // Solving and unpacking only access the island's own bodies and contacts,
+    // so different islands can be processed concurrently.
+    void solve_island(uint32_t p_island, int p_iterations);
+    void unpack_island(uint32_t p_island);
+
+    _FORCE_INLINE_ int get_packed_contact_count() const {
+        return packed_contact_count;
+    }
+
+    _FORCE_INLINE_ int get_unpacked_island_count() const {
+        return unpacked_island_count;
+    }
+
+    ContactSolver2DSW();
+};
+
+#endif // CONTACT_SOLVER_2D_SW_H
@@ -42,6 +42,10 @@ public:
 
     virtual Physics2DServer::JointType get_type() const = 0;
 
+    ConstraintType get_constraint_type() const {
+        return CONSTRAINT_TYPE_JOINT;
+    }
+
     Joint2DSW(Body2DSW** p_body_ptr = nullptr, int p_body_count = 0) :
         Constraint2DSW(p_body_ptr, p_body_count) {
         bias      = 0;
@@ -110,7 +110,7 @@ Physics2DServerWrapMT::Physics2DServerWrapMT(
     Physics2DServer* p_contained,
     bool p_create_thread
 ) :
-    command_queue(p_create_thread) {
+    command_queue(p_create_thread, true) {
     physics_2d_server = p_contained;
     create_thread     = p_create_thread;
     step_pending      = 0;
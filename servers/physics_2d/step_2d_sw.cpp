@@ -7,6 +7,7 @@
 #include "step_2d_sw.h"
 
 #include "core/os/os.h"
+#include "core/project_settings.h"
 
 void Step2DSW::_populate_island(
     Body2DSW* p_body,
@@ -48,14 +49,20 @@ void Step2DSW::_populate_island(
     }
 }
 
-bool Step2DSW::_setup_island(Constraint2DSW* p_island, real_t p_delta) {
+void Step2DSW::_setup_island(Constraint2DSW* p_island, real_t p_delta) {
+    Constraint2DSW* ci = p_island;
+    while (ci) {
+        ci->set_setup_result(ci->setup(p_delta));
+        ci = ci->get_island_next();
+    }
+}
+
+bool Step2DSW::_prune_island(Constraint2DSW* p_island) {
     Constraint2DSW* ci      = p_island;
     Constraint2DSW* prev_ci = nullptr;
     bool removed_root       = false;
     while (ci) {
-        bool process = ci->setup(p_delta);
-
-        if (!process) {
+        if (!ci->get_setup_result()) {
             // remove from island if process fails
             if (prev_ci) {
                 prev_ci->set_island_next(ci->get_island_next());
@@ -86,6 +93,61 @@ void Step2DSW::_solve_island(
     }
 }
 
+void Step2DSW::_integrate_forces_thread(uint32_t p_index, void* p_userdata) {
+    active_bodies[p_index]->integrate_forces_local(solve_delta);
+}
+
+void Step2DSW::_setup_island_thread(uint32_t p_index, void* p_userdata) {
+    Constraint2DSW* island = constraint_islands[p_index];
+
+    serial_islands[p_index] = false;
+    if (match_serial_results) {
+        for (Constraint2DSW* ci = island; ci; ci = ci->get_island_next()) {
+            if (ci->get_setup_mode() == Constraint2DSW::SETUP_MODE_SERIAL) {
+                serial_islands[p_index] = true;
+                return;
+            }
+        }
+    }
+
+    for (Constraint2DSW* ci = island; ci; ci = ci->get_island_next()) {
+        if (ci->get_setup_mode() == Constraint2DSW::SETUP_MODE_THREAD_SAFE) {
+            ci->set_setup_result(ci->setup(solve_delta));
+        }
+    }
+}
+
+void Step2DSW::_setup_island_deferred(uint32_t p_index) {
+    Constraint2DSW* island = constraint_islands[p_index];
+
+    if (serial_islands[p_index]) {
+        _setup_island(island, solve_delta);
+        return;
+    }
+
+    for (Constraint2DSW* ci = island; ci; ci = ci->get_island_next()) {
+        if (ci->get_setup_mode() != Constraint2DSW::SETUP_MODE_THREAD_SAFE) {
+            ci->set_setup_result(ci->setup(solve_delta));
+        }
+    }
+}
+
+void Step2DSW::_solve_island_thread(uint32_t p_index, void* p_userdata) {
+    if (batched_contact_solver && contact_solver.is_island_packed(p_index)) {
+        contact_solver.solve_island(p_index, solve_iterations);
+        contact_solver.unpack_island(p_index);
+        return;
+    }
+    _solve_island(constraint_islands[p_index], solve_iterations, solve_delta);
+}
+
+void Step2DSW::_integrate_velocities_thread(
+    uint32_t p_index,
+    void* p_userdata
+) {
+    active_bodies[p_index]->integrate_velocities_local(solve_delta);
+}
+
 void Step2DSW::_check_suspend(Body2DSW* p_island, real_t p_delta) {
     bool can_sleep = true;
 
@@ -137,16 +199,29 @@ void Step2DSW::step(Space2DSW* p_space, real_t p_delta, int p_iterations) {
     uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
     uint64_t profile_endtime = 0;
 
-    int active_count = 0;
+    solve_iterations = p_iterations;
+    solve_delta      = p_delta;
 
+    active_bodies.clear();
     const SelfList<Body2DSW>* b = body_list->first();
     while (b) {
-        b->self()->integrate_forces(p_delta);
+        active_bodies.push_back(b->self());
         b = b->next();
-        active_count++;
     }
 
-    p_space->set_active_objects(active_count);
+    // Bodies are integrated concurrently, then the space is updated in the
+    // active list order.
+    work_pool.do_work(
+        active_bodies.size(),
+        this,
+        &Step2DSW::_integrate_forces_thread,
+        nullptr
+    );
+    for (uint32_t i = 0; i < active_bodies.size(); i++) {
+        active_bodies[i]->integrate_forces_commit();
+    }
+
+    p_space->set_active_objects(active_bodies.size());
 
     // Update the broadphase to register collision pairs.
     p_space->update();
@@ -221,11 +296,39 @@ void Step2DSW::step(Space2DSW* p_space, real_t p_delta, int p_iterations) {
 
     /* SETUP CONSTRAINT ISLANDS */
 
+    {
+        constraint_islands.clear();
+        Constraint2DSW* ci = constraint_island_list;
+        while (ci) {
+            constraint_islands.push_back(ci);
+            ci = ci->get_island_list_next();
+        }
+
+        if (work_pool.get_thread_count() > 1) {
+            // Islands are set up concurrently, constraints that change shared
+            // state are set up afterwards on this thread in island order.
+            serial_islands.resize(constraint_islands.size());
+            work_pool.do_work(
+                constraint_islands.size(),
+                this,
+                &Step2DSW::_setup_island_thread,
+                nullptr
+            );
+            for (uint32_t i = 0; i < constraint_islands.size(); i++) {
+                _setup_island_deferred(i);
+            }
+        } else {
+            for (uint32_t i = 0; i < constraint_islands.size(); i++) {
+                _setup_island(constraint_islands[i], p_delta);
+            }
+        }
+    }
+
     {
         Constraint2DSW* ci      = constraint_island_list;
         Constraint2DSW* prev_ci = nullptr;
         while (ci) {
-            if (_setup_island(ci, p_delta)) {
+            if (_prune_island(ci)) {
                 // removed the root from the island graph because it is not to
                 // be processed
 
@@ -271,12 +374,26 @@ void Step2DSW::step(Space2DSW* p_space, real_t p_delta, int p_iterations) {
     /* SOLVE CONSTRAINT ISLANDS */
 
     {
+        // Every island is solved on a single thread in the same order as the
+        // serial path, so the results don't depend on the thread count.
+        constraint_islands.clear();
         Constraint2DSW* ci = constraint_island_list;
         while (ci) {
-            // iterating each island separatedly improves cache efficiency
-            _solve_island(ci, p_iterations, p_delta);
+            constraint_islands.push_back(ci);
             ci = ci->get_island_list_next();
         }
+
+        if (batched_contact_solver) {
+            contact_solver.pack(constraint_islands);
+        }
+
+        // iterating each island separatedly improves cache efficiency
+        work_pool.do_work(
+            constraint_islands.size(),
+            this,
+            &Step2DSW::_solve_island_thread,
+            nullptr
+        );
     }
 
     { // profile
@@ -290,11 +407,23 @@ void Step2DSW::step(Space2DSW* p_space, real_t p_delta, int p_iterations) {
 
     /* INTEGRATE VELOCITIES */
 
+    // Bodies may have been woken up since the forces were integrated.
+    active_bodies.clear();
     b = body_list->first();
     while (b) {
-        const SelfList<Body2DSW>* n = b->next();
-        b->self()->integrate_velocities(p_delta);
-        b = n; // in case it shuts itself down
+        active_bodies.push_back(b->self());
+        b = b->next();
+    }
+
+    work_pool.do_work(
+        active_bodies.size(),
+        this,
+        &Step2DSW::_integrate_velocities_thread,
+        nullptr
+    );
+    for (uint32_t i = 0; i < active_bodies.size(); i++) {
+        // may remove the body from the active list
+        active_bodies[i]->integrate_velocities_commit();
     }
 
     /* SLEEP / WAKE UP ISLANDS */
@@ -321,5 +450,25 @@ void Step2DSW::step(Space2DSW* p_space, real_t p_delta, int p_iterations) {
 }
 
 Step2DSW::Step2DSW() {
-    _step = 1;
+    _step            = 1;
+    solve_iterations = 0;
+    solve_delta      = 0;
+
+    int thread_count = ThreadWorkPool::define_thread_count_setting(
+        "physics/2d/solver_thread_count"
+    );
+    match_serial_results =
+        GLOBAL_DEF("physics/2d/solver_match_serial_results", true);
+    work_pool.init(thread_count);
+
+    batched_contact_solver =
+        GLOBAL_DEF("physics/2d/batched_contact_solver", false);
+#ifdef REAL_T_IS_DOUBLE
+    // The batched solver only works with single precision floats.
+    batched_contact_solver = false;
+#endif
+}
+
+Step2DSW::~Step2DSW() {
+    work_pool.finish();
 }
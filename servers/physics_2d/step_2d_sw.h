@@ -7,17 +7,35 @@
 #ifndef STEP_2D_SW_H
 #define STEP_2D_SW_H
 
+#include "contact_solver_2d_sw.h"
+#include "core/local_vector.h"
+#include "core/os/thread_work_pool.h"
 #include "space_2d_sw.h"
 
 class Step2DSW {
     uint64_t _step;
 
+    ThreadWorkPool work_pool;
+    // When set, islands with serial constraints are set up entirely on the
+    // physics thread, so the threaded results match the serial ones.
+    bool match_serial_results;
+
+    LocalVector<Body2DSW*> active_bodies;
+    LocalVector<Constraint2DSW*> constraint_islands;
+    LocalVector<bool> serial_islands;
+    int solve_iterations;
+    real_t solve_delta;
+
+    ContactSolver2DSW contact_solver;
+    bool batched_contact_solver;
+
     void _populate_island(
         Body2DSW* p_body,
         Body2DSW** p_island,
         Constraint2DSW** p_constraint_island
     );
-    bool _setup_island(Constraint2DSW* p_island, real_t p_delta);
+    void _setup_island(Constraint2DSW* p_island, real_t p_delta);
+    bool _prune_island(Constraint2DSW* p_island);
     void _solve_island(
         Constraint2DSW* p_island,
         int p_iterations,
@@ -25,9 +43,16 @@ class Step2DSW {
     );
     void _check_suspend(Body2DSW* p_island, real_t p_delta);
 
+    void _integrate_forces_thread(uint32_t p_index, void* p_userdata);
+    void _setup_island_thread(uint32_t p_index, void* p_userdata);
+    void _setup_island_deferred(uint32_t p_index);
+    void _solve_island_thread(uint32_t p_index, void* p_userdata);
+    void _integrate_velocities_thread(uint32_t p_index, void* p_userdata);
+
 public:
     void step(Space2DSW* p_space, real_t p_delta, int p_iterations);
     Step2DSW();
+    ~Step2DSW();
 };
 
 #endif // STEP_2D_SW_H
@@ -1628,6 +1628,9 @@ void PhysicsServer::_bind_methods() {
     BIND_ENUM_CONSTANT(INFO_ACTIVE_OBJECTS);
     BIND_ENUM_CONSTANT(INFO_COLLISION_PAIRS);
     BIND_ENUM_CONSTANT(INFO_ISLAND_COUNT);
+    BIND_ENUM_CONSTANT(INFO_PACKED_CONTACT_COUNT);
+    BIND_ENUM_CONSTANT(INFO_UNPACKED_ISLAND_COUNT);
+    BIND_ENUM_CONSTANT(INFO_SOLVE_TIME);
 
     BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_RECYCLE_RADIUS);
     BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_MAX_SEPARATION);
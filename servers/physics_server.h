@@ -1077,7 +1077,10 @@ public:
     enum ProcessInfo {
         INFO_ACTIVE_OBJECTS,
         INFO_COLLISION_PAIRS,
-        INFO_ISLAND_COUNT
+        INFO_ISLAND_COUNT,
+        INFO_PACKED_CONTACT_COUNT,
+        INFO_UNPACKED_ISLAND_COUNT,
+        INFO_SOLVE_TIME
     };
 
     virtual int get_process_info(ProcessInfo p_info) = 0;
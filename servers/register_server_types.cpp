@@ -15,6 +15,7 @@
 #include "audio/effects/audio_effect_capture.h"
 #include "audio/effects/audio_effect_chorus.h"
 #include "audio/effects/audio_effect_compressor.h"
+#include "audio/effects/audio_effect_convolution_reverb.h"
 #include "audio/effects/audio_effect_delay.h"
 #include "audio/effects/audio_effect_distortion.h"
 #include "audio/effects/audio_effect_eq.h"
@@ -122,6 +123,7 @@ void register_server_types() {
         ClassDB::register_class<AudioEffectAmplify>();
 
         ClassDB::register_class<AudioEffectReverb>();
+        ClassDB::register_class<AudioEffectConvolutionReverb>();
 
         ClassDB::register_class<AudioEffectLowPassFilter>();
         ClassDB::register_class<AudioEffectHighPassFilter>();
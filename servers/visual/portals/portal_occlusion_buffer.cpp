@@ -0,0 +1,503 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "portal_occlusion_buffer.h"
+
+#include "core/hash_map.h"
+#include "core/map.h"
+#include "core/math/simd.h"
+
+namespace {
+enum {
+    LANES = SimdFloat::WIDTH,
+};
+
+// The offsets of the pixel centers of the lanes from the first lane's pixel.
+const float lane_centers[8] = {0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f};
+
+// Bits of the clip planes a vertex is outside of.
+uint32_t _get_outcode(real_t p_x, real_t p_y, real_t p_w) {
+    return ((p_x < -p_w) ? 1 : 0) | ((p_x > p_w) ? 2 : 0)
+         | ((p_y < -p_w) ? 4 : 0) | ((p_y > p_w) ? 8 : 0);
+}
+} // namespace
+
+PortalOcclusionBuffer::ClipVertex PortalOcclusionBuffer::_to_clip(
+    const Vector3& p_point
+) const {
+    const real_t(&m)[4][4] = view_projection.matrix;
+
+    ClipVertex v;
+    v.x = m[0][0] * p_point.x + m[1][0] * p_point.y + m[2][0] * p_point.z
+        + m[3][0];
+    v.y = m[0][1] * p_point.x + m[1][1] * p_point.y + m[2][1] * p_point.z
+        + m[3][1];
+    v.z = m[0][2] * p_point.x + m[1][2] * p_point.y + m[2][2] * p_point.z
+        + m[3][2];
+    v.w = m[0][3] * p_point.x + m[1][3] * p_point.y + m[2][3] * p_point.z
+        + m[3][3];
+    return v;
+}
+
+Vector3 PortalOcclusionBuffer::_to_screen(const ClipVertex& p_vertex) const {
+    real_t inv_w = 1.0 / p_vertex.w;
+    return Vector3(
+        (0.5 + 0.5 * p_vertex.x * inv_w) * WIDTH,
+        (0.5 - 0.5 * p_vertex.y * inv_w) * HEIGHT,
+        p_vertex.z * inv_w
+    );
+}
+
+void PortalOcclusionBuffer::begin(
+    const Transform& p_cam_transform,
+    const CameraMatrix& p_cam_projection
+) {
+    view_projection =
+        p_cam_projection * CameraMatrix(p_cam_transform.affine_inverse());
+    triangles_drawn = 0;
+
+    float* pixels = depth.ptr();
+    for (uint32_t i = 0; i < depth.size(); i++) {
+        pixels[i] = FLT_MAX;
+    }
+}
+
+// The sign of the determinant of the homogeneous clip coordinates is the
+// sign of the triangle's area on screen, even when it crosses the near plane.
+int8_t PortalOcclusionBuffer::_get_facing(
+    const ClipVertex& p_a,
+    const ClipVertex& p_b,
+    const ClipVertex& p_c
+) const {
+    real_t determinant = p_a.x * (p_b.y * p_c.w - p_c.y * p_b.w)
+                       - p_a.y * (p_b.x * p_c.w - p_c.x * p_b.w)
+                       + p_a.w * (p_b.x * p_c.y - p_c.x * p_b.y);
+    return (determinant > 0) - (determinant < 0);
+}
+
+void PortalOcclusionBuffer::draw_triangles(
+    const Vector3* p_vertices,
+    uint32_t p_vertex_count,
+    const uint32_t* p_indices,
+    const int32_t* p_edge_neighbours,
+    uint32_t p_index_count
+) {
+    clip_vertices.resize(p_vertex_count);
+    for (uint32_t i = 0; i < p_vertex_count; i++) {
+        clip_vertices[i] = _to_clip(p_vertices[i]);
+    }
+
+    facings.resize(p_index_count / 3);
+    for (uint32_t i = 0; i + 2 < p_index_count; i += 3) {
+        facings[i / 3] = _get_facing(
+            clip_vertices[p_indices[i]],
+            clip_vertices[p_indices[i + 1]],
+            clip_vertices[p_indices[i + 2]]
+        );
+    }
+
+    // The triangles that face each way are drawn and merged separately, as
+    // the edges between them are on the mesh's outline.
+    for (int8_t facing = 1; facing >= -1; facing -= 2) {
+        for (uint32_t i = 0; i + 2 < p_index_count; i += 3) {
+            if (facings[i / 3] != facing) {
+                continue;
+            }
+
+            const ClipVertex& a = clip_vertices[p_indices[i]];
+            const ClipVertex& b = clip_vertices[p_indices[i + 1]];
+            const ClipVertex& c = clip_vertices[p_indices[i + 2]];
+
+            // Triangles entirely behind the near plane, or entirely outside
+            // one of the side planes, can't cover any pixels.
+            if ((a.z + a.w < 0) && (b.z + b.w < 0) && (c.z + c.w < 0)) {
+                continue;
+            }
+            if (_get_outcode(a.x, a.y, a.w) & _get_outcode(b.x, b.y, b.w)
+                & _get_outcode(c.x, c.y, c.w)) {
+                continue;
+            }
+
+            uint32_t shared_edges = 0;
+            for (int e = 0; e < 3; e++) {
+                int32_t neighbour = p_edge_neighbours[i + e];
+                if (neighbour >= 0 && facings[neighbour] == facing) {
+                    shared_edges |= 1 << e;
+                }
+            }
+
+            _draw_triangle(a, b, c, shared_edges);
+        }
+        _merge_mesh();
+    }
+}
+
+void PortalOcclusionBuffer::_draw_triangle(
+    const ClipVertex& p_a,
+    const ClipVertex& p_b,
+    const ClipVertex& p_c,
+    uint32_t p_shared_edges
+) {
+    const ClipVertex* input[3] = {&p_a, &p_b, &p_c};
+
+    // Clipping a triangle against the near plane adds at most one vertex.
+    // Every polygon edge keeps whether it's part of a shared edge; the edge
+    // along the near plane never is.
+    ClipVertex polygon[4];
+    bool shared[4];
+    int count = 0;
+    for (int i = 0; i < 3; i++) {
+        const ClipVertex& from = *input[i];
+        const ClipVertex& to   = *input[(i + 1) % 3];
+        real_t from_distance   = from.z + from.w;
+        real_t to_distance     = to.z + to.w;
+        bool edge_shared       = p_shared_edges & (1 << i);
+
+        if (from_distance >= 0) {
+            shared[count]    = edge_shared;
+            polygon[count++] = from;
+        }
+        if ((from_distance >= 0) != (to_distance >= 0)) {
+            real_t t      = from_distance / (from_distance - to_distance);
+            shared[count] = (from_distance < 0) && edge_shared;
+            ClipVertex& v = polygon[count++];
+            v.x           = from.x + (to.x - from.x) * t;
+            v.y           = from.y + (to.y - from.y) * t;
+            v.z           = from.z + (to.z - from.z) * t;
+            v.w           = from.w + (to.w - from.w) * t;
+        }
+    }
+
+    if (count < 3) {
+        return;
+    }
+
+    Vector3 screen[4];
+    for (int i = 0; i < count; i++) {
+        screen[i] = _to_screen(polygon[i]);
+    }
+
+    // The polygon is drawn as a fan, whose diagonals are shared edges.
+    for (int i = 2; i < count; i++) {
+        uint32_t fan_shared = ((i == 2) ? shared[0] : 1)
+                            | (shared[i - 1] << 1)
+                            | (((i == count - 1) ? shared[count - 1] : 1) << 2);
+        _rasterize(screen[0], screen[i - 1], screen[i], fan_shared);
+    }
+    triangles_drawn++;
+}
+
+void PortalOcclusionBuffer::_rasterize(
+    const Vector3& p_a,
+    const Vector3& p_b,
+    const Vector3& p_c,
+    uint32_t p_shared_edges
+) {
+    Vector3 v[3]   = {p_a, p_b, p_c};
+    bool shared[3] = {
+        (p_shared_edges & 1) != 0,
+        (p_shared_edges & 2) != 0,
+        (p_shared_edges & 4) != 0,
+    };
+
+    real_t area =
+        (v[1].x - v[0].x) * (v[2].y - v[0].y)
+        - (v[1].y - v[0].y) * (v[2].x - v[0].x);
+    if (Math::abs(area) < CMP_EPSILON) {
+        return;
+    }
+    // Occluders are drawn from both sides.
+    if (area < 0) {
+        SWAP(v[1], v[2]);
+        SWAP(shared[0], shared[2]);
+        area = -area;
+    }
+
+    // The pixels the triangle's bounds overlap, clamped to the buffer.
+    real_t left   = MIN(v[0].x, MIN(v[1].x, v[2].x));
+    real_t right  = MAX(v[0].x, MAX(v[1].x, v[2].x));
+    real_t top    = MIN(v[0].y, MIN(v[1].y, v[2].y));
+    real_t bottom = MAX(v[0].y, MAX(v[1].y, v[2].y));
+
+    int min_x = (int)CLAMP(Math::floor(left), (real_t)0, (real_t)WIDTH);
+    int max_x = (int)CLAMP(Math::ceil(right), (real_t)0, (real_t)WIDTH);
+    int min_y = (int)CLAMP(Math::floor(top), (real_t)0, (real_t)HEIGHT);
+    int max_y = (int)CLAMP(Math::ceil(bottom), (real_t)0, (real_t)HEIGHT);
+    if (min_x >= max_x || min_y >= max_y) {
+        return;
+    }
+
+    // The edge functions are positive inside the triangle. Offsetting them by
+    // half a pixel along their normals makes them positive at the centers of
+    // the pixels the triangle touches, and above their limit at the centers
+    // of the pixels that are entirely on the inner side of the edge. Only
+    // the edges on the mesh's outline have a limit.
+    real_t edge_x[3];
+    real_t edge_y[3];
+    real_t edge_offset[3];
+    real_t edge_limit[3];
+    for (int i = 0; i < 3; i++) {
+        const Vector3& from = v[i];
+        const Vector3& to   = v[(i + 1) % 3];
+
+        edge_x[i]        = from.y - to.y;
+        edge_y[i]        = to.x - from.x;
+        real_t half_size = 0.5 * (Math::abs(edge_x[i]) + Math::abs(edge_y[i]));
+        edge_offset[i] = -(edge_x[i] * from.x + edge_y[i] * from.y) + half_size;
+        edge_limit[i]  = shared[i] ? 0 : 2 * half_size;
+    }
+
+    // The depth plane, offset to the farthest depth within a pixel.
+    real_t depth_x =
+        ((v[1].z - v[0].z) * (v[2].y - v[0].y)
+         - (v[2].z - v[0].z) * (v[1].y - v[0].y))
+        / area;
+    real_t depth_y =
+        ((v[2].z - v[0].z) * (v[1].x - v[0].x)
+         - (v[1].z - v[0].z) * (v[2].x - v[0].x))
+        / area;
+    real_t depth_offset = v[0].z - depth_x * v[0].x - depth_y * v[0].y
+                        + 0.5 * (Math::abs(depth_x) + Math::abs(depth_y));
+
+    mesh_min_x = MIN(mesh_min_x, min_x);
+    mesh_max_x = MAX(mesh_max_x, max_x);
+    mesh_min_y = MIN(mesh_min_y, min_y);
+    mesh_max_y = MAX(mesh_max_y, max_y);
+
+    const SimdFloat zero         = SimdFloat::splat(0.0f);
+    const SimdFloat discarded    = SimdFloat::splat(FLT_MAX);
+    const SimdFloat lane_offsets = SimdFloat::load(lane_centers);
+    const SimdFloat edge_x0      = SimdFloat::splat(edge_x[0]);
+    const SimdFloat edge_x1      = SimdFloat::splat(edge_x[1]);
+    const SimdFloat edge_x2      = SimdFloat::splat(edge_x[2]);
+    const SimdFloat edge_limit0  = SimdFloat::splat(edge_limit[0]);
+    const SimdFloat edge_limit1  = SimdFloat::splat(edge_limit[1]);
+    const SimdFloat edge_limit2  = SimdFloat::splat(edge_limit[2]);
+    const SimdFloat depth_dx     = SimdFloat::splat(depth_x);
+
+    // Rows are processed in groups of lanes aligned to the start of the row,
+    // so the lanes never go past the end of the row.
+    int first_x = min_x - (min_x % LANES);
+
+    for (int y = min_y; y < max_y; y++) {
+        real_t center_y = y + 0.5;
+        SimdFloat row_edge0 =
+            SimdFloat::splat(edge_y[0] * center_y + edge_offset[0]);
+        SimdFloat row_edge1 =
+            SimdFloat::splat(edge_y[1] * center_y + edge_offset[1]);
+        SimdFloat row_edge2 =
+            SimdFloat::splat(edge_y[2] * center_y + edge_offset[2]);
+        SimdFloat row_depth =
+            SimdFloat::splat(depth_y * center_y + depth_offset);
+        float* row = &mesh_depth[y * WIDTH];
+
+        for (int x = first_x; x < max_x; x += LANES) {
+            SimdFloat center_x = SimdFloat::splat(x) + lane_offsets;
+            SimdFloat edge0    = edge_x0 * center_x + row_edge0;
+            SimdFloat edge1    = edge_x1 * center_x + row_edge1;
+            SimdFloat edge2    = edge_x2 * center_x + row_edge2;
+
+            SimdMask touched =
+                (edge0 > zero) & (edge1 > zero) & (edge2 > zero);
+            if (!touched.any()) {
+                continue;
+            }
+            SimdMask inside = (edge0 > edge_limit0) & (edge1 > edge_limit1)
+                            & (edge2 > edge_limit2);
+
+            SimdFloat farthest = SimdFloat::select(
+                inside,
+                depth_dx * center_x + row_depth,
+                discarded
+            );
+            SimdFloat current = SimdFloat::load(row + x);
+            SimdFloat::select(
+                touched,
+                SimdFloat::max(current, farthest),
+                current
+            )
+                .store(row + x);
+        }
+    }
+}
+
+void PortalOcclusionBuffer::_merge_mesh() {
+    const SimdFloat undrawn = SimdFloat::splat(-FLT_MAX);
+    int first_x             = mesh_min_x - (mesh_min_x % LANES);
+
+    for (int y = mesh_min_y; y < mesh_max_y; y++) {
+        float* row      = &depth[y * WIDTH];
+        float* mesh_row = &mesh_depth[y * WIDTH];
+
+        for (int x = first_x; x < mesh_max_x; x += LANES) {
+            SimdFloat farthest = SimdFloat::load(mesh_row + x);
+            SimdFloat current  = SimdFloat::load(row + x);
+            SimdFloat::select(
+                farthest > undrawn,
+                SimdFloat::min(current, farthest),
+                current
+            )
+                .store(row + x);
+            undrawn.store(mesh_row + x);
+        }
+    }
+
+    mesh_min_x = WIDTH;
+    mesh_max_x = 0;
+    mesh_min_y = HEIGHT;
+    mesh_max_y = 0;
+}
+
+void PortalOcclusionBuffer::find_edge_neighbours(
+    const Vector3* p_vertices,
+    const uint32_t* p_indices,
+    uint32_t p_index_count,
+    LocalVector<int32_t, int32_t>& r_edge_neighbours
+) {
+    Map<Vector3, uint32_t> welded_ids;
+    LocalVector<uint32_t> welded;
+    welded.resize(p_index_count);
+    for (uint32_t n = 0; n < p_index_count; n++) {
+        const Vector3& vertex              = p_vertices[p_indices[n]];
+        Map<Vector3, uint32_t>::Element* E = welded_ids.find(vertex);
+        if (!E) {
+            E = welded_ids.insert(vertex, welded_ids.size());
+        }
+        welded[n] = E->get();
+    }
+
+    LocalVector<uint64_t> edges;
+    edges.resize(p_index_count);
+    HashMap<uint64_t, uint32_t> edge_counts;
+    // The first index of each edge.
+    HashMap<uint64_t, uint32_t> edge_firsts;
+    for (uint32_t n = 0; n < p_index_count; n++) {
+        uint32_t next = (n % 3 == 2) ? n - 2 : n + 1;
+        uint32_t a    = welded[n];
+        uint32_t b    = welded[next];
+        edges[n]      = ((uint64_t)MIN(a, b) << 32) | MAX(a, b);
+
+        uint32_t* count = edge_counts.getptr(edges[n]);
+        if (count) {
+            (*count)++;
+        } else {
+            edge_counts.set(edges[n], 1);
+            edge_firsts.set(edges[n], n);
+        }
+    }
+
+    r_edge_neighbours.resize(p_index_count);
+    for (uint32_t n = 0; n < p_index_count; n++) {
+        r_edge_neighbours[n] = -1;
+    }
+    for (uint32_t n = 0; n < p_index_count; n++) {
+        uint32_t first = *edge_firsts.getptr(edges[n]);
+        if (first != n && *edge_counts.getptr(edges[n]) == 2) {
+            r_edge_neighbours[n]     = first / 3;
+            r_edge_neighbours[first] = n / 3;
+        }
+    }
+}
+
+void PortalOcclusionBuffer::end() {
+    for (int tile_y = 0; tile_y < TILES_Y; tile_y++) {
+        for (int tile_x = 0; tile_x < TILES_X; tile_x++) {
+            const float* tile =
+                &depth[tile_y * TILE_SIZE * WIDTH + tile_x * TILE_SIZE];
+
+            SimdFloat farthest = SimdFloat::splat(-FLT_MAX);
+            for (int y = 0; y < TILE_SIZE; y++) {
+                for (int x = 0; x < TILE_SIZE; x += LANES) {
+                    farthest = SimdFloat::max(
+                        farthest,
+                        SimdFloat::load(tile + y * WIDTH + x)
+                    );
+                }
+            }
+
+            float lanes[LANES];
+            farthest.store(lanes);
+            float tile_farthest = lanes[0];
+            for (int i = 1; i < LANES; i++) {
+                tile_farthest = MAX(tile_farthest, lanes[i]);
+            }
+            tile_depth[tile_y * TILES_X + tile_x] = tile_farthest;
+        }
+    }
+}
+
+bool PortalOcclusionBuffer::is_aabb_occluded(const AABB& p_aabb) const {
+    if (!triangles_drawn) {
+        return false;
+    }
+
+    real_t left    = FLT_MAX;
+    real_t right   = -FLT_MAX;
+    real_t top     = FLT_MAX;
+    real_t bottom  = -FLT_MAX;
+    real_t nearest = FLT_MAX;
+
+    for (int i = 0; i < 8; i++) {
+        ClipVertex v = _to_clip(p_aabb.get_endpoint(i));
+
+        // Instances that cross the near plane are never occluded.
+        if ((v.z + v.w <= 0) || (v.w <= CMP_EPSILON)) {
+            return false;
+        }
+
+        Vector3 screen = _to_screen(v);
+        left           = MIN(left, screen.x);
+        right          = MAX(right, screen.x);
+        top            = MIN(top, screen.y);
+        bottom         = MAX(bottom, screen.y);
+        nearest        = MIN(nearest, screen.z);
+    }
+
+    // Parts of the instance outside the screen can't be seen.
+    int min_x = (int)CLAMP(Math::floor(left), (real_t)0, (real_t)WIDTH);
+    int max_x = (int)CLAMP(Math::ceil(right), (real_t)0, (real_t)WIDTH);
+    int min_y = (int)CLAMP(Math::floor(top), (real_t)0, (real_t)HEIGHT);
+    int max_y = (int)CLAMP(Math::ceil(bottom), (real_t)0, (real_t)HEIGHT);
+    if (min_x >= max_x || min_y >= max_y) {
+        return false;
+    }
+
+    float instance_depth = nearest;
+
+    for (int tile_y = min_y / TILE_SIZE; tile_y <= (max_y - 1) / TILE_SIZE;
+         tile_y++) {
+        for (int tile_x = min_x / TILE_SIZE; tile_x <= (max_x - 1) / TILE_SIZE;
+             tile_x++) {
+            if (instance_depth > tile_depth[tile_y * TILES_X + tile_x]) {
+                continue;
+            }
+
+            // The tile isn't entirely in front of the instance, so check the
+            // pixels the instance covers.
+            int begin_x = MAX(min_x, tile_x * TILE_SIZE);
+            int end_x   = MIN(max_x, (tile_x + 1) * TILE_SIZE);
+            int begin_y = MAX(min_y, tile_y * TILE_SIZE);
+            int end_y   = MIN(max_y, (tile_y + 1) * TILE_SIZE);
+            for (int y = begin_y; y < end_y; y++) {
+                const float* row = &depth[y * WIDTH];
+                for (int x = begin_x; x < end_x; x++) {
+                    if (!(instance_depth > row[x])) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+PortalOcclusionBuffer::PortalOcclusionBuffer() {
+    depth.resize(WIDTH * HEIGHT);
+    tile_depth.resize(TILES_X * TILES_Y);
+    mesh_depth.resize(WIDTH * HEIGHT);
+    for (uint32_t i = 0; i < mesh_depth.size(); i++) {
+        mesh_depth[i] = -FLT_MAX;
+    }
+}
@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef PORTAL_OCCLUSION_BUFFER_H
+#define PORTAL_OCCLUSION_BUFFER_H
+
+#include "core/local_vector.h"
+#include "core/math/aabb.h"
+#include "core/math/camera_matrix.h"
+#include "core/math/transform.h"
+
+// A small software depth buffer that occluder meshes are rasterized into, so
+// that instances can be tested against arbitrary occluder shapes.
+//
+// Every pixel stores the farthest depth of the occluders that cover the whole
+// pixel. The triangles of a mesh that face the same way are first drawn into
+// a separate buffer, in which every pixel a triangle touches keeps the
+// farthest depth the triangles touching it have within the pixel. Pixels
+// crossed by an edge on the mesh's outline, either an edge without a
+// neighbour or one between a triangle that faces the camera and one that
+// doesn't, are discarded. The remaining pixels are then merged into the
+// buffer, so meshes neither crack along their inner edges nor occlude more
+// than they cover along creases. Every tile of pixels also stores its
+// farthest depth, so most instances are accepted or rejected without reading
+// individual pixels.
+//
+// Depths are normalized device depths, which vary linearly across the screen
+// for both perspective and orthogonal projections.
+class PortalOcclusionBuffer {
+public:
+    enum {
+        WIDTH     = 256,
+        HEIGHT    = 128,
+        TILE_SIZE = 8,
+        TILES_X   = WIDTH / TILE_SIZE,
+        TILES_Y   = HEIGHT / TILE_SIZE,
+    };
+
+    // Clears the buffer and sets the camera the occluders are drawn from.
+    void begin(
+        const Transform& p_cam_transform,
+        const CameraMatrix& p_cam_projection
+    );
+    // Draws a list of triangles, given as world space vertices and three
+    // indices per triangle. For each index, p_edge_neighbours holds the
+    // triangle that shares the edge from that vertex to the next, or -1.
+    void draw_triangles(
+        const Vector3* p_vertices,
+        uint32_t p_vertex_count,
+        const uint32_t* p_indices,
+        const int32_t* p_edge_neighbours,
+        uint32_t p_index_count
+    );
+    // Updates the tiles once all the occluders are drawn.
+    void end();
+
+    // Finds the edge neighbours of a mesh's triangles for draw_triangles().
+    // Vertices at the same position are welded first, as meshes often
+    // duplicate them. Edges of more than two triangles have no neighbour.
+    static void find_edge_neighbours(
+        const Vector3* p_vertices,
+        const uint32_t* p_indices,
+        uint32_t p_index_count,
+        LocalVector<int32_t, int32_t>& r_edge_neighbours
+    );
+
+    bool is_aabb_occluded(const AABB& p_aabb) const;
+
+    _FORCE_INLINE_ bool is_empty() const {
+        return triangles_drawn == 0;
+    }
+
+    _FORCE_INLINE_ uint32_t get_triangles_drawn() const {
+        return triangles_drawn;
+    }
+
+    PortalOcclusionBuffer();
+
+private:
+    struct ClipVertex {
+        real_t x;
+        real_t y;
+        real_t z;
+        real_t w;
+    };
+
+    CameraMatrix view_projection;
+    LocalVector<float> depth;
+    LocalVector<float> tile_depth;
+    // The depths of the mesh being drawn, -FLT_MAX where it isn't drawn and
+    // FLT_MAX where it's discarded, and the pixels it overlaps.
+    LocalVector<float> mesh_depth;
+    int mesh_min_x = WIDTH;
+    int mesh_max_x = 0;
+    int mesh_min_y = HEIGHT;
+    int mesh_max_y = 0;
+    uint32_t triangles_drawn = 0;
+
+    // The mesh being drawn.
+    LocalVector<ClipVertex> clip_vertices;
+    // Which way each triangle faces on screen: 1, -1 or 0 when edge on.
+    LocalVector<int8_t> facings;
+
+    _FORCE_INLINE_ ClipVertex _to_clip(const Vector3& p_point) const;
+    _FORCE_INLINE_ Vector3 _to_screen(const ClipVertex& p_vertex) const;
+    _FORCE_INLINE_ int8_t _get_facing(
+        const ClipVertex& p_a,
+        const ClipVertex& p_b,
+        const ClipVertex& p_c
+    ) const;
+    void _draw_triangle(
+        const ClipVertex& p_a,
+        const ClipVertex& p_b,
+        const ClipVertex& p_c,
+        uint32_t p_shared_edges
+    );
+    void _rasterize(
+        const Vector3& p_a,
+        const Vector3& p_b,
+        const Vector3& p_c,
+        uint32_t p_shared_edges
+    );
+    void _merge_mesh();
+};
+
+#endif // PORTAL_OCCLUSION_BUFFER_H
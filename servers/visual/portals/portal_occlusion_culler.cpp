@@ -16,6 +16,7 @@ void PortalOcclusionCuller::prepare_generic(
     const LocalVector<Plane>& p_planes
 ) {
     _num_spheres = 0;
+    _use_buffer  = false;
     _pt_camera   = pt_camera;
 
     real_t goodness_of_fit[MAX_SPHERES];
@@ -142,6 +143,55 @@ void PortalOcclusionCuller::prepare_generic(
     }
 }
 
+void PortalOcclusionCuller::prepare_meshes(
+    PortalRenderer& p_portal_renderer,
+    const LocalVector<uint32_t, uint32_t>& p_occluder_pool_ids,
+    const Occlusion::Camera& p_camera,
+    const LocalVector<Plane>& p_planes
+) {
+    bool buffer_started = false;
+
+    for (unsigned int o = 0; o < p_occluder_pool_ids.size(); o++) {
+        int id          = p_occluder_pool_ids[o];
+        VSOccluder& occ = p_portal_renderer.get_pool_occluder(id);
+
+        if (!occ.active || (occ.type != VSOccluder::OT_MESH)) {
+            continue;
+        }
+
+        // make sure world space vertices are up to date
+        p_portal_renderer.occluder_ensure_up_to_date_mesh(occ);
+
+        // cull entire AABB
+        if (!occ.list_ids.size() || is_aabb_culled(occ.aabb, p_planes)) {
+            continue;
+        }
+
+        // the buffer is only cleared when there is something to draw
+        if (!buffer_started) {
+            _buffer.begin(p_camera.transform, p_camera.projection);
+            buffer_started = true;
+        }
+
+        for (int n = 0; n < occ.list_ids.size(); n++) {
+            const VSOccluder_Mesh& mesh =
+                p_portal_renderer.get_pool_occluder_mesh(occ.list_ids[n]);
+            _buffer.draw_triangles(
+                mesh.world_vertices.ptr(),
+                mesh.world_vertices.size(),
+                mesh.indices.ptr(),
+                mesh.edge_neighbours.ptr(),
+                mesh.indices.size()
+            );
+        }
+    }
+
+    if (buffer_started) {
+        _buffer.end();
+        _use_buffer = !_buffer.is_empty();
+    }
+}
+
 bool PortalOcclusionCuller::cull_sphere(
     const Vector3& p_occludee_center,
     real_t p_occludee_radius,
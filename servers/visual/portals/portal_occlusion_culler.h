@@ -8,6 +8,7 @@
 #define PORTAL_OCCLUSION_CULLER_H
 
 class PortalRenderer;
+#include "portal_occlusion_buffer.h"
 #include "portal_types.h"
 
 class PortalOcclusionCuller {
@@ -60,12 +61,22 @@ public:
         const LocalVector<Plane>& p_planes
     );
 
+    // rasterizes the mesh occluders in view into the occlusion buffer, must
+    // be called after prepare_generic()
+    void prepare_meshes(
+        PortalRenderer& p_portal_renderer,
+        const LocalVector<uint32_t, uint32_t>& p_occluder_pool_ids,
+        const Occlusion::Camera& p_camera,
+        const LocalVector<Plane>& p_planes
+    );
+
     bool cull_aabb(const AABB& p_aabb) const {
-        if (!_num_spheres) {
-            return false;
+        if (_num_spheres
+            && cull_sphere(p_aabb.get_center(), p_aabb.size.length() * 0.5)) {
+            return true;
         }
 
-        return cull_sphere(p_aabb.get_center(), p_aabb.size.length() * 0.5);
+        return _use_buffer && _buffer.is_aabb_occluded(p_aabb);
     }
 
     bool cull_sphere(
@@ -122,6 +133,11 @@ private:
     int _num_spheres            = 0;
     int _max_spheres            = 8;
 
+    // mesh occluders are drawn into a depth buffer, which is only used when
+    // any were drawn
+    PortalOcclusionBuffer _buffer;
+    bool _use_buffer = false;
+
     Vector3 _pt_camera;
 };
 
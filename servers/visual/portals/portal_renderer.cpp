@@ -6,6 +6,7 @@
 
 #include "portal_renderer.h"
 
+#include "portal_occlusion_buffer.h"
 #include "portal_pvs_builder.h"
 #include "servers/visual/visual_server_globals.h"
 #include "servers/visual/visual_server_scene.h"
@@ -610,6 +611,64 @@ void PortalRenderer::occluder_update_spheres(
     occ.dirty = true;
 }
 
+void PortalRenderer::occluder_update_mesh(
+    OccluderHandle p_handle,
+    const PoolVector<Vector3>& p_vertices,
+    const PoolVector<int>& p_indices
+) {
+    p_handle--;
+    VSOccluder& occ = _occluder_pool[p_handle];
+    ERR_FAIL_COND(occ.type != VSOccluder::OT_MESH);
+    ERR_FAIL_COND_MSG(
+        p_indices.size() % 3,
+        "Occluder mesh indices must contain three indices per triangle."
+    );
+
+    PoolVector<Vector3>::Read vertices = p_vertices.read();
+    PoolVector<int>::Read indices      = p_indices.read();
+    int num_vertices                   = p_vertices.size();
+    int num_indices                    = p_indices.size();
+    for (int n = 0; n < num_indices; n++) {
+        ERR_FAIL_INDEX(indices[n], num_vertices);
+    }
+
+    // remove existing
+    for (int n = 0; n < occ.list_ids.size(); n++) {
+        uint32_t id = occ.list_ids[n];
+        _occluder_mesh_pool.free(id);
+    }
+    occ.list_ids.clear();
+
+    // mark as dirty as the world space vertices will be out of date
+    occ.dirty = true;
+
+    if (!num_indices) {
+        return;
+    }
+
+    uint32_t id;
+    VSOccluder_Mesh* mesh = _occluder_mesh_pool.request(id);
+    mesh->create();
+    occ.list_ids.push_back(id);
+
+    mesh->local_vertices.resize(num_vertices);
+    mesh->world_vertices.resize(num_vertices);
+    for (int n = 0; n < num_vertices; n++) {
+        mesh->local_vertices[n] = vertices[n];
+    }
+    mesh->indices.resize(num_indices);
+    for (int n = 0; n < num_indices; n++) {
+        mesh->indices[n] = indices[n];
+    }
+
+    PortalOcclusionBuffer::find_edge_neighbours(
+        mesh->local_vertices.ptr(),
+        mesh->indices.ptr(),
+        num_indices,
+        mesh->edge_neighbours
+    );
+}
+
 void PortalRenderer::occluder_destroy(OccluderHandle p_handle) {
     p_handle--;
 
@@ -619,6 +678,13 @@ void PortalRenderer::occluder_destroy(OccluderHandle p_handle) {
         case VSOccluder::OT_SPHERE: {
             occluder_update_spheres(p_handle + 1, Vector<Plane>());
         } break;
+        case VSOccluder::OT_MESH: {
+            occluder_update_mesh(
+                p_handle + 1,
+                PoolVector<Vector3>(),
+                PoolVector<int>()
+            );
+        } break;
         default: {
         } break;
     }
@@ -8,6 +8,7 @@
 #define PORTAL_RENDERER_H
 
 #include "core/math/plane.h"
+#include "core/pool_vector.h"
 #include "core/pooled_list.h"
 #include "core/vector.h"
 #include "portal_gameplay_monitor.h"
@@ -246,6 +247,11 @@ public:
         OccluderHandle p_handle,
         const Vector<Plane>& p_spheres
     );
+    void occluder_update_mesh(
+        OccluderHandle p_handle,
+        const PoolVector<Vector3>& p_vertices,
+        const PoolVector<int>& p_indices
+    );
     void occluder_set_transform(
         OccluderHandle p_handle,
         const Transform& p_xform
@@ -295,23 +301,33 @@ public:
     );
 
     // special function for occlusion culling only that does not use portals /
-    // rooms, but allows using occluders with the main scene
+    // rooms, but allows using occluders with the main scene. Mesh occluders
+    // are only used when a camera is given. After a portal cull, which
+    // already culls against the sphere occluders of the rooms, spheres can be
+    // skipped.
     int occlusion_cull(
         const Vector3& p_point,
         const Vector<Plane>& p_convex,
         VSInstance** p_result_array,
-        int p_num_results
+        int p_num_results,
+        const Occlusion::Camera* p_camera = nullptr,
+        bool p_use_spheres                = true
     ) {
         // inactive?
         if (!_occluder_pool.active_size() || !use_occlusion_culling) {
             return p_num_results;
         }
+        if (!p_use_spheres && !p_camera) {
+            return p_num_results;
+        }
         return _tracer.occlusion_cull(
             *this,
             p_point,
             p_convex,
             p_result_array,
-            p_num_results
+            p_num_results,
+            p_camera,
+            p_use_spheres
         );
     }
 
@@ -388,6 +404,10 @@ public:
         return _occluder_sphere_pool[p_pool_id];
     }
 
+    const VSOccluder_Mesh& get_pool_occluder_mesh(uint32_t p_pool_id) const {
+        return _occluder_mesh_pool[p_pool_id];
+    }
+
     const LocalVector<uint32_t, uint32_t>& get_occluders_active_list() const {
         return _occluder_pool.get_active_list();
     }
@@ -477,6 +497,7 @@ private:
     // occluders
     TrackedPooledList<VSOccluder> _occluder_pool;
     TrackedPooledList<VSOccluder_Sphere> _occluder_sphere_pool;
+    TrackedPooledList<VSOccluder_Mesh> _occluder_mesh_pool;
 
     PVS _pvs;
 
@@ -509,6 +530,7 @@ public:
     static String _addr_to_string(const void* p_addr);
 
     void occluder_ensure_up_to_date_sphere(VSOccluder& r_occluder);
+    void occluder_ensure_up_to_date_mesh(VSOccluder& r_occluder);
     void occluder_refresh_room_within(uint32_t p_occluder_pool_id);
 };
 
@@ -558,4 +580,40 @@ inline void PortalRenderer::occluder_ensure_up_to_date_sphere(
     r_occluder.aabb.size     = bb_max - bb_min;
 }
 
+inline void PortalRenderer::occluder_ensure_up_to_date_mesh(
+    VSOccluder& r_occluder
+) {
+    if (!r_occluder.dirty) {
+        return;
+    }
+    r_occluder.dirty = false;
+
+    const Transform& tr = r_occluder.xform;
+
+    // update the AABB
+    Vector3 bb_min = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
+    Vector3 bb_max = Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+    // transform vertices
+    for (int n = 0; n < r_occluder.list_ids.size(); n++) {
+        uint32_t pool_id       = r_occluder.list_ids[n];
+        VSOccluder_Mesh& omesh = _occluder_mesh_pool[pool_id];
+
+        for (int v = 0; v < omesh.local_vertices.size(); v++) {
+            Vector3 vertex          = tr.xform(omesh.local_vertices[v]);
+            omesh.world_vertices[v] = vertex;
+
+            bb_min.x = MIN(bb_min.x, vertex.x);
+            bb_min.y = MIN(bb_min.y, vertex.y);
+            bb_min.z = MIN(bb_min.z, vertex.z);
+            bb_max.x = MAX(bb_max.x, vertex.x);
+            bb_max.y = MAX(bb_max.y, vertex.y);
+            bb_max.z = MAX(bb_max.z, vertex.z);
+        }
+    }
+
+    r_occluder.aabb.position = bb_min;
+    r_occluder.aabb.size     = bb_max - bb_min;
+}
+
 #endif
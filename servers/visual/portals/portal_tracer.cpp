@@ -605,7 +605,9 @@ int PortalTracer::occlusion_cull(
     const Vector3& p_point,
     const Vector<Plane>& p_convex,
     VSInstance** p_result_array,
-    int p_num_results
+    int p_num_results,
+    const Occlusion::Camera* p_camera,
+    bool p_use_spheres
 ) {
     // silly conversion of vector to local vector
     // can this be avoided? NYI
@@ -619,12 +621,24 @@ int PortalTracer::occlusion_cull(
         local_planes[n] = p_convex[n];
     }
 
+    static const LocalVector<uint32_t, uint32_t> no_occluders;
+    const LocalVector<uint32_t, uint32_t>& active_occluders =
+        p_portal_renderer.get_occluders_active_list();
+
     _occlusion_culler.prepare_generic(
         p_portal_renderer,
-        p_portal_renderer.get_occluders_active_list(),
+        p_use_spheres ? active_occluders : no_occluders,
         p_point,
         local_planes
     );
+    if (p_camera) {
+        _occlusion_culler.prepare_meshes(
+            p_portal_renderer,
+            active_occluders,
+            *p_camera,
+            local_planes
+        );
+    }
 
     // cull each instance
     int count = p_num_results;
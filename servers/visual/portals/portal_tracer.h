@@ -122,7 +122,9 @@ public:
         const Vector3& p_point,
         const Vector<Plane>& p_convex,
         VSInstance** p_result_array,
-        int p_num_results
+        int p_num_results,
+        const Occlusion::Camera* p_camera,
+        bool p_use_spheres
     );
 
 private:
@@ -9,6 +9,7 @@
 
 #include "core/local_vector.h"
 #include "core/math/aabb.h"
+#include "core/math/camera_matrix.h"
 #include "core/math/plane.h"
 #include "core/math/quat.h"
 #include "core/math/transform.h"
@@ -399,6 +400,7 @@ struct VSOccluder {
     enum Type : uint32_t {
         OT_UNDEFINED,
         OT_SPHERE,
+        OT_MESH,
         OT_NUM_TYPES,
     } type;
 
@@ -460,6 +462,12 @@ struct Sphere {
         return true;
     }
 };
+
+// The camera that mesh occluders are rasterized from.
+struct Camera {
+    Transform transform;
+    CameraMatrix projection;
+};
 } // namespace Occlusion
 
 struct VSOccluder_Sphere {
@@ -472,4 +480,21 @@ struct VSOccluder_Sphere {
     Occlusion::Sphere world;
 };
 
+struct VSOccluder_Mesh {
+    void create() {
+        local_vertices.clear();
+        world_vertices.clear();
+        indices.clear();
+        edge_neighbours.clear();
+    }
+
+    LocalVector<Vector3, int32_t> local_vertices;
+    LocalVector<Vector3, int32_t> world_vertices;
+    // three indices per triangle
+    LocalVector<uint32_t, int32_t> indices;
+    // for each edge of each triangle, the only other triangle sharing it,
+    // or -1
+    LocalVector<int32_t, int32_t> edge_neighbours;
+};
+
 #endif
@@ -17,6 +17,8 @@ Rasterizer* Rasterizer::create() {
 
 RasterizerStorage* RasterizerStorage::base_singleton = nullptr;
 
+uint64_t RasterizerCanvas::Item::last_version = 0;
+
 RasterizerStorage::RasterizerStorage() {
     base_singleton = this;
 }
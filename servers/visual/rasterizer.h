@@ -689,6 +689,10 @@ public:
     ) = 0;
     virtual Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone)
         const = 0;
+    virtual void skeleton_set_as_bulk_array(
+        RID p_skeleton,
+        const PoolVector<float>& p_array
+    ) = 0;
     virtual void skeleton_bone_set_transform_2d(
         RID p_skeleton,
         int p_bone,
@@ -1430,6 +1434,16 @@ public:
 
         Rect2 global_rect_cache;
 
+        // Changes whenever the commands change. Versions are unique across all
+        // items, so a renderer can use them to detect changed items.
+        uint64_t version;
+        static uint64_t last_version;
+
+        void add_command(Command* p_command) {
+            commands.push_back(p_command);
+            version = ++last_version;
+        }
+
         const Rect2& get_rect() const {
             if (custom_rect || (!rect_dirty && !update_when_visible)) {
                 return rect;
@@ -1665,6 +1679,7 @@ public:
             final_clip_owner = nullptr;
             material_owner   = nullptr;
             light_masked     = false;
+            version          = ++last_version;
         }
 
         Item() {
@@ -1683,6 +1698,7 @@ public:
             distance_field      = false;
             light_masked        = false;
             update_when_visible = false;
+            version             = ++last_version;
         }
 
         virtual ~Item() {
@@ -679,7 +679,7 @@ void VisualServerCanvas::canvas_item_add_line(
     line->antialiased       = p_antialiased;
     canvas_item->rect_dirty = true;
 
-    canvas_item->commands.push_back(line);
+    canvas_item->add_command(line);
 }
 
 void VisualServerCanvas::canvas_item_add_polyline(
@@ -770,7 +770,7 @@ void VisualServerCanvas::canvas_item_add_polyline(
         }
     }
     canvas_item->rect_dirty = true;
-    canvas_item->commands.push_back(pline);
+    canvas_item->add_command(pline);
 }
 
 void VisualServerCanvas::canvas_item_add_multiline(
@@ -800,7 +800,7 @@ void VisualServerCanvas::canvas_item_add_multiline(
     }
 
     canvas_item->rect_dirty = true;
-    canvas_item->commands.push_back(pline);
+    canvas_item->add_command(pline);
 }
 
 void VisualServerCanvas::canvas_item_add_rect(
@@ -817,7 +817,7 @@ void VisualServerCanvas::canvas_item_add_rect(
     rect->rect              = p_rect;
     canvas_item->rect_dirty = true;
 
-    canvas_item->commands.push_back(rect);
+    canvas_item->add_command(rect);
 }
 
 void VisualServerCanvas::canvas_item_add_circle(
@@ -835,7 +835,7 @@ void VisualServerCanvas::canvas_item_add_circle(
     circle->pos    = p_pos;
     circle->radius = p_radius;
 
-    canvas_item->commands.push_back(circle);
+    canvas_item->add_command(circle);
 }
 
 void VisualServerCanvas::canvas_item_add_texture_rect(
@@ -877,7 +877,7 @@ void VisualServerCanvas::canvas_item_add_texture_rect(
     rect->texture           = p_texture;
     rect->normal_map        = p_normal_map;
     canvas_item->rect_dirty = true;
-    canvas_item->commands.push_back(rect);
+    canvas_item->add_command(rect);
 }
 
 void VisualServerCanvas::canvas_item_add_texture_rect_region(
@@ -930,7 +930,7 @@ void VisualServerCanvas::canvas_item_add_texture_rect_region(
 
     canvas_item->rect_dirty = true;
 
-    canvas_item->commands.push_back(rect);
+    canvas_item->add_command(rect);
 }
 
 void VisualServerCanvas::canvas_item_add_nine_patch(
@@ -965,7 +965,7 @@ void VisualServerCanvas::canvas_item_add_nine_patch(
     style->axis_y                = p_y_axis_mode;
     canvas_item->rect_dirty      = true;
 
-    canvas_item->commands.push_back(style);
+    canvas_item->add_command(style);
 }
 
 void VisualServerCanvas::canvas_item_add_primitive(
@@ -990,7 +990,7 @@ void VisualServerCanvas::canvas_item_add_primitive(
     prim->width             = p_width;
     canvas_item->rect_dirty = true;
 
-    canvas_item->commands.push_back(prim);
+    canvas_item->add_command(prim);
 }
 
 void VisualServerCanvas::canvas_item_add_polygon(
@@ -1033,7 +1033,7 @@ void VisualServerCanvas::canvas_item_add_polygon(
     polygon->antialiasing_use_indices = false;
     canvas_item->rect_dirty           = true;
 
-    canvas_item->commands.push_back(polygon);
+    canvas_item->add_command(polygon);
 }
 
 void VisualServerCanvas::canvas_item_add_triangle_array(
@@ -1094,7 +1094,7 @@ void VisualServerCanvas::canvas_item_add_triangle_array(
     polygon->antialiasing_use_indices = p_antialiasing_use_indices;
     canvas_item->rect_dirty           = true;
 
-    canvas_item->commands.push_back(polygon);
+    canvas_item->add_command(polygon);
 }
 
 void VisualServerCanvas::canvas_item_add_set_transform(
@@ -1108,7 +1108,7 @@ void VisualServerCanvas::canvas_item_add_set_transform(
     ERR_FAIL_COND(!tr);
     tr->xform = p_transform;
 
-    canvas_item->commands.push_back(tr);
+    canvas_item->add_command(tr);
 }
 
 void VisualServerCanvas::canvas_item_add_mesh(
@@ -1130,7 +1130,7 @@ void VisualServerCanvas::canvas_item_add_mesh(
     m->transform  = p_transform;
     m->modulate   = p_modulate;
 
-    canvas_item->commands.push_back(m);
+    canvas_item->add_command(m);
 }
 
 void VisualServerCanvas::canvas_item_add_particles(
@@ -1153,7 +1153,7 @@ void VisualServerCanvas::canvas_item_add_particles(
     VSG::storage->particles_request_process(p_particles);
 
     canvas_item->rect_dirty = true;
-    canvas_item->commands.push_back(part);
+    canvas_item->add_command(part);
 }
 
 void VisualServerCanvas::canvas_item_add_multimesh(
@@ -1172,7 +1172,7 @@ void VisualServerCanvas::canvas_item_add_multimesh(
     mm->normal_map = p_normal_map;
 
     canvas_item->rect_dirty = true;
-    canvas_item->commands.push_back(mm);
+    canvas_item->add_command(mm);
 }
 
 void VisualServerCanvas::canvas_item_add_clip_ignore(
@@ -1186,7 +1186,7 @@ void VisualServerCanvas::canvas_item_add_clip_ignore(
     ERR_FAIL_COND(!ci);
     ci->ignore = p_ignore;
 
-    canvas_item->commands.push_back(ci);
+    canvas_item->add_command(ci);
 }
 
 void VisualServerCanvas::canvas_item_set_sort_children_by_y(
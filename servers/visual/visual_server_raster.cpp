@@ -97,6 +97,7 @@ void VisualServerRaster::draw(bool p_swap_buffers, double frame_step) {
 
     VSG::viewport->draw_viewports();
     VSG::scene->render_probes();
+    VSG::scene->end_frame();
     _draw_margins();
     VSG::rasterizer->end_frame(p_swap_buffers);
 
@@ -145,6 +146,12 @@ void VisualServerRaster::finish() {
 /* STATUS INFORMATION */
 
 uint64_t VisualServerRaster::get_render_info(RenderInfo p_info) {
+    if (p_info == INFO_OCCLUDED_OBJECTS_IN_FRAME) {
+        return VSG::scene->get_occluded_objects_in_frame();
+    }
+    if (p_info == INFO_CULL_OVERFLOWS_IN_FRAME) {
+        return VSG::scene->get_cull_overflows_in_frame();
+    }
     return VSG::storage->get_render_info(p_info);
 }
 
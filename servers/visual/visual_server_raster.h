@@ -571,6 +571,7 @@ public:
     BIND1RC(int, skeleton_get_bone_count, RID)
     BIND3(skeleton_bone_set_transform, RID, int, const Transform&)
     BIND2RC(Transform, skeleton_bone_get_transform, RID, int)
+    BIND2(skeleton_set_as_bulk_array, RID, const PoolVector<float>&)
     BIND3(skeleton_bone_set_transform_2d, RID, int, const Transform2D&)
     BIND2RC(Transform2D, skeleton_bone_get_transform_2d, RID, int)
     BIND2(skeleton_set_base_transform_2d, RID, const Transform2D&)
@@ -893,6 +894,7 @@ public:
     BIND2(instance_set_scenario, RID, RID)
     BIND2(instance_set_layer_mask, RID, uint32_t)
     BIND2(instance_set_transform, RID, const Transform&)
+    BIND2(instances_set_transforms, const Vector<RID>&, const Vector<Transform>&)
     BIND2(instance_attach_object_instance_id, RID, ObjectID)
     BIND3(instance_set_blend_shape_weight, RID, int, float)
     BIND3(instance_set_surface_material, RID, int, RID)
@@ -929,6 +931,12 @@ public:
     BIND0R(RID, occluder_create)
     BIND3(occluder_set_scenario, RID, RID, OccluderType)
     BIND2(occluder_spheres_update, RID, const Vector<Plane>&)
+    BIND3(
+        occluder_mesh_update,
+        RID,
+        const PoolVector<Vector3>&,
+        const PoolVector<int>&
+    )
     BIND2(occluder_set_transform, RID, const Transform&)
     BIND2(occluder_set_active, RID, bool)
     BIND1(set_use_occlusion_culling, bool)
@@ -96,6 +96,18 @@ void VisualServerScene::camera_set_use_vertical_aspect(
 
 /* SPATIAL PARTITIONING */
 
+void VisualServerScene::SpatialPartitioningScene::move_batch(
+    Instance* const* p_instances,
+    int p_count
+) {
+    for (int i = 0; i < p_count; i++) {
+        move(
+            p_instances[i]->spatial_partition_id,
+            p_instances[i]->transformed_aabb
+        );
+    }
+}
+
 VisualServerScene::SpatialPartitioningScene_BVH::SpatialPartitioningScene_BVH(
 ) {
     _bvh.params_set_thread_safe(GLOBAL_GET("rendering/threads/thread_safe_bvh")
@@ -144,6 +156,19 @@ void VisualServerScene::SpatialPartitioningScene_BVH::move(
     _bvh.move(p_handle - 1, p_aabb);
 }
 
+void VisualServerScene::SpatialPartitioningScene_BVH::move_batch(
+    Instance* const* p_instances,
+    int p_count
+) {
+    for (int i = 0; i < p_count; i++) {
+        _bvh.move_deferred(
+            p_instances[i]->spatial_partition_id - 1,
+            p_instances[i]->transformed_aabb
+        );
+    }
+    _bvh.refit_moved();
+}
+
 void VisualServerScene::SpatialPartitioningScene_BVH::activate(
     SpatialPartitionID p_handle,
     const AABB& p_aabb
@@ -716,6 +741,7 @@ void VisualServerScene::instance_set_base(RID p_instance, RID p_base) {
             scenario->sps->erase(instance->spatial_partition_id);
             instance->spatial_partition_id = 0;
         }
+        _remove_instance_from_move_list(instance);
 
         switch (instance->base_type) {
             case VS::INSTANCE_LIGHT: {
@@ -891,6 +917,7 @@ void VisualServerScene::instance_set_scenario(RID p_instance, RID p_scenario) {
             instance->scenario->sps->erase(instance->spatial_partition_id);
             instance->spatial_partition_id = 0;
         }
+        _remove_instance_from_move_list(instance);
 
         // handle occlusion changes
         if (instance->occlusion_handle) {
@@ -1005,6 +1032,17 @@ void VisualServerScene::instance_set_transform(
     _instance_queue_update(instance, true);
 }
 
+void VisualServerScene::instances_set_transforms(
+    const Vector<RID>& p_instances,
+    const Vector<Transform>& p_transforms
+) {
+    ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+    for (int i = 0; i < p_instances.size(); i++) {
+        instance_set_transform(p_instances[i], p_transforms[i]);
+    }
+}
+
 void VisualServerScene::instance_attach_object_instance_id(
     RID p_instance,
     ObjectID p_id
@@ -1687,6 +1725,21 @@ void VisualServerScene::occluder_spheres_update(
     );
 }
 
+void VisualServerScene::occluder_mesh_update(
+    RID p_occluder,
+    const PoolVector<Vector3>& p_vertices,
+    const PoolVector<int>& p_indices
+) {
+    Occluder* ro = occluder_owner.getornull(p_occluder);
+    ERR_FAIL_COND(!ro);
+    ERR_FAIL_COND(!ro->scenario);
+    ro->scenario->_portal_renderer.occluder_update_mesh(
+        ro->scenario_occluder_id,
+        p_vertices,
+        p_indices
+    );
+}
+
 void VisualServerScene::set_use_occlusion_culling(bool p_enable) {
     // this is not scenario specific, and is global
     // (mainly for debugging)
@@ -2008,45 +2061,158 @@ Vector<ObjectID> VisualServerScene::instances_cull_convex(
     return instances;
 }
 
+void VisualServerScene::InstanceCullResult::resize(int p_capacity) {
+    instances.resize(p_capacity);
+    aabbs.resize(p_capacity);
+    layer_masks.resize(p_capacity);
+    base_types.resize(p_capacity);
+    flags.resize(p_capacity);
+    depths.resize(p_capacity);
+}
+
+void VisualServerScene::InstanceCullResult::gather(int p_count) {
+    count = p_count;
+    for (int i = 0; i < p_count; i++) {
+        const Instance* instance = instances[i];
+
+        uint8_t instance_flags = 0;
+        if (instance->visible) {
+            instance_flags |= FLAG_VISIBLE;
+        }
+        if ((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) {
+            if (static_cast<InstanceGeometryData*>(instance->base_data)
+                    ->can_cast_shadows) {
+                instance_flags |= FLAG_CASTS_SHADOW;
+            }
+            if (instance->cast_shadows
+                == VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
+                instance_flags |= FLAG_SHADOWS_ONLY;
+            }
+        }
+
+        aabbs[i]       = instance->transformed_aabb;
+        layer_masks[i] = instance->layer_mask;
+        base_types[i]  = instance->base_type;
+        flags[i]       = instance_flags;
+    }
+}
+
+void VisualServerScene::InstanceCullResult::copy(int p_from, int p_to) {
+    instances[p_to]   = instances[p_from];
+    aabbs[p_to]       = aabbs[p_from];
+    layer_masks[p_to] = layer_masks[p_from];
+    base_types[p_to]  = base_types[p_from];
+    flags[p_to]       = flags[p_from];
+    depths[p_to]      = depths[p_from];
+}
+
+void VisualServerScene::InstanceCullResult::swap(int p_a, int p_b) {
+    SWAP(instances[p_a], instances[p_b]);
+    SWAP(aabbs[p_a], aabbs[p_b]);
+    SWAP(layer_masks[p_a], layer_masks[p_b]);
+    SWAP(base_types[p_a], base_types[p_b]);
+    SWAP(flags[p_a], flags[p_b]);
+    SWAP(depths[p_a], depths[p_b]);
+}
+
+int VisualServerScene::_cull_convex(
+    Scenario* p_scenario,
+    const Vector<Plane>& p_convex,
+    InstanceCullResult& r_result,
+    uint32_t p_mask
+) {
+    int res = p_scenario->sps->cull_convex(
+        p_convex,
+        r_result.instances.ptr(),
+        r_result.get_capacity(),
+        p_mask
+    );
+    // A full buffer may have dropped instances, so cull again with more room.
+    while (res == r_result.get_capacity()) {
+        cull_overflows++;
+        r_result.resize(r_result.get_capacity() * 2);
+        res = p_scenario->sps->cull_convex(
+            p_convex,
+            r_result.instances.ptr(),
+            r_result.get_capacity(),
+            p_mask
+        );
+    }
+    r_result.gather(res);
+    return res;
+}
+
 // thin wrapper to allow rooms / portals to take over culling if active
 int VisualServerScene::_cull_convex_from_point(
     Scenario* p_scenario,
     const Vector3& p_point,
     const Vector<Plane>& p_convex,
-    Instance** p_result_array,
-    int p_result_max,
+    InstanceCullResult& r_result,
     int32_t& r_previous_room_id_hint,
-    uint32_t p_mask
+    uint32_t p_mask,
+    const Occlusion::Camera* p_camera
 ) {
     int res = -1;
-    if (p_scenario->_portal_renderer.is_active()) {
-        // Note that the portal renderer ASSUMES that the planes exactly match
-        // the convention in CameraMatrix of enum Planes (6 planes, in order,
-        // near, far etc) If this is not the case, it should not be used.
-        res = p_scenario->_portal_renderer.cull_convex(
-            p_point,
-            p_convex,
-            (VSInstance**)p_result_array,
-            p_result_max,
-            p_mask,
-            r_previous_room_id_hint
-        );
-    }
+    while (true) {
+        VSInstance** result_array = (VSInstance**)r_result.instances.ptr();
+        int result_max            = r_result.get_capacity();
+
+        res = -1;
+        if (p_scenario->_portal_renderer.is_active()) {
+            // Note that the portal renderer ASSUMES that the planes exactly
+            // match the convention in CameraMatrix of enum Planes (6 planes,
+            // in order, near, far etc) If this is not the case, it should not
+            // be used.
+            res = p_scenario->_portal_renderer.cull_convex(
+                p_point,
+                p_convex,
+                result_array,
+                result_max,
+                p_mask,
+                r_previous_room_id_hint
+            );
+        }
+
+        bool portals = res != -1;
+        // fallback to BVH  / octree if portals not active
+        if (!portals) {
+            res = p_scenario->sps->cull_convex(
+                p_convex,
+                r_result.instances.ptr(),
+                result_max,
+                p_mask
+            );
+        }
 
-    // fallback to BVH  / octree if portals not active
-    if (res == -1) {
-        res = p_scenario->sps
-                  ->cull_convex(p_convex, p_result_array, p_result_max, p_mask);
+        if (res < result_max) {
+            if (portals && !p_camera) {
+                break;
+            }
 
-        // Opportunity for occlusion culling on the main scene. This will be a
-        // noop if no occluders.
-        res = p_scenario->_portal_renderer.occlusion_cull(
-            p_point,
-            p_convex,
-            (VSInstance**)p_result_array,
-            res
-        );
+            // The rooms have already culled against their sphere occluders,
+            // but mesh occluders are only used with a camera. Otherwise, this
+            // is an opportunity for occlusion culling on the main scene, which
+            // will be a noop if there are no occluders.
+            int visible = p_scenario->_portal_renderer.occlusion_cull(
+                p_point,
+                p_convex,
+                result_array,
+                res,
+                p_camera,
+                !portals
+            );
+            occluded_objects += res - visible;
+            res               = visible;
+            break;
+        }
+
+        // A full buffer may have dropped instances, so cull again with more
+        // room.
+        cull_overflows++;
+        r_result.resize(result_max * 2);
     }
+
+    r_result.gather(res);
     return res;
 }
 
@@ -2221,64 +2387,123 @@ void VisualServerScene::_update_instance(Instance* p_instance) {
         }
     }
 
-    p_instance->mirror = p_instance->transform.basis.determinant() < 0.0;
-
-    AABB new_aabb;
-
-    new_aabb = p_instance->transform.xform(p_instance->aabb);
+    if (p_instance->scenario && p_instance->spatial_partition_id != 0) {
+        if (!p_instance->in_move_list) {
+            p_instance->in_move_list = true;
+            instance_move_list.push_back(p_instance);
+        }
+        return;
+    }
 
-    p_instance->transformed_aabb = new_aabb;
+    _update_instance_transformed_aabb(p_instance);
 
     if (!p_instance->scenario) {
         return;
     }
 
-    if (p_instance->spatial_partition_id == 0) {
-        uint32_t base_type     = 1 << p_instance->base_type;
-        uint32_t pairable_mask = 0;
-        bool pairable          = false;
+    uint32_t base_type     = 1 << p_instance->base_type;
+    uint32_t pairable_mask = 0;
+    bool pairable          = false;
 
-        if (p_instance->base_type == VS::INSTANCE_LIGHT
-            || p_instance->base_type == VS::INSTANCE_REFLECTION_PROBE
-            || p_instance->base_type == VS::INSTANCE_LIGHTMAP_CAPTURE) {
-            pairable_mask =
-                p_instance->visible ? VS::INSTANCE_GEOMETRY_MASK : 0;
-            pairable = true;
-        }
+    if (p_instance->base_type == VS::INSTANCE_LIGHT
+        || p_instance->base_type == VS::INSTANCE_REFLECTION_PROBE
+        || p_instance->base_type == VS::INSTANCE_LIGHTMAP_CAPTURE) {
+        pairable_mask = p_instance->visible ? VS::INSTANCE_GEOMETRY_MASK : 0;
+        pairable      = true;
+    }
+
+    if (p_instance->base_type == VS::INSTANCE_GI_PROBE) {
+        // lights and geometries
+        pairable_mask =
+            p_instance->visible
+                ? VS::INSTANCE_GEOMETRY_MASK | (1 << VS::INSTANCE_LIGHT)
+                : 0;
+        pairable = true;
+    }
+
+    // not inside octree
+    p_instance->spatial_partition_id = p_instance->scenario->sps->create(
+        p_instance,
+        p_instance->transformed_aabb,
+        0,
+        pairable,
+        base_type,
+        pairable_mask
+    );
+
+    // keep rooms and portals instance up to date if present
+    _rooms_instance_update(p_instance, p_instance->transformed_aabb);
+}
+
+void VisualServerScene::_update_instance_transformed_aabb(Instance* p_instance
+) {
+    const Transform& transform   = p_instance->transform;
+    p_instance->mirror           = transform.basis.determinant() < 0.0;
+    p_instance->transformed_aabb = transform.xform(p_instance->aabb);
+}
+
+void VisualServerScene::_update_moved_instances_thread(
+    uint32_t p_chunk,
+    void* p_userdata
+) {
+    uint32_t begin = p_chunk * PREPARE_CHUNK_SIZE;
+    uint32_t end   = MIN(begin + PREPARE_CHUNK_SIZE, instance_move_list.size());
+    for (uint32_t i = begin; i < end; i++) {
+        _update_instance_transformed_aabb(instance_move_list[i]);
+    }
+}
 
-        if (p_instance->base_type == VS::INSTANCE_GI_PROBE) {
-            // lights and geometries
-            pairable_mask =
-                p_instance->visible
-                    ? VS::INSTANCE_GEOMETRY_MASK | (1 << VS::INSTANCE_LIGHT)
-                    : 0;
-            pairable = true;
+void VisualServerScene::_remove_instance_from_move_list(Instance* p_instance
+) {
+    if (p_instance->in_move_list) {
+        instance_move_list.erase(p_instance);
+        p_instance->in_move_list = false;
+    }
+}
+
+void VisualServerScene::_update_moved_instances() {
+    // Instances can be queued outside update_dirty_instances(), e.g. by
+    // instance_set_blend_shape_weight(), so skip any that have left their
+    // scenario since.
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < instance_move_list.size(); i++) {
+        Instance* instance = instance_move_list[i];
+        if (!instance->scenario || instance->spatial_partition_id == 0) {
+            instance->in_move_list = false;
+            continue;
         }
+        instance_move_list[count++] = instance;
+    }
+    instance_move_list.resize(count);
 
-        // not inside octree
-        p_instance->spatial_partition_id = p_instance->scenario->sps->create(
-            p_instance,
-            new_aabb,
-            0,
-            pairable,
-            base_type,
-            pairable_mask
-        );
+    work_pool.do_work(
+        _get_prepare_chunk_count(instance_move_list.size()),
+        this,
+        &VisualServerScene::_update_moved_instances_thread,
+        nullptr
+    );
 
-    } else {
-        /*
-        if (new_aabb==p_instance->data.transformed_aabb)
-            return;
-        */
-
-        p_instance->scenario->sps->move(
-            p_instance->spatial_partition_id,
-            new_aabb
-        );
+    // Every batch of moves refits the spatial partitioning once, so the
+    // instances are moved in runs of the same scenario.
+    uint32_t begin = 0;
+    while (begin < instance_move_list.size()) {
+        Scenario* scenario = instance_move_list[begin]->scenario;
+        uint32_t end       = begin + 1;
+        while (end < instance_move_list.size()
+               && instance_move_list[end]->scenario == scenario) {
+            end++;
+        }
+        scenario->sps->move_batch(&instance_move_list[begin], end - begin);
+        begin = end;
     }
 
-    // keep rooms and portals instance up to date if present
-    _rooms_instance_update(p_instance, new_aabb);
+    for (uint32_t i = 0; i < instance_move_list.size(); i++) {
+        Instance* instance     = instance_move_list[i];
+        instance->in_move_list = false;
+        // keep rooms and portals instance up to date if present
+        _rooms_instance_update(instance, instance->transformed_aabb);
+    }
+    instance_move_list.clear();
 }
 
 void VisualServerScene::_update_instance_aabb(Instance* p_instance) {
@@ -2699,10 +2924,10 @@ bool VisualServerScene::_light_instance_update_shadow(
                 // optimize min/max
                 Vector<Plane> planes =
                     p_cam_projection.get_projection_planes(p_cam_transform);
-                int cull_count = p_scenario->sps->cull_convex(
+                int cull_count = _cull_convex(
+                    p_scenario,
                     planes,
                     instance_shadow_cull_result,
-                    MAX_INSTANCE_CULL,
                     VS::INSTANCE_GEOMETRY_MASK
                 );
                 Plane base(
@@ -2716,26 +2941,19 @@ bool VisualServerScene::_light_instance_update_shadow(
                 float z_min      = 1e20f;
 
                 for (int i = 0; i < cull_count; i++) {
-                    Instance* instance = instance_shadow_cull_result[i];
-                    if (!instance->visible
-                        || !(
-                            (1 << instance->base_type)
-                            & VS::INSTANCE_GEOMETRY_MASK
-                        )
-                        || !static_cast<InstanceGeometryData*>(
-                                instance->base_data
-                        )
-                                ->can_cast_shadows) {
+                    if (!instance_shadow_cull_result.is_shadow_caster(i)) {
                         continue;
                     }
 
+                    Instance* instance =
+                        instance_shadow_cull_result.instances[i];
                     if (static_cast<InstanceGeometryData*>(instance->base_data)
                             ->material_is_animated) {
                         animated_material_found = true;
                     }
 
                     float max, min;
-                    instance->transformed_aabb
+                    instance_shadow_cull_result.aabbs[i]
                         .project_range_in_plane(base, min, max);
 
                     if (max > z_max) {
@@ -2964,10 +3182,10 @@ bool VisualServerScene::_light_instance_update_shadow(
                 ); // z_min is ok, since casters further than far-light plane
                    // are not needed
 
-                int cull_count = p_scenario->sps->cull_convex(
+                int cull_count = _cull_convex(
+                    p_scenario,
                     light_frustum_planes,
                     instance_shadow_cull_result,
-                    MAX_INSTANCE_CULL,
                     VS::INSTANCE_GEOMETRY_MASK
                 );
 
@@ -2981,26 +3199,16 @@ bool VisualServerScene::_light_instance_update_shadow(
 
                 for (int j = 0; j < cull_count; j++) {
                     float min, max;
-                    Instance* instance = instance_shadow_cull_result[j];
-                    if (!instance->visible
-                        || !(
-                            (1 << instance->base_type)
-                            & VS::INSTANCE_GEOMETRY_MASK
-                        )
-                        || !static_cast<InstanceGeometryData*>(
-                                instance->base_data
-                        )
-                                ->can_cast_shadows) {
+                    if (!instance_shadow_cull_result.is_shadow_caster(j)) {
                         cull_count--;
-                        SWAP(
-                            instance_shadow_cull_result[j],
-                            instance_shadow_cull_result[cull_count]
-                        );
+                        instance_shadow_cull_result.swap(j, cull_count);
                         j--;
                         continue;
                     }
 
-                    instance->transformed_aabb
+                    Instance* instance =
+                        instance_shadow_cull_result.instances[j];
+                    instance_shadow_cull_result.aabbs[j]
                         .project_range_in_plane(Plane(z_vec, 0), min, max);
                     instance->depth =
                         near_plane.distance_to(instance->transform.origin);
@@ -3046,7 +3254,7 @@ bool VisualServerScene::_light_instance_update_shadow(
                     p_shadow_atlas,
                     i,
                     (RasterizerScene::InstanceBase**)
-                        instance_shadow_cull_result,
+                        instance_shadow_cull_result.instances.ptr(),
                     cull_count
                 );
             }
@@ -3087,10 +3295,10 @@ bool VisualServerScene::_light_instance_update_shadow(
                     planes.write[5] =
                         light_transform.xform(Plane(Vector3(0, 0, -z), 0));
 
-                    int cull_count = p_scenario->sps->cull_convex(
+                    int cull_count = _cull_convex(
+                        p_scenario,
                         planes,
                         instance_shadow_cull_result,
-                        MAX_INSTANCE_CULL,
                         VS::INSTANCE_GEOMETRY_MASK
                     );
                     Plane near_plane(
@@ -3099,21 +3307,11 @@ bool VisualServerScene::_light_instance_update_shadow(
                     );
 
                     for (int j = 0; j < cull_count; j++) {
-                        Instance* instance = instance_shadow_cull_result[j];
-                        if (!instance->visible
-                            || !(
-                                (1 << instance->base_type)
-                                & VS::INSTANCE_GEOMETRY_MASK
-                            )
-                            || !static_cast<InstanceGeometryData*>(
-                                    instance->base_data
-                            )
-                                    ->can_cast_shadows) {
+                        Instance* instance =
+                            instance_shadow_cull_result.instances[j];
+                        if (!instance_shadow_cull_result.is_shadow_caster(j)) {
                             cull_count--;
-                            SWAP(
-                                instance_shadow_cull_result[j],
-                                instance_shadow_cull_result[cull_count]
-                            );
+                            instance_shadow_cull_result.swap(j, cull_count);
                             j--;
                         } else {
                             if (static_cast<InstanceGeometryData*>(
@@ -3143,7 +3341,7 @@ bool VisualServerScene::_light_instance_update_shadow(
                         p_shadow_atlas,
                         i,
                         (RasterizerScene::InstanceBase**)
-                            instance_shadow_cull_result,
+                            instance_shadow_cull_result.instances.ptr(),
                         cull_count
                     );
                 }
@@ -3187,28 +3385,17 @@ bool VisualServerScene::_light_instance_update_shadow(
                         light_transform.origin,
                         planes,
                         instance_shadow_cull_result,
-                        MAX_INSTANCE_CULL,
                         light->previous_room_id_hint,
                         VS::INSTANCE_GEOMETRY_MASK
                     );
 
                     Plane near_plane(xform.origin, -xform.basis.get_axis(2));
                     for (int j = 0; j < cull_count; j++) {
-                        Instance* instance = instance_shadow_cull_result[j];
-                        if (!instance->visible
-                            || !(
-                                (1 << instance->base_type)
-                                & VS::INSTANCE_GEOMETRY_MASK
-                            )
-                            || !static_cast<InstanceGeometryData*>(
-                                    instance->base_data
-                            )
-                                    ->can_cast_shadows) {
+                        Instance* instance =
+                            instance_shadow_cull_result.instances[j];
+                        if (!instance_shadow_cull_result.is_shadow_caster(j)) {
                             cull_count--;
-                            SWAP(
-                                instance_shadow_cull_result[j],
-                                instance_shadow_cull_result[cull_count]
-                            );
+                            instance_shadow_cull_result.swap(j, cull_count);
                             j--;
                         } else {
                             if (static_cast<InstanceGeometryData*>(
@@ -3237,7 +3424,7 @@ bool VisualServerScene::_light_instance_update_shadow(
                         p_shadow_atlas,
                         i,
                         (RasterizerScene::InstanceBase**)
-                            instance_shadow_cull_result,
+                            instance_shadow_cull_result.instances.ptr(),
                         cull_count
                     );
                 }
@@ -3273,7 +3460,6 @@ bool VisualServerScene::_light_instance_update_shadow(
                 light_transform.origin,
                 planes,
                 instance_shadow_cull_result,
-                MAX_INSTANCE_CULL,
                 light->previous_room_id_hint,
                 VS::INSTANCE_GEOMETRY_MASK
             );
@@ -3283,18 +3469,10 @@ bool VisualServerScene::_light_instance_update_shadow(
                 -light_transform.basis.get_axis(2)
             );
             for (int j = 0; j < cull_count; j++) {
-                Instance* instance = instance_shadow_cull_result[j];
-                if (!instance->visible
-                    || !(
-                        (1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK
-                    )
-                    || !static_cast<InstanceGeometryData*>(instance->base_data)
-                            ->can_cast_shadows) {
+                Instance* instance = instance_shadow_cull_result.instances[j];
+                if (!instance_shadow_cull_result.is_shadow_caster(j)) {
                     cull_count--;
-                    SWAP(
-                        instance_shadow_cull_result[j],
-                        instance_shadow_cull_result[cull_count]
-                    );
+                    instance_shadow_cull_result.swap(j, cull_count);
                     j--;
                 } else {
                     if (static_cast<InstanceGeometryData*>(instance->base_data)
@@ -3319,7 +3497,8 @@ bool VisualServerScene::_light_instance_update_shadow(
                 light->instance,
                 p_shadow_atlas,
                 0,
-                (RasterizerScene::InstanceBase**)instance_shadow_cull_result,
+                (RasterizerScene::InstanceBase**)
+                    instance_shadow_cull_result.instances.ptr(),
                 cull_count
             );
 
@@ -3593,17 +3772,22 @@ void VisualServerScene::_prepare_scene(
     float z_far = p_cam_projection.get_z_far();
 
     /* STEP 2 - CULL */
-    instance_cull_count = _cull_convex_from_point(
+    Occlusion::Camera occlusion_camera;
+    occlusion_camera.transform  = p_cam_transform;
+    occlusion_camera.projection = p_cam_projection;
+
+    int instance_cull_count = _cull_convex_from_point(
         scenario,
         p_cam_transform.origin,
         planes,
         instance_cull_result,
-        MAX_INSTANCE_CULL,
-        r_previous_room_id_hint
+        r_previous_room_id_hint,
+        0xFFFFFFFF,
+        &occlusion_camera
     );
-    light_cull_count = 0;
-
-    reflection_probe_cull_count = 0;
+    light_cull_result.clear();
+    light_instance_cull_result.clear();
+    reflection_probe_instance_cull_result.clear();
 
     // light_samplers_culled=0;
 
@@ -3619,184 +3803,126 @@ void VisualServerScene::_prepare_scene(
 
     /* STEP 4 - REMOVE FURTHER CULLED OBJECTS, ADD LIGHTS */
 
+    PrepareSceneData data;
+    data.cam_transform     = p_cam_transform;
+    data.cam_projection    = p_cam_projection;
+    data.cam_orthogonal    = p_cam_orthogonal;
+    data.camera_layer_mask = camera_layer_mask;
+    data.shadow_atlas      = p_shadow_atlas;
+    data.near_plane        = near_plane;
+    data.z_far             = z_far;
+
+    instance_prepare_type.resize(instance_cull_count);
+    work_pool.do_work(
+        _get_prepare_chunk_count(instance_cull_count),
+        this,
+        &VisualServerScene::_prepare_instances_thread,
+        &data
+    );
+
+    // The instances are kept, and the lights and probes are added, in cull
+    // order.
+    int kept_count = 0;
     for (int i = 0; i < instance_cull_count; i++) {
-        Instance* ins = instance_cull_result[i];
+        Instance* ins = instance_cull_result.instances[i];
 
         bool keep = false;
 
-        if ((camera_layer_mask & ins->layer_mask) == 0) {
-            // failure
-        } else if (ins->base_type == VS::INSTANCE_LIGHT && ins->visible) {
-            if (light_cull_count < MAX_LIGHTS_CULLED) {
+        switch (instance_prepare_type[i]) {
+            case INSTANCE_PREPARE_LIGHT: {
                 InstanceLightData* light =
                     static_cast<InstanceLightData*>(ins->base_data);
 
                 if (!light->geometries.empty()) {
                     // do not add this light if no geometry is affected by it..
-                    light_cull_result[light_cull_count] = ins;
-                    light_instance_cull_result[light_cull_count] =
-                        light->instance;
+                    light_cull_result.push_back(ins);
+                    light_instance_cull_result.push_back(light->instance);
                     if (p_shadow_atlas.is_valid()
                         && VSG::storage->light_has_shadow(ins->base)) {
                         VSG::scene_render->light_instance_mark_visible(
                             light->instance
                         ); // mark it visible for shadow allocation later
                     }
-
-                    light_cull_count++;
                 }
-            }
-        } else if (ins->base_type == VS::INSTANCE_REFLECTION_PROBE
-                   && ins->visible) {
-            if (reflection_probe_cull_count < MAX_REFLECTION_PROBES_CULLED) {
+            } break;
+            case INSTANCE_PREPARE_REFLECTION_PROBE: {
                 InstanceReflectionProbeData* reflection_probe =
                     static_cast<InstanceReflectionProbeData*>(ins->base_data);
 
-                if (p_reflection_probe != reflection_probe->instance) {
+                if (p_reflection_probe == reflection_probe->instance) {
                     // avoid entering The Matrix
+                    break;
+                }
 
-                    if (!reflection_probe->geometries.empty()) {
-                        // do not add this light if no geometry is affected by
-                        // it..
-
-                        if (reflection_probe->reflection_dirty
-                            || VSG::scene_render
-                                   ->reflection_probe_instance_needs_redraw(
-                                       reflection_probe->instance
-                                   )) {
-                            if (!reflection_probe->update_list.in_list()) {
-                                reflection_probe->render_step = 0;
-                                reflection_probe_render_list.add_last(
-                                    &reflection_probe->update_list
-                                );
-                            }
+                if (!reflection_probe->geometries.empty()) {
+                    // do not add this light if no geometry is affected by it..
 
-                            reflection_probe->reflection_dirty = false;
+                    if (reflection_probe->reflection_dirty
+                        || VSG::scene_render
+                               ->reflection_probe_instance_needs_redraw(
+                                   reflection_probe->instance
+                               )) {
+                        if (!reflection_probe->update_list.in_list()) {
+                            reflection_probe->render_step = 0;
+                            reflection_probe_render_list.add_last(
+                                &reflection_probe->update_list
+                            );
                         }
 
-                        if (VSG::scene_render
-                                ->reflection_probe_instance_has_reflection(
-                                    reflection_probe->instance
-                                )) {
-                            reflection_probe_instance_cull_result
-                                [reflection_probe_cull_count] =
-                                    reflection_probe->instance;
-                            reflection_probe_cull_count++;
-                        }
+                        reflection_probe->reflection_dirty = false;
                     }
-                }
-            }
-
-        } else if (ins->base_type == VS::INSTANCE_GI_PROBE && ins->visible) {
-            InstanceGIProbeData* gi_probe =
-                static_cast<InstanceGIProbeData*>(ins->base_data);
-            if (!gi_probe->update_element.in_list()) {
-                gi_probe_update_list.add(&gi_probe->update_element);
-            }
-
-        } else if (((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK)
-                   && ins->visible
-                   && ins->cast_shadows
-                          != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
-            keep = true;
-
-            InstanceGeometryData* geom =
-                static_cast<InstanceGeometryData*>(ins->base_data);
-
-            if (ins->redraw_if_visible) {
-                VisualServerRaster::redraw_request();
-            }
 
-            if (ins->base_type == VS::INSTANCE_PARTICLES) {
-                // particles visible? process them
-                if (VSG::storage->particles_is_inactive(ins->base)) {
-                    // but if nothing is going on, don't do it.
-                    keep = false;
-                } else {
-                    VSG::storage->particles_request_process(ins->base);
-                    // particles visible? request redraw
-                    VisualServerRaster::redraw_request();
+                    if (VSG::scene_render
+                            ->reflection_probe_instance_has_reflection(
+                                reflection_probe->instance
+                            )) {
+                        reflection_probe_instance_cull_result.push_back(
+                            reflection_probe->instance
+                        );
+                    }
                 }
-            }
-
-            if (geom->lighting_dirty) {
-                int l = 0;
-                // only called when lights AABB enter/exit this geometry
-                ins->light_instances.resize(geom->lighting.size());
-
-                for (List<Instance*>::Element* E = geom->lighting.front(); E;
-                     E                           = E->next()) {
-                    InstanceLightData* light =
-                        static_cast<InstanceLightData*>(E->get()->base_data);
-
-                    ins->light_instances.write[l++] = light->instance;
+            } break;
+            case INSTANCE_PREPARE_GI_PROBE: {
+                InstanceGIProbeData* gi_probe =
+                    static_cast<InstanceGIProbeData*>(ins->base_data);
+                if (!gi_probe->update_element.in_list()) {
+                    gi_probe_update_list.add(&gi_probe->update_element);
                 }
+            } break;
+            case INSTANCE_PREPARE_GEOMETRY: {
+                keep = true;
 
-                geom->lighting_dirty = false;
-            }
-
-            if (geom->reflection_dirty) {
-                int l = 0;
-                // only called when reflection probe AABB enter/exit this
-                // geometry
-                ins->reflection_probe_instances.resize(
-                    geom->reflection_probes.size()
-                );
-
-                for (List<Instance*>::Element* E =
-                         geom->reflection_probes.front();
-                     E;
-                     E = E->next()) {
-                    InstanceReflectionProbeData* reflection_probe =
-                        static_cast<InstanceReflectionProbeData*>(
-                            E->get()->base_data
-                        );
-
-                    ins->reflection_probe_instances.write[l++] =
-                        reflection_probe->instance;
+                if (ins->redraw_if_visible) {
+                    VisualServerRaster::redraw_request();
                 }
 
-                geom->reflection_dirty = false;
-            }
-
-            if (geom->gi_probes_dirty) {
-                int l = 0;
-                // only called when reflection probe AABB enter/exit this
-                // geometry
-                ins->gi_probe_instances.resize(geom->gi_probes.size());
-
-                for (List<Instance*>::Element* E = geom->gi_probes.front(); E;
-                     E                           = E->next()) {
-                    InstanceGIProbeData* gi_probe =
-                        static_cast<InstanceGIProbeData*>(E->get()->base_data);
-
-                    ins->gi_probe_instances.write[l++] =
-                        gi_probe->probe_instance;
+                if (ins->base_type == VS::INSTANCE_PARTICLES) {
+                    // particles visible? process them
+                    if (VSG::storage->particles_is_inactive(ins->base)) {
+                        // but if nothing is going on, don't do it.
+                        keep = false;
+                    } else {
+                        VSG::storage->particles_request_process(ins->base);
+                        // particles visible? request redraw
+                        VisualServerRaster::redraw_request();
+                    }
                 }
-
-                geom->gi_probes_dirty = false;
-            }
+            } break;
         }
 
-        if (!keep) {
+        if (keep) {
+            instance_cull_result.copy(i, kept_count++);
+            ins->last_render_pass = render_pass;
+        } else {
             // remove, no reason to keep
-            instance_cull_count--;
-            SWAP(
-                instance_cull_result[i],
-                instance_cull_result[instance_cull_count]
-            );
-            i--;
             ins->last_render_pass = 0; // make invalid
-        } else {
-            ins->last_render_pass = render_pass;
         }
     }
+    instance_cull_result.count = kept_count;
+    int light_cull_count       = light_cull_result.size();
 
     /* STEP 5 - PROCESS LIGHTS */
 
-    RID* directional_light_ptr = &light_instance_cull_result[light_cull_count];
-    directional_light_count    = 0;
-
     // directional lights
     {
         Instance** lights_with_shadow = (Instance**)alloca(
@@ -3807,11 +3933,6 @@ void VisualServerScene::_prepare_scene(
         for (List<Instance*>::Element* E = scenario->directional_lights.front();
              E;
              E = E->next()) {
-            if (light_cull_count + directional_light_count
-                >= MAX_LIGHTS_CULLED) {
-                break;
-            }
-
             if (!E->get()->visible) {
                 continue;
             }
@@ -3827,8 +3948,7 @@ void VisualServerScene::_prepare_scene(
                     lights_with_shadow[directional_shadow_count++] = E->get();
                 }
                 // add to list
-                directional_light_ptr[directional_light_count++] =
-                    light->instance;
+                light_instance_cull_result.push_back(light->instance);
             }
         }
 
@@ -3849,121 +3969,26 @@ void VisualServerScene::_prepare_scene(
 
     { // setup shadow maps
 
-        // SortArray<Instance*,_InstanceLightsort> sorter;
-        // sorter.sort(light_cull_result,light_cull_count);
-        for (int i = 0; i < light_cull_count; i++) {
-            Instance* ins = light_cull_result[i];
+        // The coverage of the shadowed lights is computed in parallel, but the
+        // shadow atlas is updated and the shadows are culled in light order.
+        light_cull_coverage.resize(light_cull_count);
+        work_pool.do_work(
+            light_cull_count,
+            this,
+            &VisualServerScene::_light_coverage_thread,
+            &data
+        );
 
-            if (!p_shadow_atlas.is_valid()
-                || !VSG::storage->light_has_shadow(ins->base)) {
+        for (int i = 0; i < light_cull_count; i++) {
+            if (light_cull_coverage[i] < 0) {
+                // No shadow.
                 continue;
             }
 
+            Instance* ins = light_cull_result[i];
             InstanceLightData* light =
                 static_cast<InstanceLightData*>(ins->base_data);
 
-            float coverage = 0.f;
-
-            { // compute coverage
-
-                Transform cam_xf = p_cam_transform;
-                float zn         = p_cam_projection.get_z_near();
-                Plane p(
-                    cam_xf.origin + cam_xf.basis.get_axis(2) * -zn,
-                    -cam_xf.basis.get_axis(2)
-                ); // camera near plane
-
-                // near plane half width and height
-                Vector2 vp_half_extents =
-                    p_cam_projection.get_viewport_half_extents();
-
-                switch (VSG::storage->light_get_type(ins->base)) {
-                    case VS::LIGHT_OMNI: {
-                        float radius = VSG::storage->light_get_param(
-                            ins->base,
-                            VS::LIGHT_PARAM_RANGE
-                        );
-
-                        // get two points parallel to near plane
-                        Vector3 points[2] = {
-                            ins->transform.origin,
-                            ins->transform.origin
-                                + cam_xf.basis.get_axis(0) * radius
-                        };
-
-                        if (!p_cam_orthogonal) {
-                            // if using perspetive, map them to near plane
-                            for (int j = 0; j < 2; j++) {
-                                if (p.distance_to(points[j]) < 0) {
-                                    points[j].z =
-                                        -zn; // small hack to keep size constant
-                                             // when hitting the screen
-                                }
-
-                                p.intersects_segment(
-                                    cam_xf.origin,
-                                    points[j],
-                                    &points[j]
-                                ); // map to plane
-                            }
-                        }
-
-                        float screen_diameter =
-                            points[0].distance_to(points[1]) * 2;
-                        coverage = screen_diameter
-                                 / (vp_half_extents.x + vp_half_extents.y);
-                    } break;
-                    case VS::LIGHT_SPOT: {
-                        float radius = VSG::storage->light_get_param(
-                            ins->base,
-                            VS::LIGHT_PARAM_RANGE
-                        );
-                        float angle = VSG::storage->light_get_param(
-                            ins->base,
-                            VS::LIGHT_PARAM_SPOT_ANGLE
-                        );
-
-                        float w = radius * Math::sin(Math::deg2rad(angle));
-                        float d = radius * Math::cos(Math::deg2rad(angle));
-
-                        Vector3 base =
-                            ins->transform.origin
-                            - ins->transform.basis.get_axis(2).normalized() * d;
-
-                        Vector3 points[2] = {
-                            base,
-                            base + cam_xf.basis.get_axis(0) * w
-                        };
-
-                        if (!p_cam_orthogonal) {
-                            // if using perspetive, map them to near plane
-                            for (int j = 0; j < 2; j++) {
-                                if (p.distance_to(points[j]) < 0) {
-                                    points[j].z =
-                                        -zn; // small hack to keep size constant
-                                             // when hitting the screen
-                                }
-
-                                p.intersects_segment(
-                                    cam_xf.origin,
-                                    points[j],
-                                    &points[j]
-                                ); // map to plane
-                            }
-                        }
-
-                        float screen_diameter =
-                            points[0].distance_to(points[1]) * 2;
-                        coverage = screen_diameter
-                                 / (vp_half_extents.x + vp_half_extents.y);
-
-                    } break;
-                    default: {
-                        ERR_PRINT("Invalid Light Type");
-                    }
-                }
-            }
-
             if (light->shadow_dirty) {
                 light->last_version++;
                 light->shadow_dirty = false;
@@ -3972,7 +3997,7 @@ void VisualServerScene::_prepare_scene(
             bool redraw = VSG::scene_render->shadow_atlas_update_light(
                 p_shadow_atlas,
                 light->instance,
-                coverage,
+                light_cull_coverage[i],
                 light->last_version
             );
 
@@ -3992,16 +4017,225 @@ void VisualServerScene::_prepare_scene(
 
     // Calculate instance->depth from the camera, after shadow calculation has
     // stopped overwriting instance->depth
-    for (int i = 0; i < instance_cull_count; i++) {
-        Instance* ins = instance_cull_result[i];
-
-        if (((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK) && ins->visible
-            && ins->cast_shadows != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
-            Vector3 aabb_center = ins->transformed_aabb.position
-                                + (ins->transformed_aabb.size * 0.5);
-            ins->depth       = near_plane.distance_to(aabb_center);
-            ins->depth_layer = CLAMP(int(ins->depth * 16 / z_far), 0, 15);
+    work_pool.do_work(
+        _get_prepare_chunk_count(instance_cull_result.count),
+        this,
+        &VisualServerScene::_instance_depth_thread,
+        &data
+    );
+}
+
+void VisualServerScene::_update_instance_geometry_pairs(Instance* p_instance) {
+    InstanceGeometryData* geom =
+        static_cast<InstanceGeometryData*>(p_instance->base_data);
+
+    if (geom->lighting_dirty) {
+        int l = 0;
+        // only called when lights AABB enter/exit this geometry
+        p_instance->light_instances.resize(geom->lighting.size());
+
+        for (List<Instance*>::Element* E = geom->lighting.front(); E;
+             E                           = E->next()) {
+            InstanceLightData* light =
+                static_cast<InstanceLightData*>(E->get()->base_data);
+
+            p_instance->light_instances.write[l++] = light->instance;
         }
+
+        geom->lighting_dirty = false;
+    }
+
+    if (geom->reflection_dirty) {
+        int l = 0;
+        // only called when reflection probe AABB enter/exit this geometry
+        p_instance->reflection_probe_instances.resize(
+            geom->reflection_probes.size()
+        );
+
+        for (List<Instance*>::Element* E = geom->reflection_probes.front(); E;
+             E                           = E->next()) {
+            InstanceReflectionProbeData* reflection_probe =
+                static_cast<InstanceReflectionProbeData*>(E->get()->base_data);
+
+            p_instance->reflection_probe_instances.write[l++] =
+                reflection_probe->instance;
+        }
+
+        geom->reflection_dirty = false;
+    }
+
+    if (geom->gi_probes_dirty) {
+        int l = 0;
+        // only called when reflection probe AABB enter/exit this geometry
+        p_instance->gi_probe_instances.resize(geom->gi_probes.size());
+
+        for (List<Instance*>::Element* E = geom->gi_probes.front(); E;
+             E                           = E->next()) {
+            InstanceGIProbeData* gi_probe =
+                static_cast<InstanceGIProbeData*>(E->get()->base_data);
+
+            p_instance->gi_probe_instances.write[l++] =
+                gi_probe->probe_instance;
+        }
+
+        geom->gi_probes_dirty = false;
+    }
+}
+
+void VisualServerScene::_prepare_instances_thread(
+    uint32_t p_chunk,
+    const PrepareSceneData* p_data
+) {
+    int begin = p_chunk * PREPARE_CHUNK_SIZE;
+    int end   = MIN(begin + PREPARE_CHUNK_SIZE, instance_cull_result.count);
+    for (int i = begin; i < end; i++) {
+        uint8_t flags     = instance_cull_result.flags[i];
+        uint8_t base_type = instance_cull_result.base_types[i];
+
+        InstancePrepareType type = INSTANCE_PREPARE_DISCARD;
+        if ((p_data->camera_layer_mask & instance_cull_result.layer_masks[i])
+                == 0
+            || !(flags & InstanceCullResult::FLAG_VISIBLE)) {
+            // failure
+        } else if (base_type == VS::INSTANCE_LIGHT) {
+            type = INSTANCE_PREPARE_LIGHT;
+        } else if (base_type == VS::INSTANCE_REFLECTION_PROBE) {
+            type = INSTANCE_PREPARE_REFLECTION_PROBE;
+        } else if (base_type == VS::INSTANCE_GI_PROBE) {
+            type = INSTANCE_PREPARE_GI_PROBE;
+        } else if (((1 << base_type) & VS::INSTANCE_GEOMETRY_MASK)
+                   && !(flags & InstanceCullResult::FLAG_SHADOWS_ONLY)) {
+            type = INSTANCE_PREPARE_GEOMETRY;
+            _update_instance_geometry_pairs(instance_cull_result.instances[i]);
+        }
+
+        instance_prepare_type[i] = type;
+    }
+}
+
+void VisualServerScene::_light_coverage_thread(
+    uint32_t p_light,
+    const PrepareSceneData* p_data
+) {
+    Instance* ins = light_cull_result[p_light];
+    if (!p_data->shadow_atlas.is_valid()
+        || !VSG::storage->light_has_shadow(ins->base)) {
+        light_cull_coverage[p_light] = -1;
+        return;
+    }
+
+    light_cull_coverage[p_light] = _get_light_coverage(ins, *p_data);
+}
+
+float VisualServerScene::_get_light_coverage(
+    Instance* p_light,
+    const PrepareSceneData& p_data
+) {
+    float coverage = 0.f;
+
+    Transform cam_xf = p_data.cam_transform;
+    float zn         = p_data.cam_projection.get_z_near();
+    Plane p(
+        cam_xf.origin + cam_xf.basis.get_axis(2) * -zn,
+        -cam_xf.basis.get_axis(2)
+    ); // camera near plane
+
+    // near plane half width and height
+    Vector2 vp_half_extents = p_data.cam_projection.get_viewport_half_extents();
+
+    switch (VSG::storage->light_get_type(p_light->base)) {
+        case VS::LIGHT_OMNI: {
+            float radius = VSG::storage->light_get_param(
+                p_light->base,
+                VS::LIGHT_PARAM_RANGE
+            );
+
+            // get two points parallel to near plane
+            Vector3 points[2] = {
+                p_light->transform.origin,
+                p_light->transform.origin + cam_xf.basis.get_axis(0) * radius
+            };
+
+            if (!p_data.cam_orthogonal) {
+                // if using perspetive, map them to near plane
+                for (int j = 0; j < 2; j++) {
+                    if (p.distance_to(points[j]) < 0) {
+                        points[j].z = -zn; // small hack to keep size constant
+                                           // when hitting the screen
+                    }
+
+                    p.intersects_segment(cam_xf.origin, points[j], &points[j]
+                    ); // map to plane
+                }
+            }
+
+            float screen_diameter = points[0].distance_to(points[1]) * 2;
+            coverage =
+                screen_diameter / (vp_half_extents.x + vp_half_extents.y);
+        } break;
+        case VS::LIGHT_SPOT: {
+            float radius = VSG::storage->light_get_param(
+                p_light->base,
+                VS::LIGHT_PARAM_RANGE
+            );
+            float angle = VSG::storage->light_get_param(
+                p_light->base,
+                VS::LIGHT_PARAM_SPOT_ANGLE
+            );
+
+            float w = radius * Math::sin(Math::deg2rad(angle));
+            float d = radius * Math::cos(Math::deg2rad(angle));
+
+            Vector3 base =
+                p_light->transform.origin
+                - p_light->transform.basis.get_axis(2).normalized() * d;
+
+            Vector3 points[2] = {base, base + cam_xf.basis.get_axis(0) * w};
+
+            if (!p_data.cam_orthogonal) {
+                // if using perspetive, map them to near plane
+                for (int j = 0; j < 2; j++) {
+                    if (p.distance_to(points[j]) < 0) {
+                        points[j].z = -zn; // small hack to keep size constant
+                                           // when hitting the screen
+                    }
+
+                    p.intersects_segment(cam_xf.origin, points[j], &points[j]
+                    ); // map to plane
+                }
+            }
+
+            float screen_diameter = points[0].distance_to(points[1]) * 2;
+            coverage =
+                screen_diameter / (vp_half_extents.x + vp_half_extents.y);
+
+        } break;
+        default: {
+            ERR_PRINT("Invalid Light Type");
+        }
+    }
+
+    return coverage;
+}
+
+void VisualServerScene::_instance_depth_thread(
+    uint32_t p_chunk,
+    const PrepareSceneData* p_data
+) {
+    int begin = p_chunk * PREPARE_CHUNK_SIZE;
+    int end   = MIN(begin + PREPARE_CHUNK_SIZE, instance_cull_result.count);
+    for (int i = begin; i < end; i++) {
+        // Only geometry is kept.
+        const AABB& aabb    = instance_cull_result.aabbs[i];
+        Vector3 aabb_center = aabb.position + (aabb.size * 0.5);
+        float depth         = p_data->near_plane.distance_to(aabb_center);
+
+        instance_cull_result.depths[i] = depth;
+
+        // The rasterizer sorts the instances by their own depth.
+        Instance* ins    = instance_cull_result.instances[i];
+        ins->depth       = depth;
+        ins->depth_layer = CLAMP(int(depth * 16 / p_data->z_far), 0, 15);
     }
 }
 
@@ -4037,12 +4271,12 @@ void VisualServerScene::_render_scene(
         p_cam_projection,
         p_eye,
         p_cam_orthogonal,
-        (RasterizerScene::InstanceBase**)instance_cull_result,
-        instance_cull_count,
-        light_instance_cull_result,
-        light_cull_count + directional_light_count,
-        reflection_probe_instance_cull_result,
-        reflection_probe_cull_count,
+        (RasterizerScene::InstanceBase**)instance_cull_result.instances.ptr(),
+        instance_cull_result.count,
+        light_instance_cull_result.ptr(),
+        light_instance_cull_result.size(),
+        reflection_probe_instance_cull_result.ptr(),
+        reflection_probe_instance_cull_result.size(),
         environment,
         p_shadow_atlas,
         scenario->reflection_atlas,
@@ -5461,6 +5695,13 @@ void VisualServerScene::render_probes() {
     }
 }
 
+void VisualServerScene::end_frame() {
+    occluded_objects_in_frame = occluded_objects;
+    occluded_objects          = 0;
+    cull_overflows_in_frame   = cull_overflows;
+    cull_overflows            = 0;
+}
+
 void VisualServerScene::_update_dirty_instance(Instance* p_instance) {
     if (p_instance->update_aabb) {
         _update_instance_aabb(p_instance);
@@ -5665,6 +5906,7 @@ void VisualServerScene::update_dirty_instances() {
     while (_instance_update_list.first()) {
         _update_dirty_instance(_instance_update_list.first()->self());
     }
+    _update_moved_instances();
 
     if (scenario) {
         scenario->sps->update();
@@ -5707,6 +5949,7 @@ bool VisualServerScene::free(RID p_rid) {
 
         update_dirty_instances(); // in case something changed this
 
+        _remove_instance_from_move_list(instance);
         instance_owner.free(p_rid);
         memdelete(instance);
     } else if (room_owner.owns(p_rid)) {
@@ -5760,10 +6003,20 @@ VisualServerScene::VisualServerScene() {
         )
     );
 
+    int thread_count = ThreadWorkPool::define_thread_count_setting(
+        "rendering/threads/scene_preparation_thread_count"
+    );
+    work_pool.init(thread_count);
+
+    instance_cull_result.resize(INSTANCE_CULL_INITIAL_SIZE);
+    instance_shadow_cull_result.resize(INSTANCE_CULL_INITIAL_SIZE);
+
     _visual_server_callbacks = nullptr;
 }
 
 VisualServerScene::~VisualServerScene() {
+    work_pool.finish();
+
     probe_bake_thread_exit = true;
     probe_bake_sem.post();
     probe_bake_thread.wait_to_finish();
@@ -9,9 +9,11 @@
 
 #include "core/math/bvh.h"
 #include "core/math/geometry.h"
+#include "core/local_vector.h"
 #include "core/math/octree.h"
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
+#include "core/os/thread_work_pool.h"
 #include "core/safe_refcount.h"
 #include "core/self_list.h"
 #include "portals/portal_renderer.h"
@@ -21,11 +23,9 @@
 class VisualServerScene {
 public:
     enum {
-        MAX_INSTANCE_CULL            = 65536,
-        MAX_LIGHTS_CULLED            = 4096,
-        MAX_REFLECTION_PROBES_CULLED = 4096,
-        MAX_ROOM_CULL                = 32,
-        MAX_EXTERIOR_PORTALS         = 128,
+        INSTANCE_CULL_INITIAL_SIZE = 1024,
+        MAX_ROOM_CULL              = 32,
+        MAX_EXTERIOR_PORTALS       = 128,
     };
 
     uint64_t render_pass;
@@ -120,6 +120,8 @@ public:
         )                                                                  = 0;
         virtual void erase(SpatialPartitionID p_handle)                    = 0;
         virtual void move(SpatialPartitionID p_handle, const AABB& p_aabb) = 0;
+        // Moves every instance to its transformed AABB.
+        virtual void move_batch(Instance* const* p_instances, int p_count);
 
         virtual void activate(SpatialPartitionID p_handle, const AABB& p_aabb) {
         }
@@ -254,6 +256,7 @@ public:
         );
         void erase(SpatialPartitionID p_handle);
         void move(SpatialPartitionID p_handle, const AABB& p_aabb);
+        void move_batch(Instance* const* p_instances, int p_count);
         void activate(SpatialPartitionID p_handle, const AABB& p_aabb);
         void deactivate(SpatialPartitionID p_handle);
         void force_collision_check(SpatialPartitionID p_handle);
@@ -373,6 +376,7 @@ public:
         // aabb stuff
         bool update_aabb;
         bool update_materials;
+        bool in_move_list;
 
         SelfList<Instance> update_item{this};
 
@@ -411,6 +415,7 @@ public:
 
             update_aabb      = false;
             update_materials = false;
+            in_move_list     = false;
 
             extra_margin = 0;
 
@@ -445,6 +450,10 @@ public:
     };
 
     SelfList<Instance>::List _instance_update_list;
+    // The updated instances that are already in a spatial partitioning. Their
+    // transformed AABBs are computed on the work pool, and they are moved
+    // together, once the update list is empty.
+    LocalVector<Instance*> instance_move_list;
     void _instance_queue_update(
         Instance* p_instance,
         bool p_update_aabb,
@@ -642,17 +651,50 @@ public:
         InstanceLightmapCaptureData() {}
     };
 
-    int instance_cull_count;
-    Instance* instance_cull_result[MAX_INSTANCE_CULL];
-    Instance*
-        instance_shadow_cull_result[MAX_INSTANCE_CULL]; // used for generating
-                                                        // shadowmaps
-    Instance* light_cull_result[MAX_LIGHTS_CULLED];
-    RID light_instance_cull_result[MAX_LIGHTS_CULLED];
-    int light_cull_count;
-    int directional_light_count;
-    RID reflection_probe_instance_cull_result[MAX_REFLECTION_PROBES_CULLED];
-    int reflection_probe_cull_count;
+    // The instances found by a cull, stored next to a copy of the instance
+    // data the results are filtered and sorted by, so the passes over the
+    // results don't need to read every instance. The buffers grow whenever a
+    // cull fills them, and keep their size between frames.
+    struct InstanceCullResult {
+        enum Flags {
+            FLAG_VISIBLE      = 1 << 0,
+            // A geometry instance that can cast shadows.
+            FLAG_CASTS_SHADOW = 1 << 1,
+            FLAG_SHADOWS_ONLY = 1 << 2,
+        };
+
+        int count = 0;
+        LocalVector<Instance*> instances;
+        LocalVector<AABB> aabbs;
+        LocalVector<uint32_t> layer_masks;
+        LocalVector<uint8_t> base_types;
+        LocalVector<uint8_t> flags;
+        // The distance to the camera the geometry is sorted by.
+        LocalVector<float> depths;
+
+        _FORCE_INLINE_ int get_capacity() const {
+            return instances.size();
+        }
+
+        _FORCE_INLINE_ bool is_shadow_caster(int p_index) const {
+            const uint8_t caster = FLAG_VISIBLE | FLAG_CASTS_SHADOW;
+            return (flags[p_index] & caster) == caster;
+        }
+
+        void resize(int p_capacity);
+        // Copies the data of the first p_count instances.
+        void gather(int p_count);
+        void copy(int p_from, int p_to);
+        void swap(int p_a, int p_b);
+    };
+
+    InstanceCullResult instance_cull_result;
+    // Used for generating shadow maps.
+    InstanceCullResult instance_shadow_cull_result;
+    LocalVector<Instance*> light_cull_result;
+    // The culled omni and spot lights, followed by the directional lights.
+    LocalVector<RID> light_instance_cull_result;
+    LocalVector<RID> reflection_probe_instance_cull_result;
 
     RID_Owner<Instance> instance_owner;
 
@@ -665,6 +707,10 @@ public:
         RID p_instance,
         const Transform& p_transform
     );
+    virtual void instances_set_transforms(
+        const Vector<RID>& p_instances,
+        const Vector<Transform>& p_transforms
+    );
     virtual void instance_attach_object_instance_id(
         RID p_instance,
         ObjectID p_id
@@ -856,6 +902,11 @@ public:
         RID p_occluder,
         const Vector<Plane>& p_spheres
     );
+    virtual void occluder_mesh_update(
+        RID p_occluder,
+        const PoolVector<Vector3>& p_vertices,
+        const PoolVector<int>& p_indices
+    );
     virtual void occluder_set_transform(
         RID p_occluder,
         const Transform& p_xform
@@ -960,15 +1011,22 @@ public:
         RID p_scenario = RID()
     ) const;
 
+    // Culls into r_result, growing it until every instance fits.
+    int _cull_convex(
+        Scenario* p_scenario,
+        const Vector<Plane>& p_convex,
+        InstanceCullResult& r_result,
+        uint32_t p_mask
+    );
     // internal (uses portals when available)
     int _cull_convex_from_point(
         Scenario* p_scenario,
         const Vector3& p_point,
         const Vector<Plane>& p_convex,
-        Instance** p_result_array,
-        int p_result_max,
+        InstanceCullResult& r_result,
         int32_t& r_previous_room_id_hint,
-        uint32_t p_mask = 0xFFFFFFFF
+        uint32_t p_mask                   = 0xFFFFFFFF,
+        const Occlusion::Camera* p_camera = nullptr
     );
     void _rooms_instance_update(Instance* p_instance, const AABB& p_aabb);
 
@@ -999,6 +1057,11 @@ public:
     );
 
     _FORCE_INLINE_ void _update_instance(Instance* p_instance);
+    _FORCE_INLINE_ void _update_instance_transformed_aabb(Instance* p_instance
+    );
+    void _remove_instance_from_move_list(Instance* p_instance);
+    void _update_moved_instances_thread(uint32_t p_chunk, void* p_userdata);
+    void _update_moved_instances();
     _FORCE_INLINE_ void _update_instance_aabb(Instance* p_instance);
     _FORCE_INLINE_ void _update_dirty_instance(Instance* p_instance);
     _FORCE_INLINE_ void _update_instance_lightmap_captures(Instance* p_instance
@@ -1013,6 +1076,61 @@ public:
         Scenario* p_scenario
     );
 
+    // Scene preparation filters the culled instances, computes the coverage of
+    // the shadowed lights and computes the depth of the instances on the work
+    // pool. Every job only writes to its own instances and its own entries of
+    // the result arrays, and the results are gathered in cull order, so the
+    // output is the same for any number of threads. The culling itself, and
+    // everything that modifies shared state, stays on the calling thread.
+    enum {
+        PREPARE_CHUNK_SIZE = 256,
+    };
+
+    enum InstancePrepareType {
+        INSTANCE_PREPARE_DISCARD,
+        INSTANCE_PREPARE_LIGHT,
+        INSTANCE_PREPARE_REFLECTION_PROBE,
+        INSTANCE_PREPARE_GI_PROBE,
+        INSTANCE_PREPARE_GEOMETRY,
+    };
+
+    struct PrepareSceneData {
+        Transform cam_transform;
+        CameraMatrix cam_projection;
+        bool cam_orthogonal;
+        uint32_t camera_layer_mask;
+        RID shadow_atlas;
+        Plane near_plane;
+        float z_far;
+    };
+
+    ThreadWorkPool work_pool;
+    LocalVector<uint8_t> instance_prepare_type;
+    // The coverage of every culled light, or -1 if it has no shadow.
+    LocalVector<float> light_cull_coverage;
+
+    _FORCE_INLINE_ static uint32_t _get_prepare_chunk_count(int p_count) {
+        return (p_count + PREPARE_CHUNK_SIZE - 1) / PREPARE_CHUNK_SIZE;
+    }
+
+    void _update_instance_geometry_pairs(Instance* p_instance);
+    void _prepare_instances_thread(
+        uint32_t p_chunk,
+        const PrepareSceneData* p_data
+    );
+    void _light_coverage_thread(
+        uint32_t p_light,
+        const PrepareSceneData* p_data
+    );
+    float _get_light_coverage(
+        Instance* p_light,
+        const PrepareSceneData& p_data
+    );
+    void _instance_depth_thread(
+        uint32_t p_chunk,
+        const PrepareSceneData* p_data
+    );
+
     void _prepare_scene(
         const Transform p_cam_transform,
         const CameraMatrix& p_cam_projection,
@@ -1130,10 +1248,26 @@ public:
 
     void render_probes();
 
+    // Keeps the number of instances occlusion culled, and the number of culls
+    // that overflowed their result buffers, in the frame.
+    void end_frame();
+
+    uint64_t get_occluded_objects_in_frame() const {
+        return occluded_objects_in_frame;
+    }
+
+    uint64_t get_cull_overflows_in_frame() const {
+        return cull_overflows_in_frame;
+    }
+
     bool free(RID p_rid);
 
 private:
     bool _use_bvh;
+    uint64_t occluded_objects          = 0;
+    uint64_t occluded_objects_in_frame = 0;
+    uint64_t cull_overflows            = 0;
+    uint64_t cull_overflows_in_frame   = 0;
     VisualServerCallbacks* _visual_server_callbacks;
 
 public:
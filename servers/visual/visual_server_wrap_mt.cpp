@@ -139,7 +139,7 @@ VisualServerWrapMT::VisualServerWrapMT(
     VisualServer* p_contained,
     bool p_create_thread
 ) :
-    command_queue(p_create_thread) {
+    command_queue(p_create_thread, true) {
     singleton_mt = this;
     OS::switch_vsync_function =
         set_use_vsync_callback; // as this goes to another thread, make sure it
@@ -240,6 +240,7 @@ public:
     FUNC1RC(int, skeleton_get_bone_count, RID)
     FUNC3(skeleton_bone_set_transform, RID, int, const Transform&)
     FUNC2RC(Transform, skeleton_bone_get_transform, RID, int)
+    FUNC2(skeleton_set_as_bulk_array, RID, const PoolVector<float>&)
     FUNC3(skeleton_bone_set_transform_2d, RID, int, const Transform2D&)
     FUNC2RC(Transform2D, skeleton_bone_get_transform_2d, RID, int)
     FUNC2(skeleton_set_base_transform_2d, RID, const Transform2D&)
@@ -551,6 +552,7 @@ public:
     FUNC2(instance_set_scenario, RID, RID)
     FUNC2(instance_set_layer_mask, RID, uint32_t)
     FUNC2(instance_set_transform, RID, const Transform&)
+    FUNC2(instances_set_transforms, const Vector<RID>&, const Vector<Transform>&)
     FUNC2(instance_attach_object_instance_id, RID, ObjectID)
     FUNC3(instance_set_blend_shape_weight, RID, int, float)
     FUNC3(instance_set_surface_material, RID, int, RID)
@@ -587,6 +589,12 @@ public:
     FUNCRID(occluder)
     FUNC3(occluder_set_scenario, RID, RID, OccluderType)
     FUNC2(occluder_spheres_update, RID, const Vector<Plane>&)
+    FUNC3(
+        occluder_mesh_update,
+        RID,
+        const PoolVector<Vector3>&,
+        const PoolVector<int>&
+    )
     FUNC2(occluder_set_transform, RID, const Transform&)
     FUNC2(occluder_set_active, RID, bool)
     FUNC1(set_use_occlusion_culling, bool)
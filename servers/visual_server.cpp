@@ -7,6 +7,7 @@
 #include "visual_server.h"
 
 #include "core/method_bind_ext.gen.inc"
+#include "core/os/thread_work_pool.h"
 #include "core/project_settings.h"
 
 VisualServer* VisualServer::singleton        = nullptr;
@@ -113,6 +114,26 @@ Array VisualServer::_instances_cull_convex_bind(
     return to_array(ids);
 }
 
+void VisualServer::_instances_set_transforms_bind(
+    const Array& p_instances,
+    const Array& p_transforms
+) {
+    ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+    Vector<RID> instances;
+    Vector<Transform> transforms;
+    instances.resize(p_instances.size());
+    transforms.resize(p_transforms.size());
+    for (int i = 0; i < p_instances.size(); ++i) {
+        ERR_FAIL_COND(p_instances[i].get_type() != Variant::_RID);
+        ERR_FAIL_COND(p_transforms[i].get_type() != Variant::TRANSFORM);
+        instances.write[i]  = p_instances[i];
+        transforms.write[i] = p_transforms[i];
+    }
+
+    instances_set_transforms(instances, transforms);
+}
+
 RID VisualServer::get_test_texture() {
     if (test_texture.is_valid()) {
         return test_texture;
@@ -2737,6 +2758,10 @@ void VisualServer::_bind_methods() {
         D_METHOD("skeleton_bone_get_transform", "skeleton", "bone"),
         &VisualServer::skeleton_bone_get_transform
     );
+    ClassDB::bind_method(
+        D_METHOD("skeleton_set_as_bulk_array", "skeleton", "array"),
+        &VisualServer::skeleton_set_as_bulk_array
+    );
     ClassDB::bind_method(
         D_METHOD(
             "skeleton_bone_set_transform_2d",
@@ -3588,6 +3613,10 @@ void VisualServer::_bind_methods() {
         D_METHOD("instance_set_transform", "instance", "transform"),
         &VisualServer::instance_set_transform
     );
+    ClassDB::bind_method(
+        D_METHOD("instances_set_transforms", "instances", "transforms"),
+        &VisualServer::_instances_set_transforms_bind
+    );
     ClassDB::bind_method(
         D_METHOD("instance_attach_object_instance_id", "instance", "id"),
         &VisualServer::instance_attach_object_instance_id
@@ -4458,6 +4487,8 @@ void VisualServer::_bind_methods() {
     BIND_ENUM_CONSTANT(INFO_VIDEO_MEM_USED);
     BIND_ENUM_CONSTANT(INFO_TEXTURE_MEM_USED);
     BIND_ENUM_CONSTANT(INFO_VERTEX_MEM_USED);
+    BIND_ENUM_CONSTANT(INFO_OCCLUDED_OBJECTS_IN_FRAME);
+    BIND_ENUM_CONSTANT(INFO_CULL_OVERFLOWS_IN_FRAME);
 
     BIND_ENUM_CONSTANT(FEATURE_SHADERS);
     BIND_ENUM_CONSTANT(FEATURE_MULTITHREADED);
@@ -4848,6 +4879,11 @@ VisualServer::VisualServer() {
     GLOBAL_DEF("rendering/batching/options/use_batching", true);
     GLOBAL_DEF_RST("rendering/batching/options/use_batching_in_editor", true);
     GLOBAL_DEF("rendering/batching/options/single_rect_fallback", false);
+    GLOBAL_DEF("rendering/batching/options/deferred_software_transform", false);
+    GLOBAL_DEF("rendering/batching/options/use_batch_cache", false);
+    ThreadWorkPool::define_thread_count_setting(
+        "rendering/threads/canvas_batching_thread_count"
+    );
     GLOBAL_DEF("rendering/batching/parameters/max_join_item_commands", 16);
     GLOBAL_DEF(
         "rendering/batching/parameters/colored_vertex_format_threshold",
@@ -601,6 +601,10 @@ public:
     ) = 0;
     virtual Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone)
         const = 0;
+    virtual void skeleton_set_as_bulk_array(
+        RID p_skeleton,
+        const PoolVector<float>& p_array
+    ) = 0;
     virtual void skeleton_bone_set_transform_2d(
         RID p_skeleton,
         int p_bone,
@@ -1370,6 +1374,15 @@ public:
         RID p_instance,
         const Transform& p_transform
     ) = 0;
+    // Sets the transform of every instance with a single call.
+    virtual void instances_set_transforms(
+        const Vector<RID>& p_instances,
+        const Vector<Transform>& p_transforms
+    ) = 0;
+    void _instances_set_transforms_bind(
+        const Array& p_instances,
+        const Array& p_transforms
+    );
     virtual void instance_attach_object_instance_id(
         RID p_instance,
         ObjectID p_id
@@ -1457,6 +1470,7 @@ public:
     enum OccluderType {
         OCCLUDER_TYPE_UNDEFINED,
         OCCLUDER_TYPE_SPHERE,
+        OCCLUDER_TYPE_MESH,
         OCCLUDER_TYPE_NUM_TYPES,
     };
 
@@ -1470,6 +1484,11 @@ public:
         RID p_occluder,
         const Vector<Plane>& p_spheres
     ) = 0;
+    virtual void occluder_mesh_update(
+        RID p_occluder,
+        const PoolVector<Vector3>& p_vertices,
+        const PoolVector<int>& p_indices
+    ) = 0;
     virtual void occluder_set_transform(
         RID p_occluder,
         const Transform& p_xform
@@ -1986,6 +2005,8 @@ public:
         INFO_VIDEO_MEM_USED,
         INFO_TEXTURE_MEM_USED,
         INFO_VERTEX_MEM_USED,
+        INFO_OCCLUDED_OBJECTS_IN_FRAME,
+        INFO_CULL_OVERFLOWS_IN_FRAME,
     };
 
     virtual uint64_t get_render_info(RenderInfo p_info) = 0;
@@ -0,0 +1,237 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "test_animation_compression.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/print_string.h"
+#include "scene/resources/animation.h"
+
+namespace TestAnimationCompression {
+
+enum {
+    TRACKS = 100,
+    // 100 seconds at 30 keys per second.
+    KEYS   = 3000,
+    // Sampled at 60 frames per second.
+    FRAMES = 6000,
+};
+
+static Ref<Animation> _make_animation() {
+    Ref<Animation> animation;
+    animation.instance();
+    animation->set_length((KEYS - 1) / 30.0f);
+    for (int t = 0; t < TRACKS; t++) {
+        animation->add_track(Animation::TYPE_TRANSFORM);
+        for (int k = 0; k < KEYS; k++) {
+            float time  = k / 30.0f;
+            float phase = t * 0.37f + time;
+            Vector3 loc(Math::sin(phase), Math::cos(phase * 0.5f), t * 0.1f);
+            Quat rot(Vector3(0, 1, 0).rotated(Vector3(1, 0, 0), t), phase);
+            // Only some of the bones are scaled.
+            Vector3 scale(1, 1, 1);
+            if (t % 4 == 0) {
+                scale *= 1.0f + 0.5f * Math::sin(phase * 2.0f);
+            }
+            animation->transform_track_insert_key(t, time, loc, rot, scale);
+        }
+    }
+    return animation;
+}
+
+// Returns the size of the keys of all the tracks, as they are stored.
+static int _get_stored_size(const Ref<Animation>& p_animation) {
+    int size = 0;
+    for (int t = 0; t < TRACKS; t++) {
+        Variant keys = p_animation->get("tracks/" + itos(t) + "/keys");
+        if (keys.get_type() == Variant::POOL_REAL_ARRAY) {
+            size += PoolVector<float>(keys).size() * sizeof(float);
+        } else {
+            Dictionary data = keys;
+            size += PoolVector<float>(data["pages"]).size() * sizeof(float);
+            size += PoolVector<uint8_t>(data["keys"]).size();
+        }
+    }
+    return size;
+}
+
+// Samples all the tracks, like an AnimationPlayer playing the animation.
+// Returns the usec per frame.
+static float _benchmark(
+    const Ref<Animation>& p_animation,
+    bool p_use_cursors,
+    Vector<Transform>& r_poses
+) {
+    int cursors[TRACKS] = {};
+    r_poses.resize(FRAMES * TRACKS);
+
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int f = 0; f < FRAMES; f++) {
+        float time = f / 60.0f;
+        for (int t = 0; t < TRACKS; t++) {
+            Vector3 loc;
+            Quat rot;
+            Vector3 scale;
+            p_animation->transform_track_interpolate(
+                t,
+                time,
+                &loc,
+                &rot,
+                &scale,
+                p_use_cursors ? &cursors[t] : nullptr
+            );
+            Transform& pose = r_poses.write[f * TRACKS + t];
+            pose.basis.set_quat_scale(rot, scale);
+            pose.origin = loc;
+        }
+    }
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+    return elapsed / (float)FRAMES;
+}
+
+// Returns the largest difference between the poses.
+static float _compare(
+    const Vector<Transform>& p_expected,
+    const Vector<Transform>& p_poses
+) {
+    float error = 0;
+    for (int i = 0; i < p_expected.size(); i++) {
+        const Transform& a = p_expected[i];
+        const Transform& b = p_poses[i];
+        for (int r = 0; r < 3; r++) {
+            error = MAX(error, (a.basis[r] - b.basis[r]).length());
+        }
+        error = MAX(error, (a.origin - b.origin).length());
+    }
+    return error;
+}
+
+// Creates an animation from the stored tracks of p_animation, like a saved
+// animation that is loaded again.
+static Ref<Animation> _reload(const Ref<Animation>& p_animation) {
+    Ref<Animation> animation;
+    animation.instance();
+    animation->set_length(p_animation->get_length());
+    for (int t = 0; t < TRACKS; t++) {
+        String track = "tracks/" + itos(t);
+        animation->add_track(Animation::TYPE_TRANSFORM);
+        animation->set(track + "/keys", p_animation->get(track + "/keys"));
+    }
+    return animation;
+}
+
+static bool _check(bool p_condition, const String& p_fail) {
+    if (!p_condition) {
+        print_line("Fail: " + p_fail);
+    }
+    return p_condition;
+}
+
+MainLoop* test() {
+    print_line("Start animation compression checks.");
+
+    // The largest difference, in the basis or the origin, from sampling the
+    // plain keys.
+    const float max_error = 0.001f;
+
+    Ref<Animation> animation = _make_animation();
+
+    Vector<Transform> expected;
+    Vector<Transform> poses;
+    Vector<Transform> searched;
+    Vector<Transform> reloaded;
+
+    int plain_size = _get_stored_size(animation);
+    _benchmark(animation, false, expected);
+
+    animation->compress();
+    _benchmark(animation, true, poses);
+    _benchmark(animation, false, searched);
+
+    bool success = true;
+    success &= _check(
+        _get_stored_size(animation) < plain_size / 2,
+        "The compressed keys aren't smaller."
+    );
+    success &= _check(
+        animation->track_get_key_count(0) == KEYS,
+        "The compressed track has " + itos(animation->track_get_key_count(0))
+            + " keys."
+    );
+
+    float error = _compare(expected, poses);
+    success &= _check(
+        error <= max_error,
+        "The compressed keys are off by " + rtos(error) + "."
+    );
+    success &= _check(
+        _compare(searched, poses) == 0,
+        "Sampling the compressed keys with cursors doesn't match."
+    );
+
+    // The stored compressed keys are loaded back as they were.
+    Ref<Animation> copy = _reload(animation);
+    _benchmark(copy, true, reloaded);
+    success &= _check(
+        _get_stored_size(copy) == _get_stored_size(animation),
+        "The reloaded keys have a different size."
+    );
+    success &= _check(
+        _compare(poses, reloaded) == 0,
+        "The reloaded keys don't match."
+    );
+
+    // Keys that don't match their count are rejected.
+    Dictionary data = animation->get("tracks/0/keys");
+    data["count"]   = KEYS + 1;
+    print_line("The following errors are expected.");
+    copy->set("tracks/0/keys", data);
+    success &= _check(
+        copy->track_get_key_count(0) == 0,
+        "Keys with the wrong count were loaded."
+    );
+
+    if (success) {
+        print_line("Animation compression checks passed.");
+    } else {
+        print_line("Animation compression checks FAILED.");
+    }
+
+    return nullptr;
+}
+
+MainLoop* test_benchmark() {
+    Ref<Animation> animation = _make_animation();
+
+    Vector<Transform> expected;
+    Vector<Transform> poses;
+
+    int plain_size = _get_stored_size(animation);
+    float plain    = _benchmark(animation, false, expected);
+    float cursors  = _benchmark(animation, true, poses);
+    if (_compare(expected, poses) != 0) {
+        ERR_PRINT("Sampling with cursors doesn't match.");
+    }
+
+    animation->compress();
+    int compressed_size = _get_stored_size(animation);
+    float compressed    = _benchmark(animation, true, poses);
+    float error         = _compare(expected, poses);
+
+    print_line(
+        "Animation compression benchmark: " + itos(TRACKS) + " tracks of "
+        + itos(KEYS) + " keys, plain " + itos(plain_size / 1024)
+        + " KiB, compressed " + itos(compressed_size / 1024)
+        + " KiB, max error " + rtos(error) + "."
+    );
+    print_line(
+        "Sampling: search " + rtos(plain) + " usec/frame, cursors "
+        + rtos(cursors) + " usec/frame, compressed with cursors "
+        + rtos(compressed) + " usec/frame."
+    );
+
+    return nullptr;
+}
+} // namespace TestAnimationCompression
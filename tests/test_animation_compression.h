@@ -0,0 +1,16 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef TEST_ANIMATION_COMPRESSION_H
+#define TEST_ANIMATION_COMPRESSION_H
+
+#include "core/os/main_loop.h"
+
+namespace TestAnimationCompression {
+
+MainLoop* test();
+MainLoop* test_benchmark();
+} // namespace TestAnimationCompression
+
+#endif // TEST_ANIMATION_COMPRESSION_H
@@ -0,0 +1,252 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "test_animation_tree.h"
+
+#include "core/print_string.h"
+#include "core/project_settings.h"
+#include "scene/3d/spatial.h"
+#include "scene/animation/animation_blend_tree.h"
+#include "scene/animation/animation_player.h"
+#include "scene/animation/animation_tree.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
+
+namespace TestAnimationTree {
+
+enum {
+    NODES  = 8,
+    RIGS   = 16,
+    FRAMES = 30,
+};
+
+struct Rig {
+    Spatial* nodes[NODES];
+    AnimationPlayer* player;
+    AnimationTree* tree;
+};
+
+// Moves every node along p_axis, at its own speed, while turning it. Node i
+// is animated by the track of node (i + p_shift) % NODES.
+static Ref<Animation> _make_animation(
+    Vector3::Axis p_axis,
+    float p_speed,
+    int p_shift = 0
+) {
+    Ref<Animation> animation;
+    animation.instance();
+    animation->set_length(2);
+    animation->set_loop(true);
+    for (int i = 0; i < NODES; i++) {
+        int track = animation->add_track(Animation::TYPE_TRANSFORM);
+        animation->track_set_path(track, "n" + itos((i + p_shift) % NODES));
+        for (int k = 0; k <= 8; k++) {
+            float time = k * 0.25f;
+            Vector3 loc;
+            loc[p_axis] = time * p_speed * (i + 1);
+            Quat rot(Vector3(0, 1, 0), time * (i + 1) * 0.3f);
+            animation->transform_track_insert_key(
+                track,
+                time,
+                loc,
+                rot,
+                Vector3(1, 1, 1)
+            );
+        }
+    }
+    return animation;
+}
+
+static Rig _make_rig(Node* p_parent, const Ref<AnimationNode>& p_root) {
+    Rig rig;
+    Spatial* root = memnew(Spatial);
+    p_parent->add_child(root);
+    for (int i = 0; i < NODES; i++) {
+        rig.nodes[i] = memnew(Spatial);
+        rig.nodes[i]->set_name("n" + itos(i));
+        root->add_child(rig.nodes[i]);
+    }
+
+    rig.player = memnew(AnimationPlayer);
+    rig.player->set_name("player");
+    rig.player->add_animation("walk", _make_animation(Vector3::AXIS_X, 1));
+    rig.player->add_animation("run", _make_animation(Vector3::AXIS_Y, 2));
+    root->add_child(rig.player);
+
+    rig.tree = memnew(AnimationTree);
+    rig.tree->set_tree_root(p_root);
+    rig.tree->set_animation_player(NodePath("../player"));
+    root->add_child(rig.tree);
+    rig.tree->set_active(true);
+    return rig;
+}
+
+// Blends walk and run, by a different amount for every rig.
+static Ref<AnimationNode> _make_blend_tree() {
+    Ref<AnimationNodeAnimation> walk;
+    walk.instance();
+    walk->set_animation("walk");
+    Ref<AnimationNodeAnimation> run;
+    run.instance();
+    run->set_animation("run");
+    Ref<AnimationNodeBlend2> blend;
+    blend.instance();
+
+    Ref<AnimationNodeBlendTree> blend_tree;
+    blend_tree.instance();
+    blend_tree->add_node("walk", walk);
+    blend_tree->add_node("run", run);
+    blend_tree->add_node("blend", blend);
+    blend_tree->connect_node("blend", 0, "walk");
+    blend_tree->connect_node("blend", 1, "run");
+    blend_tree->connect_node("output", 0, "blend");
+    return blend_tree;
+}
+
+// Processes the rigs with p_thread_count blend threads, and returns the
+// transforms of their nodes after every frame.
+static Vector<Transform> _process_rigs(int p_thread_count) {
+    AnimationTree::set_blend_thread_count(p_thread_count);
+
+    SceneTree* tree = memnew(SceneTree);
+    tree->init();
+
+    Rig rigs[RIGS];
+    for (int r = 0; r < RIGS; r++) {
+        rigs[r] = _make_rig(tree->get_root(), _make_blend_tree());
+        rigs[r].tree->set(
+            "parameters/blend/blend_amount",
+            r / (float)RIGS
+        );
+    }
+
+    Vector<Transform> transforms;
+    for (int f = 0; f < FRAMES; f++) {
+        tree->idle(1.0 / 60.0);
+        for (int r = 0; r < RIGS; r++) {
+            for (int i = 0; i < NODES; i++) {
+                transforms.push_back(rigs[r].nodes[i]->get_transform());
+            }
+        }
+    }
+
+    tree->finish();
+    memdelete(tree);
+    return transforms;
+}
+
+// The trees blended together on the work pool move their nodes exactly like
+// the trees blended one by one.
+static bool _check_parallel() {
+    Vector<Transform> serial   = _process_rigs(1);
+    Vector<Transform> parallel = _process_rigs(4);
+    AnimationTree::set_blend_thread_count(
+        GLOBAL_GET("rendering/threads/animation_tree_thread_count")
+    );
+
+    if (serial.size() != parallel.size()) {
+        print_line("Fail: The serial and parallel blends differ in size.");
+        return false;
+    }
+    for (int i = 0; i < serial.size(); i++) {
+        if (serial[i] != parallel[i]) {
+            print_line(
+                "Fail: Parallel blend differs at frame "
+                + itos(i / (RIGS * NODES)) + ": " + String(parallel[i])
+                + " instead of " + String(serial[i]) + "."
+            );
+            return false;
+        }
+    }
+    if (serial[serial.size() - 1] == Transform()) {
+        print_line("Fail: The rigs weren't animated.");
+        return false;
+    }
+    return true;
+}
+
+// Checks that the nodes of p_rig are at the pose of p_name at the time of
+// the tree's animation.
+static bool _check_pose(const Rig& p_rig, const StringName& p_name) {
+    Ref<Animation> animation = p_rig.player->get_animation(p_name);
+    float time               = p_rig.tree->get("parameters/time");
+
+    for (int track = 0; track < NODES; track++) {
+        String path = animation->track_get_path(track);
+        int node    = path.substr(1).to_int();
+
+        Vector3 loc;
+        Quat rot;
+        Vector3 scale;
+        animation->transform_track_interpolate(
+            track,
+            time,
+            &loc,
+            &rot,
+            &scale
+        );
+        Vector3 actual = p_rig.nodes[node]->get_translation();
+        if (!actual.is_equal_approx(loc)) {
+            print_line(
+                "Fail: With '" + String(p_name) + "', node " + itos(node)
+                + " is at " + String(actual) + " instead of " + String(loc)
+                + "."
+            );
+            return false;
+        }
+    }
+    return true;
+}
+
+// Animations that are added, renamed or replaced after the tree resolved
+// its tracks are played with the right tracks.
+static bool _check_changed_animations() {
+    SceneTree* tree = memnew(SceneTree);
+    tree->init();
+
+    Ref<AnimationNodeAnimation> root;
+    root.instance();
+    root->set_animation("walk");
+    Rig rig = _make_rig(tree->get_root(), root);
+
+    bool success = true;
+    tree->idle(1.0 / 60.0);
+    success &= _check_pose(rig, "walk");
+
+    rig.player->add_animation("jump", _make_animation(Vector3::AXIS_Z, 1));
+    root->set_animation("jump");
+    tree->idle(1.0 / 60.0);
+    success &= _check_pose(rig, "jump");
+
+    rig.player->rename_animation("jump", "hop");
+    root->set_animation("hop");
+    tree->idle(1.0 / 60.0);
+    success &= _check_pose(rig, "hop");
+
+    // Same track count, but every track animates another node.
+    rig.player->add_animation("hop", _make_animation(Vector3::AXIS_Z, 3, 1));
+    tree->idle(1.0 / 60.0);
+    success &= _check_pose(rig, "hop");
+
+    tree->finish();
+    memdelete(tree);
+    return success;
+}
+
+MainLoop* test() {
+    print_line("Start animation tree checks.");
+
+    bool success = true;
+    success &= _check_parallel();
+    success &= _check_changed_animations();
+
+    if (success) {
+        print_line("Animation tree checks passed.");
+    } else {
+        print_line("Animation tree checks FAILED.");
+    }
+
+    return nullptr;
+}
+} // namespace TestAnimationTree
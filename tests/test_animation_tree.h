@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef TEST_ANIMATION_TREE_H
+#define TEST_ANIMATION_TREE_H
+
+#include "core/os/main_loop.h"
+
+namespace TestAnimationTree {
+
+MainLoop* test();
+} // namespace TestAnimationTree
+
+#endif // TEST_ANIMATION_TREE_H
@@ -0,0 +1,356 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "test_audio_kernels.h"
+
+#include "core/local_vector.h"
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/print_string.h"
+#include "servers/audio/audio_driver_dummy.h"
+#include "servers/audio/audio_mix_kernels.h"
+#include "servers/audio/audio_stream.h"
+#include "servers/audio_server.h"
+
+namespace TestAudioKernels {
+
+enum {
+    FRAMES       = 1024,
+    RUNS         = 2000,
+    VOICES       = 64,
+    BLOCKS       = 100,
+    BLOCK_FRAMES = 1024,
+    WAVE_SIZE    = 4096,
+    FP_BITS      = 16,
+    FP_LEN       = 1 << FP_BITS,
+    FP_MASK      = FP_LEN - 1,
+};
+
+struct Buffers {
+    LocalVector<AudioFrame> src;
+    LocalVector<AudioFrame> dst;
+    LocalVector<AudioFrame> expected;
+    LocalVector<int32_t> samples;
+    LocalVector<int32_t> expected_samples;
+};
+
+static void _fill(LocalVector<AudioFrame>& r_frames, int p_frames, int p_seed) {
+    r_frames.resize(p_frames);
+    for (int i = 0; i < p_frames; i++) {
+        float phase = (i + p_seed) * 0.01f;
+        // Goes slightly over [-1, 1], so the conversion clamps.
+        r_frames[i] =
+            AudioFrame(1.2f * Math::sin(phase), 1.2f * Math::cos(phase));
+    }
+}
+
+// The ramps are evaluated per frame instead of accumulated, so the results
+// are only compared up to a relative tolerance.
+static bool _is_close(float p_expected, float p_value) {
+    float tolerance = 0.0001f * MAX(1.0f, ABS(p_expected));
+    return ABS(p_expected - p_value) <= tolerance;
+}
+
+static void _compare(const String& p_kernel, const Buffers& p_buffers) {
+    for (uint32_t i = 0; i < p_buffers.expected.size(); i++) {
+        const AudioFrame& a = p_buffers.expected[i];
+        const AudioFrame& b = p_buffers.dst[i];
+        if (!_is_close(a.l, b.l) || !_is_close(a.r, b.r)) {
+            ERR_PRINT(p_kernel + " frame " + itos(i) + " doesn't match.");
+            return;
+        }
+    }
+    for (uint32_t i = 0; i < p_buffers.expected_samples.size(); i++) {
+        if (p_buffers.expected_samples[i] != p_buffers.samples[i]) {
+            ERR_PRINT(p_kernel + " sample " + itos(i) + " doesn't match.");
+            return;
+        }
+    }
+}
+
+// The reference loops are the ones the kernels replaced. Every benchmark
+// returns the usec per run.
+
+static float _benchmark_mix(Buffers& r_buffers, bool p_kernel) {
+    AudioFrame* dst       = r_buffers.dst.ptr();
+    const AudioFrame* src = r_buffers.src.ptr();
+
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int run = 0; run < RUNS; run++) {
+        if (p_kernel) {
+            AudioMixKernels::mix(dst, src, FRAMES);
+            continue;
+        }
+        for (int i = 0; i < FRAMES; i++) {
+            dst[i] += src[i];
+        }
+    }
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+    return float(elapsed) / RUNS;
+}
+
+static float _benchmark_mix_ramp(Buffers& r_buffers, bool p_kernel) {
+    AudioFrame* dst       = r_buffers.dst.ptr();
+    const AudioFrame* src = r_buffers.src.ptr();
+    AudioFrame volume(0.9f, 0.1f);
+    AudioFrame volume_step = (AudioFrame(0.1f, 0.9f) - volume) / FRAMES;
+
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int run = 0; run < RUNS; run++) {
+        if (p_kernel) {
+            AudioMixKernels::mix_ramp(dst, src, FRAMES, volume, volume_step);
+            continue;
+        }
+        AudioFrame vol = volume;
+        for (int i = 0; i < FRAMES; i++) {
+            dst[i] += src[i] * vol;
+            vol    += volume_step;
+        }
+    }
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+    return float(elapsed) / RUNS;
+}
+
+static float _benchmark_apply_volume(Buffers& r_buffers, bool p_kernel) {
+    AudioFrame* dst = r_buffers.dst.ptr();
+    AudioFrame peak;
+
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int run = 0; run < RUNS; run++) {
+        // Alternates the volume, so the buffer doesn't decay.
+        float volume = run & 1 ? 2.0f : 0.5f;
+        if (p_kernel) {
+            peak = AudioMixKernels::apply_volume(dst, FRAMES, volume);
+            continue;
+        }
+        peak = AudioFrame(0, 0);
+        for (int i = 0; i < FRAMES; i++) {
+            dst[i] *= volume;
+            peak.l  = MAX(peak.l, ABS(dst[i].l));
+            peak.r  = MAX(peak.r, ABS(dst[i].r));
+        }
+    }
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+    // Appends the last peak, so it is compared too.
+    r_buffers.dst.push_back(peak);
+    return float(elapsed) / RUNS;
+}
+
+static float _benchmark_convert(Buffers& r_buffers, bool p_kernel) {
+    const AudioFrame* src = r_buffers.src.ptr();
+    LocalVector<int32_t>& samples =
+        p_kernel ? r_buffers.samples : r_buffers.expected_samples;
+    samples.resize(FRAMES * 2);
+    int32_t* dst = samples.ptr();
+
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int run = 0; run < RUNS; run++) {
+        if (p_kernel) {
+            AudioMixKernels::convert_to_int32(src, FRAMES, dst, 2);
+            continue;
+        }
+        for (int i = 0; i < FRAMES; i++) {
+            float l        = CLAMP(src[i].l, -1.0, 1.0);
+            int32_t vl     = l * ((1 << 20) - 1);
+            dst[i * 2]     = (vl < 0 ? -1 : 1) * (ABS(vl) << 11);
+            float r        = CLAMP(src[i].r, -1.0, 1.0);
+            int32_t vr     = r * ((1 << 20) - 1);
+            dst[i * 2 + 1] = (vr < 0 ? -1 : 1) * (ABS(vr) << 11);
+        }
+    }
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+    return float(elapsed) / RUNS;
+}
+
+static float _benchmark_resample(Buffers& r_buffers, bool p_kernel) {
+    AudioFrame* dst       = r_buffers.dst.ptr();
+    const AudioFrame* src = r_buffers.src.ptr();
+    // Resamples 44100 Hz to 48000 Hz.
+    const uint64_t increment = uint64_t(44100.0 / 48000.0 * FP_LEN);
+
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int run = 0; run < RUNS; run++) {
+        if (p_kernel) {
+            AudioMixKernels::resample_cubic(
+                dst,
+                FRAMES,
+                src,
+                0,
+                increment,
+                FP_BITS
+            );
+            continue;
+        }
+        uint64_t offset = 0;
+        for (int i = 0; i < FRAMES; i++) {
+            const AudioFrame* y = src + (offset >> FP_BITS);
+            float mu            = (offset & FP_MASK) / float(FP_LEN);
+            float mu2           = mu * mu;
+
+            AudioFrame a0 = 3 * y[1] - 3 * y[2] + y[3] - y[0];
+            AudioFrame a1 = 2 * y[0] - 5 * y[1] + 4 * y[2] - y[3];
+            AudioFrame a2 = y[2] - y[0];
+            AudioFrame a3 = 2 * y[1];
+
+            dst[i]  = (a0 * mu * mu2 + a1 * mu2 + a2 * mu + a3) / 2;
+            offset += increment;
+        }
+    }
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+    return float(elapsed) / RUNS;
+}
+
+typedef float (*Benchmark)(Buffers& r_buffers, bool p_kernel);
+
+static void _run(const char* p_kernel, Benchmark p_benchmark) {
+    Buffers buffers;
+    // The resampler reads up to three frames past the end.
+    _fill(buffers.src, FRAMES + 4, 0);
+
+    _fill(buffers.dst, FRAMES, 100);
+    float reference  = p_benchmark(buffers, false);
+    buffers.expected = buffers.dst;
+
+    _fill(buffers.dst, FRAMES, 100);
+    float kernel = p_benchmark(buffers, true);
+
+    _compare(p_kernel, buffers);
+
+    print_line(
+        String(p_kernel) + ": " + itos(FRAMES) + " frames, scalar "
+        + rtos(reference) + " usec, kernel " + rtos(kernel) + " usec."
+    );
+}
+
+// A resampled stream that plays a looping tone.
+class Tone : public AudioStreamPlaybackResampled {
+public:
+    LocalVector<AudioFrame>* wave = nullptr;
+    float rate                    = 44100;
+    uint32_t position             = 0;
+
+    virtual void start(float p_from_pos = 0.0) {
+        _begin_resample();
+    }
+
+    virtual void stop() {}
+
+    virtual bool is_playing() const {
+        return true;
+    }
+
+    virtual int get_loop_count() const {
+        return 0;
+    }
+
+    virtual float get_playback_position() const {
+        return 0;
+    }
+
+    virtual void seek(float p_time) {}
+
+protected:
+    virtual void _mix_internal(AudioFrame* p_buffer, int p_frames) {
+        for (int i = 0; i < p_frames; i++) {
+            p_buffer[i] = (*wave)[(position + i) & (WAVE_SIZE - 1)];
+        }
+        position += p_frames;
+    }
+
+    virtual float get_stream_sampling_rate() {
+        return rate;
+    }
+};
+
+struct Voices {
+    LocalVector<Ref<Tone>> tones;
+    LocalVector<AudioFrame> buffer;
+    LocalVector<AudioFrame> volumes;
+};
+
+// Resamples every voice and mixes it to the master bus with a volume ramp,
+// like the audio stream players do.
+static void _mix_voices(void* p_userdata) {
+    Voices* voices  = static_cast<Voices*>(p_userdata);
+    AudioServer* as = AudioServer::get_singleton();
+    int size        = as->thread_get_mix_buffer_size();
+    AudioFrame* buf = as->thread_get_channel_mix_buffer(0, 0);
+
+    voices->buffer.resize(size);
+    for (uint32_t i = 0; i < voices->tones.size(); i++) {
+        voices->tones[i]->mix(voices->buffer.ptr(), 1.0f, size);
+
+        AudioFrame target(voices->volumes[i].r, voices->volumes[i].l);
+        AudioFrame volume_step = (target - voices->volumes[i]) / float(size);
+        AudioMixKernels::mix_ramp(
+            buf,
+            voices->buffer.ptr(),
+            size,
+            voices->volumes[i],
+            volume_step
+        );
+        voices->volumes[i] = target;
+    }
+}
+
+// Returns the msec per block.
+static float _benchmark_driver(AudioDriverDummy* p_driver) {
+    AudioServer* as = AudioServer::get_singleton();
+
+    LocalVector<AudioFrame> wave;
+    _fill(wave, WAVE_SIZE, 0);
+
+    Voices voices;
+    for (int i = 0; i < VOICES; i++) {
+        Ref<Tone> tone;
+        tone.instance();
+        tone->wave = &wave;
+        tone->rate = 22050 + i * 500;
+        tone->start();
+        voices.tones.push_back(tone);
+        voices.volumes.push_back(AudioFrame(0.01f * (i + 1), 0.01f));
+    }
+    as->add_callback(_mix_voices, &voices);
+
+    // The dummy driver mixes stereo.
+    LocalVector<int32_t> output;
+    output.resize(BLOCK_FRAMES * 2);
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < BLOCKS; i++) {
+        p_driver->mix_audio(BLOCK_FRAMES, output.ptr());
+    }
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+    as->remove_callback(_mix_voices, &voices);
+    return elapsed / 1000.0f / BLOCKS;
+}
+
+MainLoop* test_benchmark() {
+    _run("mix", _benchmark_mix);
+    _run("mix_ramp", _benchmark_mix_ramp);
+    _run("apply_volume", _benchmark_apply_volume);
+    _run("convert_to_int32", _benchmark_convert);
+    _run("resample_cubic", _benchmark_resample);
+
+    AudioDriver* driver = AudioDriver::get_singleton();
+    if (!driver || String(driver->get_name()) != "Dummy") {
+        print_line("Run with --audio-driver Dummy to benchmark the mixing.");
+        return nullptr;
+    }
+    AudioDriverDummy* dummy = static_cast<AudioDriverDummy*>(driver);
+
+    // Keeps the driver's thread from mixing in between the blocks.
+    dummy->lock();
+    float mixing = _benchmark_driver(dummy);
+    dummy->unlock();
+
+    print_line(
+        "Audio kernels benchmark: " + itos(VOICES) + " resampled voices, "
+        + itos(BLOCK_FRAMES) + " frames per block, "
+        + rtos(mixing) + " msec/block."
+    );
+
+    return nullptr;
+}
+} // namespace TestAudioKernels
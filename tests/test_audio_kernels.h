@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef TEST_AUDIO_KERNELS_H
+#define TEST_AUDIO_KERNELS_H
+
+#include "core/os/main_loop.h"
+
+namespace TestAudioKernels {
+
+MainLoop* test_benchmark();
+} // namespace TestAudioKernels
+
+#endif // TEST_AUDIO_KERNELS_H
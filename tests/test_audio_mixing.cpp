@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "test_audio_mixing.h"
+
+#include "core/local_vector.h"
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/print_string.h"
+#include "core/project_settings.h"
+#include "servers/audio/audio_driver_dummy.h"
+#include "servers/audio/effects/audio_effect_compressor.h"
+#include "servers/audio/effects/audio_effect_eq.h"
+#include "servers/audio/effects/audio_effect_reverb.h"
+#include "servers/audio_server.h"
+
+namespace TestAudioMixing {
+
+enum {
+    GROUP_BUSES  = 8,
+    SOURCE_BUSES = 40,
+    BLOCKS       = 100,
+    BLOCK_FRAMES = 1024,
+    WAVE_SIZE    = 4096,
+};
+
+struct Sources {
+    LocalVector<AudioFrame> wave;
+    uint32_t position;
+};
+
+// Writes a different tone to every source bus, like the audio stream
+// players do.
+static void _mix_sources(void* p_userdata) {
+    Sources* sources = static_cast<Sources*>(p_userdata);
+    AudioServer* as  = AudioServer::get_singleton();
+    int size         = as->thread_get_mix_buffer_size();
+
+    for (int i = 0; i < SOURCE_BUSES; i++) {
+        int bus         = 1 + GROUP_BUSES + i;
+        AudioFrame* buf = as->thread_get_channel_mix_buffer(bus, 0);
+        for (int j = 0; j < size; j++) {
+            uint32_t index  = (sources->position + j) * (i + 1);
+            buf[j]         += sources->wave[index & (WAVE_SIZE - 1)];
+        }
+    }
+    sources->position += size;
+}
+
+// Makes new buses, with new effect instances, for every run: the source buses
+// have an EQ and a compressor, and send to the group buses, which have a
+// reverb and send to the master bus.
+static void _make_buses(Sources& r_sources) {
+    AudioServer* as = AudioServer::get_singleton();
+    as->set_bus_count(1);
+    as->set_bus_count(1 + GROUP_BUSES + SOURCE_BUSES);
+
+    for (int i = 0; i < GROUP_BUSES; i++) {
+        int bus = 1 + i;
+        as->set_bus_send(bus, as->get_bus_name(0));
+        as->add_bus_effect(bus, memnew(AudioEffectReverb));
+    }
+    for (int i = 0; i < SOURCE_BUSES; i++) {
+        int bus = 1 + GROUP_BUSES + i;
+        as->set_bus_send(bus, as->get_bus_name(1 + i % GROUP_BUSES));
+        as->add_bus_effect(bus, memnew(AudioEffectEQ10));
+        as->add_bus_effect(bus, memnew(AudioEffectCompressor));
+    }
+
+    r_sources.position = 0;
+}
+
+// Returns the msec per block.
+static float _benchmark(
+    AudioDriverDummy* p_driver,
+    int p_thread_count,
+    LocalVector<int32_t>& r_output
+) {
+    AudioServer* as = AudioServer::get_singleton();
+    as->set_bus_mixing_thread_count(p_thread_count);
+
+    Sources sources;
+    sources.wave.resize(WAVE_SIZE);
+    for (int i = 0; i < WAVE_SIZE; i++) {
+        float value     = 0.1f * Math::sin(i * Math_TAU / WAVE_SIZE);
+        sources.wave[i] = AudioFrame(value, value);
+    }
+    _make_buses(sources);
+    as->add_callback(_mix_sources, &sources);
+
+    // The dummy driver mixes stereo.
+    r_output.resize(BLOCKS * BLOCK_FRAMES * 2);
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < BLOCKS; i++) {
+        p_driver->mix_audio(BLOCK_FRAMES, &r_output[i * BLOCK_FRAMES * 2]);
+    }
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+    as->remove_callback(_mix_sources, &sources);
+    as->set_bus_count(1);
+    return elapsed / 1000.0f / BLOCKS;
+}
+
+MainLoop* test_benchmark() {
+    AudioDriver* driver = AudioDriver::get_singleton();
+    if (!driver || String(driver->get_name()) != "Dummy") {
+        ERR_PRINT("Run the audio mixing benchmark with --audio-driver Dummy.");
+        return nullptr;
+    }
+    AudioDriverDummy* dummy = static_cast<AudioDriverDummy*>(driver);
+
+    // Keeps the driver's thread from mixing in between the blocks.
+    dummy->lock();
+
+    LocalVector<int32_t> serial_output;
+    float serial = _benchmark(dummy, 1, serial_output);
+
+    LocalVector<int32_t> parallel_output;
+    float parallel = _benchmark(dummy, 0, parallel_output);
+
+    AudioServer::get_singleton()->set_bus_mixing_thread_count(
+        GLOBAL_GET("audio/bus_mixing_thread_count")
+    );
+    dummy->unlock();
+
+    for (uint32_t i = 0; i < serial_output.size(); i++) {
+        if (serial_output[i] != parallel_output[i]) {
+            ERR_PRINT("Audio mixing sample " + itos(i) + " doesn't match.");
+            break;
+        }
+    }
+
+    print_line(
+        "Audio mixing benchmark: " + itos(1 + GROUP_BUSES + SOURCE_BUSES)
+        + " buses, " + itos(BLOCK_FRAMES) + " frames per block, serial "
+        + rtos(serial) + " msec/block, parallel on all cores "
+        + rtos(parallel) + " msec/block."
+    );
+
+    return nullptr;
+}
+} // namespace TestAudioMixing
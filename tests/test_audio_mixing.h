@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef TEST_AUDIO_MIXING_H
+#define TEST_AUDIO_MIXING_H
+
+#include "core/os/main_loop.h"
+
+namespace TestAudioMixing {
+
+MainLoop* test_benchmark();
+} // namespace TestAudioMixing
+
+#endif // TEST_AUDIO_MIXING_H
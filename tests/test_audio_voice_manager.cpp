@@ -0,0 +1,252 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "test_audio_voice_manager.h"
+
+#include "core/local_vector.h"
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "scene/3d/audio_stream_player_3d.h"
+#include "scene/3d/camera.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
+#include "scene/resources/audio_stream_sample.h"
+#include "servers/audio/audio_driver_dummy.h"
+#include "servers/audio/audio_voice_manager.h"
+#include "servers/audio_server.h"
+
+namespace TestAudioVoiceManager {
+
+enum {
+    BLOCKS        = 20,
+    BLOCK_FRAMES  = 1024,
+    STREAM_BLOCKS = 100,
+};
+
+static bool _check_virtual(
+    const AudioVoiceManager& p_manager,
+    const char* p_name,
+    int p_voice,
+    bool p_virtual
+) {
+    if (p_manager.is_voice_virtual(p_voice) == p_virtual) {
+        return true;
+    }
+    OS::get_singleton()->print(
+        "Fail: %s should %sbe virtual.\n",
+        p_name,
+        p_virtual ? "" : "not "
+    );
+    return false;
+}
+
+// Only the voices with the highest priorities, and then the loudest ones,
+// are mixed.
+static bool _check_budget() {
+    AudioVoiceManager manager;
+    manager.set_voice_limit(2);
+
+    int low_loud  = manager.add_voice();
+    int high      = manager.add_voice();
+    int low_quiet = manager.add_voice();
+    int low_mid   = manager.add_voice();
+    manager.set_voice_state(low_loud, 0, 0.9, true);
+    manager.set_voice_state(high, 1, 0.1, true);
+    manager.set_voice_state(low_quiet, 0, 0.2, true);
+    manager.set_voice_state(low_mid, 0, 0.5, true);
+    manager.update();
+
+    bool success = true;
+    success &= _check_virtual(manager, "High priority", high, false);
+    success &= _check_virtual(manager, "Loudest", low_loud, false);
+    success &= _check_virtual(manager, "Second loudest", low_mid, true);
+    success &= _check_virtual(manager, "Quietest", low_quiet, true);
+    if (manager.get_real_voice_count() != 2) {
+        OS::get_singleton()->print("Fail: Voice limit exceeded.\n");
+        success = false;
+    }
+    return success;
+}
+
+// Voices become virtual, and are mixed again, as the other voices start and
+// stop, and as they get quieter and louder.
+static bool _check_transitions() {
+    AudioVoiceManager manager;
+    manager.set_voice_limit(1);
+    manager.set_audibility_threshold_db(-60);
+
+    int voice = manager.add_voice();
+    int other = manager.add_voice();
+    manager.set_voice_state(voice, 0, 0.5, true);
+    manager.update();
+
+    bool success = true;
+    success &= _check_virtual(manager, "Only voice", voice, false);
+    success &= _check_virtual(manager, "Stopped voice", other, true);
+
+    manager.set_voice_state(other, 1, 0.5, true);
+    manager.update();
+    success &= _check_virtual(manager, "Outranked voice", voice, true);
+    success &= _check_virtual(manager, "Started voice", other, false);
+
+    manager.set_voice_state(other, 1, 0.5, false);
+    manager.update();
+    success &= _check_virtual(manager, "Restored voice", voice, false);
+
+    manager.set_voice_state(voice, 0, Math::db2linear(-70.0f), true);
+    manager.update();
+    success &= _check_virtual(manager, "Inaudible voice", voice, true);
+
+    // Without a limit, no voice is virtual, however quiet.
+    manager.set_voice_limit(0);
+    manager.update();
+    success &= _check_virtual(manager, "Unlimited voice", voice, false);
+    return success;
+}
+
+// A voice that starts between two updates is mixed until the next update
+// ranks it, so the player doesn't skip its first block.
+static bool _check_start() {
+    AudioVoiceManager manager;
+
+    // Without a limit, the voice was never ranked.
+    int voice = manager.add_voice();
+    manager.update();
+    manager.set_voice_state(voice, 0, 0.5, true);
+
+    bool success = true;
+    success &= _check_virtual(manager, "Unranked voice", voice, false);
+
+    // With a limit, the voice was virtual when it was last ranked.
+    manager.set_voice_limit(1);
+    int other = manager.add_voice();
+    manager.set_voice_state(other, 1, 0.5, true);
+    manager.update();
+    success &= _check_virtual(manager, "Outranked voice", voice, true);
+
+    manager.set_voice_state(voice, 0, 0.5, false);
+    manager.update();
+    manager.set_voice_state(voice, 0, 0.5, true);
+    success &= _check_virtual(manager, "Restarted voice", voice, false);
+
+    manager.update();
+    success &= _check_virtual(manager, "Ranked voice", voice, true);
+    return success;
+}
+
+// A constant mono tone, at the audio server's mix rate.
+static Ref<AudioStreamSample> _make_stream() {
+    int frame_count = STREAM_BLOCKS * BLOCK_FRAMES;
+    PoolVector<uint8_t> data;
+    data.resize(frame_count * 2);
+    {
+        PoolVector<uint8_t>::Write w = data.write();
+        for (int i = 0; i < frame_count; i++) {
+            w[i * 2]     = 0x00;
+            w[i * 2 + 1] = 0x10;
+        }
+    }
+
+    Ref<AudioStreamSample> stream;
+    stream.instance();
+    stream->set_format(AudioStreamSample::FORMAT_16_BITS);
+    stream->set_mix_rate(AudioServer::get_singleton()->get_mix_rate());
+    stream->set_data(data);
+    return stream;
+}
+
+static void _step(SceneTree* p_tree, AudioDriverDummy* p_driver) {
+    // The dummy driver mixes stereo.
+    int32_t buffer[BLOCK_FRAMES * 2];
+    p_tree->iteration(1.0 / 60.0);
+    p_driver->mix_audio(BLOCK_FRAMES, buffer);
+}
+
+// A player that is outranked keeps its playback position while it is
+// virtual, and continues from there when it is mixed again.
+static bool _check_position(AudioDriverDummy* p_driver) {
+    AudioVoiceManager* manager =
+        AudioServer::get_singleton()->get_voice_manager();
+    int voice_limit = manager->get_voice_limit();
+    manager->set_voice_limit(1);
+
+    SceneTree* tree = memnew(SceneTree);
+    tree->init();
+
+    Camera* camera = memnew(Camera);
+    tree->get_root()->add_child(camera);
+
+    Ref<AudioStreamSample> stream = _make_stream();
+    AudioStreamPlayer3D* players[2];
+    for (int i = 0; i < 2; i++) {
+        players[i] = memnew(AudioStreamPlayer3D);
+        players[i]->set_stream(stream);
+        players[i]->set_voice_priority(i);
+        players[i]->set_translation(Vector3(0, 0, -2));
+        tree->get_root()->add_child(players[i]);
+        players[i]->play();
+    }
+
+    for (int i = 0; i < BLOCKS; i++) {
+        _step(tree, p_driver);
+    }
+
+    bool success = true;
+    float mix_rate = AudioServer::get_singleton()->get_mix_rate();
+    if (players[0]->get_playback_position() > 0) {
+        OS::get_singleton()->print("Fail: Outranked player was mixed.\n");
+        success = false;
+    }
+
+    players[1]->stop();
+    _step(tree, p_driver);
+
+    // Seeking can round down to the previous frame.
+    float expected = (BLOCKS + 1) * BLOCK_FRAMES / mix_rate;
+    float position = players[0]->get_playback_position();
+    if (Math::abs(position - expected) > 2.0f / mix_rate) {
+        OS::get_singleton()->print(
+            "Fail: Player continued from %f seconds instead of %f.\n",
+            position,
+            expected
+        );
+        success = false;
+    }
+
+    tree->finish();
+    memdelete(tree);
+    manager->set_voice_limit(voice_limit);
+    return success;
+}
+
+MainLoop* test() {
+    OS::get_singleton()->print("Start audio voice manager checks.\n");
+
+    bool success = true;
+    success &= _check_budget();
+    success &= _check_transitions();
+    success &= _check_start();
+
+    AudioDriver* driver = AudioDriver::get_singleton();
+    if (driver && String(driver->get_name()) == "Dummy") {
+        AudioDriverDummy* dummy = static_cast<AudioDriverDummy*>(driver);
+        // Keeps the driver's thread from mixing in between the steps.
+        dummy->lock();
+        success &= _check_position(dummy);
+        dummy->unlock();
+    } else {
+        OS::get_singleton()->print(
+            "Run with --audio-driver Dummy to check the playback position.\n"
+        );
+    }
+
+    if (success) {
+        OS::get_singleton()->print("Audio voice manager checks passed.\n");
+    } else {
+        OS::get_singleton()->print("Audio voice manager checks FAILED.\n");
+    }
+
+    return nullptr;
+}
+} // namespace TestAudioVoiceManager
@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef TEST_AUDIO_VOICE_MANAGER_H
+#define TEST_AUDIO_VOICE_MANAGER_H
+
+#include "core/os/main_loop.h"
+
+namespace TestAudioVoiceManager {
+
+MainLoop* test();
+} // namespace TestAudioVoiceManager
+
+#endif // TEST_AUDIO_VOICE_MANAGER_H
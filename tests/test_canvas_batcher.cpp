@@ -0,0 +1,313 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "test_canvas_batcher.h"
+
+#include "core/local_vector.h"
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/print_string.h"
+#include "core/rid.h"
+#include "drivers/gles_common/rasterizer_canvas_batcher.h"
+
+// Drives the RasterizerCanvasBatcher through a stand-in for the GLES
+// rasterizers that doesn't need a GL context. Uploading the vertex buffers
+// and drawing the batches only counts them, so the benchmark times
+// recording, sorting and joining the items, prefilling the batches and
+// transforming their vertices.
+namespace TestCanvasBatcher {
+
+enum {
+    ITEMS          = 50000,
+    RECTS_PER_ITEM = 4,
+    FRAMES         = 20,
+};
+
+// The parts of the GLES storage the batcher reads.
+struct StubStorage {
+    struct Shader {};
+
+    struct Material {
+        Shader* shader;
+    };
+
+    struct Texture : public RID_Data {
+        int width;
+        int height;
+        int alloc_width;
+        int alloc_height;
+        uint32_t flags;
+        Texture* proxy;
+
+        Texture* get_ptr() {
+            return this;
+        }
+    };
+
+    struct Skeleton : public RID_Data {
+        bool use_2d;
+        Transform2D base_transform_2d;
+    };
+
+    struct RenderTarget {
+        int width;
+        int height;
+        bool flags[RasterizerStorage::RENDER_TARGET_FLAG_MAX];
+    };
+
+    struct Config {
+        bool support_npot_repeat_mipmap;
+    } config;
+
+    struct Frame {
+        RenderTarget* current_rt;
+    } frame;
+
+    mutable RID_Owner<Texture> texture_owner;
+    mutable RID_Owner<Skeleton> skeleton_owner;
+
+    RenderTarget render_target;
+
+    StubStorage() {
+        config.support_npot_repeat_mipmap = true;
+        render_target.width               = 1024;
+        render_target.height              = 768;
+        for (int i = 0; i < RasterizerStorage::RENDER_TARGET_FLAG_MAX; i++) {
+            render_target.flags[i] = false;
+        }
+        frame.current_rt = &render_target;
+    }
+};
+
+class StubCanvas :
+    public RasterizerCanvasBatcher<StubCanvas, StubStorage> {
+    friend class RasterizerCanvasBatcher<StubCanvas, StubStorage>;
+
+public:
+    typedef RasterizerCanvas::Item Item;
+    typedef RasterizerCanvas::Light Light;
+
+    StubStorage* storage;
+
+    struct State {
+        bool using_skeleton;
+    } state;
+
+    // The vertices uploaded by every flush, while capturing.
+    bool capture = false;
+    LocalVector<BatchVertex> uploaded;
+
+    void set_deferred_software_transform(bool p_enabled, int p_thread_count) {
+        bdata.settings_deferred_software_transform = p_enabled;
+        if (p_enabled) {
+            bdata.software_transformer.init(p_thread_count);
+        }
+    }
+
+    void draw(Item* p_item_list) {
+        batch_canvas_begin();
+        batch_canvas_render_items_begin(Color(1, 1, 1), nullptr, Transform2D());
+        batch_canvas_render_items(
+            p_item_list,
+            0,
+            Color(1, 1, 1),
+            nullptr,
+            Transform2D()
+        );
+        batch_canvas_render_items_end();
+        batch_canvas_end();
+    }
+
+    StubCanvas(StubStorage* p_storage) {
+        storage              = p_storage;
+        state.using_skeleton = false;
+        batch_constructor();
+        batch_initialize();
+
+        // Every frame is filled from scratch.
+        bdata.settings_use_batching    = true;
+        bdata.settings_use_batch_cache = false;
+    }
+
+private:
+    void canvas_render_items_implementation(
+        Item* p_item_list,
+        int p_z,
+        const Color& p_modulate,
+        Light* p_light,
+        const Transform2D& p_base_transform
+    ) {
+        RenderItemState ris;
+        ris.item_group_z              = p_z;
+        ris.item_group_modulate       = p_modulate;
+        ris.item_group_light          = p_light;
+        ris.item_group_base_transform = p_base_transform;
+        ris.prev_distance_field       = false;
+
+        for (int j = 0; j < bdata.items_joined.size(); j++) {
+            bool reclip = false;
+            render_joined_item_commands(
+                bdata.items_joined[j],
+                nullptr,
+                reclip,
+                nullptr,
+                false,
+                ris
+            );
+        }
+    }
+
+    // Like the GLES rasterizers for items without clips, materials, skeletons
+    // or lights.
+    bool try_join_item(
+        Item* p_ci,
+        RenderItemState& r_ris,
+        bool& r_batch_break
+    ) {
+        r_batch_break = false;
+        bool join     = !r_ris.rebind_shader;
+
+        r_ris.rebind_shader  = false;
+        r_ris.final_modulate = p_ci->final_modulate * r_ris.item_group_modulate;
+        bdata.joined_item_batch_flags = 0;
+
+        if (_detect_item_batch_break(r_ris, p_ci, r_batch_break)) {
+            join          = false;
+            r_batch_break = true;
+        }
+        return join;
+    }
+
+    void _batch_upload_buffers() {
+        if (!capture) {
+            return;
+        }
+        for (int i = 0; i < bdata.vertices.size(); i++) {
+            uploaded.push_back(bdata.vertices[i]);
+        }
+    }
+
+    void render_batches(
+        Item* p_current_clip,
+        bool& r_reclip,
+        StubStorage::Material* p_material
+    ) {}
+
+    void gl_enable_scissor(int p_x, int p_y, int p_width, int p_height) const {}
+
+    void gl_disable_scissor() const {}
+};
+
+struct Scene {
+    LocalVector<StubCanvas::Item*> items;
+
+    ~Scene() {
+        for (uint32_t i = 0; i < items.size(); i++) {
+            memdelete(items[i]);
+        }
+    }
+};
+
+// Untextured rects in items that are rotated and scaled, so every rect is
+// transformed in software.
+static void _make_scene(Scene& r_scene) {
+    r_scene.items.resize(ITEMS);
+    for (int i = 0; i < ITEMS; i++) {
+        StubCanvas::Item* item = memnew(StubCanvas::Item);
+        for (int r = 0; r < RECTS_PER_ITEM; r++) {
+            StubCanvas::Item::CommandRect* rect =
+                memnew(StubCanvas::Item::CommandRect);
+            rect->rect     = Rect2(r * 16.0f, 0.0f, 16.0f, 16.0f);
+            rect->modulate = Color(1, 1, 1);
+            item->add_command(rect);
+        }
+
+        Transform2D transform(i * 0.01f, Vector2(i % 1024, i / 64));
+        item->final_transform =
+            transform.scaled(Size2(1.0f + (i % 7) * 0.25f, 1.0f));
+        item->global_rect_cache =
+            item->final_transform.xform(item->get_rect());
+        if (i > 0) {
+            r_scene.items[i - 1]->next = item;
+        }
+        r_scene.items[i] = item;
+    }
+}
+
+// Draws the scene once, capturing the vertices, and then times FRAMES frames.
+// Returns the msec per frame.
+static float _benchmark(
+    Scene& r_scene,
+    StubCanvas& r_canvas,
+    LocalVector<StubCanvas::BatchVertex>& r_vertices
+) {
+    r_canvas.capture = true;
+    r_canvas.uploaded.clear();
+    r_canvas.draw(r_scene.items[0]);
+    r_canvas.capture = false;
+    r_vertices       = r_canvas.uploaded;
+
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int f = 0; f < FRAMES; f++) {
+        r_canvas.draw(r_scene.items[0]);
+    }
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+    return elapsed / 1000.0f / FRAMES;
+}
+
+static void _compare(
+    const LocalVector<StubCanvas::BatchVertex>& p_expected,
+    const LocalVector<StubCanvas::BatchVertex>& p_vertices
+) {
+    if (p_expected.size() != p_vertices.size()) {
+        ERR_PRINT("Canvas batcher vertex counts don't match.");
+        return;
+    }
+    for (uint32_t i = 0; i < p_expected.size(); i++) {
+        const StubCanvas::BatchVertex& a = p_expected[i];
+        const StubCanvas::BatchVertex& b = p_vertices[i];
+        if (!Math::is_equal_approx(a.pos.x, b.pos.x, 0.01f)
+            || !Math::is_equal_approx(a.pos.y, b.pos.y, 0.01f)
+            || a.uv.x != b.uv.x || a.uv.y != b.uv.y) {
+            ERR_PRINT("Canvas batcher vertex " + itos(i) + " doesn't match.");
+            return;
+        }
+    }
+}
+
+MainLoop* test_benchmark() {
+    Scene scene;
+    _make_scene(scene);
+
+    StubStorage storage;
+    StubCanvas canvas(&storage);
+
+    LocalVector<StubCanvas::BatchVertex> expected;
+    LocalVector<StubCanvas::BatchVertex> vertices;
+
+    canvas.set_deferred_software_transform(false, 1);
+    float immediate = _benchmark(scene, canvas, expected);
+    if (expected.size() != ITEMS * RECTS_PER_ITEM * 4) {
+        ERR_PRINT("Not every canvas batcher rect was batched.");
+    }
+
+    canvas.set_deferred_software_transform(true, 1);
+    float deferred = _benchmark(scene, canvas, vertices);
+    _compare(expected, vertices);
+
+    canvas.set_deferred_software_transform(true, 0);
+    float threaded = _benchmark(scene, canvas, vertices);
+    _compare(expected, vertices);
+
+    print_line(
+        "Canvas batcher benchmark: " + itos(ITEMS * RECTS_PER_ITEM)
+        + " rects, immediate " + rtos(immediate)
+        + " msec/frame, deferred transform " + rtos(deferred)
+        + " msec/frame, deferred transform on all cores " + rtos(threaded)
+        + " msec/frame."
+    );
+
+    return nullptr;
+}
+} // namespace TestCanvasBatcher
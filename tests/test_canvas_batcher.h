@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef TEST_CANVAS_BATCHER_H
+#define TEST_CANVAS_BATCHER_H
+
+#include "core/os/main_loop.h"
+
+namespace TestCanvasBatcher {
+
+MainLoop* test_benchmark();
+} // namespace TestCanvasBatcher
+
+#endif // TEST_CANVAS_BATCHER_H
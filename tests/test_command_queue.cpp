@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "test_command_queue.h"
+
+#include "core/command_queue_mt.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/print_string.h"
+#include "core/safe_refcount.h"
+
+namespace TestCommandQueue {
+
+enum {
+    WARMUP_COMMANDS    = 100000,
+    BENCHMARK_COMMANDS = 2000000,
+};
+
+struct Receiver {
+    uint64_t sum;
+    SafeFlag exit;
+
+    void add(int p_value) {
+        sum += p_value;
+    }
+
+    void quit() {
+        exit.set();
+    }
+};
+
+struct Consumer {
+    CommandQueueMT* queue;
+    Receiver* receiver;
+};
+
+static void _consumer_thread(void* p_userdata) {
+    Consumer* consumer = static_cast<Consumer*>(p_userdata);
+    while (!consumer->receiver->exit.is_set()) {
+        consumer->queue->wait_and_flush_one();
+    }
+    consumer->queue->flush_all();
+}
+
+// Returns the number of commands per second pushed by the main thread and
+// executed by a server thread.
+static float _benchmark(bool p_ring_buffer) {
+    CommandQueueMT queue(true, p_ring_buffer);
+    Receiver receiver;
+    receiver.sum = 0;
+
+    Consumer consumer;
+    consumer.queue    = &queue;
+    consumer.receiver = &receiver;
+
+    Thread thread;
+    thread.start(_consumer_thread, &consumer);
+
+    for (int i = 0; i < WARMUP_COMMANDS; i++) {
+        queue.push(&receiver, &Receiver::add, 1);
+    }
+
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < BENCHMARK_COMMANDS; i++) {
+        queue.push(&receiver, &Receiver::add, 1);
+    }
+    queue.push_and_sync(&receiver, &Receiver::quit);
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+    thread.wait_to_finish();
+
+    if (receiver.sum != WARMUP_COMMANDS + BENCHMARK_COMMANDS) {
+        ERR_PRINT(
+            "Command queue lost commands: " + itos(receiver.sum) + " of "
+            + itos(WARMUP_COMMANDS + BENCHMARK_COMMANDS) + " executed."
+        );
+    }
+
+    return BENCHMARK_COMMANDS / (MAX(elapsed, (uint64_t)1) / 1000000.0);
+}
+
+MainLoop* test_benchmark() {
+    float mutex       = _benchmark(false);
+    float ring_buffer = _benchmark(true);
+
+    print_line(
+        "Command queue benchmark: mutex " + rtos(mutex)
+        + " commands/sec, ring buffer " + rtos(ring_buffer)
+        + " commands/sec, " + rtos(ring_buffer / mutex) + "x."
+    );
+
+    return nullptr;
+}
+} // namespace TestCommandQueue
@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef TEST_COMMAND_QUEUE_H
+#define TEST_COMMAND_QUEUE_H
+
+#include "core/os/main_loop.h"
+
+namespace TestCommandQueue {
+
+MainLoop* test_benchmark();
+} // namespace TestCommandQueue
+
+#endif // TEST_COMMAND_QUEUE_H
@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "test_convolution_reverb.h"
+
+#include "core/local_vector.h"
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/print_string.h"
+#include "servers/audio/effects/audio_effect_convolution_reverb.h"
+#include "servers/audio_server.h"
+
+namespace TestConvolutionReverb {
+
+enum {
+    BLOCKS       = 200,
+    BLOCK_FRAMES = 1024,
+    CHECK_FRAMES = 4000,
+    CHECK_LENGTH = 1000,
+};
+
+// A stereo impulse of decaying noise, at the audio server's mix rate.
+static Ref<AudioStreamSample> _make_impulse(int p_frame_count) {
+    PoolVector<uint8_t> data;
+    data.resize(p_frame_count * 4);
+    {
+        PoolVector<uint8_t>::Write w = data.write();
+        for (int i = 0; i < p_frame_count * 2; i++) {
+            float decay    = Math::exp(-4.0f * i / (p_frame_count * 2));
+            float noise    = Math::random(-1.0f, 1.0f) * decay;
+            int16_t sample = CLAMP(noise * 32767.0f, -32767.0f, 32767.0f);
+            w[i * 2]       = sample & 0xFF;
+            w[i * 2 + 1]   = (sample >> 8) & 0xFF;
+        }
+    }
+
+    Ref<AudioStreamSample> impulse;
+    impulse.instance();
+    impulse->set_format(AudioStreamSample::FORMAT_16_BITS);
+    impulse->set_stereo(true);
+    impulse->set_mix_rate(AudioServer::get_singleton()->get_mix_rate());
+    impulse->set_data(data);
+    return impulse;
+}
+
+static void _fill(LocalVector<AudioFrame>& r_frames, int p_frames) {
+    r_frames.resize(p_frames);
+    for (int i = 0; i < p_frames; i++) {
+        r_frames[i] = AudioFrame(
+            Math::random(-1.0f, 1.0f),
+            Math::random(-1.0f, 1.0f)
+        );
+    }
+}
+
+// Compares the effect with a direct convolution, delayed by the effect's
+// latency.
+static void _check() {
+    Ref<AudioStreamSample> impulse = _make_impulse(CHECK_LENGTH);
+    Ref<AudioEffectConvolutionReverb> effect;
+    effect.instance();
+    effect->set_impulse(impulse);
+    effect->set_dry(0.0f);
+    effect->set_wet(1.0f);
+    Ref<AudioEffectInstance> instance = effect->instance();
+
+    LocalVector<AudioFrame> src;
+    LocalVector<AudioFrame> dst;
+    _fill(src, CHECK_FRAMES);
+    dst.resize(CHECK_FRAMES);
+    // Odd block sizes, so partitions straddle the blocks.
+    for (int i = 0; i < CHECK_FRAMES; i += 333) {
+        int count = MIN(333, CHECK_FRAMES - i);
+        instance->process(&src[i], &dst[i], count);
+    }
+
+    // The 16 bit samples are decoded like the effect does.
+    PoolVector<uint8_t> data    = impulse->get_data();
+    PoolVector<uint8_t>::Read r = data.read();
+    const int16_t* samples      = (const int16_t*)r.ptr();
+    const int latency           = ConvolutionReverb::PARTITION_SIZE;
+    for (int i = 0; i < CHECK_FRAMES; i++) {
+        AudioFrame expected(0, 0);
+        for (int k = 0; k < CHECK_LENGTH && k <= i - latency; k++) {
+            const AudioFrame& input = src[i - latency - k];
+            expected.l += input.l * (samples[k * 2] / 32768.0f);
+            expected.r += input.r * (samples[k * 2 + 1] / 32768.0f);
+        }
+        if (ABS(expected.l - dst[i].l) > 0.001f
+            || ABS(expected.r - dst[i].r) > 0.001f) {
+            ERR_PRINT("Convolution reverb frame " + itos(i) + " is wrong.");
+            return;
+        }
+    }
+}
+
+// Returns the usec per block.
+static float _benchmark(float p_seconds) {
+    float mix_rate = AudioServer::get_singleton()->get_mix_rate();
+    Ref<AudioEffectConvolutionReverb> effect;
+    effect.instance();
+    effect->set_impulse(_make_impulse(p_seconds * mix_rate));
+    Ref<AudioEffectInstance> instance = effect->instance();
+
+    LocalVector<AudioFrame> src;
+    LocalVector<AudioFrame> dst;
+    _fill(src, BLOCK_FRAMES);
+    dst.resize(BLOCK_FRAMES);
+
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < BLOCKS; i++) {
+        instance->process(src.ptr(), dst.ptr(), BLOCK_FRAMES);
+    }
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+    return (float)elapsed / BLOCKS;
+}
+
+MainLoop* test_benchmark() {
+    _check();
+
+    float mix_rate        = AudioServer::get_singleton()->get_mix_rate();
+    float block_usec      = BLOCK_FRAMES * 1000000.0f / mix_rate;
+    const float seconds[] = {0.25f, 0.5f, 1.0f, 2.0f, 4.0f, 8.0f};
+    for (int i = 0; i < 6; i++) {
+        float usec = _benchmark(seconds[i]);
+        print_line(
+            "Convolution reverb benchmark: " + rtos(seconds[i])
+            + " sec impulse, " + rtos(usec) + " usec/block of "
+            + itos(BLOCK_FRAMES) + " frames, "
+            + rtos(100.0f * usec / block_usec) + "% of real time."
+        );
+    }
+
+    return nullptr;
+}
+} // namespace TestConvolutionReverb
@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef TEST_CONVOLUTION_REVERB_H
+#define TEST_CONVOLUTION_REVERB_H
+
+#include "core/os/main_loop.h"
+
+namespace TestConvolutionReverb {
+
+MainLoop* test_benchmark();
+} // namespace TestConvolutionReverb
+
+#endif // TEST_CONVOLUTION_REVERB_H
@@ -0,0 +1,377 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "test_cpu_particles_kernels.h"
+
+#include "core/color.h"
+#include "core/local_vector.h"
+#include "core/math/math_funcs.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/print_string.h"
+#include "scene/main/cpu_particles_kernels.h"
+
+namespace TestCPUParticlesKernels {
+
+enum {
+    // Not a multiple of any SIMD width, so the kernels' tails run too.
+    PARTICLES  = 100003,
+    RUNS       = 50,
+    STRIDE     = 17,
+    STRIDE_2D  = 13,
+    COMPONENTS = CPUParticlesKernels::COMPONENTS_3D,
+};
+
+// The array of structures layouts the kernels replaced.
+struct Particle {
+    Transform transform;
+    Color color;
+    float custom[4];
+    Vector3 velocity;
+    bool active;
+    float angle_rand;
+    float scale_rand;
+    float hue_rot_rand;
+    float anim_offset_rand;
+    float time;
+    float lifetime;
+    Color base_color;
+
+    uint32_t seed;
+};
+
+struct Particle2D {
+    Transform2D transform;
+    Color color;
+    float custom[4];
+    float rotation;
+    Vector2 velocity;
+    bool active;
+    float angle_rand;
+    float scale_rand;
+    float hue_rot_rand;
+    float anim_offset_rand;
+    float time;
+    float lifetime;
+    Color base_color;
+
+    uint32_t seed;
+};
+
+struct Particles {
+    LocalVector<Particle> particles;
+    LocalVector<Particle2D> particles_2d;
+    LocalVector<float> components[COMPONENTS];
+    LocalVector<float> components_2d[CPUParticlesKernels::COMPONENTS_2D];
+    LocalVector<float> velocities[3];
+    LocalVector<float> steps;
+    // Shuffled, like particles sorted by lifetime or depth.
+    LocalVector<int> order;
+
+    LocalVector<float> buffer;
+    LocalVector<float> expected;
+
+    float* component_ptrs[COMPONENTS];
+    float* component_2d_ptrs[CPUParticlesKernels::COMPONENTS_2D];
+};
+
+static void _make_particles(Particles& r_particles) {
+    RandomPCG rng(1234);
+
+    r_particles.particles.resize(PARTICLES);
+    r_particles.particles_2d.resize(PARTICLES);
+    for (int c = 0; c < COMPONENTS; c++) {
+        r_particles.components[c].resize(PARTICLES);
+        r_particles.component_ptrs[c] = r_particles.components[c].ptr();
+    }
+    for (int c = 0; c < CPUParticlesKernels::COMPONENTS_2D; c++) {
+        r_particles.components_2d[c].resize(PARTICLES);
+        r_particles.component_2d_ptrs[c] = r_particles.components_2d[c].ptr();
+    }
+    for (int axis = 0; axis < 3; axis++) {
+        r_particles.velocities[axis].resize(PARTICLES);
+    }
+    r_particles.steps.resize(PARTICLES);
+    r_particles.order.resize(PARTICLES);
+
+    for (int i = 0; i < PARTICLES; i++) {
+        Vector3 axis(rng.randf() - 0.5f, rng.randf() - 0.5f, 1.0f);
+        Transform transform(
+            Basis(axis.normalized(), rng.randf() * Math_PI)
+                .scaled(Vector3(1, 1, 1) * (0.5f + rng.randf())),
+            Vector3(rng.randf(), rng.randf(), rng.randf()) * 10.0f
+        );
+        Vector3 velocity(rng.randf(), rng.randf(), rng.randf());
+        float step = i % 5 ? 1.0f / 60.0f : 0.0f;
+
+        Particle& p = r_particles.particles[i];
+        p.transform = transform;
+        p.velocity  = velocity;
+        CPUParticlesKernels::store_transform(
+            r_particles.component_ptrs,
+            i,
+            transform
+        );
+
+        Transform2D transform_2d(
+            rng.randf() * Math_PI,
+            Vector2(rng.randf(), rng.randf()) * 10.0f
+        );
+        Particle2D& p2 = r_particles.particles_2d[i];
+        p2.transform   = transform_2d;
+        p2.velocity    = Vector2(velocity.x, velocity.y);
+        CPUParticlesKernels::store_transform_2d(
+            r_particles.component_2d_ptrs,
+            i,
+            transform_2d
+        );
+
+        for (int a = 0; a < 3; a++) {
+            r_particles.velocities[a][i] = velocity[a];
+        }
+        r_particles.steps[i] = step;
+        r_particles.order[i] = i;
+    }
+
+    for (int i = PARTICLES - 1; i > 0; i--) {
+        SWAP(r_particles.order[i], r_particles.order[rng.rand() % (i + 1)]);
+    }
+}
+
+static Transform _emission_xform() {
+    return Transform(
+        Basis(Vector3(0, 1, 0), 0.7f).scaled(Vector3(2, 1, 0.5f)),
+        Vector3(3, -2, 5)
+    );
+}
+
+static Transform2D _emission_xform_2d() {
+    return Transform2D(0.7f, Vector2(3, -2)).scaled(Vector2(2, 0.5f));
+}
+
+// The kernels do the same operations in the same order, but the compiler may
+// still contract some of them, so the results are compared up to a relative
+// tolerance.
+static bool _is_close(float p_expected, float p_value) {
+    float tolerance = 0.0001f * MAX(1.0f, ABS(p_expected));
+    return ABS(p_expected - p_value) <= tolerance;
+}
+
+static void _compare(const String& p_kernel, const Particles& p_particles) {
+    if (p_particles.expected.size() != p_particles.buffer.size()) {
+        ERR_PRINT(p_kernel + " sizes don't match.");
+        return;
+    }
+    for (uint32_t i = 0; i < p_particles.expected.size(); i++) {
+        if (!_is_close(p_particles.expected[i], p_particles.buffer[i])) {
+            ERR_PRINT(p_kernel + " float " + itos(i) + " doesn't match.");
+            return;
+        }
+    }
+}
+
+// The reference loops are the ones the kernels replaced. Every benchmark
+// returns the usec per run.
+
+static float _benchmark_move(Particles& r_particles, bool p_kernel) {
+    Particle* particles     = r_particles.particles.ptr();
+    float* const* positions = r_particles.component_ptrs;
+    const float* steps      = r_particles.steps.ptr();
+
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int run = 0; run < RUNS; run++) {
+        if (p_kernel) {
+            for (int axis = 0; axis < 3; axis++) {
+                CPUParticlesKernels::move(
+                    positions[axis * 4 + 3],
+                    r_particles.velocities[axis].ptr(),
+                    steps,
+                    0,
+                    PARTICLES
+                );
+            }
+            continue;
+        }
+        for (int i = 0; i < PARTICLES; i++) {
+            Particle& p         = particles[i];
+            p.transform.origin += p.velocity * steps[i];
+        }
+    }
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+    LocalVector<float>& origins =
+        p_kernel ? r_particles.buffer : r_particles.expected;
+    origins.resize(PARTICLES * 3);
+    for (int i = 0; i < PARTICLES; i++) {
+        for (int axis = 0; axis < 3; axis++) {
+            origins[i * 3 + axis] = p_kernel
+                                      ? positions[axis * 4 + 3][i]
+                                      : particles[i].transform.origin[axis];
+        }
+    }
+    return float(elapsed) / RUNS;
+}
+
+static float _benchmark_write(
+    Particles& r_particles,
+    bool p_kernel,
+    const int* p_order,
+    const Transform* p_xform
+) {
+    LocalVector<float>& buffer =
+        p_kernel ? r_particles.buffer : r_particles.expected;
+    buffer.resize(PARTICLES * STRIDE);
+    const Particle* particles = r_particles.particles.ptr();
+
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int run = 0; run < RUNS; run++) {
+        if (p_kernel) {
+            CPUParticlesKernels::write_transforms(
+                r_particles.component_ptrs,
+                p_order,
+                0,
+                PARTICLES,
+                p_xform,
+                buffer.ptr(),
+                STRIDE
+            );
+            continue;
+        }
+        float* ptr = buffer.ptr();
+        for (int i = 0; i < PARTICLES; i++) {
+            int idx = p_order ? p_order[i] : i;
+
+            Transform t = particles[idx].transform;
+            if (p_xform) {
+                t = *p_xform * t;
+            }
+
+            ptr[0]  = t.basis.elements[0][0];
+            ptr[1]  = t.basis.elements[0][1];
+            ptr[2]  = t.basis.elements[0][2];
+            ptr[3]  = t.origin.x;
+            ptr[4]  = t.basis.elements[1][0];
+            ptr[5]  = t.basis.elements[1][1];
+            ptr[6]  = t.basis.elements[1][2];
+            ptr[7]  = t.origin.y;
+            ptr[8]  = t.basis.elements[2][0];
+            ptr[9]  = t.basis.elements[2][1];
+            ptr[10] = t.basis.elements[2][2];
+            ptr[11] = t.origin.z;
+
+            ptr += STRIDE;
+        }
+    }
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+    // Only the transforms are written.
+    for (int i = 0; i < PARTICLES; i++) {
+        for (int c = COMPONENTS; c < STRIDE; c++) {
+            buffer[i * STRIDE + c] = 0;
+        }
+    }
+    return float(elapsed) / RUNS;
+}
+
+static float _benchmark_write_local(Particles& r_particles, bool p_kernel) {
+    return _benchmark_write(r_particles, p_kernel, nullptr, nullptr);
+}
+
+static float _benchmark_write_global(Particles& r_particles, bool p_kernel) {
+    Transform xform = _emission_xform();
+    return _benchmark_write(r_particles, p_kernel, nullptr, &xform);
+}
+
+static float _benchmark_write_sorted(Particles& r_particles, bool p_kernel) {
+    Transform xform = _emission_xform();
+    return _benchmark_write(
+        r_particles,
+        p_kernel,
+        r_particles.order.ptr(),
+        &xform
+    );
+}
+
+static float _benchmark_write_2d(Particles& r_particles, bool p_kernel) {
+    LocalVector<float>& buffer =
+        p_kernel ? r_particles.buffer : r_particles.expected;
+    buffer.resize(PARTICLES * STRIDE_2D);
+    const Particle2D* particles = r_particles.particles_2d.ptr();
+    const int* order            = r_particles.order.ptr();
+    Transform2D xform           = _emission_xform_2d();
+
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int run = 0; run < RUNS; run++) {
+        if (p_kernel) {
+            CPUParticlesKernels::write_transforms_2d(
+                r_particles.component_2d_ptrs,
+                order,
+                0,
+                PARTICLES,
+                &xform,
+                buffer.ptr(),
+                STRIDE_2D
+            );
+            continue;
+        }
+        float* ptr = buffer.ptr();
+        for (int i = 0; i < PARTICLES; i++) {
+            int idx = order[i];
+
+            Transform2D t = xform * particles[idx].transform;
+
+            ptr[0] = t.elements[0][0];
+            ptr[1] = t.elements[1][0];
+            ptr[2] = 0;
+            ptr[3] = t.elements[2][0];
+            ptr[4] = t.elements[0][1];
+            ptr[5] = t.elements[1][1];
+            ptr[6] = 0;
+            ptr[7] = t.elements[2][1];
+
+            ptr += STRIDE_2D;
+        }
+    }
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+    // Only the transforms are written.
+    for (int i = 0; i < PARTICLES; i++) {
+        for (int c = 8; c < STRIDE_2D; c++) {
+            buffer[i * STRIDE_2D + c] = 0;
+        }
+    }
+    return float(elapsed) / RUNS;
+}
+
+typedef float (*Benchmark)(Particles& r_particles, bool p_kernel);
+
+static void _run(const char* p_kernel, Benchmark p_benchmark) {
+    // Every run starts from the same particles, as the moves change them.
+    Particles reference_particles;
+    _make_particles(reference_particles);
+    float reference = p_benchmark(reference_particles, false);
+
+    Particles particles;
+    _make_particles(particles);
+    float kernel       = p_benchmark(particles, true);
+    particles.expected = reference_particles.expected;
+
+    _compare(p_kernel, particles);
+
+    print_line(
+        String(p_kernel) + ": " + itos(PARTICLES) + " particles, scalar "
+        + rtos(reference) + " usec, kernel " + rtos(kernel) + " usec."
+    );
+}
+
+MainLoop* test_benchmark() {
+    _run("move", _benchmark_move);
+    _run("write_transforms local", _benchmark_write_local);
+    _run("write_transforms global", _benchmark_write_global);
+    _run("write_transforms global sorted", _benchmark_write_sorted);
+    _run("write_transforms_2d global sorted", _benchmark_write_2d);
+
+    return nullptr;
+}
+} // namespace TestCPUParticlesKernels
@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef TEST_CPU_PARTICLES_KERNELS_H
+#define TEST_CPU_PARTICLES_KERNELS_H
+
+#include "core/os/main_loop.h"
+
+namespace TestCPUParticlesKernels {
+
+MainLoop* test_benchmark();
+} // namespace TestCPUParticlesKernels
+
+#endif // TEST_CPU_PARTICLES_KERNELS_H
@@ -612,9 +612,29 @@ static void _disassemble_class(
             String txt = itos(ip) + " ";
 
             switch (code[ip]) {
-                case GDScriptFunction::OPCODE_OPERATOR: {
-                    int op  = code[ip + 1];
-                    txt    += " op ";
+                case GDScriptFunction::OPCODE_OPERATOR:
+                case GDScriptFunction::OPCODE_OPERATOR_INT:
+                case GDScriptFunction::OPCODE_OPERATOR_REAL:
+                case GDScriptFunction::OPCODE_OPERATOR_VECTOR2:
+                case GDScriptFunction::OPCODE_OPERATOR_VECTOR3: {
+                    int op = code[ip + 1];
+                    switch (code[ip]) {
+                        case GDScriptFunction::OPCODE_OPERATOR_INT: {
+                            txt += " op_int ";
+                        } break;
+                        case GDScriptFunction::OPCODE_OPERATOR_REAL: {
+                            txt += " op_real ";
+                        } break;
+                        case GDScriptFunction::OPCODE_OPERATOR_VECTOR2: {
+                            txt += " op_vector2 ";
+                        } break;
+                        case GDScriptFunction::OPCODE_OPERATOR_VECTOR3: {
+                            txt += " op_vector3 ";
+                        } break;
+                        default: {
+                            txt += " op ";
+                        }
+                    }
 
                     String opname =
                         Variant::get_operator_name(Variant::Operator(op));
@@ -660,13 +680,13 @@ static void _disassemble_class(
                 } break;
                 case GDScriptFunction::OPCODE_GET_NAMED: {
                     txt  += " get_named ";
-                    txt  += DADDR(3);
+                    txt  += DADDR(4);
                     txt  += "=";
                     txt  += DADDR(1);
                     txt  += "[\"";
                     txt  += func.get_global_name(code[ip + 2]);
                     txt  += "\"]";
-                    incr += 4;
+                    incr += 5;
 
                 } break;
                 case GDScriptFunction::OPCODE_SET_MEMBER: {
@@ -687,6 +707,25 @@ static void _disassemble_class(
                     txt  += "\"]";
                     incr += 3;
 
+                } break;
+                case GDScriptFunction::OPCODE_SET_MEMBER_NATIVE: {
+                    txt  += " set_member_native ";
+                    txt  += "[\"";
+                    txt  += func.get_global_name(code[ip + 1]);
+                    txt  += "\"]=";
+                    txt  += DADDR(3);
+                    incr += 4;
+
+                } break;
+                case GDScriptFunction::OPCODE_GET_MEMBER_NATIVE: {
+                    txt  += " get_member_native ";
+                    txt  += DADDR(3);
+                    txt  += "=";
+                    txt  += "[\"";
+                    txt  += func.get_global_name(code[ip + 1]);
+                    txt  += "\"]";
+                    incr += 4;
+
                 } break;
                 case GDScriptFunction::OPCODE_ASSIGN: {
                     txt  += " assign ";
@@ -817,7 +856,38 @@ static void _disassemble_class(
 
                     int argc = code[ip + 1];
                     if (ret) {
-                        txt += DADDR(4 + argc) + "=";
+                        txt += DADDR(5 + argc) + "=";
+                    }
+
+                    txt += DADDR(2) + ".";
+                    txt += String(func.get_global_name(code[ip + 3]));
+                    txt += "(";
+
+                    for (int i = 0; i < argc; i++) {
+                        if (i > 0) {
+                            txt += ", ";
+                        }
+                        txt += DADDR(5 + i);
+                    }
+                    txt += ")";
+
+                    incr = 6 + argc;
+
+                } break;
+                case GDScriptFunction::OPCODE_CALL_NATIVE:
+                case GDScriptFunction::OPCODE_CALL_NATIVE_RETURN: {
+                    bool ret =
+                        code[ip] == GDScriptFunction::OPCODE_CALL_NATIVE_RETURN;
+
+                    if (ret) {
+                        txt += " call-native-ret ";
+                    } else {
+                        txt += " call-native ";
+                    }
+
+                    int argc = code[ip + 1];
+                    if (ret) {
+                        txt += DADDR(5 + argc) + "=";
                     }
 
                     txt += DADDR(2) + ".";
@@ -828,11 +898,11 @@ static void _disassemble_class(
                         if (i > 0) {
                             txt += ", ";
                         }
-                        txt += DADDR(4 + i);
+                        txt += DADDR(5 + i);
                     }
                     txt += ")";
 
-                    incr = 5 + argc;
+                    incr = 6 + argc;
 
                 } break;
                 case GDScriptFunction::OPCODE_CALL_BUILT_IN: {
@@ -976,7 +1046,297 @@ static void _disassemble_class(
     }
 }
 
+// Every function has a typed and an untyped version, with the same body, so
+// the typed opcodes can be compared with the generic ones.
+static const char* typed_script_source =
+    "class Base extends Node2D:\n"
+    "\tfunc move_typed(x: float):\n"
+    "\t\tposition = Vector2(x, 0)\n"
+    "\t\tset_position(Vector2(position.x, x))\n"
+    "\t\treturn position\n"
+    "\n"
+    "\tfunc move_untyped(x):\n"
+    "\t\tposition = Vector2(x, 0)\n"
+    "\t\tset_position(Vector2(position.x, x))\n"
+    "\t\treturn position\n"
+    "\n"
+    "class Sub extends Base:\n"
+    "\tvar calls = 0\n"
+    "\n"
+    "\tfunc set_position(value):\n"
+    "\t\tcalls += 1\n"
+    "\t\t.set_position(value * 2)\n"
+    "\n"
+    "static func int_ops_typed(a: int, b: int):\n"
+    "\treturn [a + b, a - b, a * b, -a, a < b, a >= b, a == b, a != b]\n"
+    "\n"
+    "static func int_ops_untyped(a, b):\n"
+    "\treturn [a + b, a - b, a * b, -a, a < b, a >= b, a == b, a != b]\n"
+    "\n"
+    "static func mixed_ops_typed(a: int, b: float):\n"
+    "\treturn [a + b, b + a, a - b, b * a, a / b, b / a, a < b, a == b]\n"
+    "\n"
+    "static func mixed_ops_untyped(a, b):\n"
+    "\treturn [a + b, b + a, a - b, b * a, a / b, b / a, a < b, a == b]\n"
+    "\n"
+    "static func vector_ops_typed(a: Vector2, b: Vector2, s: float):\n"
+    "\treturn [a + b, a - b, a * b, a / b, a * s, a / s, -a, a == b]\n"
+    "\n"
+    "static func vector_ops_untyped(a, b, s):\n"
+    "\treturn [a + b, a - b, a * b, a / b, a * s, a / s, -a, a == b]\n"
+    "\n"
+    "static func int_div_typed(a: int, b: int):\n"
+    "\treturn a / b\n"
+    "\n"
+    "static func int_div_untyped(a, b):\n"
+    "\treturn a / b\n"
+    "\n"
+    "static func real_div_typed(a: float, b: float):\n"
+    "\treturn a / b\n"
+    "\n"
+    "static func real_div_untyped(a, b):\n"
+    "\treturn a / b\n"
+    "\n"
+    "static func mixed_div_typed(a: int, b: float):\n"
+    "\treturn a / b\n"
+    "\n"
+    "static func mixed_div_untyped(a, b):\n"
+    "\treturn a / b\n"
+    "\n"
+    "static func setter_typed(x: float):\n"
+    "\tvar sub = Sub.new()\n"
+    "\tvar node: Node2D = sub\n"
+    "\tvar moved = sub.move_typed(x)\n"
+    "\tnode.set_position(Vector2(x, x))\n"
+    "\tvar result = [moved, node.position, sub.calls]\n"
+    "\tsub.free()\n"
+    "\treturn result\n"
+    "\n"
+    "static func setter_untyped(x):\n"
+    "\tvar sub = Sub.new()\n"
+    "\tvar node = sub\n"
+    "\tvar moved = sub.move_untyped(x)\n"
+    "\tnode.set_position(Vector2(x, x))\n"
+    "\tvar result = [moved, node.position, sub.calls]\n"
+    "\tsub.free()\n"
+    "\treturn result\n"
+    "\n"
+    "static func base_type_typed():\n"
+    "\tvar sprite: Node2D = Sprite.new()\n"
+    "\tvar plain: Node2D = Node2D.new()\n"
+    "\tsprite.set_position(Vector2(1, 2))\n"
+    "\tplain.set_position(Vector2(3, 4))\n"
+    "\tvar result = [sprite.get_class(), plain.get_class(), sprite.position]\n"
+    "\tresult.append(plain.get_position())\n"
+    "\tsprite.free()\n"
+    "\tplain.free()\n"
+    "\treturn result\n"
+    "\n"
+    "static func base_type_untyped():\n"
+    "\tvar sprite = Sprite.new()\n"
+    "\tvar plain = Node2D.new()\n"
+    "\tsprite.set_position(Vector2(1, 2))\n"
+    "\tplain.set_position(Vector2(3, 4))\n"
+    "\tvar result = [sprite.get_class(), plain.get_class(), sprite.position]\n"
+    "\tresult.append(plain.get_position())\n"
+    "\tsprite.free()\n"
+    "\tplain.free()\n"
+    "\treturn result\n"
+    "\n"
+    "static func receivers_typed(x: float):\n"
+    "\tvar result = []\n"
+    "\tfor n in [Node2D.new(), Sub.new(), Node2D.new(), Sub.new()]:\n"
+    "\t\tvar node: Node2D = n\n"
+    "\t\tnode.set_position(Vector2(x, x))\n"
+    "\t\tresult.append(node.position)\n"
+    "\t\tnode.free()\n"
+    "\treturn result\n"
+    "\n"
+    "static func receivers_untyped(x):\n"
+    "\tvar result = []\n"
+    "\tfor n in [Node2D.new(), Sub.new(), Node2D.new(), Sub.new()]:\n"
+    "\t\tvar node = n\n"
+    "\t\tnode.set_position(Vector2(x, x))\n"
+    "\t\tresult.append(node.position)\n"
+    "\t\tnode.free()\n"
+    "\treturn result\n";
+
+// Same type and value, element by element for arrays.
+static bool _is_same(const Variant& p_a, const Variant& p_b) {
+    if (p_a.get_type() != p_b.get_type()) {
+        return false;
+    }
+    if (p_a.get_type() != Variant::ARRAY) {
+        return p_a == p_b;
+    }
+    Array a = p_a;
+    Array b = p_b;
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (int i = 0; i < a.size(); i++) {
+        if (!_is_same(a[i], b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Calls both versions of p_function, and checks that they return the same,
+// and, if p_expected isn't null, what was expected.
+static bool _check_typed(
+    Ref<GDScript>& p_script,
+    const String& p_function,
+    const Variant& p_arg1     = Variant(),
+    const Variant& p_arg2     = Variant(),
+    const Variant& p_arg3     = Variant(),
+    const Variant& p_expected = Variant()
+) {
+    const Variant* args[3] = {&p_arg1, &p_arg2, &p_arg3};
+    int arg_count          = 3;
+    while (arg_count > 0 && args[arg_count - 1]->get_type() == Variant::NIL) {
+        arg_count--;
+    }
+
+    // GDScript::call() is protected.
+    Object* script = p_script.ptr();
+    Variant::CallError call_error;
+    Variant typed_result = script->call(
+        p_function + "_typed",
+        args,
+        arg_count,
+        call_error
+    );
+    Variant untyped_result = script->call(
+        p_function + "_untyped",
+        args,
+        arg_count,
+        call_error
+    );
+
+    bool success = _is_same(typed_result, untyped_result);
+    if (p_expected.get_type() != Variant::NIL) {
+        success &= _is_same(typed_result, p_expected);
+    }
+    if (!success) {
+        print_line(
+            "Fail: " + p_function + "(" + String(p_arg1) + ", "
+            + String(p_arg2) + ", " + String(p_arg3)
+            + "): typed returned " + String(typed_result)
+            + ", untyped returned " + String(untyped_result) + "."
+        );
+    }
+    return success;
+}
+
+// Runs the typed opcodes and the generic ones on the same operands.
+static MainLoop* _test_typed() {
+    print_line("Start typed GDScript checks.");
+
+    Ref<GDScript> script;
+    script.instance();
+    script->set_source_code(typed_script_source);
+    Error err = script->reload();
+    if (err) {
+        print_line("Typed GDScript checks FAILED: the script didn't compile.");
+        return nullptr;
+    }
+
+    const int64_t int_max = 0x7FFFFFFFFFFFFFFF;
+
+    bool success = true;
+    // Integers wrap around on overflow.
+    success &= _check_typed(script, "int_ops", int_max, 1);
+    success &= _check_typed(script, "int_ops", -int_max - 1, -1);
+    success &= _check_typed(script, "int_ops", 7, -3);
+    success &= _check_typed(script, "mixed_ops", 7, 2.5);
+    success &= _check_typed(script, "mixed_ops", -3, 0.5);
+    success &= _check_typed(script, "mixed_ops", 2, 2.0);
+    success &= _check_typed(script, "mixed_ops", int_max, 1.0);
+    success &= _check_typed(
+        script,
+        "vector_ops",
+        Vector2(1, -2),
+        Vector2(4, 0.5),
+        0.25
+    );
+    success &= _check_typed(
+        script,
+        "vector_ops",
+        Vector2(3, 3),
+        Vector2(3, 3),
+        2.0
+    );
+    // Division by zero fails the same way, and prints the same error, for
+    // both versions.
+    print_line("The following division by zero errors are expected.");
+    success &= _check_typed(script, "int_div", 7, 0);
+    success &= _check_typed(script, "real_div", 7.0, 0.0);
+    success &= _check_typed(script, "mixed_div", 7, 0.0);
+    success &= _check_typed(script, "int_div", 7, 2);
+    success &= _check_typed(script, "real_div", 7.0, 2.0);
+    success &= _check_typed(script, "mixed_div", 7, 2.0);
+
+    // The subclass's set_position() doubles the position, and is used for
+    // the method calls, even when the static type is the native base class,
+    // but not for the assignment, which sets the native property.
+    Array setter_expected;
+    setter_expected.push_back(Vector2(6, 6));
+    setter_expected.push_back(Vector2(6, 6));
+    setter_expected.push_back(2);
+    success &= _check_typed(
+        script,
+        "setter",
+        3.0,
+        Variant(),
+        Variant(),
+        setter_expected
+    );
+
+    Array base_type_expected;
+    base_type_expected.push_back("Sprite");
+    base_type_expected.push_back("Node2D");
+    base_type_expected.push_back(Vector2(1, 2));
+    base_type_expected.push_back(Vector2(3, 4));
+    success &= _check_typed(
+        script,
+        "base_type",
+        Variant(),
+        Variant(),
+        Variant(),
+        base_type_expected
+    );
+
+    // The same call site sees receivers with and without the overriding
+    // script, after their methods are cached.
+    Array receivers_expected;
+    receivers_expected.push_back(Vector2(1, 1));
+    receivers_expected.push_back(Vector2(2, 2));
+    receivers_expected.push_back(Vector2(1, 1));
+    receivers_expected.push_back(Vector2(2, 2));
+    success &= _check_typed(
+        script,
+        "receivers",
+        1.0,
+        Variant(),
+        Variant(),
+        receivers_expected
+    );
+
+    if (success) {
+        print_line("Typed GDScript checks passed.");
+    } else {
+        print_line("Typed GDScript checks FAILED.");
+    }
+
+    return nullptr;
+}
+
 MainLoop* test(TestType p_type) {
+    if (p_type == TEST_TYPED) {
+        return _test_typed();
+    }
+
     List<String> cmdlargs = OS::get_singleton()->get_cmdline_args();
 
     if (cmdlargs.empty()) {
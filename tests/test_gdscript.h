@@ -16,6 +16,7 @@ enum TestType {
     TEST_PARSER,
     TEST_COMPILER,
     TEST_BYTECODE,
+    TEST_TYPED,
 };
 
 MainLoop* test(TestType p_type);
@@ -10,13 +10,23 @@
 
 #ifdef DEBUG_ENABLED
 
+#include "test_animation_compression.h"
+#include "test_animation_tree.h"
 #include "test_astar.h"
+#include "test_audio_kernels.h"
+#include "test_audio_mixing.h"
+#include "test_audio_voice_manager.h"
 #include "test_basis.h"
+#include "test_canvas_batcher.h"
+#include "test_command_queue.h"
+#include "test_convolution_reverb.h"
+#include "test_cpu_particles_kernels.h"
 #include "test_crypto.h"
 #include "test_gdscript.h"
 #include "test_gui.h"
 #include "test_math.h"
 #include "test_oa_hash_map.h"
+#include "test_occlusion_buffer.h"
 #include "test_ordered_hash_map.h"
 #include "test_physics.h"
 #include "test_physics_2d.h"
@@ -33,15 +43,29 @@ const char** tests_get_names() {
         "basis",
         "transform",
         "physics",
+        "physics_benchmark",
         "physics_2d",
         "render",
+        "render_benchmark",
+        "command_queue_benchmark",
+        "canvas_batcher_benchmark",
+        "animation_compression",
+        "animation_compression_benchmark",
+        "animation_tree",
+        "audio_mixing_benchmark",
+        "audio_kernels_benchmark",
+        "audio_voice_manager",
+        "convolution_reverb_benchmark",
+        "cpu_particles_kernels_benchmark",
         "oa_hash_map",
+        "occlusion_buffer",
         "gui",
         "shaderlang",
         "gd_tokenizer",
         "gd_parser",
         "gd_compiler",
         "gd_bytecode",
+        "gd_typed",
         "ordered_hash_map",
         "astar",
         "xml_parser",
@@ -72,6 +96,10 @@ MainLoop* test_main(String p_test, const List<String>& p_args) {
         return TestPhysics::test();
     }
 
+    if (p_test == "physics_benchmark") {
+        return TestPhysics::test_benchmark();
+    }
+
     if (p_test == "physics_2d") {
         return TestPhysics2D::test();
     }
@@ -80,10 +108,58 @@ MainLoop* test_main(String p_test, const List<String>& p_args) {
         return TestRender::test();
     }
 
+    if (p_test == "render_benchmark") {
+        return TestRender::test_benchmark();
+    }
+
+    if (p_test == "command_queue_benchmark") {
+        return TestCommandQueue::test_benchmark();
+    }
+
+    if (p_test == "canvas_batcher_benchmark") {
+        return TestCanvasBatcher::test_benchmark();
+    }
+
+    if (p_test == "animation_compression") {
+        return TestAnimationCompression::test();
+    }
+
+    if (p_test == "animation_compression_benchmark") {
+        return TestAnimationCompression::test_benchmark();
+    }
+
+    if (p_test == "animation_tree") {
+        return TestAnimationTree::test();
+    }
+
+    if (p_test == "audio_mixing_benchmark") {
+        return TestAudioMixing::test_benchmark();
+    }
+
+    if (p_test == "audio_kernels_benchmark") {
+        return TestAudioKernels::test_benchmark();
+    }
+
+    if (p_test == "audio_voice_manager") {
+        return TestAudioVoiceManager::test();
+    }
+
+    if (p_test == "convolution_reverb_benchmark") {
+        return TestConvolutionReverb::test_benchmark();
+    }
+
+    if (p_test == "cpu_particles_kernels_benchmark") {
+        return TestCPUParticlesKernels::test_benchmark();
+    }
+
     if (p_test == "oa_hash_map") {
         return TestOAHashMap::test();
     }
 
+    if (p_test == "occlusion_buffer") {
+        return TestOcclusionBuffer::test();
+    }
+
 #ifndef _3D_DISABLED
     if (p_test == "gui") {
         return TestGUI::test();
@@ -114,6 +190,10 @@ MainLoop* test_main(String p_test, const List<String>& p_args) {
         return TestGDScript::test(TestGDScript::TEST_BYTECODE);
     }
 
+    if (p_test == "gd_typed") {
+        return TestGDScript::test(TestGDScript::TEST_TYPED);
+    }
+
     if (p_test == "ordered_hash_map") {
         return TestOrderedHashMap::test();
     }
@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#include "test_occlusion_buffer.h"
+
+#include "core/os/os.h"
+#include "servers/visual/portals/portal_occlusion_buffer.h"
+
+namespace TestOcclusionBuffer {
+
+// A box in front of a camera at the origin, looking down -z. The box's
+// distance is chosen so the outline doesn't fall on a pixel boundary.
+const real_t HALF_SIZE    = 2.0;
+const real_t BOX_DEPTH    = 9.7;
+// The instances are far behind the box.
+const real_t TARGET_DEPTH = 30.0;
+
+const real_t ASPECT =
+    (real_t)PortalOcclusionBuffer::WIDTH / PortalOcclusionBuffer::HEIGHT;
+
+// Outward facing quads of the box's corners, where bit 0 of a corner is its
+// x, bit 1 its y and bit 2 its z.
+const uint32_t box_quads[6][4] = {
+    {0, 4, 6, 2},
+    {1, 3, 7, 5},
+    {0, 1, 5, 4},
+    {2, 6, 7, 3},
+    {0, 2, 3, 1},
+    {4, 5, 7, 6},
+};
+
+static void _draw_box(PortalOcclusionBuffer& r_buffer) {
+    Vector3 vertices[8];
+    for (int i = 0; i < 8; i++) {
+        vertices[i] = Vector3(
+            (i & 1) ? HALF_SIZE : -HALF_SIZE,
+            (i & 2) ? HALF_SIZE : -HALF_SIZE,
+            -BOX_DEPTH + ((i & 4) ? HALF_SIZE : -HALF_SIZE)
+        );
+    }
+
+    uint32_t indices[36];
+    for (int q = 0; q < 6; q++) {
+        const uint32_t* quad = box_quads[q];
+        uint32_t* triangles  = &indices[q * 6];
+        triangles[0]         = quad[0];
+        triangles[1]         = quad[1];
+        triangles[2]         = quad[2];
+        triangles[3]         = quad[0];
+        triangles[4]         = quad[2];
+        triangles[5]         = quad[3];
+    }
+
+    LocalVector<int32_t, int32_t> edge_neighbours;
+    PortalOcclusionBuffer::find_edge_neighbours(
+        vertices,
+        indices,
+        36,
+        edge_neighbours
+    );
+
+    CameraMatrix projection;
+    projection.set_perspective(90, ASPECT, 0.1, 100);
+    r_buffer.begin(Transform(), projection);
+    r_buffer.draw_triangles(vertices, 8, indices, edge_neighbours.ptr(), 36);
+    r_buffer.end();
+}
+
+// A thin instance behind the box, covering the given screen columns.
+static AABB _get_target(real_t p_left, real_t p_right) {
+    real_t half_width = PortalOcclusionBuffer::WIDTH * 0.5;
+    real_t scale      = TARGET_DEPTH * ASPECT / half_width;
+    real_t left       = (p_left - half_width) * scale;
+    real_t right      = (p_right - half_width) * scale;
+    return AABB(
+        Vector3(left, -0.5, -TARGET_DEPTH - 0.01),
+        Vector3(right - left, 1.0, 0.01)
+    );
+}
+
+// Two slopes that meet at a crease pointing toward an orthogonal camera, with
+// one pixel per unit. The crease is at x = CREASE_X, which is past the center
+// of its pixel, and is CREASE_DEPTH away. The left slope is almost flat, and
+// the right one is steep.
+const real_t CREASE_X     = 0.7;
+const real_t CREASE_DEPTH = 10.0;
+
+static void _draw_crease(PortalOcclusionBuffer& r_buffer) {
+    Vector3 vertices[6] = {
+        Vector3(-20, -20, -CREASE_DEPTH - 0.2),
+        Vector3(CREASE_X, -20, -CREASE_DEPTH),
+        Vector3(CREASE_X, 20, -CREASE_DEPTH),
+        Vector3(-20, 20, -CREASE_DEPTH - 0.2),
+        Vector3(CREASE_X + 2, -20, -CREASE_DEPTH - 20),
+        Vector3(CREASE_X + 2, 20, -CREASE_DEPTH - 20),
+    };
+    uint32_t indices[12] = {0, 1, 2, 0, 2, 3, 1, 4, 5, 1, 5, 2};
+
+    LocalVector<int32_t, int32_t> edge_neighbours;
+    PortalOcclusionBuffer::find_edge_neighbours(
+        vertices,
+        indices,
+        12,
+        edge_neighbours
+    );
+
+    CameraMatrix projection;
+    projection.set_orthogonal(
+        -PortalOcclusionBuffer::WIDTH / 2,
+        PortalOcclusionBuffer::WIDTH / 2,
+        -PortalOcclusionBuffer::HEIGHT / 2,
+        PortalOcclusionBuffer::HEIGHT / 2,
+        1,
+        100
+    );
+    r_buffer.begin(Transform(), projection);
+    r_buffer.draw_triangles(vertices, 6, indices, edge_neighbours.ptr(), 12);
+    r_buffer.end();
+}
+
+// An instance from the left slope to just past the crease, p_depth away.
+static AABB _get_crease_target(real_t p_depth) {
+    return AABB(
+        Vector3(-3, -3, -p_depth - 0.5),
+        Vector3(CREASE_X + 3.2, 6, 0.5)
+    );
+}
+
+static bool _check_aabb(
+    const PortalOcclusionBuffer& p_buffer,
+    const char* p_name,
+    const AABB& p_target,
+    bool p_occluded
+) {
+    if (p_buffer.is_aabb_occluded(p_target) == p_occluded) {
+        return true;
+    }
+    OS::get_singleton()->print(
+        "Fail: %s should %sbe occluded.\n",
+        p_name,
+        p_occluded ? "" : "not "
+    );
+    return false;
+}
+
+static bool _check(
+    const PortalOcclusionBuffer& p_buffer,
+    const char* p_name,
+    real_t p_left,
+    real_t p_right,
+    bool p_occluded
+) {
+    return _check_aabb(
+        p_buffer,
+        p_name,
+        _get_target(p_left, p_right),
+        p_occluded
+    );
+}
+
+MainLoop* test() {
+    OS::get_singleton()->print("Start occlusion buffer checks.\n");
+
+    PortalOcclusionBuffer buffer;
+    _draw_box(buffer);
+
+    // The screen column of the right edge of the box's outline, which is the
+    // outline of its front face.
+    real_t half_width = PortalOcclusionBuffer::WIDTH * 0.5;
+    real_t outline =
+        half_width * (1 + HALF_SIZE / ((BOX_DEPTH - HALF_SIZE) * ASPECT));
+    real_t pixel = Math::floor(outline);
+
+    bool success = true;
+
+    success &= _check(buffer, "Center", half_width - 2, half_width + 2, true);
+    // The pixel before the outline is entirely covered by the box.
+    success &= _check(buffer, "Inside", pixel - 0.8, pixel - 0.2, true);
+    // The outline's pixel is only partly covered, so an instance in the part
+    // that isn't can be seen.
+    success &= _check(buffer, "Outline", outline + 0.05, pixel + 0.95, false);
+    success &= _check(buffer, "Outside", pixel + 1.2, pixel + 1.8, false);
+
+    // The instance is behind the flat slope, but in front of the steep one
+    // within the crease's pixel.
+    _draw_crease(buffer);
+    success &= _check_aabb(
+        buffer,
+        "Crease",
+        _get_crease_target(CREASE_DEPTH + 1),
+        false
+    );
+    success &= _check_aabb(
+        buffer,
+        "Behind crease",
+        _get_crease_target(CREASE_DEPTH + 21),
+        true
+    );
+
+    if (success) {
+        OS::get_singleton()->print("Occlusion buffer checks passed.\n");
+    } else {
+        OS::get_singleton()->print("Occlusion buffer checks FAILED.\n");
+    }
+
+    return nullptr;
+}
+} // namespace TestOcclusionBuffer
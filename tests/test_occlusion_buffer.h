@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: 2023 Rebel Engine contributors
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef TEST_OCCLUSION_BUFFER_H
+#define TEST_OCCLUSION_BUFFER_H
+
+#include "core/os/main_loop.h"
+
+namespace TestOcclusionBuffer {
+
+MainLoop* test();
+} // namespace TestOcclusionBuffer
+
+#endif // TEST_OCCLUSION_BUFFER_H
@@ -466,9 +466,110 @@ public:
     TestPhysicsMainLoop() {}
 };
 
+// Steps many independent piles of boxes without any visuals and reports the
+// solver throughput. Change physics/3d/rebel_physics/solver_thread_count to
+// compare the serial and the threaded island solver.
+class TestPhysicsBenchmarkMainLoop : public MainLoop {
+    GDCLASS(TestPhysicsBenchmarkMainLoop, MainLoop);
+
+    enum {
+        PILE_COUNT      = 256,
+        PILE_HEIGHT     = 6,
+        WARMUP_STEPS    = 60,
+        BENCHMARK_STEPS = 300,
+    };
+
+    RID space;
+    RID box_shape;
+    RID plane_shape;
+    RID plane;
+    List<RID> bodies;
+
+public:
+    virtual void init() {
+        PhysicsServer* ps = PhysicsServer::get_singleton();
+
+        space = ps->space_create();
+        ps->space_set_active(space, true);
+
+        box_shape = ps->shape_create(PhysicsServer::SHAPE_BOX);
+        ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+        plane_shape = ps->shape_create(PhysicsServer::SHAPE_PLANE);
+        ps->shape_set_data(plane_shape, Plane(Vector3(0, 1, 0), 0));
+        plane = ps->body_create(PhysicsServer::BODY_MODE_STATIC);
+        ps->body_set_space(plane, space);
+        ps->body_add_shape(plane, plane_shape);
+
+        // Piles are far enough apart to always be separate islands.
+        int side = Math::ceil(Math::sqrt((float)PILE_COUNT));
+        for (int i = 0; i < PILE_COUNT; i++) {
+            Vector3 base((i % side) * 3.0, 0.5, (i / side) * 3.0);
+            for (int j = 0; j < PILE_HEIGHT; j++) {
+                RID body = ps->body_create(PhysicsServer::BODY_MODE_RIGID);
+                ps->body_set_space(body, space);
+                ps->body_add_shape(body, box_shape);
+                ps->body_set_state(
+                    body,
+                    PhysicsServer::BODY_STATE_TRANSFORM,
+                    Transform(Basis(), base + Vector3(0, j * 1.01, 0))
+                );
+                bodies.push_back(body);
+            }
+        }
+
+        const real_t delta = 1.0 / 60.0;
+        for (int i = 0; i < WARMUP_STEPS; i++) {
+            ps->step(delta);
+            ps->flush_queries();
+        }
+
+        uint64_t begin = OS::get_singleton()->get_ticks_usec();
+        for (int i = 0; i < BENCHMARK_STEPS; i++) {
+            ps->step(delta);
+            ps->flush_queries();
+        }
+        uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+        int active  = ps->get_process_info(PhysicsServer::INFO_ACTIVE_OBJECTS);
+        int islands = ps->get_process_info(PhysicsServer::INFO_ISLAND_COUNT);
+        float msec  = MAX(elapsed, (uint64_t)1) / 1000.0;
+        print_line(
+            "Physics benchmark: " + itos(bodies.size()) + " bodies, "
+            + itos(active) + " active, " + itos(islands) + " islands, "
+            + rtos(msec / BENCHMARK_STEPS) + " msec/step, "
+            + rtos(bodies.size() * BENCHMARK_STEPS / msec) + " bodies/msec."
+        );
+    }
+
+    virtual bool iteration(float p_time) {
+        return true;
+    }
+
+    virtual bool idle(float p_time) {
+        return false;
+    }
+
+    virtual void finish() {
+        PhysicsServer* ps = PhysicsServer::get_singleton();
+        for (List<RID>::Element* E = bodies.front(); E; E = E->next()) {
+            ps->free(E->get());
+        }
+        bodies.clear();
+        ps->free(plane);
+        ps->free(plane_shape);
+        ps->free(box_shape);
+        ps->free(space);
+    }
+};
+
 namespace TestPhysics {
 
 MainLoop* test() {
     return memnew(TestPhysicsMainLoop);
 }
+
+MainLoop* test_benchmark() {
+    return memnew(TestPhysicsBenchmarkMainLoop);
+}
 } // namespace TestPhysics
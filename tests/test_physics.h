@@ -12,6 +12,7 @@
 namespace TestPhysics {
 
 MainLoop* test();
+MainLoop* test_benchmark();
 } // namespace TestPhysics
 
 #endif
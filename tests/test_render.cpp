@@ -12,6 +12,8 @@
 #include "core/os/main_loop.h"
 #include "core/os/os.h"
 #include "core/print_string.h"
+#include "servers/visual/visual_server_globals.h"
+#include "servers/visual/visual_server_scene.h"
 #include "servers/visual_server.h"
 
 #define OBJECT_COUNT 50
@@ -229,4 +231,72 @@ public:
 MainLoop* test() {
     return memnew(TestMainLoop);
 }
+
+enum {
+    BENCHMARK_INSTANCES = 50000,
+    WARMUP_FRAMES       = 10,
+    BENCHMARK_FRAMES    = 100,
+};
+
+// Prepares a scene with many instances for a camera and reports the time
+// spent per frame. Run it headless, where the dummy rasterizer makes the
+// scene preparation the only cost, with the default thread model. Change
+// rendering/threads/scene_preparation_thread_count to compare the serial and
+// the threaded preparation.
+MainLoop* test_benchmark() {
+    VisualServer* vs = VisualServer::get_singleton();
+    RID scenario     = vs->scenario_create();
+    RID mesh         = vs->mesh_create();
+
+    List<RID> instances;
+    for (int i = 0; i < BENCHMARK_INSTANCES; i++) {
+        RID instance = vs->instance_create2(mesh, scenario);
+        vs->instance_set_custom_aabb(
+            instance,
+            AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1))
+        );
+        vs->instance_set_transform(
+            instance,
+            Transform(
+                Basis(),
+                Vector3(
+                    Math::random(-100, 100),
+                    Math::random(-100, 100),
+                    Math::random(-200, 0)
+                )
+            )
+        );
+        instances.push_back(instance);
+    }
+
+    RID camera = vs->camera_create();
+    vs->camera_set_perspective(camera, 90, 0.1f, 1000);
+    VSG::scene->update_dirty_instances();
+
+    Size2 viewport_size(1920, 1080);
+    for (int i = 0; i < WARMUP_FRAMES; i++) {
+        VSG::scene->render_camera(camera, scenario, viewport_size, RID());
+    }
+
+    uint64_t begin = OS::get_singleton()->get_ticks_usec();
+    for (int i = 0; i < BENCHMARK_FRAMES; i++) {
+        VSG::scene->render_camera(camera, scenario, viewport_size, RID());
+    }
+    uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+    print_line(
+        "Render benchmark: " + itos(BENCHMARK_INSTANCES) + " instances, "
+        + itos(VSG::scene->instance_cull_result.count) + " visible, "
+        + rtos(elapsed / 1000.0 / BENCHMARK_FRAMES) + " msec/frame."
+    );
+
+    for (List<RID>::Element* E = instances.front(); E; E = E->next()) {
+        vs->free(E->get());
+    }
+    vs->free(camera);
+    vs->free(mesh);
+    vs->free(scenario);
+
+    return nullptr;
+}
 } // namespace TestRender
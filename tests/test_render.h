@@ -12,6 +12,7 @@
 namespace TestRender {
 
 MainLoop* test();
+MainLoop* test_benchmark();
 } // namespace TestRender
 
 #endif